@@ -125,6 +125,7 @@ XdmfAttribute::setCenter(const shared_ptr<const XdmfAttributeCenter> center)
 void
 XdmfAttribute::setName(const std::string & name)
 {
+  XdmfItemNameIndex::nameChanged(this, mName, name);
   mName = name;
 }
 
@@ -143,6 +143,7 @@ XdmfGrid::populateItem(const std::map<std::string, std::string> & itemProperties
 void
 XdmfGrid::setName(const std::string & name)
 {
+  XdmfItemNameIndex::nameChanged(this, mName, name);
   mName = name;
 }
 
@@ -150,6 +151,15 @@ void
 XdmfGrid::setTime(const shared_ptr<XdmfTime> time)
 {
   mTime = time;
+  for(std::vector<boost::weak_ptr<bool> >::const_iterator iter =
+        mStepIndices.begin();
+      iter != mStepIndices.end();
+      ++iter) {
+    if(shared_ptr<bool> stepsCurrent = iter->lock()) {
+      *stepsCurrent = false;
+    }
+  }
+  mStepIndices.clear();
 }
 
 void
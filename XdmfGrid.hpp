@@ -33,6 +33,7 @@ class XdmfTime;
 class XdmfTopology;
 
 // Includes
+#include <boost/weak_ptr.hpp>
 #include "Xdmf.hpp"
 #include "XdmfItem.hpp"
 
@@ -271,7 +272,12 @@ private:
   XdmfGrid(const XdmfGrid &);  // Not implemented.
   void operator=(const XdmfGrid &);  // Not implemented.
 
+  friend class XdmfGridCollection;
+
   std::string mName;
+  // Step indices of the collections the grid is in, set out of date
+  // when its time is replaced
+  std::vector<boost::weak_ptr<bool> > mStepIndices;
   shared_ptr<XdmfTime> mTime;
 
 };
@@ -21,11 +21,64 @@
 /*                                                                           */
 /*****************************************************************************/
 
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
 #include <utility>
+#include "XdmfCurvilinearGrid.hpp"
+#include "XdmfDeferredItem.hpp"
+#include "XdmfError.hpp"
 #include "XdmfGeometry.hpp"
 #include "XdmfTopology.hpp"
 #include "XdmfGridCollection.hpp"
 #include "XdmfGridCollectionType.hpp"
+#include "XdmfRectilinearGrid.hpp"
+#include "XdmfRegularGrid.hpp"
+#include "XdmfTime.hpp"
+#include "XdmfUnstructuredGrid.hpp"
+
+namespace {
+
+  template <typename T>
+  bool
+  eraseGrid(std::vector<shared_ptr<T> > & grids,
+            XdmfItemNameIndex & gridIndex,
+            const XdmfGrid * const grid)
+  {
+    for(typename std::vector<shared_ptr<T> >::iterator iter = grids.begin();
+        iter != grids.end();
+        ++iter) {
+      if(iter->get() == grid) {
+        grids.erase(iter);
+        gridIndex.clear();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Adds the flag of a step index to the indices a grid or time is in
+  void
+  addStepIndex(std::vector<boost::weak_ptr<bool> > & stepIndices,
+               const shared_ptr<bool> & stepsCurrent)
+  {
+    std::vector<boost::weak_ptr<bool> >::iterator iter = stepIndices.begin();
+    while(iter != stepIndices.end()) {
+      const shared_ptr<bool> index = iter->lock();
+      if(index == stepsCurrent) {
+        return;
+      }
+      if(index) {
+        ++iter;
+      }
+      else {
+        iter = stepIndices.erase(iter);
+      }
+    }
+    stepIndices.push_back(stepsCurrent);
+  }
+
+}
 
 shared_ptr<XdmfGridCollection>
 XdmfGridCollection::New()
@@ -37,6 +90,8 @@ XdmfGridCollection::New()
 XdmfGridCollection::XdmfGridCollection() :
   XdmfDomain(),
   XdmfGrid(XdmfGeometry::New(), XdmfTopology::New(), "Collection"),
+  mIndexedGridsVersion(0),
+  mStepsCurrent(new bool(false)),
   mType(XdmfGridCollectionType::NoCollectionType())
 {
 }
@@ -63,18 +118,144 @@ XdmfGridCollection::getItemTag() const
   return ItemTag;
 }
 
+unsigned int
+XdmfGridCollection::getLowerStep(const double time) const
+{
+  updateSteps();
+  XdmfGridCollectionStep step;
+  step.mTime = time;
+  return std::lower_bound(mSteps.begin(), mSteps.end(), step, isStepBefore) -
+    mSteps.begin();
+}
+
+unsigned int
+XdmfGridCollection::getNearestStep(const double time) const
+{
+  const unsigned int upper = this->getLowerStep(time);
+  if(upper == 0) {
+    return 0;
+  }
+  if(upper == mSteps.size() ||
+     time - mSteps[upper - 1].mTime <= mSteps[upper].mTime - time) {
+    return this->getLowerStep(mSteps[upper - 1].mTime);
+  }
+  return upper;
+}
+
+unsigned int
+XdmfGridCollection::getGridsVersion() const
+{
+  // Each version only grows, so the sum changes with any of them
+  return mGridCollectionIndex.getVersion() +
+    mCurvilinearGridIndex.getVersion() +
+    mRectilinearGridIndex.getVersion() +
+    mRegularGridIndex.getVersion() +
+    mUnstructuredGridIndex.getVersion();
+}
+
+unsigned int
+XdmfGridCollection::getNumberSteps() const
+{
+  updateSteps();
+  return mSteps.size();
+}
+
+shared_ptr<XdmfGrid>
+XdmfGridCollection::getStep(const unsigned int index)
+{
+  updateSteps();
+  if(index >= mSteps.size()) {
+    return shared_ptr<XdmfGrid>();
+  }
+  XdmfGridCollectionStep & step = mSteps[index];
+  if(!step.mGrid) {
+    shared_ptr<XdmfGrid> grid = shared_dynamic_cast<XdmfGrid>(
+      mDeferredSteps[step.mDeferredIndex]->read());
+    if(!grid) {
+      XdmfError::message(XdmfError::FATAL,
+                         "Error: Deferred step is not a grid in "
+                         "XdmfGridCollection::getStep");
+    }
+    mDeferredSteps[step.mDeferredIndex].reset();
+    mDeferredGrids[step.mDeferredIndex] = grid;
+    this->insertGrid(grid);
+    // The index stays valid with the grid read
+    mIndexedGridsVersion = this->getGridsVersion();
+    addStepIndex(grid->mStepIndices, mStepsCurrent);
+    if(grid->getTime()) {
+      addStepIndex(grid->getTime()->mStepIndices, mStepsCurrent);
+    }
+    step.mGrid = grid;
+  }
+  return step.mGrid;
+}
+
+double
+XdmfGridCollection::getStepTime(const unsigned int index) const
+{
+  updateSteps();
+  if(index >= mSteps.size()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Index out of range in "
+                       "XdmfGridCollection::getStepTime");
+  }
+  return mSteps[index].mTime;
+}
+
 shared_ptr<const XdmfGridCollectionType>
 XdmfGridCollection::getType() const
 {
   return mType;
 }
 
+unsigned int
+XdmfGridCollection::getUpperStep(const double time) const
+{
+  updateSteps();
+  XdmfGridCollectionStep step;
+  step.mTime = time;
+  return std::upper_bound(mSteps.begin(), mSteps.end(), step, isStepBefore) -
+    mSteps.begin();
+}
+
 void
 XdmfGridCollection::insert(const shared_ptr<XdmfInformation> information)
 {
   XdmfItem::insert(information);
 }
 
+void
+XdmfGridCollection::insertGrid(const shared_ptr<XdmfGrid> grid)
+{
+  if(shared_ptr<XdmfGridCollection> gridCollection =
+     shared_dynamic_cast<XdmfGridCollection>(grid)) {
+    this->insert(gridCollection);
+  }
+  else if(shared_ptr<XdmfCurvilinearGrid> curvilinearGrid =
+          shared_dynamic_cast<XdmfCurvilinearGrid>(grid)) {
+    this->insert(curvilinearGrid);
+  }
+  else if(shared_ptr<XdmfRectilinearGrid> rectilinearGrid =
+          shared_dynamic_cast<XdmfRectilinearGrid>(grid)) {
+    this->insert(rectilinearGrid);
+  }
+  else if(shared_ptr<XdmfRegularGrid> regularGrid =
+          shared_dynamic_cast<XdmfRegularGrid>(grid)) {
+    this->insert(regularGrid);
+  }
+  else if(shared_ptr<XdmfUnstructuredGrid> unstructuredGrid =
+          shared_dynamic_cast<XdmfUnstructuredGrid>(grid)) {
+    this->insert(unstructuredGrid);
+  }
+}
+
+bool
+XdmfGridCollection::isStepBefore(const XdmfGridCollectionStep & step1,
+                                 const XdmfGridCollectionStep & step2)
+{
+  return step1.mTime < step2.mTime;
+}
+
 void
 XdmfGridCollection::populateItem(const std::map<std::string, std::string> & itemProperties,
                                  const std::vector<shared_ptr<XdmfItem> > & childItems,
@@ -84,6 +265,73 @@ XdmfGridCollection::populateItem(const std::map<std::string, std::string> & item
   XdmfDomain::populateItem(itemProperties, childItems, reader);
   mInformations.clear();
   XdmfGrid::populateItem(itemProperties, childItems, reader);
+  for(std::vector<shared_ptr<XdmfItem> >::const_iterator iter =
+        childItems.begin();
+      iter != childItems.end();
+      ++iter) {
+    if(shared_ptr<XdmfDeferredItem> deferredStep =
+       shared_dynamic_cast<XdmfDeferredItem>(*iter)) {
+      const std::map<std::string, std::string> timeProperties =
+        deferredStep->getChildProperties(XdmfTime::ItemTag);
+      std::map<std::string, std::string>::const_iterator value =
+        timeProperties.find("Value");
+      mDeferredSteps.push_back(deferredStep);
+      mDeferredGrids.push_back(shared_ptr<XdmfGrid>());
+      mDeferredTimes.push_back(0.0);
+      if(value != timeProperties.end()) {
+        mDeferredTimes.back() = std::atof(value->second.c_str());
+      }
+      else {
+        // Without a single time the step can not be indexed unread
+        mDeferredGrids.back() =
+          shared_dynamic_cast<XdmfGrid>(deferredStep->read());
+        mDeferredSteps.back().reset();
+        this->insertGrid(mDeferredGrids.back());
+      }
+    }
+  }
+  *mStepsCurrent = false;
+}
+
+void
+XdmfGridCollection::readDeferredSteps()
+{
+  if(mDeferredSteps.size() == 0) {
+    return;
+  }
+  // Steps read so far are put back in the order of the file
+  for(unsigned int i = 0; i < mDeferredSteps.size(); ++i) {
+    if(mDeferredSteps[i]) {
+      mDeferredGrids[i] =
+        shared_dynamic_cast<XdmfGrid>(mDeferredSteps[i]->read());
+    }
+    else if(!this->removeGrid(mDeferredGrids[i])) {
+      // Removed from the collection since
+      mDeferredGrids[i].reset();
+    }
+  }
+  for(std::vector<shared_ptr<XdmfGrid> >::const_iterator iter =
+        mDeferredGrids.begin();
+      iter != mDeferredGrids.end();
+      ++iter) {
+    if(*iter) {
+      this->insertGrid(*iter);
+    }
+  }
+  mDeferredSteps.clear();
+  mDeferredGrids.clear();
+  mDeferredTimes.clear();
+  *mStepsCurrent = false;
+}
+
+bool
+XdmfGridCollection::removeGrid(const shared_ptr<XdmfGrid> grid)
+{
+  return eraseGrid(mGridCollections, mGridCollectionIndex, grid.get()) ||
+    eraseGrid(mCurvilinearGrids, mCurvilinearGridIndex, grid.get()) ||
+    eraseGrid(mRectilinearGrids, mRectilinearGridIndex, grid.get()) ||
+    eraseGrid(mRegularGrids, mRegularGridIndex, grid.get()) ||
+    eraseGrid(mUnstructuredGrids, mUnstructuredGridIndex, grid.get());
 }
 
 void
@@ -95,6 +343,8 @@ XdmfGridCollection::setType(const shared_ptr<const XdmfGridCollectionType> type)
 void
 XdmfGridCollection::traverse(const shared_ptr<XdmfBaseVisitor> visitor)
 {
+  this->readDeferredSteps();
+
   XdmfGrid::traverse(visitor);
 
   // Only write XdmfInformations once (deal with diamond inheritance)
@@ -103,3 +353,57 @@ XdmfGridCollection::traverse(const shared_ptr<XdmfBaseVisitor> visitor)
   XdmfDomain::traverse(visitor);
   informations.swap(mInformations);
 }
+
+void
+XdmfGridCollection::updateSteps() const
+{
+  // Grids inserted or removed, or times changed, since the steps
+  // were indexed
+  const unsigned int gridsVersion = this->getGridsVersion();
+  if(*mStepsCurrent && gridsVersion == mIndexedGridsVersion) {
+    return;
+  }
+  mSteps.clear();
+  XdmfGridCollectionStep step;
+  step.mDeferredIndex = std::numeric_limits<unsigned int>::max();
+  std::vector<shared_ptr<XdmfGrid> > grids;
+  for(unsigned int i = 0; i < this->getNumberGridCollections(); ++i) {
+    grids.push_back(mGridCollections[i]);
+  }
+  for(unsigned int i = 0; i < this->getNumberCurvilinearGrids(); ++i) {
+    grids.push_back(mCurvilinearGrids[i]);
+  }
+  for(unsigned int i = 0; i < this->getNumberRectilinearGrids(); ++i) {
+    grids.push_back(mRectilinearGrids[i]);
+  }
+  for(unsigned int i = 0; i < this->getNumberRegularGrids(); ++i) {
+    grids.push_back(mRegularGrids[i]);
+  }
+  for(unsigned int i = 0; i < this->getNumberUnstructuredGrids(); ++i) {
+    grids.push_back(mUnstructuredGrids[i]);
+  }
+  for(std::vector<shared_ptr<XdmfGrid> >::const_iterator iter =
+        grids.begin();
+      iter != grids.end();
+      ++iter) {
+    // Grids without a time are told too, to report a time set later
+    addStepIndex((*iter)->mStepIndices, mStepsCurrent);
+    if(shared_ptr<XdmfTime> time = (*iter)->getTime()) {
+      addStepIndex(time->mStepIndices, mStepsCurrent);
+      step.mTime = time->getValue();
+      step.mGrid = *iter;
+      mSteps.push_back(step);
+    }
+  }
+  step.mGrid = shared_ptr<XdmfGrid>();
+  for(unsigned int i = 0; i < mDeferredSteps.size(); ++i) {
+    if(mDeferredSteps[i]) {
+      step.mTime = mDeferredTimes[i];
+      step.mDeferredIndex = i;
+      mSteps.push_back(step);
+    }
+  }
+  std::stable_sort(mSteps.begin(), mSteps.end(), isStepBefore);
+  mIndexedGridsVersion = gridsVersion;
+  *mStepsCurrent = true;
+}
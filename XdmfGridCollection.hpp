@@ -25,6 +25,7 @@
 #define XDMFGRIDCOLLECTION_HPP_
 
 // Forward Declarations
+class XdmfDeferredItem;
 class XdmfGridCollectionType;
 
 // Includes
@@ -42,6 +43,17 @@ class XdmfGridCollectionType;
  *
  * It is valid to nest collections. A spatial collection inside a
  * temporal collection is commonly used.
+ *
+ * The grids with a time are indexed as steps, sorted by time, to
+ * look them up by time without going through every grid. The index
+ * is sorted again after grids are inserted or removed, or after the
+ * time of a step is replaced or its value set. A reader can
+ * leave steps unread until they are requested, see
+ * XdmfReader::setDeferredSteps(). Such steps only appear among the
+ * grids of the collection once they are read, in the order they were
+ * read, so use getNumberSteps() and getStep() rather than the grid
+ * accessors while steps are deferred. All of them are read when the
+ * collection is traversed, for example when it is written.
  */
 class XDMF_EXPORT XdmfGridCollection : public XdmfDomain,
                                        public XdmfGrid {
@@ -78,6 +90,147 @@ public:
 
   std::string getItemTag() const;
 
+  /**
+   * Get the index of the first step with a time not before a time,
+   * binary searching the steps. With getUpperStep() this gives the
+   * steps in a range of time.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfGridCollection.cpp
+   * @skipline //#initalization
+   * @until //#initalization
+   * @skipline //#getLowerStep
+   * @until //#getLowerStep
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleGridCollection.py
+   * @skipline #//initalization
+   * @until #//initalization
+   * @skipline #//getLowerStep
+   * @until #//getLowerStep
+   *
+   * @param     time    The time to look for.
+   *
+   * @return            The index of the step, getNumberSteps() if every
+   *                    step is before the time.
+   */
+  unsigned int getLowerStep(const double time) const;
+
+  /**
+   * Get the index of the step with the time nearest to a time. Of two
+   * times equally near the earlier one is taken, and of steps sharing
+   * that time the first is returned.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfGridCollection.cpp
+   * @skipline //#initalization
+   * @until //#initalization
+   * @skipline //#getNearestStep
+   * @until //#getNearestStep
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleGridCollection.py
+   * @skipline #//initalization
+   * @until #//initalization
+   * @skipline #//getNearestStep
+   * @until #//getNearestStep
+   *
+   * @param     time    The time to look for.
+   *
+   * @return            The index of the step, getNumberSteps() if the
+   *                    collection has no steps.
+   */
+  unsigned int getNearestStep(const double time) const;
+
+  /**
+   * Get the number of steps, the grids of the collection that have a
+   * time, including the steps that are not read yet.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfGridCollection.cpp
+   * @skipline //#initalization
+   * @until //#initalization
+   * @skipline //#getNumberSteps
+   * @until //#getNumberSteps
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleGridCollection.py
+   * @skipline #//initalization
+   * @until #//initalization
+   * @skipline #//getNumberSteps
+   * @until #//getNumberSteps
+   *
+   * @return    The number of steps.
+   */
+  unsigned int getNumberSteps() const;
+
+  /**
+   * Get a step, reading it if it was deferred. Steps are sorted by
+   * time, steps with the same time keep the order of their grids.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfGridCollection.cpp
+   * @skipline //#initalization
+   * @until //#initalization
+   * @skipline //#getStep
+   * @until //#getStep
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleGridCollection.py
+   * @skipline #//initalization
+   * @until #//initalization
+   * @skipline #//getStep
+   * @until #//getStep
+   *
+   * @param     index   The index of the step.
+   *
+   * @return            The grid of the step, NULL if out of range.
+   */
+  shared_ptr<XdmfGrid> getStep(const unsigned int index);
+
+  /**
+   * Get the time of a step without reading it.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfGridCollection.cpp
+   * @skipline //#initalization
+   * @until //#initalization
+   * @skipline //#getStepTime
+   * @until //#getStepTime
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleGridCollection.py
+   * @skipline #//initalization
+   * @until #//initalization
+   * @skipline #//getStepTime
+   * @until #//getStepTime
+   *
+   * @param     index   The index of the step.
+   *
+   * @return            The time of the step.
+   */
+  double getStepTime(const unsigned int index) const;
+
   /**
    * Get the XdmfGridCollectionType associated with this grid collection.
    *
@@ -103,6 +256,36 @@ public:
    */
   shared_ptr<const XdmfGridCollectionType> getType() const;
 
+  /**
+   * Get the index of the first step with a time after a time, binary
+   * searching the steps. The step before it, if any, and the one at
+   * getLowerStep() bracket the time.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfGridCollection.cpp
+   * @skipline //#initalization
+   * @until //#initalization
+   * @skipline //#getUpperStep
+   * @until //#getUpperStep
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleGridCollection.py
+   * @skipline #//initalization
+   * @until #//initalization
+   * @skipline #//getUpperStep
+   * @until #//getUpperStep
+   *
+   * @param     time    The time to look for.
+   *
+   * @return            The index of the step, getNumberSteps() if no
+   *                    step is after the time.
+   */
+  unsigned int getUpperStep(const double time) const;
+
   using XdmfDomain::insert;
   using XdmfGrid::insert;
 
@@ -173,6 +356,35 @@ private:
   XdmfGridCollection(const XdmfGridCollection &);  // Not implemented.
   void operator=(const XdmfGridCollection &);  // Not implemented.
 
+  struct XdmfGridCollectionStep {
+    double mTime;
+    shared_ptr<XdmfGrid> mGrid;            // NULL until read
+    unsigned int mDeferredIndex;           // Into mDeferredSteps
+  };
+
+  static bool
+  isStepBefore(const XdmfGridCollectionStep & step1,
+               const XdmfGridCollectionStep & step2);
+
+  unsigned int getGridsVersion() const;
+
+  void insertGrid(const shared_ptr<XdmfGrid> grid);
+
+  void readDeferredSteps();
+
+  bool removeGrid(const shared_ptr<XdmfGrid> grid);
+
+  void updateSteps() const;
+
+  // Steps not read yet in the order of the file, NULL once read
+  std::vector<shared_ptr<XdmfDeferredItem> > mDeferredSteps;
+  std::vector<shared_ptr<XdmfGrid> > mDeferredGrids;
+  std::vector<double> mDeferredTimes;
+  // Version of the grids the steps were indexed from
+  mutable unsigned int mIndexedGridsVersion;
+  mutable std::vector<XdmfGridCollectionStep> mSteps;
+  // Set out of date by the steps when a time changes
+  shared_ptr<bool> mStepsCurrent;
   shared_ptr<const XdmfGridCollectionType> mType;
 };
 
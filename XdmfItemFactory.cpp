@@ -43,40 +43,29 @@
 #include "XdmfTopology.hpp"
 #include "XdmfUnstructuredGrid.hpp"
 
-shared_ptr<XdmfItemFactory>
-XdmfItemFactory::New()
-{
-  shared_ptr<XdmfItemFactory> p(new XdmfItemFactory());
-  return p;
-}
-
-XdmfItemFactory::XdmfItemFactory()
-{
-}
-
-XdmfItemFactory::~XdmfItemFactory()
-{
-}
-
-shared_ptr<XdmfItem>
-XdmfItemFactory::createItem(const std::string & itemTag,
-                            const std::map<std::string, std::string> & itemProperties,
-                            const std::vector<shared_ptr<XdmfItem> > & childItems) const
-{
-  shared_ptr<XdmfItem> newItem =
-    XdmfCoreItemFactory::createItem(itemTag, itemProperties, childItems);
-  
-  if(newItem) {
-    return newItem;
-  }
+namespace {
 
-  if(itemTag.compare(XdmfAttribute::ItemTag) == 0) {
+  shared_ptr<XdmfItem>
+  createAttribute(const XdmfCoreItemFactory &,
+                  const std::map<std::string, std::string> &,
+                  const std::vector<shared_ptr<XdmfItem> > &)
+  {
     return XdmfAttribute::New();
   }
-  else if(itemTag.compare(XdmfDomain::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createDomain(const XdmfCoreItemFactory &,
+               const std::map<std::string, std::string> &,
+               const std::vector<shared_ptr<XdmfItem> > &)
+  {
     return XdmfDomain::New();
   }
-  else if(itemTag.compare(XdmfGeometry::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createGeometry(const XdmfCoreItemFactory &,
+                 const std::map<std::string, std::string> & itemProperties,
+                 const std::vector<shared_ptr<XdmfItem> > & childItems)
+  {
     std::map<std::string, std::string>::const_iterator type =
       itemProperties.find("Type");
     if(type == itemProperties.end()) {
@@ -128,10 +117,20 @@ XdmfItemFactory::createItem(const std::string & itemTag,
     }
     return XdmfGeometry::New();
   }
-  else if(itemTag.compare(XdmfGraph::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createGraph(const XdmfCoreItemFactory &,
+              const std::map<std::string, std::string> &,
+              const std::vector<shared_ptr<XdmfItem> > &)
+  {
     return XdmfGraph::New(0);
   }
-  else if(itemTag.compare(XdmfGrid::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createGrid(const XdmfCoreItemFactory &,
+             const std::map<std::string, std::string> & itemProperties,
+             const std::vector<shared_ptr<XdmfItem> > & childItems)
+  {
     // For backwards compatibility with the old format, this tag can
     // correspond to multiple XdmfItems.
     std::map<std::string, std::string>::const_iterator gridType =
@@ -163,29 +162,61 @@ XdmfItemFactory::createItem(const std::string & itemTag,
       return XdmfUnstructuredGrid::New();
     }
   }
-  else if(itemTag.compare(XdmfInformation::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createInformation(const XdmfCoreItemFactory &,
+                    const std::map<std::string, std::string> &,
+                    const std::vector<shared_ptr<XdmfItem> > &)
+  {
     return XdmfInformation::New();
   }
-  else if(itemTag.compare(XdmfMap::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createMap(const XdmfCoreItemFactory &,
+            const std::map<std::string, std::string> &,
+            const std::vector<shared_ptr<XdmfItem> > &)
+  {
     return XdmfMap::New();
   }
-  else if(itemTag.compare(XdmfSet::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createSet(const XdmfCoreItemFactory &,
+            const std::map<std::string, std::string> &,
+            const std::vector<shared_ptr<XdmfItem> > &)
+  {
     return XdmfSet::New();
   }
-  else if(itemTag.compare(XdmfSparseMatrix::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createSparseMatrix(const XdmfCoreItemFactory &,
+                     const std::map<std::string, std::string> &,
+                     const std::vector<shared_ptr<XdmfItem> > &)
+  {
     return XdmfSparseMatrix::New(0, 0);
   }
-  else if(itemTag.compare(XdmfTime::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createTime(const XdmfCoreItemFactory &,
+             const std::map<std::string, std::string> &,
+             const std::vector<shared_ptr<XdmfItem> > &)
+  {
     return XdmfTime::New();
   }
-  else if(itemTag.compare(XdmfTopology::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createTopology(const XdmfCoreItemFactory &,
+                 const std::map<std::string, std::string> & itemProperties,
+                 const std::vector<shared_ptr<XdmfItem> > &)
+  {
     std::map<std::string, std::string>::const_iterator type =
       itemProperties.find("Type");
     if(type == itemProperties.end()) {
       type = itemProperties.find("TopologyType");
     }
 
-    if(type != itemProperties.end()) {
+    // Only the types of structured grids start with their dimension
+    if(type != itemProperties.end() &&
+       (type->second[0] == '2' || type->second[0] == '3')) {
       std::string typeVal = type->second;
       std::transform(typeVal.begin(),
                      typeVal.end(),
@@ -227,5 +258,31 @@ XdmfItemFactory::createItem(const std::string & itemTag,
     }
     return XdmfTopology::New();
   }
-  return shared_ptr<XdmfItem>();
+
+}
+
+shared_ptr<XdmfItemFactory>
+XdmfItemFactory::New()
+{
+  shared_ptr<XdmfItemFactory> p(new XdmfItemFactory());
+  return p;
+}
+
+XdmfItemFactory::XdmfItemFactory()
+{
+  this->registerItem(XdmfAttribute::ItemTag, createAttribute);
+  this->registerItem(XdmfDomain::ItemTag, createDomain);
+  this->registerItem(XdmfGeometry::ItemTag, createGeometry);
+  this->registerItem(XdmfGraph::ItemTag, createGraph);
+  this->registerItem(XdmfGrid::ItemTag, createGrid);
+  this->registerItem(XdmfInformation::ItemTag, createInformation);
+  this->registerItem(XdmfMap::ItemTag, createMap);
+  this->registerItem(XdmfSet::ItemTag, createSet);
+  this->registerItem(XdmfSparseMatrix::ItemTag, createSparseMatrix);
+  this->registerItem(XdmfTime::ItemTag, createTime);
+  this->registerItem(XdmfTopology::ItemTag, createTopology);
+}
+
+XdmfItemFactory::~XdmfItemFactory()
+{
 }
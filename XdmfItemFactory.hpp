@@ -62,11 +62,6 @@ public:
 
   virtual ~XdmfItemFactory();
 
-  virtual shared_ptr<XdmfItem>
-  createItem(const std::string & itemTag,
-             const std::map<std::string, std::string> & itemProperties,
-             const std::vector<shared_ptr<XdmfItem> > & childItems) const;
-
 protected:
 
   XdmfItemFactory();
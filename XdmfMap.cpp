@@ -352,6 +352,7 @@ XdmfMap::setMap(std::map<task_id, node_id_map> map)
 void
 XdmfMap::setName(const std::string & name)
 {
+  XdmfItemNameIndex::nameChanged(this, mName, name);
   mName = name;
 }
 
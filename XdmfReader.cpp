@@ -21,6 +21,7 @@
 /*                                                                           */
 /*****************************************************************************/
 
+#include "XdmfGridCollection.hpp"
 #include "XdmfItemFactory.hpp"
 #include "XdmfReader.hpp"
 #include "XdmfError.hpp"
@@ -33,7 +34,8 @@ XdmfReader::New()
 }
 
 XdmfReader::XdmfReader() :
-  XdmfCoreReader(XdmfItemFactory::New())
+  XdmfCoreReader(XdmfItemFactory::New()),
+  mDeferredSteps(false)
 {
 }
 
@@ -41,6 +43,32 @@ XdmfReader::~XdmfReader()
 {
 }
 
+bool
+XdmfReader::getDeferredSteps() const
+{
+  return mDeferredSteps;
+}
+
+bool
+XdmfReader::isDeferred(const std::string & tag,
+                       const std::string & parentTag,
+                       const std::map<std::string, std::string> & parentProperties) const
+{
+  if(!mDeferredSteps ||
+     tag.compare(XdmfGridCollection::ItemTag) != 0 ||
+     parentTag.compare(XdmfGridCollection::ItemTag) != 0) {
+    return false;
+  }
+  std::map<std::string, std::string>::const_iterator gridType =
+    parentProperties.find("GridType");
+  std::map<std::string, std::string>::const_iterator collectionType =
+    parentProperties.find("CollectionType");
+  return gridType != parentProperties.end() &&
+    gridType->second.compare("Collection") == 0 &&
+    collectionType != parentProperties.end() &&
+    collectionType->second.compare("Temporal") == 0;
+}
+
 // Implemented to make SWIG wrapping work correctly
 // (typemaps to return specific subclass instances of XdmfItems)
 shared_ptr<XdmfItem>
@@ -55,3 +83,9 @@ XdmfReader::read(const std::string & filePath,
 {
   return XdmfCoreReader::read(filePath, xPath);
 }
+
+void
+XdmfReader::setDeferredSteps(const bool deferredSteps)
+{
+  mDeferredSteps = deferredSteps;
+}
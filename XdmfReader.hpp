@@ -35,6 +35,9 @@
  * memory. All light data is parsed in order to create appropriate
  * Xdmf objects. Heavy data controllers are created and attached to
  * XdmfArrays but no heavy data is read into memory.
+ *
+ * The steps of temporal collections can be left unread until they are
+ * used, see setDeferredSteps().
  */
 class XDMF_EXPORT XdmfReader : public XdmfCoreReader {
 
@@ -63,20 +66,95 @@ public:
 
   virtual ~XdmfReader();
 
+  /**
+   * Get whether the steps of temporal collections are read only when
+   * they are used.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfReader.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#setDeferredSteps
+   * @until //#setDeferredSteps
+   * @skipline //#getDeferredSteps
+   * @until //#getDeferredSteps
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleReader.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//setDeferredSteps
+   * @until #//setDeferredSteps
+   * @skipline #//getDeferredSteps
+   * @until #//getDeferredSteps
+   *
+   * @return    Whether reading the steps is deferred.
+   */
+  bool getDeferredSteps() const;
+
   shared_ptr<XdmfItem> read(const std::string & filePath) const;
 
   std::vector<shared_ptr<XdmfItem> >
   read(const std::string & filePath,
        const std::string & xPath) const;
 
+  /**
+   * Set whether the steps of temporal collections are read only when
+   * they are used. The XML is still parsed when the file is read, but
+   * the grids of the steps are built one at a time when they are
+   * requested from the collection, see XdmfGridCollection::getStep().
+   * A step is indexed by the Value of its Time, steps with another
+   * type of time are read right away.
+   *
+   * While steps are deferred only the step API of the collection,
+   * getNumberSteps(), getStep() and getStepTime(), sees all of them.
+   * The grid accessors inherited from XdmfDomain, such as
+   * getNumberUnstructuredGrids() and getUnstructuredGrid(), only
+   * return the steps read so far, in the order they were read rather
+   * than in the order of the file. Traversing the collection, for
+   * example when writing it, reads the remaining steps first.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfReader.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#setDeferredSteps
+   * @until //#setDeferredSteps
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleReader.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//setDeferredSteps
+   * @until #//setDeferredSteps
+   *
+   * @param     deferredSteps   Whether to defer reading the steps.
+   */
+  void setDeferredSteps(const bool deferredSteps);
+
 protected:
 
   XdmfReader();
 
+  bool
+  isDeferred(const std::string & tag,
+             const std::string & parentTag,
+             const std::map<std::string, std::string> & parentProperties) const;
+
 private:
 
   XdmfReader(const XdmfReader &);  // Not implemented.
   void operator=(const XdmfReader &);  // Not implemented.
+
+  bool mDeferredSteps;
 };
 
 #endif /* XDMFREADER_HPP_ */
@@ -115,6 +115,7 @@ XdmfSet::populateItem(const std::map<std::string, std::string> & itemProperties,
 void
 XdmfSet::setName(const std::string & name)
 {
+  XdmfItemNameIndex::nameChanged(this, mName, name);
   mName = name;
 }
 
@@ -88,4 +88,13 @@ void
 XdmfTime::setValue(const double & value)
 {
   mValue = value;
+  for(std::vector<boost::weak_ptr<bool> >::const_iterator iter =
+        mStepIndices.begin();
+      iter != mStepIndices.end();
+      ++iter) {
+    if(shared_ptr<bool> stepsCurrent = iter->lock()) {
+      *stepsCurrent = false;
+    }
+  }
+  mStepIndices.clear();
 }
@@ -25,6 +25,7 @@
 #define XDMFTIME_HPP_
 
 // Includes
+#include <boost/weak_ptr.hpp>
 #include "Xdmf.hpp"
 #include "XdmfItem.hpp"
 
@@ -132,6 +133,11 @@ private:
   XdmfTime(const XdmfTime &);  // Not implemented.
   void operator=(const XdmfTime &);  // Not implemented.
 
+  friend class XdmfGridCollection;
+
+  // Step indices of the collections the time is in, set out of date
+  // when the value changes
+  std::vector<boost::weak_ptr<bool> > mStepIndices;
   double mValue;
 };
 
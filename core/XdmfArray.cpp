@@ -22,12 +22,16 @@
 /*****************************************************************************/
 
 #include <boost/tokenizer.hpp>
+#include <algorithm>
+#include <cstring>
 #include <limits>
+#include <numeric>
 #include <sstream>
 #include <utility>
 #include <stack>
 #include <math.h>
 #include "XdmfArray.hpp"
+#include "XdmfArrayAllocator.hpp"
 #include "XdmfArrayType.hpp"
 #include "XdmfArrayReference.hpp"
 #include "XdmfBinaryController.hpp"
@@ -575,6 +579,27 @@ private:
   const XdmfArray * const mArray; 
 };
 
+struct XdmfArray::AllocatorDeleter
+{
+  AllocatorDeleter(const shared_ptr<XdmfArrayAllocator> & allocator,
+                   const std::size_t size) :
+    mAllocator(allocator),
+    mSize(size)
+  {
+  }
+
+  void
+  operator()(void const * pointer) const
+  {
+    mAllocator->deallocate(const_cast<void *>(pointer), mSize);
+  }
+
+  shared_ptr<XdmfArrayAllocator> mAllocator;
+  std::size_t mSize;
+};
+
+shared_ptr<XdmfArrayAllocator> XdmfArray::mDefaultAllocator;
+
 shared_ptr<XdmfArray>
 XdmfArray::New()
 {
@@ -613,6 +638,12 @@ XdmfArray::erase(const unsigned int index)
   mDimensions.clear();
 }
 
+shared_ptr<XdmfArrayAllocator>
+XdmfArray::getAllocator() const
+{
+  return mAllocator;
+}
+
 shared_ptr<const XdmfArrayType>
 XdmfArray::getArrayType() const
 {
@@ -633,6 +664,12 @@ XdmfArray::getCapacity() const
                               mArray);
 }
 
+shared_ptr<XdmfArrayAllocator>
+XdmfArray::getDefaultAllocator()
+{
+  return mDefaultAllocator;
+}
+
 std::vector<unsigned int>
 XdmfArray::getDimensions() const
 {
@@ -773,36 +810,65 @@ XdmfArray::getHeavyDataController() const
   }
 }
 
+template <typename T>
+void
+XdmfArray::initializeStorage(const unsigned int size,
+                             const shared_ptr<XdmfArrayAllocator> & allocator)
+{
+  if(!allocator) {
+    this->initialize<T>(size);
+    return;
+  }
+  // The block is held as an array pointer, so it is copied to a
+  // vector by the first operation that modifies the array
+  const std::size_t numBytes = static_cast<std::size_t>(size) * sizeof(T);
+  T * const values = static_cast<T *>(allocator->allocate(numBytes));
+  std::memset(values, 0, numBytes);
+  const boost::shared_array<const T> newArrayPointer(values,
+                                                     AllocatorDeleter(allocator,
+                                                                      numBytes));
+  mArray = newArrayPointer;
+  mArrayPointerNumValues = size;
+}
+
 void
 XdmfArray::initialize(const shared_ptr<const XdmfArrayType> & arrayType,
                       const unsigned int size)
 {
+  // Values come from the allocator when one is set, unless a reserve
+  // is pending which needs a vector that can grow
+  shared_ptr<XdmfArrayAllocator> allocator =
+    mAllocator ? mAllocator : mDefaultAllocator;
+  if(mTmpReserveSize > 0) {
+    allocator = shared_ptr<XdmfArrayAllocator>();
+  }
+
   if(arrayType == XdmfArrayType::Int8()) {
-    this->initialize<char>(size);
+    this->initializeStorage<char>(size, allocator);
   }
   else if(arrayType == XdmfArrayType::Int16()) {
-    this->initialize<short>(size);
+    this->initializeStorage<short>(size, allocator);
   }
   else if(arrayType == XdmfArrayType::Int32()) {
-    this->initialize<int>(size);
+    this->initializeStorage<int>(size, allocator);
   }
   else if(arrayType == XdmfArrayType::Int64()) {
-    this->initialize<long>(size);
+    this->initializeStorage<long>(size, allocator);
   }
   else if(arrayType == XdmfArrayType::Float32()) {
-    this->initialize<float>(size);
+    this->initializeStorage<float>(size, allocator);
   }
   else if(arrayType == XdmfArrayType::Float64()) {
-    this->initialize<double>(size);
+    this->initializeStorage<double>(size, allocator);
   }
   else if(arrayType == XdmfArrayType::UInt8()) {
-    this->initialize<unsigned char>(size);
+    this->initializeStorage<unsigned char>(size, allocator);
   }
   else if(arrayType == XdmfArrayType::UInt16()) {
-    this->initialize<unsigned short>(size);
+    this->initializeStorage<unsigned short>(size, allocator);
   }
   else if(arrayType == XdmfArrayType::UInt32()) {
-    this->initialize<unsigned int>(size);
+    this->initializeStorage<unsigned int>(size, allocator);
   }
   else if(arrayType == XdmfArrayType::String()) {
     this->initialize<std::string>(size);
@@ -1053,6 +1119,73 @@ XdmfArray::populateItem(const std::map<std::string, std::string> & itemPropertie
       this->setReadMode(XdmfArray::Reference);
       filled = true;
     }
+    else if (itemType->second.compare("HyperSlab") == 0) {
+      // The first child holds the start, stride and count of each
+      // dimension, the second the hdf5 data set they select from
+      std::vector<shared_ptr<XdmfArray> > arrays;
+      for(std::vector<shared_ptr<XdmfItem> >::const_iterator iter =
+            childItems.begin();
+          iter != childItems.end();
+          ++iter) {
+        if(shared_ptr<XdmfArray> array = shared_dynamic_cast<XdmfArray>(*iter)) {
+          arrays.push_back(array);
+        }
+      }
+      shared_ptr<XdmfHDF5Controller> source;
+      if(arrays.size() == 2 && arrays[1]->getNumberHeavyDataControllers() == 1) {
+        source =
+          shared_dynamic_cast<XdmfHDF5Controller>(arrays[1]->getHeavyDataController(0));
+      }
+      if(!source) {
+        XdmfError::message(XdmfError::FATAL,
+                           "HyperSlab does not select from an hdf5 data set "
+                           "in XdmfArray::populateItem");
+      }
+      const shared_ptr<XdmfArray> selection = arrays[0];
+      if(!selection->isInitialized()) {
+        selection->read();
+      }
+      const unsigned int rank = source->getDimensions().size();
+      if(selection->getSize() != 3 * rank) {
+        XdmfError::message(XdmfError::FATAL,
+                           "HyperSlab selection does not match the rank of "
+                           "its data set in XdmfArray::populateItem");
+      }
+      std::vector<unsigned int> start(rank);
+      std::vector<unsigned int> stride(rank);
+      std::vector<unsigned int> count(rank);
+      for(unsigned int i = 0; i < rank; ++i) {
+        start[i] = selection->getValue<unsigned int>(i);
+        stride[i] = selection->getValue<unsigned int>(rank + i);
+        count[i] = selection->getValue<unsigned int>(2 * rank + i);
+      }
+
+      std::map<std::string, std::string>::const_iterator dimensions =
+        itemProperties.find("Dimensions");
+      if(dimensions == itemProperties.end()) {
+        XdmfError::message(XdmfError::FATAL,
+                           "'Dimensions' not found in itemProperties in "
+                           "XdmfArray::populateItem");
+      }
+      boost::tokenizer<> tokens(dimensions->second);
+      for(boost::tokenizer<>::const_iterator iter = tokens.begin();
+          iter != tokens.end();
+          ++iter) {
+        mDimensions.push_back(atoi((*iter).c_str()));
+      }
+
+      // A run of values in a one dimensional data set keeps the
+      // dimensions of the array, as XdmfHDF5Writer packs them
+      mHeavyDataControllers.push_back(
+        XdmfHDF5Controller::New(source->getFilePath(),
+                                source->getDataSetPath(),
+                                XdmfArrayType::New(itemProperties),
+                                start,
+                                stride,
+                                rank == 1 ? mDimensions : count,
+                                source->getDimensions()));
+      filled = true;
+    }
   }
 
   if (!filled) {
@@ -1268,14 +1401,107 @@ XdmfArray::read()
   }
 }
 
+void
+XdmfArray::read(const shared_ptr<const XdmfArrayType> & readType)
+{
+  switch (mReadMode)
+  {
+    case XdmfArray::Controller:
+      this->readController(readType);
+      break;
+    case XdmfArray::Reference:
+      this->readReference();
+      if(readType && this->getArrayType() != readType) {
+        // References produce a new array, so convert it afterwards
+        shared_ptr<XdmfArray> source = XdmfArray::New();
+        std::swap(mArray, source->mArray);
+        std::swap(mArrayPointerNumValues, source->mArrayPointerNumValues);
+        const std::vector<unsigned int> dimensions = mDimensions;
+        this->initialize(readType, dimensions);
+        this->insert(0, source, 0, source->getSize(), 1, 1);
+      }
+      break;
+    default:
+      XdmfError::message(XdmfError::FATAL,
+                         "Error: Invalid Read Mode");
+  }
+}
+
+void
+XdmfArray::read(const unsigned int start,
+                const unsigned int stride,
+                const unsigned int count)
+{
+  if(stride == 0) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Stride of zero in XdmfArray::read");
+  }
+
+  if(mReadMode == XdmfArray::Reference) {
+    // References produce the whole array, take the window afterwards
+    this->readReference();
+    shared_ptr<XdmfArray> source = XdmfArray::New();
+    std::swap(mArray, source->mArray);
+    std::swap(mArrayPointerNumValues, source->mArrayPointerNumValues);
+    this->initialize(source->getArrayType(),
+                     std::vector<unsigned int>(1, count));
+    this->insert(0, source, start, count, 1, stride);
+    return;
+  }
+
+  this->release();
+  if(count == 0) {
+    mDimensions = std::vector<unsigned int>(1, 0);
+    return;
+  }
+
+  if(mHeavyDataControllers.size() == 1 &&
+     mHeavyDataControllers[0]->getArrayOffset() == 0) {
+    mHeavyDataControllers[0]->read(this, start, stride, count);
+  }
+  else {
+    const unsigned int windowEnd = start + (count - 1) * stride;
+    for (unsigned int i = 0; i < mHeavyDataControllers.size(); ++i) {
+      // Values [offset, offset + size) of the array are held by this
+      // controller, find the window indices that fall in that range
+      const unsigned int offset = mHeavyDataControllers[i]->getArrayOffset();
+      const unsigned int size = mHeavyDataControllers[i]->getSize();
+      if(size == 0 || offset > windowEnd || offset + size <= start) {
+        continue;
+      }
+      const unsigned int first =
+        offset > start ? (offset - start + stride - 1) / stride : 0;
+      const unsigned int last =
+        std::min(count - 1, (offset + size - 1 - start) / stride);
+      if(first > last) {
+        continue;
+      }
+      shared_ptr<XdmfArray> tempArray = XdmfArray::New();
+      mHeavyDataControllers[i]->read(tempArray.get(),
+                                     start + first * stride - offset,
+                                     stride,
+                                     last - first + 1);
+      this->insert(first, tempArray, 0, last - first + 1, 1, 1);
+    }
+  }
+  mDimensions = std::vector<unsigned int>(1, count);
+}
+
 void
 XdmfArray::readController()
 {
+  this->readController(shared_ptr<const XdmfArrayType>());
+}
+
+void
+XdmfArray::readController(const shared_ptr<const XdmfArrayType> & readType)
+{
+  // A null readType reads values in the type stored by the controllers
   if(mHeavyDataControllers.size() > 1) {
     this->release();
     for (unsigned int i = 0; i < mHeavyDataControllers.size(); ++i) {
       shared_ptr<XdmfArray> tempArray = XdmfArray::New();
-      mHeavyDataControllers[i]->read(tempArray.get());
+      mHeavyDataControllers[i]->read(tempArray.get(), readType);
       unsigned int dimTotal = 1;
       for (unsigned int j = 0; j < mHeavyDataControllers[i]->getDimensions().size(); ++j) {
         dimTotal *= mHeavyDataControllers[i]->getDimensions()[j];
@@ -1309,18 +1535,59 @@ XdmfArray::readController()
   }
   else if (mHeavyDataControllers.size() == 1 && mHeavyDataControllers[0]->getArrayOffset() == 0) {
     this->release();
-    mHeavyDataControllers[0]->read(this);
+    mHeavyDataControllers[0]->read(this, readType);
     mDimensions = mHeavyDataControllers[0]->getDimensions();
   }
   else if (mHeavyDataControllers.size() == 1 && mHeavyDataControllers[0]->getArrayOffset() > 0) {
     this->release();
     shared_ptr<XdmfArray> tempArray = XdmfArray::New();
-    mHeavyDataControllers[0]->read(tempArray.get());
+    mHeavyDataControllers[0]->read(tempArray.get(), readType);
     this->insert(mHeavyDataControllers[0]->getArrayOffset(), tempArray, 0, mHeavyDataControllers[0]->getSize(), 1, 1);
     mDimensions = mHeavyDataControllers[0]->getDimensions();
   }
 }
 
+void
+XdmfArray::readInto(void * const valuesPointer,
+                    const unsigned int numValues)
+{
+  if(mReadMode != XdmfArray::Controller) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Reading into memory requires Controller "
+                       "read mode in XdmfArray::read");
+  }
+
+  unsigned int totalValues = 0;
+  for (unsigned int i = 0; i < mHeavyDataControllers.size(); ++i) {
+    totalValues =
+      std::max(totalValues,
+               mHeavyDataControllers[i]->getArrayOffset() +
+               mHeavyDataControllers[i]->getSize());
+  }
+  if(numValues != totalValues) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Number of values in memory does not match "
+                       "size of heavy data in XdmfArray::read");
+  }
+
+  const shared_ptr<const XdmfArrayType> valuesType = this->getArrayType();
+  char * const values = static_cast<char *>(valuesPointer);
+  for (unsigned int i = 0; i < mHeavyDataControllers.size(); ++i) {
+    mHeavyDataControllers[i]->read(values +
+                                   mHeavyDataControllers[i]->getArrayOffset() *
+                                   valuesType->getElementSize(),
+                                   valuesType,
+                                   mHeavyDataControllers[i]->getSize());
+  }
+
+  if(mHeavyDataControllers.size() == 1) {
+    mDimensions = mHeavyDataControllers[0]->getDimensions();
+  }
+  else {
+    mDimensions = std::vector<unsigned int>(1, numValues);
+  }
+}
+
 void
 XdmfArray::readReference()
 {
@@ -1344,6 +1611,18 @@ XdmfArray::reserve(const unsigned int size)
                        mArray);
 }
 
+void
+XdmfArray::setAllocator(const shared_ptr<XdmfArrayAllocator> allocator)
+{
+  mAllocator = allocator;
+}
+
+void
+XdmfArray::setDefaultAllocator(const shared_ptr<XdmfArrayAllocator> allocator)
+{
+  mDefaultAllocator = allocator;
+}
+
 void
 XdmfArray::setHeavyDataController(shared_ptr<XdmfHeavyDataController> newController)
 {
@@ -1357,6 +1636,7 @@ XdmfArray::setHeavyDataController(shared_ptr<XdmfHeavyDataController> newControl
 void
 XdmfArray::setName(const std::string & name)
 {
+  XdmfItemNameIndex::nameChanged(this, mName, name);
   mName = name;
 }
 
@@ -25,6 +25,7 @@
 #define XDMFARRAY_HPP_
 
 // Forward Declarations
+class XdmfArrayAllocator;
 class XdmfArrayType;
 class XdmfHeavyDataController;
 
@@ -182,6 +183,26 @@ public:
    */
   void erase(const unsigned int index);
 
+  /**
+   * Get the allocator set on this array with setAllocator. Arrays
+   * without their own allocator use the default allocator.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initializationpool
+   * @until //#initializationpool
+   * @skipline //#setAllocator
+   * @until //#setAllocator
+   *
+   * Python: does not support allocators
+   *
+   * @return    The allocator of this array, may be null.
+   */
+  shared_ptr<XdmfArrayAllocator> getAllocator() const;
+
   /**
    * Get the data type of this array.
    *
@@ -233,6 +254,26 @@ public:
    */
   unsigned int getCapacity() const;
 
+  /**
+   * Get the allocator used by arrays that do not have their own.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initializationpool
+   * @until //#initializationpool
+   * @skipline //#setDefaultAllocator
+   * @until //#setDefaultAllocator
+   *
+   * Python: does not support allocators
+   *
+   * @return    The default allocator, null when values are stored in
+   *            std::vectors.
+   */
+  static shared_ptr<XdmfArrayAllocator> getDefaultAllocator();
+
   /**
    * Get the dimensions of the array.
    * If the array isn't initialized the dimensions
@@ -626,6 +667,13 @@ public:
   /**
    * Initialize the array to contain a specified amount of a particular type.
    *
+   * If the array has an allocator (see setAllocator and
+   * setDefaultAllocator) the zeroed values are placed in a block from
+   * that allocator and are not copied until the array is resized or
+   * modified through the XdmfArray API, at which point they move to
+   * internal storage and the block is released. Arrays of strings and
+   * arrays with a pending reserve always use internal storage.
+   *
    * Example of use:
    *
    * C++
@@ -988,6 +1036,98 @@ public:
    */
   void read();
 
+  /**
+   * Read data from disk into memory, storing the values as readType
+   * instead of the type they are stored as on disk. Heavy data
+   * controllers that support it convert the values while reading so
+   * the unconverted values are never held in memory.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArray.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#readconvert
+   * @until //#readconvert
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleArray.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//readconvert
+   * @until #//readconvert
+   *
+   * @param     readType        The array type to store the values as.
+   */
+  void read(const shared_ptr<const XdmfArrayType> & readType);
+
+  /**
+   * Read a window of the data from disk into memory. The window is
+   * taken over the values of the array in row major order and covers
+   * indices start, start + stride, ... start + (count - 1) * stride.
+   * The window is split across the attached heavy data controllers by
+   * their array offsets and each controller reads only its selected
+   * values. After reading, the array is one dimensional and holds
+   * count values.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArray.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#readwindow
+   * @until //#readwindow
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleArray.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//readwindow
+   * @until #//readwindow
+   *
+   * @param     start   The index of the first value to read.
+   * @param     stride  The distance between values to read.
+   * @param     count   The number of values to read.
+   */
+  void read(const unsigned int start,
+            const unsigned int stride,
+            const unsigned int count);
+
+  /**
+   * Read data from the attached heavy data controllers directly into
+   * memory supplied by the caller. The array wraps the memory without
+   * copying it, in the same way as setValuesInternal with
+   * transferOwnership set to false, so the memory must outlive the
+   * array's use of it. Values are converted to T while reading when
+   * it differs from the type on disk. numValues must equal the number
+   * of values held by the controllers. Only valid in Controller read
+   * mode.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArray.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#readbuffer
+   * @until //#readbuffer
+   *
+   * Python: does not support reading into a pointer
+   *
+   * @param     valuesPointer   A pointer to the memory to read into.
+   * @param     numValues       The number of values the memory holds.
+   */
+  template <typename T>
+  void read(T * const valuesPointer,
+            const unsigned int numValues);
+
   /**
    * Reads data from the attached controllers to the internal data storage.
    *
@@ -1019,6 +1159,40 @@ public:
    */
   void readController();
 
+  /**
+   * Reads data from the attached controllers to the internal data
+   * storage, storing the values as readType.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArray.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#getHeavyDataController
+   * @until //#getHeavyDataController
+   * @skipline //#setHeavyDataController
+   * @until //#setHeavyDataController
+   * @skipline //#readControllerconvert
+   * @until //#readControllerconvert
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleArray.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//getHeavyDataController
+   * @until #//getHeavyDataController
+   * @skipline #//setHeavyDataController
+   * @until #//setHeavyDataController
+   * @skipline #//readControllerconvert
+   * @until #//readControllerconvert
+   *
+   * @param     readType        The array type to store the values as.
+   */
+  void readController(const shared_ptr<const XdmfArrayType> & readType);
+
   /**
    * Reads the data pointed to by the array reference into the array.
    *
@@ -1169,6 +1343,60 @@ public:
   void resize(const std::vector<unsigned int> & dimensions,
               const T & value = 0);
 
+  /**
+   * Set the allocator that supplies memory for the values of this
+   * array, overriding the default allocator. Passing a null allocator
+   * returns the array to the default allocator. Values already in the
+   * array are not moved.
+   *
+   * The allocator only supplies the storage created by
+   * initialize(arrayType, ...), which is how heavy data controllers
+   * fill arrays when reading. It is meant for arrays that are read
+   * and then accessed, not modified: the templated initialize, insert,
+   * pushBack, resize and reserve keep values in a std::vector, and the
+   * first of them applied to an array holding a block copies the
+   * values out and returns the block to the allocator.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initializationpool
+   * @until //#initializationpool
+   * @skipline //#setAllocator
+   * @until //#setAllocator
+   *
+   * Python: does not support allocators
+   *
+   * @param     allocator       The allocator to use for this array.
+   */
+  void setAllocator(const shared_ptr<XdmfArrayAllocator> allocator);
+
+  /**
+   * Set the allocator used by arrays that do not have their own,
+   * including arrays created internally when reading heavy data.
+   * Passing a null allocator stores values in std::vectors, which is
+   * the default. As with setAllocator, only values placed by
+   * initialize(arrayType, ...) come from the allocator.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initializationpool
+   * @until //#initializationpool
+   * @skipline //#setDefaultAllocator
+   * @until //#setDefaultAllocator
+   *
+   * Python: does not support allocators
+   *
+   * @param     allocator       The allocator to use by default.
+   */
+  static void
+  setDefaultAllocator(const shared_ptr<XdmfArrayAllocator> allocator);
+
   /**
    * Sets the array reference from which the Array will fill when readReference is called.
    *
@@ -1438,6 +1666,7 @@ private:
   void operator=(const XdmfArray &);  // Not implemented.
 
   // Variant Visitor Operations
+  struct AllocatorDeleter;
   class Clear;
   class Erase;
   class GetArrayType;
@@ -1466,6 +1695,21 @@ private:
    */
   void internalizeArrayPointer();
 
+  /**
+   * Place size zeroed values of type T in a block from allocator, or
+   * in an internal vector when allocator is null.
+   */
+  template <typename T>
+  void initializeStorage(const unsigned int size,
+                         const shared_ptr<XdmfArrayAllocator> & allocator);
+
+  /**
+   * Fill memory already wrapped by setValuesInternal from the heavy
+   * data controllers.
+   */
+  void readInto(void * const valuesPointer,
+                const unsigned int numValues);
+
   typedef boost::variant<
     boost::blank,
     shared_ptr<std::vector<char> >,
@@ -1495,6 +1739,9 @@ private:
   unsigned int mTmpReserveSize;
   ReadMode mReadMode;
   shared_ptr<XdmfArrayReference> mReference;
+  shared_ptr<XdmfArrayAllocator> mAllocator;
+
+  static shared_ptr<XdmfArrayAllocator> mDefaultAllocator;
 
 };
 
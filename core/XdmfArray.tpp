@@ -710,6 +710,17 @@ XdmfArray::pushBack(const T & value)
                               mArray);
 }
 
+template <typename T>
+void
+XdmfArray::read(T * const valuesPointer,
+                const unsigned int numValues)
+{
+  // Wrap the memory first so that its type can be found by visiting
+  // the array, the values are then filled in by the controllers.
+  this->setValuesInternal(valuesPointer, numValues, false);
+  this->readInto(valuesPointer, numValues);
+}
+
 template<typename T>
 void
 XdmfArray::resize(const unsigned int numValues,
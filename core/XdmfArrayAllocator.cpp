@@ -0,0 +1,132 @@
+/*****************************************************************************/
+/*                                    XDMF                                   */
+/*                       eXtensible Data Model and Format                    */
+/*                                                                           */
+/*  Id : XdmfArrayAllocator.cpp                                              */
+/*                                                                           */
+/*     This software is distributed WITHOUT ANY WARRANTY; without            */
+/*     even the implied warranty of MERCHANTABILITY or FITNESS               */
+/*     FOR A PARTICULAR PURPOSE.  See Copyright.txt for details.             */
+/*                                                                           */
+/*****************************************************************************/
+
+#include <cstdlib>
+#ifdef _WIN32
+  #include <malloc.h>
+#endif
+#include "XdmfArrayAllocator.hpp"
+#include "XdmfError.hpp"
+
+const std::size_t XdmfArrayAllocator::DefaultAlignment;
+
+shared_ptr<XdmfArrayAllocator>
+XdmfArrayAllocator::New(const std::size_t alignment)
+{
+  shared_ptr<XdmfArrayAllocator> p(new XdmfArrayAllocator(alignment));
+  return p;
+}
+
+XdmfArrayAllocator::XdmfArrayAllocator(const std::size_t alignment) :
+  mAlignment(alignment),
+  mBytesLive(0),
+  mPeakBytes(0)
+{
+  if(alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Alignment must be a power of two no smaller than a "
+                       "pointer in XdmfArrayAllocator");
+  }
+}
+
+XdmfArrayAllocator::~XdmfArrayAllocator()
+{
+}
+
+void *
+XdmfArrayAllocator::allocate(const std::size_t size)
+{
+  void * const pointer = this->allocateBytes(size);
+  mBytesLive += size;
+  if(mBytesLive > mPeakBytes) {
+    mPeakBytes = mBytesLive;
+  }
+  return pointer;
+}
+
+void *
+XdmfArrayAllocator::allocateAligned(const std::size_t size) const
+{
+  // Zero byte requests still return a unique block
+  const std::size_t blockSize = size > 0 ? size : 1;
+  void * pointer = NULL;
+#ifdef _WIN32
+  pointer = _aligned_malloc(blockSize, mAlignment);
+#else
+  if(posix_memalign(&pointer, mAlignment, blockSize) != 0) {
+    pointer = NULL;
+  }
+#endif
+  if(pointer == NULL) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Unable to allocate memory in XdmfArrayAllocator");
+  }
+  return pointer;
+}
+
+void *
+XdmfArrayAllocator::allocateBytes(const std::size_t size)
+{
+  return this->allocateAligned(size);
+}
+
+void
+XdmfArrayAllocator::deallocate(void * const pointer,
+                               const std::size_t size)
+{
+  if(pointer == NULL) {
+    return;
+  }
+  this->deallocateBytes(pointer, size);
+  mBytesLive -= size;
+}
+
+void
+XdmfArrayAllocator::deallocateAligned(void * const pointer) const
+{
+#ifdef _WIN32
+  _aligned_free(pointer);
+#else
+  free(pointer);
+#endif
+}
+
+void
+XdmfArrayAllocator::deallocateBytes(void * const pointer,
+                                    const std::size_t)
+{
+  this->deallocateAligned(pointer);
+}
+
+std::size_t
+XdmfArrayAllocator::getAlignment() const
+{
+  return mAlignment;
+}
+
+std::size_t
+XdmfArrayAllocator::getBytesLive() const
+{
+  return mBytesLive;
+}
+
+std::size_t
+XdmfArrayAllocator::getPeakBytes() const
+{
+  return mPeakBytes;
+}
+
+void
+XdmfArrayAllocator::resetPeakBytes()
+{
+  mPeakBytes = mBytesLive;
+}
@@ -0,0 +1,205 @@
+/*****************************************************************************/
+/*                                    XDMF                                   */
+/*                       eXtensible Data Model and Format                    */
+/*                                                                           */
+/*  Id : XdmfArrayAllocator.hpp                                              */
+/*                                                                           */
+/*     This software is distributed WITHOUT ANY WARRANTY; without            */
+/*     even the implied warranty of MERCHANTABILITY or FITNESS               */
+/*     FOR A PARTICULAR PURPOSE.  See Copyright.txt for details.             */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef XDMFARRAYALLOCATOR_HPP_
+#define XDMFARRAYALLOCATOR_HPP_
+
+// Includes
+#include <cstddef>
+#include "XdmfCore.hpp"
+#include "XdmfSharedPtr.hpp"
+
+/**
+ * @brief Supplies aligned memory for the values stored in XdmfArrays.
+ *
+ * An allocator can be attached to a single XdmfArray with
+ * XdmfArray::setAllocator or to every XdmfArray with
+ * XdmfArray::setDefaultAllocator. Arrays that have an allocator take
+ * the memory for XdmfArray::initialize from it, which includes the
+ * arrays filled by heavy data controllers when reading. Every block
+ * is aligned to at least getAlignment() bytes.
+ *
+ * Allocators serve read-only storage only. Modifying an array through
+ * insert, pushBack, resize or reserve moves its values to a std::vector
+ * and returns the block, so arrays that are built up or changed after
+ * reading do not use the allocator.
+ *
+ * The allocator keeps count of the bytes handed out to arrays that
+ * are still alive and of the largest that count has been. Subclasses
+ * change where memory comes from by overriding allocateBytes and
+ * deallocateBytes, the counters are kept by the base class.
+ *
+ * Allocators are not thread safe.
+ */
+class XDMFCORE_EXPORT XdmfArrayAllocator {
+
+public:
+
+  /**
+   * Create a new XdmfArrayAllocator that allocates aligned memory
+   * directly from the system.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   *
+   * Python: does not support allocators
+   *
+   * @param     alignment       The alignment of blocks in bytes, must be
+   *                            a power of two.
+   *
+   * @return    Constructed XdmfArrayAllocator.
+   */
+  static shared_ptr<XdmfArrayAllocator>
+  New(const std::size_t alignment = DefaultAlignment);
+
+  virtual ~XdmfArrayAllocator();
+
+  /**
+   * Alignment in bytes used when none is given, suitable for 512 bit
+   * vector loads and a cache line on common hardware.
+   */
+  static const std::size_t DefaultAlignment = 64;
+
+  /**
+   * Allocate a block of memory of at least size bytes.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#allocate
+   * @until //#allocate
+   *
+   * Python: does not support allocators
+   *
+   * @param     size    The number of bytes to allocate.
+   *
+   * @return    A pointer to the aligned block.
+   */
+  void * allocate(const std::size_t size);
+
+  /**
+   * Return a block obtained from allocate to the allocator.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#allocate
+   * @until //#allocate
+   *
+   * Python: does not support allocators
+   *
+   * @param     pointer The block to release.
+   * @param     size    The size the block was allocated with.
+   */
+  void deallocate(void * const pointer,
+                  const std::size_t size);
+
+  /**
+   * Get the alignment in bytes of blocks returned by this allocator.
+   *
+   * @return    The alignment in bytes.
+   */
+  std::size_t getAlignment() const;
+
+  /**
+   * Get the number of bytes currently allocated and not yet released.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#getBytesLive
+   * @until //#getBytesLive
+   *
+   * Python: does not support allocators
+   *
+   * @return    The number of live bytes.
+   */
+  std::size_t getBytesLive() const;
+
+  /**
+   * Get the largest number of bytes that have been live at once since
+   * the allocator was created or resetPeakBytes was last called.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#getBytesLive
+   * @until //#getBytesLive
+   *
+   * Python: does not support allocators
+   *
+   * @return    The peak number of live bytes.
+   */
+  std::size_t getPeakBytes() const;
+
+  /**
+   * Set the peak byte count to the number of bytes currently live.
+   */
+  void resetPeakBytes();
+
+protected:
+
+  XdmfArrayAllocator(const std::size_t alignment);
+
+  /**
+   * Obtain an aligned block of at least size bytes.
+   */
+  virtual void * allocateBytes(const std::size_t size);
+
+  /**
+   * Release a block obtained from allocateBytes.
+   */
+  virtual void deallocateBytes(void * const pointer,
+                               const std::size_t size);
+
+  /**
+   * Allocate aligned memory from the system.
+   */
+  void * allocateAligned(const std::size_t size) const;
+
+  /**
+   * Release memory obtained from allocateAligned.
+   */
+  void deallocateAligned(void * const pointer) const;
+
+private:
+
+  XdmfArrayAllocator(const XdmfArrayAllocator &);  // Not implemented.
+  void operator=(const XdmfArrayAllocator &);  // Not implemented.
+
+  const std::size_t mAlignment;
+  std::size_t mBytesLive;
+  std::size_t mPeakBytes;
+};
+
+#endif /* XDMFARRAYALLOCATOR_HPP_ */
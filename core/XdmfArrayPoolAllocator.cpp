@@ -0,0 +1,116 @@
+/*****************************************************************************/
+/*                                    XDMF                                   */
+/*                       eXtensible Data Model and Format                    */
+/*                                                                           */
+/*  Id : XdmfArrayPoolAllocator.cpp                                          */
+/*                                                                           */
+/*     This software is distributed WITHOUT ANY WARRANTY; without            */
+/*     even the implied warranty of MERCHANTABILITY or FITNESS               */
+/*     FOR A PARTICULAR PURPOSE.  See Copyright.txt for details.             */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "XdmfArrayPoolAllocator.hpp"
+
+const std::size_t XdmfArrayPoolAllocator::DefaultMaxCachedBytes;
+
+shared_ptr<XdmfArrayPoolAllocator>
+XdmfArrayPoolAllocator::New(const std::size_t maxCachedBytes,
+                            const std::size_t alignment)
+{
+  shared_ptr<XdmfArrayPoolAllocator>
+    p(new XdmfArrayPoolAllocator(maxCachedBytes, alignment));
+  return p;
+}
+
+XdmfArrayPoolAllocator::XdmfArrayPoolAllocator(const std::size_t maxCachedBytes,
+                                               const std::size_t alignment) :
+  XdmfArrayAllocator(alignment),
+  mBytesCached(0),
+  mMaxCachedBytes(maxCachedBytes)
+{
+}
+
+XdmfArrayPoolAllocator::~XdmfArrayPoolAllocator()
+{
+  this->release();
+}
+
+void *
+XdmfArrayPoolAllocator::allocateBytes(const std::size_t size)
+{
+  const std::size_t blockSize = this->getBlockSize(size);
+  std::map<std::size_t, std::vector<void *> >::iterator iter =
+    mCachedBlocks.find(blockSize);
+  if(iter != mCachedBlocks.end() && !iter->second.empty()) {
+    void * const pointer = iter->second.back();
+    iter->second.pop_back();
+    mBytesCached -= blockSize;
+    return pointer;
+  }
+  return this->allocateAligned(blockSize);
+}
+
+void
+XdmfArrayPoolAllocator::deallocateBytes(void * const pointer,
+                                        const std::size_t size)
+{
+  const std::size_t blockSize = this->getBlockSize(size);
+  if(mBytesCached + blockSize > mMaxCachedBytes) {
+    this->deallocateAligned(pointer);
+    return;
+  }
+  mCachedBlocks[blockSize].push_back(pointer);
+  mBytesCached += blockSize;
+}
+
+std::size_t
+XdmfArrayPoolAllocator::getBlockSize(const std::size_t size) const
+{
+  const std::size_t alignment = this->getAlignment();
+  if(size == 0) {
+    return alignment;
+  }
+  return ((size + alignment - 1) / alignment) * alignment;
+}
+
+std::size_t
+XdmfArrayPoolAllocator::getBytesCached() const
+{
+  return mBytesCached;
+}
+
+std::size_t
+XdmfArrayPoolAllocator::getMaxCachedBytes() const
+{
+  return mMaxCachedBytes;
+}
+
+void
+XdmfArrayPoolAllocator::release()
+{
+  this->trimCache(0);
+}
+
+void
+XdmfArrayPoolAllocator::setMaxCachedBytes(const std::size_t maxCachedBytes)
+{
+  mMaxCachedBytes = maxCachedBytes;
+  this->trimCache(maxCachedBytes);
+}
+
+void
+XdmfArrayPoolAllocator::trimCache(const std::size_t maxCachedBytes)
+{
+  // Free the largest blocks first
+  std::map<std::size_t, std::vector<void *> >::reverse_iterator iter =
+    mCachedBlocks.rbegin();
+  while(mBytesCached > maxCachedBytes && iter != mCachedBlocks.rend()) {
+    while(mBytesCached > maxCachedBytes && !iter->second.empty()) {
+      this->deallocateAligned(iter->second.back());
+      iter->second.pop_back();
+      mBytesCached -= iter->first;
+    }
+    ++iter;
+  }
+}
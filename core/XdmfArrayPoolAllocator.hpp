@@ -0,0 +1,143 @@
+/*****************************************************************************/
+/*                                    XDMF                                   */
+/*                       eXtensible Data Model and Format                    */
+/*                                                                           */
+/*  Id : XdmfArrayPoolAllocator.hpp                                          */
+/*                                                                           */
+/*     This software is distributed WITHOUT ANY WARRANTY; without            */
+/*     even the implied warranty of MERCHANTABILITY or FITNESS               */
+/*     FOR A PARTICULAR PURPOSE.  See Copyright.txt for details.             */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef XDMFARRAYPOOLALLOCATOR_HPP_
+#define XDMFARRAYPOOLALLOCATOR_HPP_
+
+// Includes
+#include <map>
+#include <vector>
+#include "XdmfCore.hpp"
+#include "XdmfArrayAllocator.hpp"
+
+/**
+ * @brief Array allocator that keeps released blocks for reuse.
+ *
+ * Blocks returned by arrays are cached by size instead of being given
+ * back to the system, so repeatedly initializing and releasing arrays
+ * of the same sizes (for instance the arrays of every grid written in
+ * a checkpoint) stops going through the system allocator. Sizes are
+ * rounded up to a multiple of the alignment. The cache is bounded by
+ * setMaxCachedBytes, blocks that do not fit are freed immediately.
+ */
+class XDMFCORE_EXPORT XdmfArrayPoolAllocator : public XdmfArrayAllocator {
+
+public:
+
+  /**
+   * Create a new XdmfArrayPoolAllocator.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initializationpool
+   * @until //#initializationpool
+   *
+   * Python: does not support allocators
+   *
+   * @param     maxCachedBytes  The largest number of released bytes to
+   *                            keep for reuse.
+   * @param     alignment       The alignment of blocks in bytes, must be
+   *                            a power of two.
+   *
+   * @return    Constructed XdmfArrayPoolAllocator.
+   */
+  static shared_ptr<XdmfArrayPoolAllocator>
+  New(const std::size_t maxCachedBytes = DefaultMaxCachedBytes,
+      const std::size_t alignment = DefaultAlignment);
+
+  virtual ~XdmfArrayPoolAllocator();
+
+  /**
+   * Limit on cached bytes used when none is given.
+   */
+  static const std::size_t DefaultMaxCachedBytes = 268435456;
+
+  /**
+   * Get the number of released bytes held for reuse.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initializationpool
+   * @until //#initializationpool
+   * @skipline //#getBytesCached
+   * @until //#getBytesCached
+   *
+   * Python: does not support allocators
+   *
+   * @return    The number of cached bytes.
+   */
+  std::size_t getBytesCached() const;
+
+  /**
+   * Get the largest number of released bytes held for reuse.
+   *
+   * @return    The limit on cached bytes.
+   */
+  std::size_t getMaxCachedBytes() const;
+
+  /**
+   * Give every cached block back to the system.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfArrayAllocator.cpp
+   * @skipline //#initializationpool
+   * @until //#initializationpool
+   * @skipline //#getBytesCached
+   * @until //#getBytesCached
+   *
+   * Python: does not support allocators
+   */
+  void release();
+
+  /**
+   * Set the largest number of released bytes held for reuse. Cached
+   * blocks over the new limit are freed.
+   *
+   * @param     maxCachedBytes  The limit on cached bytes.
+   */
+  void setMaxCachedBytes(const std::size_t maxCachedBytes);
+
+protected:
+
+  XdmfArrayPoolAllocator(const std::size_t maxCachedBytes,
+                         const std::size_t alignment);
+
+  virtual void * allocateBytes(const std::size_t size);
+
+  virtual void deallocateBytes(void * const pointer,
+                               const std::size_t size);
+
+private:
+
+  XdmfArrayPoolAllocator(const XdmfArrayPoolAllocator &);  // Not implemented.
+  void operator=(const XdmfArrayPoolAllocator &);  // Not implemented.
+
+  std::size_t getBlockSize(const std::size_t size) const;
+
+  void trimCache(const std::size_t maxCachedBytes);
+
+  // Released blocks keyed by block size
+  std::map<std::size_t, std::vector<void *> > mCachedBlocks;
+  std::size_t mBytesCached;
+  std::size_t mMaxCachedBytes;
+};
+
+#endif /* XDMFARRAYPOOLALLOCATOR_HPP_ */
@@ -21,6 +21,8 @@
 /*                                                                           */
 /*****************************************************************************/
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include "XdmfArray.hpp"
@@ -69,6 +71,33 @@ namespace {
     one_byte = data[3]; data[3] = data[4]; data[4] = one_byte;
   }
 
+  // Number of bytes read from file at once when converting types
+  const unsigned int convertBlockBytes = 1048576;
+
+  void
+  swapBytes(void * data,
+            const unsigned int numValues,
+            const unsigned int elementSize)
+  {
+    switch(elementSize){
+    case 1:
+      break;
+    case 2:
+      ByteSwaper<2>::swap(data, numValues);
+      break;
+    case 4:
+      ByteSwaper<4>::swap(data, numValues);
+      break;
+    case 8:
+      ByteSwaper<8>::swap(data, numValues);
+      break;
+    default:
+      XdmfError::message(XdmfError::FATAL,
+                         "Cannot perform endianness swap for datatype");
+      break;
+    }
+  }
+
 }
 
 shared_ptr<XdmfBinaryController>
@@ -174,26 +203,217 @@ XdmfBinaryController::read(XdmfArray * const array)
 #endif // XDMF_BIG_ENDIAN
   
   if(needByteSwap) {
-    switch(mType->getElementSize()){
-    case 1:
-      break;
-    case 2:
-      ByteSwaper<2>::swap(array->getValuesInternal(),
-                          array->getSize());
-        break;
-    case 4:
-      ByteSwaper<4>::swap(array->getValuesInternal(),
-                          array->getSize());
-      break;
-    case 8:
-      ByteSwaper<8>::swap(array->getValuesInternal(),
-                          array->getSize());
-      break;
-    default:
-      XdmfError::message(XdmfError::FATAL,
-                         "Cannot perform endianness swap for datatype");
-      break;
+    swapBytes(array->getValuesInternal(),
+              array->getSize(),
+              mType->getElementSize());
+  }
+
+}
+
+void
+XdmfBinaryController::read(XdmfArray * const array,
+                           const shared_ptr<const XdmfArrayType> & readType)
+{
+  if(!readType || readType == mType) {
+    this->read(array);
+    return;
+  }
+
+  array->initialize(readType, mDimensions);
+
+  std::ifstream fileStream(mFilePath.c_str(),
+                           std::ifstream::binary);
+
+  if(!fileStream.good()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error reading " + mFilePath +
+                       " in XdmfBinaryController::read");
+  }
+
+  fileStream.seekg(mSeek);
+
+  if(!fileStream.good()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error seeking " + mFilePath +
+                       " in XdmfBinaryController::read");
+  }
+
+#if defined(XDMF_BIG_ENDIAN)
+  const bool needByteSwap = mEndian == LITTLE;
+#else
+  const bool needByteSwap = mEndian == BIG;
+#endif // XDMF_BIG_ENDIAN
+
+  const unsigned int elementSize = mType->getElementSize();
+  if(elementSize == 0) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Cannot convert binary data of variable size type "
+                       "in XdmfBinaryController::read");
+  }
+  const unsigned int totalValues = array->getSize();
+  unsigned int blockValues = convertBlockBytes / elementSize;
+  if(blockValues > totalValues) {
+    blockValues = totalValues;
+  }
+
+  // Values are read in their stored type one block at a time and
+  // converted into the array by insert
+  shared_ptr<XdmfArray> block = XdmfArray::New();
+  block->initialize(mType, blockValues);
+
+  for(unsigned int offset = 0; offset < totalValues; offset += blockValues) {
+    const unsigned int numValues = std::min(blockValues,
+                                            totalValues - offset);
+    fileStream.read(static_cast<char *>(block->getValuesInternal()),
+                    numValues * elementSize);
+    if(needByteSwap) {
+      swapBytes(block->getValuesInternal(),
+                numValues,
+                elementSize);
     }
+    array->insert(offset, block, 0, numValues, 1, 1);
+  }
+}
+
+void
+XdmfBinaryController::read(XdmfArray * const array,
+                           const unsigned int start,
+                           const unsigned int stride,
+                           const unsigned int count)
+{
+  if(stride == 0 ||
+     (count > 0 && start + (count - 1) * stride >= this->getSize())) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Window out of range of binary data in "
+                       "XdmfBinaryController::read");
   }
 
+  const unsigned int elementSize = mType->getElementSize();
+  if(elementSize == 0) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Cannot read window of variable size type "
+                       "in XdmfBinaryController::read");
+  }
+
+  array->initialize(mType, std::vector<unsigned int>(1, count));
+  if(count == 0) {
+    return;
+  }
+
+  std::ifstream fileStream(mFilePath.c_str(),
+                           std::ifstream::binary);
+
+  if(!fileStream.good()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error reading " + mFilePath +
+                       " in XdmfBinaryController::read");
+  }
+
+  char * values = static_cast<char *>(array->getValuesInternal());
+  const std::streamoff windowStart =
+    mSeek + static_cast<std::streamoff>(start) * elementSize;
+
+  if(stride == 1) {
+    fileStream.seekg(windowStart);
+    fileStream.read(values, static_cast<std::streamsize>(count) * elementSize);
+  }
+  else {
+    // Read the bytes spanned by up to a block of values at once and
+    // pick out the selected values. Values further apart than a
+    // block are read with one seek each.
+    const std::streamoff strideBytes =
+      static_cast<std::streamoff>(stride) * elementSize;
+    unsigned int blockValues = convertBlockBytes / strideBytes;
+    if(blockValues == 0) {
+      blockValues = 1;
+    }
+    if(blockValues > count) {
+      blockValues = count;
+    }
+    std::vector<char> buffer((blockValues - 1) * strideBytes + elementSize);
+    for(unsigned int i = 0; i < count; i += blockValues) {
+      const unsigned int numValues = std::min(blockValues, count - i);
+      fileStream.seekg(windowStart + i * strideBytes);
+      fileStream.read(&buffer[0], (numValues - 1) * strideBytes + elementSize);
+      for(unsigned int j = 0; j < numValues; ++j) {
+        std::memcpy(values + (i + j) * elementSize,
+                    &buffer[j * strideBytes],
+                    elementSize);
+      }
+    }
+  }
+
+  if(!fileStream.good()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error reading " + mFilePath +
+                       " in XdmfBinaryController::read");
+  }
+
+#if defined(XDMF_BIG_ENDIAN)
+  const bool needByteSwap = mEndian == LITTLE;
+#else
+  const bool needByteSwap = mEndian == BIG;
+#endif // XDMF_BIG_ENDIAN
+
+  if(needByteSwap) {
+    swapBytes(values,
+              count,
+              elementSize);
+  }
+}
+
+void
+XdmfBinaryController::read(void * const valuesPointer,
+                           const shared_ptr<const XdmfArrayType> & valuesType,
+                           const unsigned int numValues)
+{
+  if(valuesType != mType) {
+    // Conversion goes through an XdmfArray
+    XdmfHeavyDataController::read(valuesPointer, valuesType, numValues);
+    return;
+  }
+
+  if(numValues != this->getSize()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Number of values in memory does not match size of "
+                       "binary data in XdmfBinaryController::read");
+  }
+
+  const unsigned int elementSize = mType->getElementSize();
+  if(elementSize == 0) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Cannot read variable size type into memory in "
+                       "XdmfBinaryController::read");
+  }
+
+  std::ifstream fileStream(mFilePath.c_str(),
+                           std::ifstream::binary);
+
+  if(!fileStream.good()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error reading " + mFilePath +
+                       " in XdmfBinaryController::read");
+  }
+
+  fileStream.seekg(mSeek);
+  fileStream.read(static_cast<char *>(valuesPointer),
+                  static_cast<std::streamsize>(numValues) * elementSize);
+
+  if(!fileStream.good()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error reading " + mFilePath +
+                       " in XdmfBinaryController::read");
+  }
+
+#if defined(XDMF_BIG_ENDIAN)
+  const bool needByteSwap = mEndian == LITTLE;
+#else
+  const bool needByteSwap = mEndian == BIG;
+#endif // XDMF_BIG_ENDIAN
+
+  if(needByteSwap) {
+    swapBytes(valuesPointer,
+              numValues,
+              elementSize);
+  }
 }
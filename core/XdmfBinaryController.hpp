@@ -81,6 +81,45 @@ public:
 
   virtual void read(XdmfArray * const array);
 
+  /**
+   * Read the binary data into the passed XdmfArray as readType. The
+   * file is read in fixed size blocks that are converted into the
+   * array as they arrive, so only the converted values are held in
+   * full.
+   *
+   * @param array the XdmfArray to read data into.
+   * @param readType the array type to store the values as.
+   */
+  virtual void read(XdmfArray * const array,
+                    const shared_ptr<const XdmfArrayType> & readType);
+
+  /**
+   * Read a window of the binary data into the passed XdmfArray.
+   * Only the bytes spanned by the window are read from the file.
+   *
+   * @param array the XdmfArray to read data into.
+   * @param start the index of the first value to read.
+   * @param stride the distance between values to read.
+   * @param count the number of values to read.
+   */
+  virtual void read(XdmfArray * const array,
+                    const unsigned int start,
+                    const unsigned int stride,
+                    const unsigned int count);
+
+  /**
+   * Read the binary data into memory supplied by the caller. When
+   * valuesType matches the type on disk the file is read straight
+   * into the buffer.
+   *
+   * @param valuesPointer a pointer to the memory to read into.
+   * @param valuesType the array type of the values in memory.
+   * @param numValues the number of values the memory holds.
+   */
+  virtual void read(void * const valuesPointer,
+                    const shared_ptr<const XdmfArrayType> & valuesType,
+                    const unsigned int numValues);
+
 protected:
 
   XdmfBinaryController(const std::string & filePath,
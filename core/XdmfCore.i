@@ -510,6 +510,9 @@ swig -v -c++ -python -o XdmfCorePython.cpp XdmfCore.i
 %template() Loki::Visitor<XdmfArray>;
 %template() Loki::Visitor<XdmfItem>;
 
+// Internal to the children of XdmfItems
+%ignore XdmfItemNameIndex;
+
 %include XdmfCore.hpp
 %include XdmfError.hpp
 %include XdmfItem.hpp
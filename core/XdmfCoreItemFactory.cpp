@@ -29,28 +29,23 @@
 #include "XdmfInformation.hpp"
 #include "XdmfSparseMatrix.hpp"
 #include <boost/tokenizer.hpp>
+#include <boost/unordered_map.hpp>
 
-XdmfCoreItemFactory::XdmfCoreItemFactory()
-{
-}
-
-XdmfCoreItemFactory::~XdmfCoreItemFactory()
-{
-}
+namespace {
 
-shared_ptr<XdmfItem>
-XdmfCoreItemFactory::createItem(const std::string & itemTag,
-                                const std::map<std::string, std::string> & itemProperties,
-                                const std::vector<shared_ptr<XdmfItem> > & childItems) const
-{
-  if(itemTag.compare(XdmfArray::ItemTag) == 0) {
-    return XdmfArray::New();
-  }
-  else if(itemTag.compare("DataStructure") == 0) {
-    // to support old xdmf DataStructure tag
+  shared_ptr<XdmfItem>
+  createArray(const XdmfCoreItemFactory &,
+              const std::map<std::string, std::string> &,
+              const std::vector<shared_ptr<XdmfItem> > &)
+  {
     return XdmfArray::New();
   }
-  else if (itemTag.compare(XdmfFunction::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createFunction(const XdmfCoreItemFactory & factory,
+                 const std::map<std::string, std::string> & itemProperties,
+                 const std::vector<shared_ptr<XdmfItem> > & childItems)
+  {
     std::map<std::string, std::string>::const_iterator type =
       itemProperties.find("ConstructedType");
     std::string arraySubType;
@@ -123,10 +118,8 @@ XdmfCoreItemFactory::createItem(const std::string & itemTag,
       // This should generate an item that corresponds to the tag provided
       // the casting ensures that it is a subtype of array
       // Using a factory to be able to build things outside of core
-      returnArray = shared_dynamic_cast<XdmfArray>(createItem(
-                                                     arraySubType,
-                                                     itemProperties,
-                                                     newArrayChildren));
+      returnArray = shared_dynamic_cast<XdmfArray>(
+        factory.createItem(arraySubType, itemProperties, newArrayChildren));
 
       returnArray->insert(0, parsedArray, 0, parsedArray->getSize());
       returnArray->setReference(XdmfFunction::New(expressionToParse,
@@ -141,7 +134,12 @@ XdmfCoreItemFactory::createItem(const std::string & itemTag,
       return parsedArray;
     }
   }
-  else if(itemTag.compare(XdmfSubset::ItemTag) == 0) {
+
+  shared_ptr<XdmfItem>
+  createSubset(const XdmfCoreItemFactory & factory,
+               const std::map<std::string, std::string> & itemProperties,
+               const std::vector<shared_ptr<XdmfItem> > & childItems)
+  {
     std::map<std::string, std::string>::const_iterator type =
       itemProperties.find("ConstructedType");
     std::string arraySubType;
@@ -156,10 +154,8 @@ XdmfCoreItemFactory::createItem(const std::string & itemTag,
     std::vector<shared_ptr<XdmfItem> > newArrayChildren;
     shared_ptr<XdmfArray> returnArray = shared_ptr<XdmfArray>();
 
-    returnArray = shared_dynamic_cast<XdmfArray>(createItem(
-                                                   arraySubType,
-                                                   itemProperties,
-                                                   newArrayChildren));
+    returnArray = shared_dynamic_cast<XdmfArray>(
+      factory.createItem(arraySubType, itemProperties, newArrayChildren));
 
     std::vector<unsigned int> startVector;
     std::vector<unsigned int> strideVector;
@@ -222,7 +218,49 @@ XdmfCoreItemFactory::createItem(const std::string & itemTag,
     returnArray->setReadMode(XdmfArray::Reference);
 
     return returnArray;
+  }
+
+}
+
+class XdmfCoreItemFactory::XdmfCoreItemFactoryImpl {
 
+public:
+
+  boost::unordered_map<std::string, ItemCreator> mCreators;
+
+};
+
+XdmfCoreItemFactory::XdmfCoreItemFactory() :
+  mImpl(new XdmfCoreItemFactoryImpl())
+{
+  this->registerItem(XdmfArray::ItemTag, createArray);
+  // to support old xdmf DataStructure tag
+  this->registerItem("DataStructure", createArray);
+  this->registerItem(XdmfFunction::ItemTag, createFunction);
+  this->registerItem(XdmfSubset::ItemTag, createSubset);
+}
+
+XdmfCoreItemFactory::~XdmfCoreItemFactory()
+{
+  delete mImpl;
+}
+
+shared_ptr<XdmfItem>
+XdmfCoreItemFactory::createItem(const std::string & itemTag,
+                                const std::map<std::string, std::string> & itemProperties,
+                                const std::vector<shared_ptr<XdmfItem> > & childItems) const
+{
+  boost::unordered_map<std::string, ItemCreator>::const_iterator creator =
+    mImpl->mCreators.find(itemTag);
+  if(creator != mImpl->mCreators.end()) {
+    return creator->second(*this, itemProperties, childItems);
   }
   return shared_ptr<XdmfItem>();
 }
+
+void
+XdmfCoreItemFactory::registerItem(const std::string & itemTag,
+                                  ItemCreator creator)
+{
+  mImpl->mCreators[itemTag] = creator;
+}
@@ -37,12 +37,24 @@ class XdmfItem;
 /**
  * @brief Factory that constructs XdmfItems using tags and properties.
  *
- * XdmfCoreItemFactory is an abstract base class.
+ * XdmfCoreItemFactory is an abstract base class. Factories register a
+ * function constructing the XdmfItems of each tag they support, and
+ * createItem finds the function for a tag in a hash table.
  */
 class XDMFCORE_EXPORT XdmfCoreItemFactory {
 
 public:
 
+  /**
+   * Function constructing an XdmfItem of a registered tag. It is
+   * passed the factory creating the item and the arguments of
+   * createItem, and returns NULL if it can not construct the item.
+   */
+  typedef shared_ptr<XdmfItem>
+  (*ItemCreator)(const XdmfCoreItemFactory & factory,
+                 const std::map<std::string, std::string> & itemProperties,
+                 const std::vector<shared_ptr<XdmfItem> > & childItems);
+
   virtual ~XdmfCoreItemFactory() = 0;
 
   /**
@@ -76,11 +88,27 @@ protected:
 
   XdmfCoreItemFactory();
 
+  /**
+   * Register the function constructing the XdmfItems of a tag,
+   * replacing any function registered for the tag before.
+   *
+   * @param     itemTag         The tag of the XdmfItems.
+   * @param     creator         The function constructing them.
+   */
+  void registerItem(const std::string & itemTag, ItemCreator creator);
+
 private:
 
+  /**
+   * PIMPL
+   */
+  class XdmfCoreItemFactoryImpl;
+
   XdmfCoreItemFactory(const XdmfCoreItemFactory &);  // Not implemented.
   void operator=(const XdmfCoreItemFactory &);  // Not implemented.
 
+  XdmfCoreItemFactoryImpl * const mImpl;
+
 };
 
 #endif /* XDMFCOREITEMFACTORY_HPP_ */
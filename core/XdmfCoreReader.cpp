@@ -26,7 +26,11 @@
 #include <libxml/xmlreader.h>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/tokenizer.hpp>
+#include <boost/weak_ptr.hpp>
+#include <sys/stat.h>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <map>
 #include <sstream>
 #include <utility>
@@ -35,12 +39,161 @@
 #include "XdmfHDF5Controller.hpp"
 #include "XdmfCoreItemFactory.hpp"
 #include "XdmfCoreReader.hpp"
+#include "XdmfDeferredItem.hpp"
 #include "XdmfError.hpp"
 #include "XdmfFunction.hpp"
 #include "XdmfSubset.hpp"
 #include "XdmfItem.hpp"
 #include "XdmfSystemUtils.hpp"
 
+namespace {
+
+  // Light data cache layout, all integers are native 32 bit unsigned:
+  //   magic, byte order mark
+  //   number of documents, per document its path, modification time
+  //     in nanoseconds, size and hash of its first and last bytes
+  //     (each 64 bit)
+  //   number of strings, per string its length and characters
+  //   number of nodes, per node its tag, whether it has content, its
+  //     number of properties, key and value of each, its number of
+  //     children and the index of each, children come before parents
+  //   number of root nodes and the index of each
+  // Strings are referenced by their index in the string table.
+  const char CACHE_MAGIC[8] = {'X', 'D', 'M', 'F', 'L', 'D', 'C', '2'};
+  const unsigned int CACHE_BYTE_ORDER = 0x01020304;
+
+  // Bytes hashed at each end of a document
+  const std::streamoff STAMP_HASH_LENGTH = 4096;
+
+  // FNV-1a hash of length bytes
+  unsigned long long
+  hashBytes(unsigned long long hash,
+            const char * bytes,
+            const std::streamsize length)
+  {
+    for(std::streamsize i = 0; i < length; ++i) {
+      hash ^= static_cast<unsigned char>(bytes[i]);
+      hash *= 0x100000001b3ULL;
+    }
+    return hash;
+  }
+
+  // Modification time, size and a hash of the first and last bytes of
+  // a document. Documents edited in place within the resolution of the
+  // file system's clock keep their time, the hash tells them apart.
+  bool
+  getFileStamp(const std::string & filePath,
+               long long & modified,
+               long long & size,
+               unsigned long long & hash)
+  {
+    struct stat fileStat;
+    if(stat(filePath.c_str(), &fileStat) != 0) {
+      return false;
+    }
+    modified = (long long)fileStat.st_mtime * 1000000000LL;
+#if defined(__APPLE__)
+    modified += fileStat.st_mtimespec.tv_nsec;
+#elif !defined(_WIN32)
+    modified += fileStat.st_mtim.tv_nsec;
+#endif
+    size = fileStat.st_size;
+
+    std::ifstream file(filePath.c_str(), std::ios::in | std::ios::binary);
+    if(!file) {
+      return false;
+    }
+    char bytes[STAMP_HASH_LENGTH];
+    hash = 0xcbf29ce484222325ULL;
+    file.read(bytes, STAMP_HASH_LENGTH);
+    hash = hashBytes(hash, bytes, file.gcount());
+    if(size > 2 * STAMP_HASH_LENGTH) {
+      file.clear();
+      file.seekg(-STAMP_HASH_LENGTH, std::ios::end);
+      file.read(bytes, STAMP_HASH_LENGTH);
+      hash = hashBytes(hash, bytes, file.gcount());
+    }
+    else if(size > STAMP_HASH_LENGTH) {
+      file.read(bytes, STAMP_HASH_LENGTH);
+      hash = hashBytes(hash, bytes, file.gcount());
+    }
+    return true;
+  }
+
+  template <typename T>
+  void
+  appendValue(std::string & buffer,
+              const T value)
+  {
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  void
+  appendString(std::string & buffer,
+               const std::string & value)
+  {
+    appendValue<unsigned int>(buffer, value.size());
+    buffer.append(value);
+  }
+
+  // Reads values out of a cache loaded in one piece, running off the
+  // end marks the cache as invalid instead of reading past it
+  class XdmfCacheCursor {
+
+  public:
+
+    XdmfCacheCursor(const std::string & buffer) :
+      mBuffer(buffer),
+      mPosition(0),
+      mValid(true)
+    {
+    }
+
+    template <typename T>
+    T
+    read()
+    {
+      T value = T();
+      if(mPosition + sizeof(T) > mBuffer.size()) {
+        mValid = false;
+        return value;
+      }
+      std::memcpy(&value, mBuffer.data() + mPosition, sizeof(T));
+      mPosition += sizeof(T);
+      return value;
+    }
+
+    std::string
+    readString()
+    {
+      const unsigned int length = read<unsigned int>();
+      if(!mValid || mPosition + length > mBuffer.size()) {
+        mValid = false;
+        return std::string();
+      }
+      mPosition += length;
+      return mBuffer.substr(mPosition - length, length);
+    }
+
+    // An index into a table, out of range indices invalidate the cache
+    unsigned int
+    readIndex(const size_t tableSize)
+    {
+      const unsigned int index = read<unsigned int>();
+      if(index >= tableSize) {
+        mValid = false;
+        return 0;
+      }
+      return index;
+    }
+
+    const std::string & mBuffer;
+    size_t mPosition;
+    bool mValid;
+  };
+
+}
+
 /**
  * PIMPL
  */
@@ -51,7 +204,10 @@ public:
   XdmfCoreReaderImpl(const shared_ptr<const XdmfCoreItemFactory> itemFactory,
                      const XdmfCoreReader * const coreReader) :
     mCoreReader(coreReader),
-    mItemFactory(itemFactory)
+    mItemFactory(itemFactory),
+    mXPathContext(NULL),
+    mLightDataCache(false),
+    mCacheRecording(false)
   {
   };
 
@@ -59,9 +215,65 @@ public:
   {
   };
 
+  /**
+   * Keeps the light data of a file for the items whose reading was
+   * deferred and reads them later with the XPath map and documents
+   * of the file, so that xpointers still resolve to the same items.
+   */
+  class XdmfCoreReaderSession : public XdmfDeferredItem::XdmfDeferredReader {
+
+  public:
+
+    XdmfCoreReaderSession(const shared_ptr<const XdmfCoreItemFactory> itemFactory) :
+      mImpl(new XdmfCoreReaderImpl(itemFactory, NULL))
+    {
+    }
+
+    ~XdmfCoreReaderSession()
+    {
+      if(mImpl->mXPathContext) {
+        mImpl->closeFile();
+      }
+      delete mImpl;
+    }
+
+    shared_ptr<XdmfItem>
+    read(const unsigned int index) const
+    {
+      std::vector<shared_ptr<XdmfItem> > items;
+      if(index < mNodes.size()) {
+        mImpl->readSingleNode(mNodes[index], items);
+        mImpl->releaseXPathMap();
+      }
+      if(items.size() == 0) {
+        return shared_ptr<XdmfItem>();
+      }
+      return items[0];
+    }
+
+    XdmfCoreReaderImpl * const mImpl;
+    std::vector<xmlNodePtr> mNodes;
+  };
+
   void
   closeFile()
   {
+    if(mSession) {
+      // The light data now belongs to the deferred items
+      XdmfCoreReaderImpl * sessionImpl = mSession->mImpl;
+      sessionImpl->mDocument = mDocument;
+      sessionImpl->mDocuments.swap(mDocuments);
+      sessionImpl->mXMLDir = mXMLDir;
+      sessionImpl->mXPathContext = mXPathContext;
+      sessionImpl->mXPathMap.swap(mXPathMap);
+      sessionImpl->releaseXPathMap();
+      mSession.reset();
+      mDocuments.clear();
+      mXPathContext = NULL;
+      mXPathMap.clear();
+      return;
+    }
+
     mXPathMap.clear();
     xmlXPathFreeContext(mXPathContext);
     for(std::map<std::string, xmlDocPtr>::const_iterator iter = 
@@ -76,11 +288,7 @@ public:
   void
   openFile(const std::string & filePath)
   {
-    mXMLDir = XdmfSystemUtils::getRealPath(filePath);
-    size_t index = mXMLDir.find_last_of("/\\");
-    if(index != std::string::npos) {
-      mXMLDir = mXMLDir.substr(0, index + 1);
-    }
+    setXMLDir(filePath);
 
     mDocument = xmlReadFile(filePath.c_str(), NULL, XML_PARSE_NOENT);
 
@@ -96,6 +304,250 @@ public:
     mXPathMap.clear();
   }
 
+  /**
+   * Moves the items read into mReleasedXPathMap. They belong to the
+   * items that hold them, the deferred items only find them again
+   * while they are alive, so the tree read is not kept by the deferred
+   * items in it.
+   */
+  void
+  releaseXPathMap()
+  {
+    for(std::map<xmlNodePtr, shared_ptr<XdmfItem> >::const_iterator iter =
+          mXPathMap.begin(); iter != mXPathMap.end(); ++iter) {
+      mReleasedXPathMap[iter->first] = iter->second;
+    }
+    mXPathMap.clear();
+  }
+
+  void
+  setXMLDir(const std::string & filePath)
+  {
+    mXMLDir = XdmfSystemUtils::getRealPath(filePath);
+    size_t index = mXMLDir.find_last_of("/\\");
+    if(index != std::string::npos) {
+      mXMLDir = mXMLDir.substr(0, index + 1);
+    }
+  }
+
+  /**
+   * Builds the items of a file from its light data cache, creating
+   * and populating them in the same way as from the XML. Returns
+   * false, without creating anything, if there is no valid cache or
+   * the documents it was built from changed.
+   */
+  bool
+  loadCache(const std::string & filePath,
+            std::vector<shared_ptr<XdmfItem> > & myItems)
+  {
+    std::ifstream cacheFile((filePath + ".cache").c_str(),
+                            std::ios::in | std::ios::binary);
+    if(!cacheFile) {
+      return false;
+    }
+    std::string buffer;
+    cacheFile.seekg(0, std::ios::end);
+    buffer.resize(cacheFile.tellg());
+    cacheFile.seekg(0, std::ios::beg);
+    cacheFile.read(&buffer[0], buffer.size());
+    if(!cacheFile ||
+       buffer.size() < sizeof(CACHE_MAGIC) ||
+       buffer.compare(0, sizeof(CACHE_MAGIC), CACHE_MAGIC,
+                      sizeof(CACHE_MAGIC)) != 0) {
+      return false;
+    }
+
+    XdmfCacheCursor cursor(buffer);
+    cursor.mPosition = sizeof(CACHE_MAGIC);
+    if(cursor.read<unsigned int>() != CACHE_BYTE_ORDER) {
+      return false;
+    }
+
+    const unsigned int numDocuments = cursor.read<unsigned int>();
+    for(unsigned int i = 0; i < numDocuments && cursor.mValid; ++i) {
+      const std::string documentPath = cursor.readString();
+      const long long cachedModified = cursor.read<long long>();
+      const long long cachedSize = cursor.read<long long>();
+      const unsigned long long cachedHash = cursor.read<unsigned long long>();
+      long long modified, size;
+      unsigned long long hash;
+      if(!getFileStamp(documentPath, modified, size, hash) ||
+         modified != cachedModified || size != cachedSize ||
+         hash != cachedHash) {
+        return false;
+      }
+    }
+
+    std::vector<std::string> strings(cursor.read<unsigned int>());
+    for(unsigned int i = 0; i < strings.size() && cursor.mValid; ++i) {
+      strings[i] = cursor.readString();
+    }
+
+    // Check the whole cache before any item is built
+    const size_t nodesStart = cursor.mPosition;
+    const unsigned int numNodes = cursor.read<unsigned int>();
+    for(unsigned int i = 0; i < numNodes && cursor.mValid; ++i) {
+      cursor.readIndex(strings.size());
+      cursor.read<unsigned int>();
+      const unsigned int numProperties = cursor.read<unsigned int>();
+      for(unsigned int j = 0; j < 2 * numProperties && cursor.mValid; ++j) {
+        cursor.readIndex(strings.size());
+      }
+      const unsigned int numChildren = cursor.read<unsigned int>();
+      for(unsigned int j = 0; j < numChildren && cursor.mValid; ++j) {
+        cursor.readIndex(i);
+      }
+    }
+    const unsigned int numRoots = cursor.read<unsigned int>();
+    for(unsigned int i = 0; i < numRoots && cursor.mValid; ++i) {
+      cursor.readIndex(numNodes);
+    }
+    if(!cursor.mValid || cursor.mPosition != buffer.size()) {
+      return false;
+    }
+
+    setXMLDir(filePath);
+
+    cursor.mPosition = nodesStart + sizeof(unsigned int);
+    std::vector<shared_ptr<XdmfItem> > items(numNodes);
+    for(unsigned int i = 0; i < numNodes; ++i) {
+      const std::string & tag = strings[cursor.read<unsigned int>()];
+      const bool hasContent = cursor.read<unsigned int>() != 0;
+      std::map<std::string, std::string> itemProperties;
+      const unsigned int numProperties = cursor.read<unsigned int>();
+      for(unsigned int j = 0; j < numProperties; ++j) {
+        const std::string & key = strings[cursor.read<unsigned int>()];
+        itemProperties.insert(std::make_pair(key,
+                                             strings[cursor.read<unsigned int>()]));
+      }
+      if(hasContent) {
+        itemProperties.insert(std::make_pair("XMLDir", mXMLDir));
+      }
+      std::vector<shared_ptr<XdmfItem> > childItems(cursor.read<unsigned int>());
+      for(unsigned int j = 0; j < childItems.size(); ++j) {
+        childItems[j] = items[cursor.read<unsigned int>()];
+      }
+      items[i] = createItem(tag, itemProperties, childItems);
+    }
+    cursor.read<unsigned int>();
+    for(unsigned int i = 0; i < numRoots; ++i) {
+      myItems.push_back(items[cursor.read<unsigned int>()]);
+    }
+    return true;
+  }
+
+  /**
+   * Writes the items read from the XML of an open file to its light
+   * data cache. A cache that can not be written is skipped.
+   */
+  void
+  saveCache(const std::string & filePath,
+            const std::vector<shared_ptr<XdmfItem> > & roots)
+  {
+    std::string buffer(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    appendValue(buffer, CACHE_BYTE_ORDER);
+
+    appendValue<unsigned int>(buffer, mDocuments.size());
+    for(std::map<std::string, xmlDocPtr>::const_iterator iter =
+          mDocuments.begin(); iter != mDocuments.end(); ++iter) {
+      long long modified = 0, size = 0;
+      unsigned long long hash = 0;
+      getFileStamp(iter->first, modified, size, hash);
+      appendString(buffer, iter->first);
+      appendValue(buffer, modified);
+      appendValue(buffer, size);
+      appendValue(buffer, hash);
+    }
+
+    appendValue<unsigned int>(buffer, mCacheStrings.size());
+    for(std::vector<std::string>::const_iterator iter =
+          mCacheStrings.begin(); iter != mCacheStrings.end(); ++iter) {
+      appendString(buffer, *iter);
+    }
+
+    appendValue<unsigned int>(buffer, mCacheNodes.size());
+    for(std::vector<std::vector<unsigned int> >::const_iterator iter =
+          mCacheNodes.begin(); iter != mCacheNodes.end(); ++iter) {
+      buffer.append(reinterpret_cast<const char *>(&(*iter)[0]),
+                    iter->size() * sizeof(unsigned int));
+    }
+
+    appendValue<unsigned int>(buffer, roots.size());
+    for(unsigned int i = 0; i < roots.size(); ++i) {
+      appendValue(buffer, mCacheIndices[roots[i].get()]);
+    }
+
+    // Written under another name first so readers never see half a cache
+    const std::string cachePath = filePath + ".cache";
+    const std::string tempPath = cachePath + ".tmp";
+    std::ofstream cacheFile(tempPath.c_str(),
+                            std::ios::out | std::ios::binary | std::ios::trunc);
+    cacheFile.write(buffer.data(), buffer.size());
+    cacheFile.close();
+    std::remove(cachePath.c_str());
+    if(!cacheFile || std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+      std::remove(tempPath.c_str());
+    }
+  }
+
+  unsigned int
+  getCacheString(const std::string & value)
+  {
+    std::map<std::string, unsigned int>::const_iterator iter =
+      mCacheStringIndices.find(value);
+    if(iter != mCacheStringIndices.end()) {
+      return iter->second;
+    }
+    mCacheStrings.push_back(value);
+    mCacheStringIndices.insert(std::make_pair(value,
+                                              mCacheStrings.size() - 1));
+    return mCacheStrings.size() - 1;
+  }
+
+  void
+  startCache()
+  {
+    mCacheRecording = mLightDataCache;
+    mCacheIndices.clear();
+    mCacheNodes.clear();
+    mCacheStrings.clear();
+    mCacheStringIndices.clear();
+  }
+
+  void
+  stopCache()
+  {
+    mCacheRecording = false;
+    mCacheIndices.clear();
+    mCacheNodes.clear();
+    mCacheStrings.clear();
+    mCacheStringIndices.clear();
+  }
+
+  shared_ptr<XdmfItem>
+  createItem(const std::string & tag,
+             const std::map<std::string, std::string> & itemProperties,
+             const std::vector<shared_ptr<XdmfItem> > & childItems)
+  {
+    shared_ptr<XdmfItem> newItem = 
+      mItemFactory->createItem(tag,
+                               itemProperties,
+                               childItems);
+    
+    if(newItem == NULL) {
+      XdmfError::message(XdmfError::FATAL, 
+                         "mItemFactory failed to createItem in "
+                         "XdmfCoreReader::XdmfCoreReaderImpl::readSingleNode");
+    }
+    
+
+    // Populate built XdmfItem
+    newItem->populateItem(itemProperties,
+                          childItems,
+                          mCoreReader);
+    return newItem;
+  }
+
   void
   parse(const std::string & lightData) 
   {
@@ -118,20 +570,76 @@ public:
    * children of currNode.
    */
   std::vector<shared_ptr<XdmfItem> >
-  read(xmlNodePtr currNode)
+  read(xmlNodePtr currNode,
+       const xmlNodePtr parentNode = NULL,
+       const std::map<std::string, std::string> * parentProperties = NULL)
   {
     std::vector<shared_ptr<XdmfItem> > myItems;
 
     while(currNode != NULL) {
       if(currNode->type == XML_ELEMENT_NODE) {
-        // Normal reading
-        this->readSingleNode(currNode, myItems);
+        if(parentNode && mCoreReader &&
+           mCoreReader->isDeferred((const char *)currNode->name,
+                                   (const char *)parentNode->name,
+                                   *parentProperties)) {
+          this->deferNode(currNode, myItems);
+        }
+        else {
+          // Normal reading
+          this->readSingleNode(currNode, myItems);
+        }
       }
       currNode = currNode->next;
     }
     return myItems;
   }
 
+  /**
+   * Adds an XdmfDeferredItem for a node to myItems instead of reading
+   * it. The properties of the node and of its children are kept so
+   * the parent can index the item without reading it.
+   */
+  void
+  deferNode(const xmlNodePtr currNode,
+            std::vector<shared_ptr<XdmfItem> > & myItems)
+  {
+    if(!mSession) {
+      mSession.reset(new XdmfCoreReaderSession(mItemFactory));
+    }
+    // A cache can only hold items that were read
+    mCacheRecording = false;
+
+    std::vector<std::pair<std::string, std::map<std::string, std::string> > >
+      childProperties;
+    for(xmlNodePtr childNode = currNode->children;
+        childNode != NULL;
+        childNode = childNode->next) {
+      if(childNode->type == XML_ELEMENT_NODE) {
+        childProperties.push_back(std::make_pair((char *)childNode->name,
+                                                 getProperties(childNode)));
+      }
+    }
+    mSession->mNodes.push_back(currNode);
+    myItems.push_back(XdmfDeferredItem::New((const char *)currNode->name,
+                                            getProperties(currNode),
+                                            childProperties,
+                                            mSession,
+                                            mSession->mNodes.size() - 1));
+  }
+
+  static std::map<std::string, std::string>
+  getProperties(const xmlNodePtr currNode)
+  {
+    std::map<std::string, std::string> itemProperties;
+    for(xmlAttrPtr currAttribute = currNode->properties;
+        currAttribute != NULL;
+        currAttribute = currAttribute->next) {
+      itemProperties.insert(std::make_pair((char *)currAttribute->name,
+                                           (char *)currAttribute->children->content));
+    }
+    return itemProperties;
+  }
+
   /**
    * Reads a single xmlNode into an XdmfItem object in memory. The constructed
    * XdmfItem is added to myItems and an entry is added mapping the xmlNodePtr
@@ -204,9 +712,24 @@ public:
       // Check to see if the node is already in the XPath Map (seen previously)
       std::map<xmlNodePtr, shared_ptr<XdmfItem> >::const_iterator iter =
         mXPathMap.find(currNode);
-      // If it is grab it from the previously stored items
+      shared_ptr<XdmfItem> seenItem;
       if(iter != mXPathMap.end()) {
-        myItems.push_back(iter->second);
+        seenItem = iter->second;
+      }
+      else if(mReleasedXPathMap.size() > 0) {
+        std::map<xmlNodePtr, boost::weak_ptr<XdmfItem> >::iterator
+          releasedIter = mReleasedXPathMap.find(currNode);
+        if(releasedIter != mReleasedXPathMap.end()) {
+          seenItem = releasedIter->second.lock();
+          if(!seenItem) {
+            // Nothing holds the item any more, it is read again
+            mReleasedXPathMap.erase(releasedIter);
+          }
+        }
+      }
+      // If it is grab it from the previously stored items
+      if(seenItem) {
+        myItems.push_back(seenItem);
       }
       else {
         // Otherwise, generate a new XdmfItem from the node
@@ -267,23 +790,34 @@ public:
         
         // Build XdmfItem
         const std::vector<shared_ptr<XdmfItem> > childItems =
-          this->read(currNode->children);
+          this->read(currNode->children, currNode, &itemProperties);
         shared_ptr<XdmfItem> newItem = 
-          mItemFactory->createItem((const char *)currNode->name,
-                                   itemProperties,
-                                   childItems);
-        
-        if(newItem == NULL) {
-          XdmfError::message(XdmfError::FATAL, 
-                             "mItemFactory failed to createItem in "
-                             "XdmfCoreReader::XdmfCoreReaderImpl::readSingleNode");
+          this->createItem((const char *)currNode->name,
+                           itemProperties,
+                           childItems);
+
+        if(mCacheRecording) {
+          // The directory is added again when the cache is loaded
+          const bool hasContent = itemProperties.count("Content") > 0;
+          std::vector<unsigned int> node;
+          node.push_back(getCacheString((const char *)currNode->name));
+          node.push_back(hasContent);
+          node.push_back(itemProperties.size() - hasContent);
+          for(std::map<std::string, std::string>::const_iterator iter =
+                itemProperties.begin(); iter != itemProperties.end(); ++iter) {
+            if(!hasContent || iter->first.compare("XMLDir") != 0) {
+              node.push_back(getCacheString(iter->first));
+              node.push_back(getCacheString(iter->second));
+            }
+          }
+          node.push_back(childItems.size());
+          for(unsigned int i = 0; i < childItems.size(); ++i) {
+            node.push_back(mCacheIndices[childItems[i].get()]);
+          }
+          mCacheIndices.insert(std::make_pair(newItem.get(),
+                                              mCacheNodes.size()));
+          mCacheNodes.push_back(node);
         }
-        
-
-        // Populate built XdmfItem
-        newItem->populateItem(itemProperties,
-                              childItems,
-                              mCoreReader);
 
         myItems.push_back(newItem);
         mXPathMap.insert(std::make_pair(currNode, newItem));
@@ -312,6 +846,14 @@ public:
   std::string mXMLDir;
   xmlXPathContextPtr mXPathContext;
   std::map<xmlNodePtr, shared_ptr<XdmfItem> > mXPathMap;
+  std::map<xmlNodePtr, boost::weak_ptr<XdmfItem> > mReleasedXPathMap;
+  bool mLightDataCache;
+  bool mCacheRecording;
+  shared_ptr<XdmfCoreReaderSession> mSession;
+  std::map<const XdmfItem *, unsigned int> mCacheIndices;
+  std::vector<std::vector<unsigned int> > mCacheNodes;
+  std::vector<std::string> mCacheStrings;
+  std::map<std::string, unsigned int> mCacheStringIndices;
 };
 
 XdmfCoreReader::XdmfCoreReader(const shared_ptr<const XdmfCoreItemFactory> itemFactory) :
@@ -342,13 +884,35 @@ XdmfCoreReader::parse(const std::string & lightData) const
   return(toReturn[0]);
 }
 
+bool
+XdmfCoreReader::isDeferred(const std::string &,
+                           const std::string &,
+                           const std::map<std::string, std::string> &) const
+{
+  return false;
+}
+
+bool
+XdmfCoreReader::getLightDataCache() const
+{
+  return mImpl->mLightDataCache;
+}
+
 std::vector<shared_ptr<XdmfItem> >
 XdmfCoreReader::readItems(const std::string & filePath) const
 {
+  std::vector<shared_ptr<XdmfItem> > toReturn;
+  if(mImpl->mLightDataCache && mImpl->loadCache(filePath, toReturn)) {
+    return toReturn;
+  }
   mImpl->openFile(filePath);
+  mImpl->startCache();
   const xmlNodePtr currNode = xmlDocGetRootElement(mImpl->mDocument);
-  const std::vector<shared_ptr<XdmfItem> > toReturn =
-    mImpl->read(currNode->children);
+  toReturn = mImpl->read(currNode->children);
+  if(mImpl->mCacheRecording) {
+    mImpl->saveCache(filePath, toReturn);
+  }
+  mImpl->stopCache();
   mImpl->closeFile();
   return toReturn;
 }
@@ -373,6 +937,12 @@ XdmfCoreReader::read(const std::string & filePath,
   return toReturn;
 }
 
+void
+XdmfCoreReader::setLightDataCache(const bool cache)
+{
+  mImpl->mLightDataCache = cache;
+}
+
 std::vector<shared_ptr<XdmfItem> >
 XdmfCoreReader::readPathObjects(const std::string & xPath) const
 {
@@ -29,6 +29,7 @@ class XdmfCoreItemFactory;
 class XdmfItem;
 
 // Includes
+#include <map>
 #include <string>
 #include <vector>
 #include "XdmfCore.hpp"
@@ -43,6 +44,11 @@ class XdmfItem;
  * XdmfArrays but no heavy data is read into memory.
  *
  * XdmfCoreReader is an abstract base class.
+ *
+ * Files that are read many times can keep a binary cache of their
+ * light data next to them, see setLightDataCache(). Reading from the
+ * cache skips parsing the XML and resolving XPointers, the items are
+ * built from it in the same way and the tree read is identical.
  */
 class XDMFCORE_EXPORT XdmfCoreReader {
 
@@ -50,6 +56,35 @@ public:
 
   virtual ~XdmfCoreReader() = 0;
 
+  /**
+   * Get whether whole files are read through a light data cache.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfCoreReader.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#setLightDataCache
+   * @until //#setLightDataCache
+   * @skipline //#getLightDataCache
+   * @until //#getLightDataCache
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleCoreReader.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//setLightDataCache
+   * @until #//setLightDataCache
+   * @skipline #//getLightDataCache
+   * @until #//getLightDataCache
+   *
+   * @return    Whether the light data cache is used.
+   */
+  bool getLightDataCache() const;
+
   /**
    * Parse a string containing light data into an Xdmf structure in
    * memory.
@@ -190,8 +225,57 @@ public:
   std::vector<shared_ptr<XdmfItem> >
   readPathObjects(const std::string & xPath) const;
 
+  /**
+   * Set whether whole files are read through a light data cache. The
+   * cache of "file.xmf" is kept in "file.xmf.cache". The first read
+   * parses the XML and writes the cache, later reads build the items
+   * from the cache as long as the modification time, size and first
+   * and last bytes of the file, and of any file it includes, are
+   * unchanged. Otherwise the
+   * XML is parsed again and the cache replaced. A cache that can not
+   * be written is skipped. Reads of an XPath and of strings do not
+   * use the cache.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfCoreReader.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#setLightDataCache
+   * @until //#setLightDataCache
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleCoreReader.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//setLightDataCache
+   * @until #//setLightDataCache
+   *
+   * @param     cache   Whether to use the light data cache.
+   */
+  void setLightDataCache(const bool cache);
+
 protected:
 
+  /**
+   * Decide whether reading an item is deferred. The parent of a
+   * deferred item is populated with an XdmfDeferredItem in its place,
+   * which reads the item when needed. Nothing is deferred by default.
+   *
+   * @param     tag                     The tag of the item.
+   * @param     parentTag               The tag of the parent of the item.
+   * @param     parentProperties        The properties of the parent.
+   *
+   * @return                            Whether to defer reading the item.
+   */
+  virtual bool
+  isDeferred(const std::string & tag,
+             const std::string & parentTag,
+             const std::map<std::string, std::string> & parentProperties) const;
+
   /**
    * Constructor
    *
@@ -0,0 +1,93 @@
+/*****************************************************************************/
+/*                                    XDMF                                   */
+/*                       eXtensible Data Model and Format                    */
+/*                                                                           */
+/*  Id : XdmfDeferredItem.cpp                                                */
+/*                                                                           */
+/*     This software is distributed WITHOUT ANY WARRANTY; without            */
+/*     even the implied warranty of MERCHANTABILITY or FITNESS               */
+/*     FOR A PARTICULAR PURPOSE.  See Copyright.txt for details.             */
+/*                                                                           */
+/*****************************************************************************/
+
+
+#include "XdmfDeferredItem.hpp"
+#include "XdmfError.hpp"
+
+XdmfDeferredItem::XdmfDeferredReader::XdmfDeferredReader()
+{
+}
+
+XdmfDeferredItem::XdmfDeferredReader::~XdmfDeferredReader()
+{
+}
+
+shared_ptr<XdmfDeferredItem>
+XdmfDeferredItem::New(const std::string & tag,
+                      const std::map<std::string, std::string> & itemProperties,
+                      const std::vector<std::pair<std::string, std::map<std::string, std::string> > > & childProperties,
+                      const shared_ptr<const XdmfDeferredReader> reader,
+                      const unsigned int index)
+{
+  shared_ptr<XdmfDeferredItem> p(new XdmfDeferredItem(tag,
+                                                      itemProperties,
+                                                      childProperties,
+                                                      reader,
+                                                      index));
+  return p;
+}
+
+XdmfDeferredItem::XdmfDeferredItem(const std::string & tag,
+                                   const std::map<std::string, std::string> & itemProperties,
+                                   const std::vector<std::pair<std::string, std::map<std::string, std::string> > > & childProperties,
+                                   const shared_ptr<const XdmfDeferredReader> reader,
+                                   const unsigned int index) :
+  mChildProperties(childProperties),
+  mIndex(index),
+  mItemProperties(itemProperties),
+  mReader(reader),
+  mTag(tag)
+{
+}
+
+XdmfDeferredItem::~XdmfDeferredItem()
+{
+}
+
+std::map<std::string, std::string>
+XdmfDeferredItem::getChildProperties(const std::string & tag) const
+{
+  for(std::vector<std::pair<std::string, std::map<std::string, std::string> > >::const_iterator iter =
+        mChildProperties.begin();
+      iter != mChildProperties.end();
+      ++iter) {
+    if(iter->first.compare(tag) == 0) {
+      return iter->second;
+    }
+  }
+  return std::map<std::string, std::string>();
+}
+
+std::map<std::string, std::string>
+XdmfDeferredItem::getItemProperties() const
+{
+  return mItemProperties;
+}
+
+std::string
+XdmfDeferredItem::getItemTag() const
+{
+  return mTag;
+}
+
+shared_ptr<XdmfItem>
+XdmfDeferredItem::read() const
+{
+  shared_ptr<XdmfItem> item = mReader->read(mIndex);
+  if(!item) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Could not read deferred " + mTag +
+                       " in XdmfDeferredItem::read");
+  }
+  return item;
+}
@@ -0,0 +1,132 @@
+/*****************************************************************************/
+/*                                    XDMF                                   */
+/*                       eXtensible Data Model and Format                    */
+/*                                                                           */
+/*  Id : XdmfDeferredItem.hpp                                                */
+/*                                                                           */
+/*     This software is distributed WITHOUT ANY WARRANTY; without            */
+/*     even the implied warranty of MERCHANTABILITY or FITNESS               */
+/*     FOR A PARTICULAR PURPOSE.  See Copyright.txt for details.             */
+/*                                                                           */
+/*****************************************************************************/
+
+
+#ifndef XDMFDEFERREDITEM_HPP_
+#define XDMFDEFERREDITEM_HPP_
+
+// Includes
+#include <utility>
+#include "XdmfCore.hpp"
+#include "XdmfItem.hpp"
+
+/**
+ * @brief Stands in for an item whose reading was deferred by an
+ * XdmfCoreReader.
+ *
+ * A reader can leave items, for example the steps of a temporal
+ * collection, unread until they are needed. The parent is populated
+ * with an XdmfDeferredItem in place of each of them, holding the tag
+ * and properties of the item and of its children so that the parent
+ * can index it. Calling read() builds the item in the same way the
+ * reader would have. The light data of the file stays in memory until
+ * every deferred item of the file is gone. Items read before are only
+ * shared with the item while something else still holds them, the
+ * deferred items do not keep the tree they are in alive.
+ *
+ * XdmfDeferredItems are created by readers and are never written.
+ */
+class XDMFCORE_EXPORT XdmfDeferredItem : public XdmfItem {
+
+public:
+
+  /**
+   * Reads deferred items from the light data they were found in.
+   */
+  class XDMFCORE_EXPORT XdmfDeferredReader {
+
+  public:
+
+    virtual ~XdmfDeferredReader();
+
+    /**
+     * Build the item at a position in the light data.
+     *
+     * @param     index   The position of the item, as given to New().
+     *
+     * @return            The item read.
+     */
+    virtual shared_ptr<XdmfItem> read(const unsigned int index) const = 0;
+
+  protected:
+
+    XdmfDeferredReader();
+
+  };
+
+  /**
+   * Create a new XdmfDeferredItem. Called by readers.
+   *
+   * @param     tag             The tag of the deferred item.
+   * @param     itemProperties  The properties of the deferred item.
+   * @param     childProperties The tag and properties of each child
+   *                            of the deferred item.
+   * @param     reader          The reader that builds the item.
+   * @param     index           The position of the item in the reader.
+   *
+   * @return                    Constructed XdmfDeferredItem.
+   */
+  static shared_ptr<XdmfDeferredItem>
+  New(const std::string & tag,
+      const std::map<std::string, std::string> & itemProperties,
+      const std::vector<std::pair<std::string, std::map<std::string, std::string> > > & childProperties,
+      const shared_ptr<const XdmfDeferredReader> reader,
+      const unsigned int index);
+
+  virtual ~XdmfDeferredItem();
+
+  LOKI_DEFINE_VISITABLE(XdmfDeferredItem, XdmfItem)
+
+  /**
+   * Get the properties of the first child of the deferred item with a
+   * tag, without reading the item.
+   *
+   * @param     tag     The tag of the child.
+   *
+   * @return            The properties of the child, empty if the item
+   *                    has no child with the tag.
+   */
+  std::map<std::string, std::string>
+  getChildProperties(const std::string & tag) const;
+
+  std::map<std::string, std::string> getItemProperties() const;
+
+  std::string getItemTag() const;
+
+  /**
+   * Read the deferred item. Reading it again returns the same item.
+   *
+   * @return    The item this stands in for.
+   */
+  shared_ptr<XdmfItem> read() const;
+
+protected:
+
+  XdmfDeferredItem(const std::string & tag,
+                   const std::map<std::string, std::string> & itemProperties,
+                   const std::vector<std::pair<std::string, std::map<std::string, std::string> > > & childProperties,
+                   const shared_ptr<const XdmfDeferredReader> reader,
+                   const unsigned int index);
+
+private:
+
+  XdmfDeferredItem(const XdmfDeferredItem &);  // Not implemented.
+  void operator=(const XdmfDeferredItem &);  // Not implemented.
+
+  std::vector<std::pair<std::string, std::map<std::string, std::string> > > mChildProperties;
+  unsigned int mIndex;
+  std::map<std::string, std::string> mItemProperties;
+  shared_ptr<const XdmfDeferredReader> mReader;
+  std::string mTag;
+};
+
+#endif /* XDMFDEFERREDITEM_HPP_ */
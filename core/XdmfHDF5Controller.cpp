@@ -23,6 +23,8 @@
 
 #include <H5public.h>
 #include <hdf5.h>
+#include <algorithm>
+#include <cstring>
 #include <numeric>
 #include <sstream>
 #include "XdmfArray.hpp"
@@ -33,7 +35,284 @@
 
 unsigned int XdmfHDF5Controller::mMaxOpenedFiles = 0;
 static std::map<std::string, hid_t> mOpenFiles;
-std::map<std::string, unsigned int> XdmfHDF5Controller::mOpenFileUsage;
+// Data sets that stay open with their file, keyed by file then data set path
+static std::map<std::string, std::map<std::string, hid_t> > mOpenDataSets;
+static std::map<std::string, unsigned int> mOpenFileUsage;
+
+namespace {
+
+  void
+  closeDataSets(const std::string & filePath)
+  {
+    std::map<std::string, std::map<std::string, hid_t> >::iterator fileIter =
+      mOpenDataSets.find(filePath);
+    if(fileIter != mOpenDataSets.end()) {
+      for(std::map<std::string, hid_t>::iterator dataSetIter =
+            fileIter->second.begin();
+          dataSetIter != fileIter->second.end();
+          ++dataSetIter) {
+        H5Dclose(dataSetIter->second);
+      }
+      mOpenDataSets.erase(fileIter);
+    }
+  }
+
+  // Open a data set for reading. When maxOpenedFiles is nonzero the
+  // file and data set stay open between reads, so repeated reads of
+  // the same data set skip H5Fopen and H5Dopen.
+  hid_t
+  openDataSet(const std::string & filePath,
+              const std::string & dataSetPath,
+              const hid_t fapl,
+              const unsigned int maxOpenedFiles,
+              hid_t & hdf5Handle)
+  {
+    if (maxOpenedFiles == 0) {
+      hdf5Handle = H5Fopen(filePath.c_str(), H5F_ACC_RDONLY, fapl);
+      return H5Dopen(hdf5Handle, dataSetPath.c_str(), H5P_DEFAULT);
+    }
+
+    std::map<std::string, hid_t>::iterator checkOpen = mOpenFiles.find(filePath);
+    if (checkOpen == mOpenFiles.end()) {
+      // If the number of open files would become larger than allowed
+      if (mOpenFiles.size() + 1 > maxOpenedFiles) {
+        // Close least used one
+        std::map<std::string, unsigned int>::iterator walker = mOpenFileUsage.begin();
+        std::string oldestFile = walker->first;
+        while (walker != mOpenFileUsage.end()) {
+          // We want the file with the fewest accesses
+          // If two are tied, we use the older one
+          if (mOpenFileUsage[oldestFile] > walker->second) {
+            oldestFile = walker->first;
+          }
+          ++walker;
+        }
+        closeDataSets(oldestFile);
+        H5Fclose(mOpenFiles[oldestFile]);
+        mOpenFiles.erase(oldestFile);
+        mOpenFileUsage.erase(oldestFile);
+      }
+      hdf5Handle = H5Fopen(filePath.c_str(), H5F_ACC_RDONLY, fapl);
+      mOpenFiles[filePath] = hdf5Handle;
+      mOpenFileUsage[filePath] = 1;
+    }
+    else {
+      hdf5Handle = checkOpen->second;
+      mOpenFileUsage[filePath]++;
+    }
+
+    std::map<std::string, hid_t> & dataSets = mOpenDataSets[filePath];
+    std::map<std::string, hid_t>::iterator checkDataSet =
+      dataSets.find(dataSetPath);
+    if (checkDataSet != dataSets.end()) {
+      return checkDataSet->second;
+    }
+    const hid_t dataset = H5Dopen(hdf5Handle, dataSetPath.c_str(), H5P_DEFAULT);
+    if (dataset >= 0) {
+      dataSets[dataSetPath] = dataset;
+    }
+    return dataset;
+  }
+
+  void
+  closeDataSet(const hid_t dataset,
+               const hid_t hdf5Handle,
+               const unsigned int maxOpenedFiles)
+  {
+    // Handles of files kept open are released by closeFiles
+    if (maxOpenedFiles == 0) {
+      H5Dclose(dataset);
+      H5Fclose(hdf5Handle);
+    }
+  }
+
+  hid_t
+  getNativeType(const shared_ptr<const XdmfArrayType> & type,
+                bool & closeDatatype)
+  {
+    closeDatatype = false;
+    if(type == XdmfArrayType::Int8()) {
+      return H5T_NATIVE_CHAR;
+    }
+    else if(type == XdmfArrayType::Int16()) {
+      return H5T_NATIVE_SHORT;
+    }
+    else if(type == XdmfArrayType::Int32()) {
+      return H5T_NATIVE_INT;
+    }
+    else if(type == XdmfArrayType::Int64()) {
+      return H5T_NATIVE_LONG;
+    }
+    else if(type == XdmfArrayType::Float32()) {
+      return H5T_NATIVE_FLOAT;
+    }
+    else if(type == XdmfArrayType::Float64()) {
+      return H5T_NATIVE_DOUBLE;
+    }
+    else if(type == XdmfArrayType::UInt8()) {
+      return H5T_NATIVE_UCHAR;
+    }
+    else if(type == XdmfArrayType::UInt16()) {
+      return H5T_NATIVE_USHORT;
+    }
+    else if(type == XdmfArrayType::UInt32()) {
+      return H5T_NATIVE_UINT;
+    }
+    else if(type == XdmfArrayType::String()) {
+      hid_t datatype = H5Tcopy(H5T_C_S1);
+      H5Tset_size(datatype, H5T_VARIABLE);
+      closeDatatype = true;
+      return datatype;
+    }
+    XdmfError::message(XdmfError::FATAL,
+                       "Unknown XdmfArrayType encountered in hdf5 "
+                       "controller.");
+    return H5T_NO_CLASS;
+  }
+
+  // Select the values a controller owns in the data set's dataspace
+  void
+  selectValues(const hid_t dataspace,
+               const std::vector<unsigned int> & start,
+               const std::vector<unsigned int> & stride,
+               const std::vector<unsigned int> & dimensions)
+  {
+    const unsigned int dataspaceDims = H5Sget_simple_extent_ndims(dataspace);
+
+    if(dataspaceDims == 1 && start.size() == 1 && dimensions.size() != 1) {
+      // An array packed by XdmfHDF5Writer is a run of values in a one
+      // dimensional data set, whatever its own dimensions are
+      const hsize_t fileStart = start[0];
+      const hsize_t fileStride = stride[0];
+      const hsize_t count =
+        std::accumulate(dimensions.begin(),
+                        dimensions.end(),
+                        1,
+                        std::multiplies<unsigned int>());
+      H5Sselect_hyperslab(dataspace,
+                          H5S_SELECT_SET,
+                          &fileStart,
+                          &fileStride,
+                          &count,
+                          NULL);
+    }
+    else if(dataspaceDims != dimensions.size()) {
+      // special case where the number of dimensions of the hdf5 dataset
+      // does not equal the number of dimensions in the light data
+      // description - in this case we cannot properly take a hyperslab
+      // selection, so we assume we are reading the entire dataset and
+      // check whether that is ok to do
+      const int numberValuesHDF5 = H5Sget_select_npoints(dataspace);
+      const int numberValuesXdmf =
+        std::accumulate(dimensions.begin(),
+                        dimensions.end(),
+                        1,
+                        std::multiplies<unsigned int>());
+      if(numberValuesHDF5 != numberValuesXdmf) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Number of dimensions in light data description in "
+                           "Xdmf does not match number of dimensions in hdf5 "
+                           "file.");
+      }
+    }
+    else {
+      const std::vector<hsize_t> fileStart(start.begin(), start.end());
+      const std::vector<hsize_t> fileStride(stride.begin(), stride.end());
+      const std::vector<hsize_t> count(dimensions.begin(), dimensions.end());
+
+      H5Sselect_hyperslab(dataspace,
+                          H5S_SELECT_SET,
+                          &fileStart[0],
+                          &fileStride[0],
+                          &count[0],
+                          NULL);
+    }
+  }
+
+  // Add the values [lo, hi) of the row major block with dimensions
+  // dims[dim...] to the selection. coords holds the block indices of
+  // the outer dimensions. Whole rows are merged into one hyperslab so
+  // a contiguous window costs at most 2 * rank - 1 hyperslabs.
+  void
+  selectRange(const hid_t dataspace,
+              bool & firstSelection,
+              const std::vector<hsize_t> & dims,
+              const std::vector<hsize_t> & fileStart,
+              const std::vector<hsize_t> & fileStride,
+              std::vector<hsize_t> & coords,
+              const unsigned int dim,
+              hsize_t lo,
+              hsize_t hi)
+  {
+    const unsigned int rank = dims.size();
+    hsize_t inner = 1;
+    for(unsigned int i = dim + 1; i < rank; ++i) {
+      inner *= dims[i];
+    }
+    hsize_t first = lo / inner;
+    hsize_t last = (hi - 1) / inner;
+    if(first == last && dim + 1 < rank) {
+      coords[dim] = first;
+      selectRange(dataspace, firstSelection, dims, fileStart, fileStride,
+                  coords, dim + 1, lo - first * inner, hi - first * inner);
+      return;
+    }
+    if(dim + 1 < rank) {
+      if(lo % inner != 0) {
+        coords[dim] = first;
+        selectRange(dataspace, firstSelection, dims, fileStart, fileStride,
+                    coords, dim + 1, lo % inner, inner);
+        ++first;
+      }
+      if(hi % inner != 0) {
+        coords[dim] = last;
+        selectRange(dataspace, firstSelection, dims, fileStart, fileStride,
+                    coords, dim + 1, 0, hi % inner);
+        if(last == 0) {
+          return;
+        }
+        --last;
+      }
+      if(first > last) {
+        return;
+      }
+    }
+    std::vector<hsize_t> start(rank);
+    std::vector<hsize_t> count(rank);
+    for(unsigned int i = 0; i < rank; ++i) {
+      if(i < dim) {
+        start[i] = fileStart[i] + coords[i] * fileStride[i];
+        count[i] = 1;
+      }
+      else if(i == dim) {
+        start[i] = fileStart[i] + first * fileStride[i];
+        count[i] = last - first + 1;
+      }
+      else {
+        start[i] = fileStart[i];
+        count[i] = dims[i];
+      }
+    }
+    H5Sselect_hyperslab(dataspace,
+                        firstSelection ? H5S_SELECT_SET : H5S_SELECT_OR,
+                        &start[0],
+                        &fileStride[0],
+                        &count[0],
+                        NULL);
+    firstSelection = false;
+  }
+
+  // A packed array and the controller holding its run of values
+  typedef std::pair<shared_ptr<XdmfHDF5Controller>, XdmfArray *> PackedRun;
+
+  bool
+  compareRunStart(const PackedRun & first,
+                  const PackedRun & second)
+  {
+    return first.first->getStart()[0] < second.first->getStart()[0];
+  }
+
+}
 
 shared_ptr<XdmfHDF5Controller>
 XdmfHDF5Controller::New(const std::string & hdf5FilePath,
@@ -82,6 +361,7 @@ XdmfHDF5Controller::closeFiles()
   for (std::map<std::string, hid_t>::iterator closeIter = mOpenFiles.begin();
        closeIter != mOpenFiles.end();
        ++closeIter) {
+    closeDataSets(closeIter->first);
     H5Fclose(closeIter->second);
   }
   mOpenFiles.clear();
@@ -139,179 +419,409 @@ XdmfHDF5Controller::getStride() const
 void
 XdmfHDF5Controller::read(XdmfArray * const array)
 {
-  this->read(array, H5P_DEFAULT);
+  this->read(array, mType, H5P_DEFAULT);
+}
+
+void
+XdmfHDF5Controller::read(XdmfArray * const array,
+                         const shared_ptr<const XdmfArrayType> & readType)
+{
+  this->read(array, readType, H5P_DEFAULT);
 }
 
 void
 XdmfHDF5Controller::read(XdmfArray * const array, const int fapl)
 {
-  herr_t status;
-  hid_t hdf5Handle;
-  if (XdmfHDF5Controller::mMaxOpenedFiles == 0) {
-    hdf5Handle = H5Fopen(mFilePath.c_str(), H5F_ACC_RDONLY, fapl);
+  this->read(array, mType, fapl);
+}
+
+void
+XdmfHDF5Controller::read(XdmfArray * const array,
+                         const shared_ptr<const XdmfArrayType> & readType,
+                         const int fapl)
+{
+  // The memory type hdf5 converts into, the file type is taken from
+  // the dataset itself
+  const shared_ptr<const XdmfArrayType> memoryType = readType ? readType : mType;
+  if((memoryType == XdmfArrayType::String()) !=
+     (mType == XdmfArrayType::String())) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Cannot convert between string and numeric types "
+                       "when reading in XdmfHDF5Controller::read");
   }
-  else {
-    std::map<std::string, hid_t>::iterator checkOpen = mOpenFiles.find(mFilePath);
-    if (checkOpen == mOpenFiles.end()) {
-      // If the number of open files would become larger than allowed
-      if (mOpenFiles.size() + 1 > mMaxOpenedFiles) {
-        // Close least used one
-        std::map<std::string, unsigned int>::iterator walker = mOpenFileUsage.begin();
-        std::string oldestFile = walker->first;
-        while (walker != mOpenFileUsage.end()) {
-          // We want the file with the fewest accesses
-          // If two are tied, we use the older one
-          if (mOpenFileUsage[oldestFile] > walker->second) {
-            oldestFile = walker->first;
-          }
-          ++walker;
-        }
-        status = H5Fclose(mOpenFiles[oldestFile]);
-        mOpenFiles.erase(oldestFile);
-        mOpenFileUsage.erase(oldestFile);
-      }
-      hdf5Handle = H5Fopen(mFilePath.c_str(), H5F_ACC_RDONLY, fapl);
-      mOpenFiles[mFilePath] = hdf5Handle;
-      mOpenFileUsage[mFilePath] = 1;
-    }
-    else {
-      hdf5Handle = checkOpen->second;
-      mOpenFileUsage[mFilePath]++;
-    }
+
+  if(memoryType != XdmfArrayType::String()) {
+    // Numeric data is read straight into the array's storage
+    array->initialize(memoryType, mDimensions);
+    this->read(array->getValuesInternal(),
+               memoryType,
+               array->getSize(),
+               fapl);
+    return;
   }
 
-  const hid_t dataset = H5Dopen(hdf5Handle, mDataSetPath.c_str(), H5P_DEFAULT);
+  herr_t status;
+  hid_t hdf5Handle;
+  const hid_t dataset = openDataSet(mFilePath,
+                                    mDataSetPath,
+                                    fapl,
+                                    mMaxOpenedFiles,
+                                    hdf5Handle);
   const hid_t dataspace = H5Dget_space(dataset);
 
-  const unsigned int dataspaceDims = H5Sget_simple_extent_ndims(dataspace);
+  selectValues(dataspace, mStart, mStride, mDimensions);
+
+  const hssize_t numVals = H5Sget_select_npoints(dataspace);
   const std::vector<hsize_t> count(mDimensions.begin(), mDimensions.end());
+  hid_t memspace = H5Screate_simple(mDimensions.size(),
+                                    &count[0],
+                                    NULL);
 
-  if(dataspaceDims != mDimensions.size()) {
-    // special case where the number of dimensions of the hdf5 dataset
-    // does not equal the number of dimensions in the light data
-    // description - in this case we cannot properly take a hyperslab
-    // selection, so we assume we are reading the entire dataset and
-    // check whether that is ok to do
-    const int numberValuesHDF5 = H5Sget_select_npoints(dataspace);
-    const int numberValuesXdmf = 
-      std::accumulate(mDimensions.begin(),
-                      mDimensions.end(),
-                      1,
-                      std::multiplies<unsigned int>());
-    if(numberValuesHDF5 != numberValuesXdmf) {
-      XdmfError::message(XdmfError::FATAL,
-                         "Number of dimensions in light data description in "
-                         "Xdmf does not match number of dimensions in hdf5 "
-                         "file.");
-    }
+  bool closeDatatype;
+  const hid_t datatype = getNativeType(memoryType, closeDatatype);
+
+  array->initialize(memoryType, mDimensions);
+
+  if(numVals != array->getSize()) {
+    std::stringstream errOut;
+    errOut << "Number of values in hdf5 dataset (" << numVals;
+    errOut << ")\ndoes not match allocated size in XdmfArray (" << array->getSize() << ").";
+    XdmfError::message(XdmfError::FATAL,
+                       errOut.str());
   }
-  else {
-    const std::vector<hsize_t> start(mStart.begin(), mStart.end());
-    const std::vector<hsize_t> stride(mStride.begin(), mStride.end());
-
-    status = H5Sselect_hyperslab(dataspace,
-                                 H5S_SELECT_SET,
-                                 &start[0],
-                                 &stride[0],
-                                 &count[0],
-                                 NULL);
+
+  char ** data = new char*[numVals];
+  status = H5Dread(dataset,
+                   datatype,
+                   memspace,
+                   dataspace,
+                   H5P_DEFAULT,
+                   data);
+  for(hssize_t i=0; i<numVals; ++i) {
+    array->insert<std::string>(i, data[i]);
+  }
+  status = H5Dvlen_reclaim(datatype,
+                           dataspace,
+                           H5P_DEFAULT,
+                           data);
+  delete [] data;
+
+  status = H5Sclose(dataspace);
+  status = H5Sclose(memspace);
+  status = H5Tclose(datatype);
+  closeDataSet(dataset, hdf5Handle, mMaxOpenedFiles);
+}
+
+void
+XdmfHDF5Controller::read(void * const valuesPointer,
+                         const shared_ptr<const XdmfArrayType> & valuesType,
+                         const unsigned int numValues)
+{
+  this->read(valuesPointer, valuesType, numValues, H5P_DEFAULT);
+}
+
+void
+XdmfHDF5Controller::read(void * const valuesPointer,
+                         const shared_ptr<const XdmfArrayType> & valuesType,
+                         const unsigned int numValues,
+                         const int fapl)
+{
+  if(valuesType == XdmfArrayType::String() ||
+     mType == XdmfArrayType::String()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Cannot read string data into memory in "
+                       "XdmfHDF5Controller::read");
+  }
+
+  if(numValues != this->getSize()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Number of values in memory does not match size of "
+                       "hdf5 dataset in XdmfHDF5Controller::read");
   }
 
+  hid_t hdf5Handle;
+  const hid_t dataset = openDataSet(mFilePath,
+                                    mDataSetPath,
+                                    fapl,
+                                    mMaxOpenedFiles,
+                                    hdf5Handle);
+  const hid_t dataspace = H5Dget_space(dataset);
+
+  selectValues(dataspace, mStart, mStride, mDimensions);
+
   const hssize_t numVals = H5Sget_select_npoints(dataspace);
+  if(numVals != static_cast<hssize_t>(numValues)) {
+    std::stringstream errOut;
+    errOut << "Number of values in hdf5 dataset (" << numVals;
+    errOut << ")\ndoes not match size of memory (" << numValues << ").";
+    XdmfError::message(XdmfError::FATAL,
+                       errOut.str());
+  }
+
+  const std::vector<hsize_t> count(mDimensions.begin(), mDimensions.end());
   hid_t memspace = H5Screate_simple(mDimensions.size(),
                                     &count[0],
                                     NULL);
 
-  /* status = H5Sselect_hyperslab(memspace,
-     H5S_SELECT_SET,
-     &memStart[0],
-     &memStride[0],
-     &memCount[0],
-     NULL);*/
-
-  hid_t datatype = H5T_NO_CLASS;
-  bool closeDatatype = false;
-  if(mType == XdmfArrayType::Int8()) {
-    datatype = H5T_NATIVE_CHAR;
-  }
-  else if(mType == XdmfArrayType::Int16()) {
-    datatype = H5T_NATIVE_SHORT;
-  }
-  else if(mType == XdmfArrayType::Int32()) {
-    datatype = H5T_NATIVE_INT;
-  }
-  else if(mType == XdmfArrayType::Int64()) {
-    datatype = H5T_NATIVE_LONG;
+  // hdf5 converts from the file type to the memory type while reading
+  bool closeDatatype;
+  const hid_t datatype = getNativeType(valuesType, closeDatatype);
+
+  const herr_t status = H5Dread(dataset,
+                                datatype,
+                                memspace,
+                                dataspace,
+                                H5P_DEFAULT,
+                                valuesPointer);
+
+  H5Sclose(dataspace);
+  H5Sclose(memspace);
+  closeDataSet(dataset, hdf5Handle, mMaxOpenedFiles);
+
+  if(status < 0) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error reading hdf5 dataset in "
+                       "XdmfHDF5Controller::read");
   }
-  else if(mType == XdmfArrayType::Float32()) {
-    datatype = H5T_NATIVE_FLOAT;
+}
+
+void
+XdmfHDF5Controller::read(XdmfArray * const array,
+                         const unsigned int start,
+                         const unsigned int stride,
+                         const unsigned int count)
+{
+  this->read(array, start, stride, count, H5P_DEFAULT);
+}
+
+void
+XdmfHDF5Controller::read(XdmfArray * const array,
+                         const unsigned int start,
+                         const unsigned int stride,
+                         const unsigned int count,
+                         const int fapl)
+{
+  if(stride == 0 ||
+     (count > 0 && start + (count - 1) * stride >= this->getSize())) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Window out of range of data set in "
+                       "XdmfHDF5Controller::read");
   }
-  else if(mType == XdmfArrayType::Float64()) {
-    datatype = H5T_NATIVE_DOUBLE;
+
+  array->initialize(mType, std::vector<unsigned int>(1, count));
+  if(count == 0) {
+    return;
   }
-  else if(mType == XdmfArrayType::UInt8()) {
-    datatype = H5T_NATIVE_UCHAR;
+
+  hid_t hdf5Handle;
+  const hid_t dataset = openDataSet(mFilePath,
+                                    mDataSetPath,
+                                    fapl,
+                                    mMaxOpenedFiles,
+                                    hdf5Handle);
+  const hid_t dataspace = H5Dget_space(dataset);
+  const unsigned int rank = H5Sget_simple_extent_ndims(dataspace);
+
+  // The window is given in the row major order of the values selected
+  // by this controller. Map it to coordinates in the data set.
+  std::vector<hsize_t> dims(mDimensions.begin(), mDimensions.end());
+  std::vector<hsize_t> fileStart(mStart.begin(), mStart.end());
+  std::vector<hsize_t> fileStride(mStride.begin(), mStride.end());
+  if(rank == 1 && mStart.size() == 1 && mDimensions.size() != 1) {
+    // A packed array, the window is taken from its run of values
+    dims = std::vector<hsize_t>(1, this->getSize());
   }
-  else if(mType == XdmfArrayType::UInt16()) {
-    datatype = H5T_NATIVE_USHORT;
+  else if(rank != mDimensions.size()) {
+    // Same special case as a full read, the whole data set is used
+    dims.resize(rank);
+    H5Sget_simple_extent_dims(dataspace, &dims[0], NULL);
+    fileStart = std::vector<hsize_t>(rank, 0);
+    fileStride = std::vector<hsize_t>(rank, 1);
   }
-  else if(mType == XdmfArrayType::UInt32()) {
-    datatype = H5T_NATIVE_UINT;
+
+  if(rank == 1) {
+    const hsize_t windowStart = fileStart[0] + start * fileStride[0];
+    const hsize_t windowStride = stride * fileStride[0];
+    const hsize_t windowCount = count;
+    H5Sselect_hyperslab(dataspace,
+                        H5S_SELECT_SET,
+                        &windowStart,
+                        &windowStride,
+                        &windowCount,
+                        NULL);
   }
-  else if(mType == XdmfArrayType::String()) {
-    datatype = H5Tcopy(H5T_C_S1);
-    H5Tset_size(datatype, H5T_VARIABLE);
-    closeDatatype = true;
+  else if(stride == 1) {
+    bool firstSelection = true;
+    std::vector<hsize_t> coords(rank, 0);
+    selectRange(dataspace, firstSelection, dims, fileStart, fileStride,
+                coords, 0, start, static_cast<hsize_t>(start) + count);
   }
   else {
-    XdmfError::message(XdmfError::FATAL,
-                       "Unknown XdmfArrayType encountered in hdf5 "
-                       "controller.");
+    // A strided window over several dimensions is not a hyperslab,
+    // select the individual points instead
+    std::vector<hsize_t> points(count * rank);
+    for(unsigned int i = 0; i < count; ++i) {
+      hsize_t index = start + static_cast<hsize_t>(i) * stride;
+      for(unsigned int j = rank; j > 0; --j) {
+        points[i * rank + j - 1] =
+          fileStart[j - 1] + (index % dims[j - 1]) * fileStride[j - 1];
+        index /= dims[j - 1];
+      }
+    }
+    H5Sselect_elements(dataspace, H5S_SELECT_SET, count, &points[0]);
   }
 
-  array->initialize(mType, mDimensions);
+  const hsize_t memCount = count;
+  const hid_t memspace = H5Screate_simple(1, &memCount, NULL);
+
+  bool closeDatatype;
+  const hid_t datatype = getNativeType(mType, closeDatatype);
 
-  if(numVals != array->getSize()) {
-    std::stringstream errOut;
-    errOut << "Number of values in hdf5 dataset (" << numVals;
-    errOut << ")\ndoes not match allocated size in XdmfArray (" << array->getSize() << ").";
-    XdmfError::message(XdmfError::FATAL,
-                       errOut.str());
-  }
   if(closeDatatype) {
-    char ** data = new char*[numVals];
-    status = H5Dread(dataset,
-                     datatype,
-                     memspace,
-                     dataspace,
-                     H5P_DEFAULT,
-                     data);
-    for(hssize_t i=0; i<numVals; ++i) {
+    std::vector<char *> data(count);
+    H5Dread(dataset,
+            datatype,
+            memspace,
+            dataspace,
+            H5P_DEFAULT,
+            &data[0]);
+    for(unsigned int i = 0; i < count; ++i) {
       array->insert<std::string>(i, data[i]);
     }
-    status = H5Dvlen_reclaim(datatype,
-                             dataspace,
-                             H5P_DEFAULT,
-                             data);
-    delete [] data;
+    H5Dvlen_reclaim(datatype,
+                    memspace,
+                    H5P_DEFAULT,
+                    &data[0]);
+    H5Tclose(datatype);
   }
   else {
-    status = H5Dread(dataset,
-                     datatype,
-                     memspace,
-                     dataspace,
-                     H5P_DEFAULT,
-                     array->getValuesInternal());
+    H5Dread(dataset,
+            datatype,
+            memspace,
+            dataspace,
+            H5P_DEFAULT,
+            array->getValuesInternal());
   }
 
-  status = H5Sclose(dataspace);
-  status = H5Sclose(memspace);
-  status = H5Dclose(dataset);
-  if(closeDatatype) {
-    status = H5Tclose(datatype);
+  H5Sclose(dataspace);
+  H5Sclose(memspace);
+  closeDataSet(dataset, hdf5Handle, mMaxOpenedFiles);
+}
+
+void
+XdmfHDF5Controller::readArrays(const std::vector<shared_ptr<XdmfArray> > & arrays)
+{
+  // Runs of values in one dimensional data sets, keyed by file and data set
+  std::map<std::pair<std::string, std::string>, std::vector<PackedRun> > runs;
+  for(unsigned int i = 0; i < arrays.size(); ++i) {
+    XdmfArray * const array = arrays[i].get();
+    shared_ptr<XdmfHDF5Controller> controller;
+    if(array->getReadMode() == XdmfArray::Controller &&
+       array->getNumberHeavyDataControllers() == 1 &&
+       array->getHeavyDataController(0)->getArrayOffset() == 0) {
+      controller =
+        shared_dynamic_cast<XdmfHDF5Controller>(array->getHeavyDataController(0));
+    }
+    // Subclasses read through their own file access properties
+    if(controller &&
+       controller->getName().compare("HDF") == 0 &&
+       controller->getType() != XdmfArrayType::String() &&
+       controller->getStart().size() == 1 &&
+       controller->getStride()[0] == 1) {
+      runs[std::make_pair(controller->getFilePath(),
+                          controller->getDataSetPath())].push_back(
+        PackedRun(controller, array));
+    }
+    else {
+      array->read();
+    }
   }
-  if (XdmfHDF5Controller::mMaxOpenedFiles == 0) {
-    status = H5Fclose(hdf5Handle);
+
+  for(std::map<std::pair<std::string, std::string>,
+               std::vector<PackedRun> >::iterator iter = runs.begin();
+      iter != runs.end();
+      ++iter) {
+    std::vector<PackedRun> & dataSetRuns = iter->second;
+    std::sort(dataSetRuns.begin(), dataSetRuns.end(), compareRunStart);
+
+    unsigned int first = 0;
+    while(first < dataSetRuns.size()) {
+      // Extend the read while the next array starts where this one ends
+      const shared_ptr<const XdmfArrayType> type =
+        dataSetRuns[first].first->getType();
+      hsize_t readEnd =
+        dataSetRuns[first].first->getStart()[0] +
+        dataSetRuns[first].first->getSize();
+      unsigned int last = first + 1;
+      while(last < dataSetRuns.size() &&
+            dataSetRuns[last].first->getType() == type &&
+            dataSetRuns[last].first->getStart()[0] == readEnd) {
+        readEnd += dataSetRuns[last].first->getSize();
+        ++last;
+      }
+
+      if(last - first == 1) {
+        dataSetRuns[first].second->read();
+        first = last;
+        continue;
+      }
+
+      hid_t hdf5Handle;
+      const hid_t dataset = openDataSet(iter->first.first,
+                                        iter->first.second,
+                                        H5P_DEFAULT,
+                                        mMaxOpenedFiles,
+                                        hdf5Handle);
+      const hid_t dataspace = H5Dget_space(dataset);
+      if(H5Sget_simple_extent_ndims(dataspace) != 1) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Data set " + iter->first.second + " is not one "
+                           "dimensional in XdmfHDF5Controller::readArrays");
+      }
+
+      const hsize_t readStart = dataSetRuns[first].first->getStart()[0];
+      const hsize_t readCount = readEnd - readStart;
+      H5Sselect_hyperslab(dataspace,
+                          H5S_SELECT_SET,
+                          &readStart,
+                          NULL,
+                          &readCount,
+                          NULL);
+      const hid_t memspace = H5Screate_simple(1, &readCount, NULL);
+
+      bool closeDatatype;
+      const hid_t datatype = getNativeType(type, closeDatatype);
+      const unsigned int elementSize = type->getElementSize();
+      std::vector<char> values(readCount * elementSize);
+      const herr_t status = H5Dread(dataset,
+                                    datatype,
+                                    memspace,
+                                    dataspace,
+                                    H5P_DEFAULT,
+                                    &values[0]);
+      H5Sclose(memspace);
+      H5Sclose(dataspace);
+      closeDataSet(dataset, hdf5Handle, mMaxOpenedFiles);
+
+      if(status < 0) {
+        XdmfError::message(XdmfError::FATAL,
+                           "H5Dread returned failure in "
+                           "XdmfHDF5Controller::readArrays");
+      }
+
+      // Hand each array its part of the values
+      hsize_t offset = 0;
+      for(unsigned int i = first; i < last; ++i) {
+        XdmfArray * const array = dataSetRuns[i].second;
+        array->initialize(type, dataSetRuns[i].first->getDimensions());
+        std::memcpy(array->getValuesInternal(),
+                    &values[offset * elementSize],
+                    array->getSize() * elementSize);
+        offset += array->getSize();
+      }
+
+      first = last;
+    }
   }
 }
 
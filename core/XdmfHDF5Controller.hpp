@@ -261,6 +261,122 @@ public:
 
   virtual void read(XdmfArray * const array);
 
+  /**
+   * Read the data set into the passed XdmfArray, letting hdf5 convert
+   * the values to readType while reading. Only the converted values
+   * are allocated. String data sets can only be read as strings.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Controller.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#readconvert
+   * @until //#readconvert
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Controller.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//readconvert
+   * @until #//readconvert
+   *
+   * @param     array           An XdmfArray to read data into.
+   * @param     readType        The array type to store the values as.
+   */
+  virtual void read(XdmfArray * const array,
+                    const shared_ptr<const XdmfArrayType> & readType);
+
+  /**
+   * Read a window of the values owned by this controller into the
+   * passed XdmfArray. The window is taken over the values in row
+   * major order and covers indices start, start + stride, ...
+   * start + (count - 1) * stride. Only the selected values are read
+   * from the hdf5 file. When files are kept open (see
+   * setMaxOpenedFiles) the data set stays open between windows.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Controller.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#readwindow
+   * @until //#readwindow
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Controller.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//readwindow
+   * @until #//readwindow
+   *
+   * @param     array   An XdmfArray to read data into.
+   * @param     start   The index of the first value to read.
+   * @param     stride  The distance between values to read.
+   * @param     count   The number of values to read.
+   */
+  virtual void read(XdmfArray * const array,
+                    const unsigned int start,
+                    const unsigned int stride,
+                    const unsigned int count);
+
+  /**
+   * Read the values owned by this controller directly into memory
+   * supplied by the caller. hdf5 converts from the type on disk to
+   * valuesType while reading, so no intermediate XdmfArray is
+   * allocated. String data sets can not be read into memory.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Controller.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#readbuffer
+   * @until //#readbuffer
+   *
+   * Python: does not support reading into a pointer
+   *
+   * @param     valuesPointer   A pointer to the memory to read into.
+   * @param     valuesType      The array type of the values in memory.
+   * @param     numValues       The number of values the memory holds.
+   */
+  virtual void read(void * const valuesPointer,
+                    const shared_ptr<const XdmfArrayType> & valuesType,
+                    const unsigned int numValues);
+
+  /**
+   * Read several arrays, coalescing arrays whose values lie next to
+   * each other in the same one dimensional data set into a single
+   * hdf5 read. This is the layout XdmfHDF5Writer produces when
+   * packing small arrays (see XdmfHDF5Writer::setPackSize). Arrays
+   * that can not be coalesced are read on their own.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Controller.cpp
+   * @skipline //#readArrays
+   * @until //#readArrays
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Controller.py
+   * @skipline #//readArrays
+   * @until #//readArrays
+   *
+   * @param     arrays  The XdmfArrays to read data into.
+   */
+  static void readArrays(const std::vector<shared_ptr<XdmfArray> > & arrays);
+
   /**
    * Sets the maximum number of hdf5 files that are allowed to be open at once.
    *
@@ -294,12 +410,26 @@ protected:
 
   void read(XdmfArray * const array, const int fapl);
 
+  void read(XdmfArray * const array,
+            const shared_ptr<const XdmfArrayType> & readType,
+            const int fapl);
+
+  void read(XdmfArray * const array,
+            const unsigned int start,
+            const unsigned int stride,
+            const unsigned int count,
+            const int fapl);
+
+  void read(void * const valuesPointer,
+            const shared_ptr<const XdmfArrayType> & valuesType,
+            const unsigned int numValues,
+            const int fapl);
+
 private:
 
   XdmfHDF5Controller(const XdmfHDF5Controller &);  // Not implemented.
   void operator=(const XdmfHDF5Controller &);  // Not implemented.
 
-  static std::map<std::string, unsigned int> mOpenFileUsage;
   // When set to 0 there will be no files that stay open after a read
   static unsigned int mMaxOpenedFiles;
 
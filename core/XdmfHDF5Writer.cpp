@@ -23,11 +23,18 @@
 
 #include <H5public.h>
 #include <hdf5.h>
+#include <algorithm>
 #include <sstream>
+#include <fstream>
 #include <cstdio>
+#include <cstdlib>
 #include <cmath>
 #include <set>
 #include <list>
+#include <map>
+#include <cstring>
+#include <limits>
+#include <numeric>
 #include "XdmfItem.hpp"
 #include "XdmfArray.hpp"
 #include "XdmfArrayType.hpp"
@@ -39,6 +46,104 @@ namespace {
 
   const static unsigned int DEFAULT_CHUNK_SIZE = 1000;
 
+  // Bytes of packed values buffered for a pool before they are written
+  const static unsigned int PACK_BUFFER_SIZE = 8 * 1024 * 1024;
+
+  // Bytes a new data set adds to a file on top of its chunks: the
+  // object header, the chunk index and the link to it. Measured with
+  // HDF5 1.10, see TestXdmfHDF5WriterSplitting.
+  const static unsigned int DATASET_OVERHEAD = 2500;
+
+  // MurmurHash64A, a fast non-cryptographic hash of the values of an
+  // array used to find arrays that were written before
+  unsigned long long
+  hashValues(const void * values,
+             const size_t length)
+  {
+    const unsigned long long m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+    unsigned long long h = length * m;
+
+    const unsigned char * data = static_cast<const unsigned char *>(values);
+    const size_t numBlocks = length / 8;
+    for(size_t i = 0; i < numBlocks; ++i) {
+      unsigned long long k;
+      std::memcpy(&k, data + i * 8, 8);
+      k *= m;
+      k ^= k >> r;
+      k *= m;
+      h ^= k;
+      h *= m;
+    }
+
+    // The last length % 8 bytes, mixed in as one little endian word
+    const unsigned char * tail = data + numBlocks * 8;
+    const size_t tailLength = length & 7;
+    if(tailLength > 0) {
+      for(size_t i = 0; i < tailLength; ++i) {
+        h ^= (unsigned long long)tail[i] << (8 * i);
+      }
+      h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+  }
+
+  void
+  writeVector(std::ostream & stream,
+              const std::vector<unsigned int> & values)
+  {
+    for(unsigned int i = 0; i < values.size(); ++i) {
+      stream << (i > 0 ? " " : "") << values[i];
+    }
+  }
+
+  std::vector<unsigned int>
+  readVector(const std::string & text)
+  {
+    std::vector<unsigned int> values;
+    std::istringstream stream(text);
+    unsigned int value;
+    while(stream >> value) {
+      values.push_back(value);
+    }
+    return values;
+  }
+
+  // Root attribute holding the first free "Data<index>" of a file, so
+  // reopening it needs no scan of its names
+  const char * const FREE_DATA_SET_ID_ATTRIBUTE = "XdmfFreeDataSetId";
+
+  // Moves freeId past the index of a link named "Data<index>", returns
+  // whether it moved
+  bool
+  moveFreeDataSetId(const char * name,
+                    int & freeId)
+  {
+    if(std::strncmp(name, "Data", 4) == 0 && name[4] != '\0') {
+      char * end;
+      const long index = std::strtol(name + 4, &end, 10);
+      if(*end == '\0' && index >= freeId) {
+        freeId = index + 1;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  herr_t
+  findFreeDataSetId(hid_t,
+                    const char * name,
+                    const H5L_info_t *,
+                    void * freeId)
+  {
+    moveFreeDataSetId(name, *static_cast<int *>(freeId));
+    return 0;
+  }
+
 }
 
 /**
@@ -48,29 +153,115 @@ class XdmfHDF5Writer::XdmfHDF5WriterImpl  {
 
 public:
 
-  XdmfHDF5WriterImpl():
+  XdmfHDF5WriterImpl(const unsigned int fileOverhead):
     mHDF5Handle(-1),
     mChunkSize(DEFAULT_CHUNK_SIZE),
     mOpenFile(""),
-    mDepth(0)
+    mDepth(0),
+    mPackSize(0),
+    mFreeDataSetId(0),
+    mFreeDataSetIdChanged(false),
+    mCloseAfterVisit(false),
+    mStringType(-1),
+    mCreateProperty(-1),
+    mFileOverhead(fileOverhead),
+    mVirtualDataSets(false),
+    mDeduplicate(false),
+    mVerifyDuplicates(false),
+    mDuplicatesLoaded(false),
+    mDuplicateHits(0),
+    mDuplicateLookups(0)
   {
   };
 
   ~XdmfHDF5WriterImpl()
   {
     closeFile();
+    if(mStringType >= 0) {
+      H5Tclose(mStringType);
+    }
+    if(mCreateProperty >= 0) {
+      H5Pclose(mCreateProperty);
+    }
   };
 
   void
   closeFile()
   {
     if(mHDF5Handle >= 0) {
+      if(mFreeDataSetIdChanged) {
+        writeFreeDataSetId();
+      }
       /*herr_t status =*/H5Fclose(mHDF5Handle);
       mHDF5Handle = -1;
     }
     mOpenFile = "";
   };  
 
+  // Notes a data set created in the open file
+  void
+  addDataSetName(const std::string & dataSetPath)
+  {
+    if(moveFreeDataSetId(dataSetPath.c_str(), mFreeDataSetId)) {
+      mFreeDataSetIdChanged = true;
+    }
+  }
+
+  // First free index stored in the open file, or -1 if it has none or
+  // the file was written without updating it
+  int
+  readFreeDataSetId()
+  {
+    int freeId = -1;
+    if(H5Aexists(mHDF5Handle, FREE_DATA_SET_ID_ATTRIBUTE) > 0) {
+      const hid_t attribute = H5Aopen(mHDF5Handle,
+                                      FREE_DATA_SET_ID_ATTRIBUTE,
+                                      H5P_DEFAULT);
+      if(attribute < 0 ||
+         H5Aread(attribute, H5T_NATIVE_INT, &freeId) < 0) {
+        freeId = -1;
+      }
+      if(attribute >= 0) {
+        H5Aclose(attribute);
+      }
+    }
+    if(freeId >= 0) {
+      // A writer that kept counting from the stored index took it
+      std::stringstream freeName;
+      freeName << "Data" << freeId;
+      if(H5Lexists(mHDF5Handle, freeName.str().c_str(), H5P_DEFAULT) != 0) {
+        freeId = -1;
+      }
+    }
+    return freeId;
+  }
+
+  void
+  writeFreeDataSetId()
+  {
+    hid_t attribute;
+    if(H5Aexists(mHDF5Handle, FREE_DATA_SET_ID_ATTRIBUTE) > 0) {
+      attribute = H5Aopen(mHDF5Handle,
+                          FREE_DATA_SET_ID_ATTRIBUTE,
+                          H5P_DEFAULT);
+    }
+    else {
+      const hid_t dataspace = H5Screate(H5S_SCALAR);
+      attribute = H5Acreate(mHDF5Handle,
+                            FREE_DATA_SET_ID_ATTRIBUTE,
+                            H5T_NATIVE_INT,
+                            dataspace,
+                            H5P_DEFAULT,
+                            H5P_DEFAULT);
+      H5Sclose(dataspace);
+    }
+    if(attribute >= 0) {
+      H5Awrite(attribute, H5T_NATIVE_INT, &mFreeDataSetId);
+      H5Aclose(attribute);
+    }
+    mFreeDataSetIdChanged = false;
+  }
+
   int
   openFile(const std::string & filePath,
            const int fapl,
@@ -92,18 +283,27 @@ public:
 
 
     if(H5Fis_hdf5(filePath.c_str()) > 0) {
+      // The size on disk is taken before anything is added to it
+      getFileSize(filePath);
       mHDF5Handle = H5Fopen(filePath.c_str(), 
                             H5F_ACC_RDWR, 
                             fapl);
-      if(mDataSetId == 0) {
-        hsize_t numObjects;
-        /*herr_t status = */H5Gget_num_objs(mHDF5Handle,
-                                            &numObjects);
-        toReturn = numObjects;
-      }
-      else {
-        toReturn = mDataSetId;
+      mFreeDataSetId = readFreeDataSetId();
+      mFreeDataSetIdChanged = false;
+      if(mFreeDataSetId < 0) {
+        // Scan the names once so new data sets never have to probe
+        // for a free name, the result is stored when the file closes
+        int freeId = 0;
+        H5Literate(mHDF5Handle,
+                   H5_INDEX_NAME,
+                   H5_ITER_NATIVE,
+                   NULL,
+                   findFreeDataSetId,
+                   &freeId);
+        mFreeDataSetId = freeId;
+        mFreeDataSetIdChanged = true;
       }
+      toReturn = std::max(mDataSetId, mFreeDataSetId);
     }
     else {
       // This is where it currently fails
@@ -111,6 +311,9 @@ public:
                               H5F_ACC_TRUNC,
                               H5P_DEFAULT,
                               fapl);
+      mFreeDataSetId = 0;
+      mFreeDataSetIdChanged = true;
+      mFileSizes[filePath] = mFileOverhead;
     }
 
     // Restore previous error handler
@@ -120,11 +323,394 @@ public:
 
   }
 
+  // A one dimensional data set that small arrays of one type are
+  // appended to. Values are buffered until the pool is flushed.
+  struct XdmfHDF5Pool
+  {
+    XdmfHDF5Pool() :
+      mFilePath(""),
+      mDataSetPath(""),
+      mDatatype(-1),
+      mNumWritten(0),
+      mNumValues(0)
+    {
+    }
+
+    std::string mFilePath;
+    std::string mDataSetPath;
+    hid_t mDatatype;
+    hsize_t mNumWritten;  // Values already in the data set
+    hsize_t mNumValues;   // Values waiting in mValues
+    std::vector<char> mValues;
+  };
+
+  void
+  flushPool(XdmfHDF5Pool & pool)
+  {
+    if(pool.mNumValues == 0) {
+      return;
+    }
+
+    bool closeAfterWrite = false;
+    if(mOpenFile.compare(pool.mFilePath) != 0) {
+      if(mHDF5Handle < 0) {
+        closeAfterWrite = true;
+      }
+      openFile(pool.mFilePath, H5P_DEFAULT, 1);
+    }
+
+    herr_t status;
+    hid_t dataset;
+    const hsize_t newSize = pool.mNumWritten + pool.mNumValues;
+    if(pool.mNumWritten == 0) {
+      const hsize_t maximumSize = H5S_UNLIMITED;
+      const hid_t dataspace = H5Screate_simple(1, &newSize, &maximumSize);
+      const hsize_t chunkSize = mChunkSize > 0 ? mChunkSize : newSize;
+      addFileSize(pool.mFilePath,
+                  estimateDataSetSize(std::vector<hsize_t>(1, newSize),
+                                      std::vector<hsize_t>(1, chunkSize),
+                                      H5Tget_size(pool.mDatatype)));
+      status = H5Pset_chunk(getCreateProperty(), 1, &chunkSize);
+      dataset = H5Dcreate(mHDF5Handle,
+                          pool.mDataSetPath.c_str(),
+                          pool.mDatatype,
+                          dataspace,
+                          H5P_DEFAULT,
+                          mCreateProperty,
+                          H5P_DEFAULT);
+      addDataSetName(pool.mDataSetPath);
+      status = H5Sclose(dataspace);
+    }
+    else {
+      dataset = H5Dopen(mHDF5Handle,
+                        pool.mDataSetPath.c_str(),
+                        H5P_DEFAULT);
+      status = H5Dset_extent(dataset, &newSize);
+      addFileSize(pool.mFilePath,
+                  pool.mNumValues * H5Tget_size(pool.mDatatype));
+    }
+
+    // The buffered values go to the end of the pool in one write
+    const hid_t dataspace = H5Dget_space(dataset);
+    status = H5Sselect_hyperslab(dataspace,
+                                 H5S_SELECT_SET,
+                                 &pool.mNumWritten,
+                                 NULL,
+                                 &pool.mNumValues,
+                                 NULL);
+    const hid_t memspace = H5Screate_simple(1, &pool.mNumValues, NULL);
+    status = H5Dwrite(dataset,
+                      pool.mDatatype,
+                      memspace,
+                      dataspace,
+                      H5P_DEFAULT,
+                      &pool.mValues[0]);
+    H5Sclose(memspace);
+    H5Sclose(dataspace);
+    H5Dclose(dataset);
+
+    if(closeAfterWrite) {
+      closeFile();
+    }
+
+    if(status < 0) {
+      XdmfError::message(XdmfError::FATAL,
+                         "H5Dwrite returned failure when writing pool " +
+                         pool.mDataSetPath + " in XdmfHDF5Writer");
+    }
+
+    pool.mNumWritten = newSize;
+    pool.mNumValues = 0;
+    pool.mValues.clear();
+  }
+
+  void
+  addFileSize(const std::string & filePath,
+              const unsigned int bytes)
+  {
+    getFileSize(filePath) += bytes;
+  }
+
+  // Chunks are allocated whole, so a new data set takes every chunk
+  // its dimensions touch
+  static unsigned int
+  estimateDataSetSize(const std::vector<hsize_t> & dimensions,
+                      const std::vector<hsize_t> & chunkDimensions,
+                      const size_t valueSize)
+  {
+    hsize_t numChunks = 1;
+    hsize_t chunkValues = 1;
+    for(unsigned int i = 0; i < dimensions.size(); ++i) {
+      numChunks *= (dimensions[i] + chunkDimensions[i] - 1) / chunkDimensions[i];
+      chunkValues *= chunkDimensions[i];
+    }
+    return (unsigned int)(numChunks * chunkValues * valueSize) +
+      DATASET_OVERHEAD;
+  }
+
+  // The size of a file is read from disk once, afterwards the writes
+  // keep an estimate of it up to date
+  unsigned int &
+  getFileSize(const std::string & filePath)
+  {
+    std::map<std::string, unsigned int>::iterator fileSize =
+      mFileSizes.find(filePath);
+    if(fileSize == mFileSizes.end()) {
+      unsigned int diskSize = 0;
+      FILE * checkFile = fopen(filePath.c_str(), "rb");
+      if(checkFile != NULL) {
+        fseek(checkFile, 0, SEEK_END);
+        diskSize = ftell(checkFile);
+        fclose(checkFile);
+      }
+      fileSize = mFileSizes.insert(std::make_pair(filePath, diskSize)).first;
+    }
+    return fileSize->second;
+  }
+
+#if H5_VERSION_GE(1,10,0)
+  // Maps the pieces of a split array, in order, into a one dimensional
+  // virtual data set in the open file
+  void
+  createVirtualDataSet(const std::string & dataSetPath,
+                       const hid_t datatype,
+                       const std::vector<shared_ptr<XdmfHDF5Controller> > & pieces)
+  {
+    hsize_t size = 0;
+    for(unsigned int i = 0; i < pieces.size(); ++i) {
+      size += pieces[i]->getSize();
+    }
+
+    const hid_t virtualSpace = H5Screate_simple(1, &size, NULL);
+    const hid_t property = H5Pcreate(H5P_DATASET_CREATE);
+    herr_t status = 0;
+    for(unsigned int i = 0; i < pieces.size() && status >= 0; ++i) {
+      const hsize_t start = pieces[i]->getArrayOffset();
+      const hsize_t count = pieces[i]->getSize();
+      const std::vector<unsigned int> sourceDimensions =
+        pieces[i]->getDataspaceDimensions();
+      const std::vector<hsize_t> dimensions(sourceDimensions.begin(),
+                                            sourceDimensions.end());
+      const hid_t sourceSpace = H5Screate_simple(dimensions.size(),
+                                                 &dimensions[0],
+                                                 NULL);
+      status = H5Sselect_hyperslab(virtualSpace,
+                                   H5S_SELECT_SET,
+                                   &start,
+                                   NULL,
+                                   &count,
+                                   NULL);
+      if(status >= 0) {
+        status = H5Pset_virtual(property,
+                                virtualSpace,
+                                getSourceFileName(pieces[i]->getFilePath()).c_str(),
+                                pieces[i]->getDataSetPath().c_str(),
+                                sourceSpace);
+      }
+      H5Sclose(sourceSpace);
+    }
+    H5Sselect_all(virtualSpace);
+
+    hid_t dataset = -1;
+    if(status >= 0) {
+      dataset = H5Dcreate(mHDF5Handle,
+                          dataSetPath.c_str(),
+                          datatype,
+                          virtualSpace,
+                          H5P_DEFAULT,
+                          property,
+                          H5P_DEFAULT);
+      addDataSetName(dataSetPath);
+    }
+    H5Pclose(property);
+    H5Sclose(virtualSpace);
+
+    if(dataset < 0) {
+      XdmfError::message(XdmfError::FATAL,
+                         "H5Dcreate returned failure when writing virtual "
+                         "data set " + dataSetPath + " in XdmfHDF5Writer");
+    }
+    H5Dclose(dataset);
+    addFileSize(mOpenFile, DATASET_OVERHEAD);
+  }
+
+  // Source files are named relative to the open file, so the files of
+  // a split array can be moved together
+  std::string
+  getSourceFileName(const std::string & sourceFile) const
+  {
+    if(sourceFile.compare(mOpenFile) == 0) {
+      return ".";
+    }
+    const size_t directoryEnd = mOpenFile.find_last_of("/");
+    if(directoryEnd != std::string::npos &&
+       sourceFile.compare(0, directoryEnd + 1, mOpenFile, 0, directoryEnd + 1) == 0) {
+      return sourceFile.substr(directoryEnd + 1);
+    }
+    return sourceFile;
+  }
+#endif
+
+  // Where an array with some content was written. The index is keyed
+  // by the hash, type and dimensions of the array and is kept in a
+  // sidecar next to the hdf5 file, one tab separated line per entry.
+  struct XdmfHDF5Duplicate
+  {
+    std::string mFilePath;
+    std::string mDataSetPath;
+    std::vector<unsigned int> mStart;
+    std::vector<unsigned int> mStride;
+    std::vector<unsigned int> mDataspaceDimensions;
+  };
+
+  static std::string
+  getDuplicateKey(XdmfArray & array)
+  {
+    std::stringstream key;
+    key << std::hex
+        << hashValues(array.getValuesInternal(),
+                      array.getSize() * array.getArrayType()->getElementSize())
+        << std::dec << "\t" << array.getArrayType()->getName() << "\t"
+        << array.getArrayType()->getElementSize() << "\t";
+    writeVector(key, array.getDimensions());
+    return key.str();
+  }
+
+  void
+  addDuplicate(const std::string & key,
+               const shared_ptr<XdmfHDF5Controller> & controller)
+  {
+    XdmfHDF5Duplicate & duplicate = mDuplicates[key];
+    duplicate.mFilePath = controller->getFilePath();
+    duplicate.mDataSetPath = controller->getDataSetPath();
+    duplicate.mStart = controller->getStart();
+    duplicate.mStride = controller->getStride();
+    duplicate.mDataspaceDimensions = controller->getDataspaceDimensions();
+
+    std::stringstream line;
+    line << key << "\t" << duplicate.mFilePath << "\t"
+         << duplicate.mDataSetPath << "\t";
+    writeVector(line, duplicate.mStart);
+    line << "\t";
+    writeVector(line, duplicate.mStride);
+    line << "\t";
+    writeVector(line, duplicate.mDataspaceDimensions);
+    mNewDuplicates.push_back(line.str());
+  }
+
+  void
+  loadDuplicates(const std::string & duplicatesPath)
+  {
+    mDuplicatesPath = duplicatesPath;
+    mDuplicatesLoaded = true;
+    std::ifstream stream(duplicatesPath.c_str());
+    std::string line;
+    while(std::getline(stream, line)) {
+      std::vector<std::string> fields;
+      std::istringstream lineStream(line);
+      std::string field;
+      while(std::getline(lineStream, field, '\t')) {
+        fields.push_back(field);
+      }
+      if(fields.size() != 9) {
+        continue;
+      }
+      XdmfHDF5Duplicate & duplicate =
+        mDuplicates[fields[0] + "\t" + fields[1] + "\t" +
+                    fields[2] + "\t" + fields[3]];
+      duplicate.mFilePath = fields[4];
+      duplicate.mDataSetPath = fields[5];
+      duplicate.mStart = readVector(fields[6]);
+      duplicate.mStride = readVector(fields[7]);
+      duplicate.mDataspaceDimensions = readVector(fields[8]);
+    }
+  }
+
+  void
+  saveDuplicates()
+  {
+    if(mNewDuplicates.size() == 0) {
+      return;
+    }
+    std::ofstream stream(mDuplicatesPath.c_str(), std::ios::app);
+    for(unsigned int i = 0; i < mNewDuplicates.size(); ++i) {
+      stream << mNewDuplicates[i] << "\n";
+    }
+    mNewDuplicates.clear();
+  }
+
+  // Files opened by the writes of a visit stay open until it ends
+  void
+  endVisit()
+  {
+    if(mCloseAfterVisit) {
+      flushPools();
+      closeFile();
+      mCloseAfterVisit = false;
+    }
+    else if(mHDF5Handle < 0) {
+      // Packed values are held until the file is closed if it was opened
+      flushPools();
+    }
+  }
+
+  // The dataset creation property list is shared by all data sets,
+  // only the chunk size is set for each one
+  hid_t
+  getCreateProperty()
+  {
+    if(mCreateProperty < 0) {
+      mCreateProperty = H5Pcreate(H5P_DATASET_CREATE);
+    }
+    return mCreateProperty;
+  }
+
+  hid_t
+  getStringType()
+  {
+    if(mStringType < 0) {
+      mStringType = H5Tcopy(H5T_C_S1);
+      H5Tset_size(mStringType, H5T_VARIABLE);
+    }
+    return mStringType;
+  }
+
+  void
+  flushPools()
+  {
+    for(std::map<const XdmfArrayType *, XdmfHDF5Pool>::iterator iter =
+          mPools.begin();
+        iter != mPools.end();
+        ++iter) {
+      flushPool(iter->second);
+    }
+    // The index only names data that has been written
+    saveDuplicates();
+  }
+
   hid_t mHDF5Handle;
   unsigned int mChunkSize;
   std::string mOpenFile;
   int mDepth;
   std::set<const XdmfItem *> mWrittenItems;
+  unsigned int mPackSize;
+  std::map<const XdmfArrayType *, XdmfHDF5Pool> mPools;
+  int mFreeDataSetId;     // First free "Data<index>" in the open file
+  bool mFreeDataSetIdChanged;  // Not yet stored in the open file
+  bool mCloseAfterVisit;
+  hid_t mStringType;
+  hid_t mCreateProperty;
+  std::map<std::string, unsigned int> mFileSizes;  // Estimated bytes in each file
+  unsigned int mFileOverhead;
+  bool mVirtualDataSets;
+  bool mDeduplicate;
+  bool mVerifyDuplicates;
+  bool mDuplicatesLoaded;
+  std::string mDuplicatesPath;          // Sidecar holding the index
+  std::map<std::string, XdmfHDF5Duplicate> mDuplicates;
+  std::vector<std::string> mNewDuplicates;  // Lines not yet in the sidecar
+  unsigned int mDuplicateHits;
+  unsigned int mDuplicateLookups;
 };
 
 shared_ptr<XdmfHDF5Writer>
@@ -133,6 +719,8 @@ XdmfHDF5Writer::New(const std::string & filePath,
 {
   if(clobberFile) {
     std::remove(filePath.c_str());
+    // The index of written arrays describes the old file
+    std::remove((filePath + ".dedup").c_str());
   }
   shared_ptr<XdmfHDF5Writer> p(new XdmfHDF5Writer(filePath));
   return p;
@@ -140,18 +728,33 @@ XdmfHDF5Writer::New(const std::string & filePath,
 
 XdmfHDF5Writer::XdmfHDF5Writer(const std::string & filePath) :
   XdmfHeavyDataWriter(filePath, 1, 800),
-  mImpl(new XdmfHDF5WriterImpl())
+  mImpl(new XdmfHDF5WriterImpl(getFileOverhead()))
 {
 }
 
 XdmfHDF5Writer::~XdmfHDF5Writer()
 {
+  // Packed values still held are written, a failure can only be
+  // reported here, closeFile() throws it
+  try {
+    mImpl->flushPools();
+  }
+  catch (XdmfError & e) {
+    try {
+      XdmfError::message(XdmfError::WARNING,
+                         std::string("Packed arrays not written when "
+                                     "destroying XdmfHDF5Writer: ") +
+                         e.what());
+    }
+    catch (XdmfError &) {
+    }
+  }
   delete mImpl;
 }
 
 void
 XdmfHDF5Writer::controllerSplitting(XdmfArray & array,
-                                    const int & fapl,
+                                    const int & /*fapl*/,
                                     int & controllerIndexOffset,
                                     shared_ptr<XdmfHeavyDataController> heavyDataController,
                                     const std::string & checkFileName,
@@ -206,47 +809,41 @@ XdmfHDF5Writer::controllerSplitting(XdmfArray & array,
       else {
         testFile << checkFileName << getFileIndex() << "." << checkFileExt;
       }
-      FILE *checkFile = NULL;
-      unsigned int fileSize = 0;
       // If the file doesn't exist the size is 0 because there's no data
-      // Get the file stream
-      checkFile = fopen(testFile.str().c_str(), "a");
-      if (checkFile != NULL) {
-        // Set the file pointer to end of file
-        fseek(checkFile, 0, SEEK_END);
-        // Get the file size, in bytes
-        fileSize = ftell(checkFile);
-
-        // If overwrite subtract previous data size.
-        if (mMode == Overwrite || mMode == Hyperslab) {
-          // Find previous data size
-          int checkfilesize = getDataSetSize(testFile.str(), dataSetPath, fapl);
-          if (checkfilesize < 0) {
-            checkfilesize = 0;
-          }
-          unsigned int checksize = (unsigned int)checkfilesize;
-          if (mMode == Overwrite) {
-            if (checksize > fileSize) {
-              fileSize = 0;
-            }
-            else {
-              fileSize = fileSize - checksize;
-              // Remove previous set's size, since it's overwritten
-            }
-            if (fileSize == 0) {
-              fileSize += getFileOverhead();
-            }
+      // The size is kept in memory after the file is first seen
+      unsigned int fileSize = mImpl->getFileSize(testFile.str());
+
+      // If overwrite subtract previous data size.
+      if (mMode == Overwrite || mMode == Hyperslab) {
+        // Find previous data size, the controller of the array
+        // describes the data set if it is in this file
+        unsigned int checksize = 0;
+        shared_ptr<XdmfHDF5Controller> previousController =
+          shared_dynamic_cast<XdmfHDF5Controller>(heavyDataController);
+        if (previousController &&
+            previousController->getFilePath() == testFile.str() &&
+            previousController->getDataSetPath() == dataSetPath) {
+          const std::vector<unsigned int> previousDataspace =
+            previousController->getDataspaceDimensions();
+          checksize = std::accumulate(previousDataspace.begin(),
+                                      previousDataspace.end(),
+                                      1,
+                                      std::multiplies<unsigned int>());
+        }
+        if (mMode == Overwrite) {
+          if (checksize > fileSize) {
+            fileSize = 0;
           }
-          else if (mMode == Hyperslab) {
-            hyperslabSize = checksize;
+          else {
+            fileSize = fileSize - checksize;
+            // Remove previous set's size, since it's overwritten
           }
         }
-        if (fileSize == 0) {
-          fileSize += getFileOverhead();
+        else if (mMode == Hyperslab) {
+          hyperslabSize = checksize;
         }
-        fclose(checkFile);
       }
-      else if (previousDataSize == 0) {
+      if (fileSize == 0) {
         fileSize += getFileOverhead();
       }
 
@@ -324,6 +921,15 @@ XdmfHDF5Writer::controllerSplitting(XdmfArray & array,
                          mCompressionRatio);
         // If remaining size is less than available space, just write all of what's left
         remainingSize = remainingValues * dataItemSize;
+        if (mMode == Default) {
+          // A new data set takes whole chunks and adds its own overhead
+          const hsize_t chunkSize =
+            mImpl->mChunkSize > 0 ? mImpl->mChunkSize : remainingValues;
+          remainingSize =
+            mImpl->estimateDataSetSize(std::vector<hsize_t>(1, remainingValues),
+                                       std::vector<hsize_t>(1, chunkSize),
+                                       dataItemSize);
+        }
       }
       if (remainingSize + previousDataSize + fileSize
           < (unsigned int)getFileSizeLimit()*(1024*1024)) {
@@ -938,12 +1544,51 @@ XdmfHDF5Writer::createController(const shared_ptr<XdmfHeavyDataController> & ref
   }
 }
 
+void
+XdmfHDF5Writer::flush()
+{
+  mImpl->flushPools();
+  if(mImpl->mHDF5Handle >= 0) {
+    H5Fflush(mImpl->mHDF5Handle, H5F_SCOPE_LOCAL);
+  }
+}
+
 unsigned int
 XdmfHDF5Writer::getChunkSize() const
 {
   return mImpl->mChunkSize;
 }
 
+unsigned int
+XdmfHDF5Writer::getPackSize() const
+{
+  return mImpl->mPackSize;
+}
+
+bool
+XdmfHDF5Writer::getDeduplicate() const
+{
+  return mImpl->mDeduplicate;
+}
+
+unsigned int
+XdmfHDF5Writer::getDuplicateHits() const
+{
+  return mImpl->mDuplicateHits;
+}
+
+unsigned int
+XdmfHDF5Writer::getDuplicateLookups() const
+{
+  return mImpl->mDuplicateLookups;
+}
+
+bool
+XdmfHDF5Writer::getVirtualDataSets() const
+{
+  return mImpl->mVirtualDataSets;
+}
+
 int
 XdmfHDF5Writer::getDataSetSize(const std::string & fileName, const std::string & dataSetName, const int fapl)
 {
@@ -994,6 +1639,7 @@ XdmfHDF5Writer::getDataSetSize(const std::string & fileName, const std::string &
 void 
 XdmfHDF5Writer::closeFile()
 {
+  mImpl->flushPools();
   mImpl->closeFile();
 }
 
@@ -1017,6 +1663,26 @@ XdmfHDF5Writer::setChunkSize(const unsigned int chunkSize)
   mImpl->mChunkSize = chunkSize;
 }
 
+void
+XdmfHDF5Writer::setPackSize(const unsigned int packSize)
+{
+  mImpl->mPackSize = packSize;
+}
+
+void
+XdmfHDF5Writer::setDeduplicate(const bool deduplicate,
+                               const bool verify)
+{
+  mImpl->mDeduplicate = deduplicate;
+  mImpl->mVerifyDuplicates = verify;
+}
+
+void
+XdmfHDF5Writer::setVirtualDataSets(const bool virtualDataSets)
+{
+  mImpl->mVirtualDataSets = virtualDataSets;
+}
+
 void
 XdmfHDF5Writer::visit(XdmfArray & array,
                       const shared_ptr<XdmfBaseVisitor> visitor)
@@ -1036,6 +1702,7 @@ XdmfHDF5Writer::visit(XdmfArray & array,
   mImpl->mDepth--;
   if(mImpl->mDepth <= 0) {
     mImpl->mWrittenItems.clear();
+    mImpl->endVisit();
   }
 }
 
@@ -1056,6 +1723,7 @@ XdmfHDF5Writer::visit(XdmfItem & item,
   mImpl->mDepth--;
   if(mImpl->mDepth <= 0) {
     mImpl->mWrittenItems.clear();
+    mImpl->endVisit();
   }
 }
 
@@ -1065,7 +1733,6 @@ XdmfHDF5Writer::write(XdmfArray & array,
                       const int fapl)
 {
   hid_t datatype = -1;
-  bool closeDatatype = false;
 
   // Determining data type
   if(array.isInitialized()) {
@@ -1098,9 +1765,7 @@ XdmfHDF5Writer::write(XdmfArray & array,
     }
     else if(array.getArrayType() == XdmfArrayType::String()) {
       // Strings are a special case as they have mutable size
-      datatype = H5Tcopy(H5T_C_S1);
-      H5Tset_size(datatype, H5T_VARIABLE);
-      closeDatatype = true;
+      datatype = mImpl->getStringType();
     }
     else {
       XdmfError::message(XdmfError::FATAL,
@@ -1142,6 +1807,138 @@ XdmfHDF5Writer::write(XdmfArray & array,
       array.removeHeavyDataController(array.getNumberHeavyDataControllers() -1);
     }
 
+    std::string duplicateKey;
+    if(mImpl->mDeduplicate &&
+       mMode == Default &&
+       fapl == H5P_DEFAULT &&
+       array.getArrayType() != XdmfArrayType::String() &&
+       array.getSize() > 0) {
+      // Arrays with the same content share the data set written first
+      if(!mImpl->mDuplicatesLoaded) {
+        mImpl->loadDuplicates(mFilePath + ".dedup");
+      }
+      ++mImpl->mDuplicateLookups;
+      duplicateKey = XdmfHDF5WriterImpl::getDuplicateKey(array);
+      std::map<std::string, XdmfHDF5WriterImpl::XdmfHDF5Duplicate>::const_iterator
+        duplicate = mImpl->mDuplicates.find(duplicateKey);
+      if(duplicate != mImpl->mDuplicates.end()) {
+        shared_ptr<XdmfHeavyDataController> duplicateController =
+          this->createController(duplicate->second.mFilePath,
+                                 duplicate->second.mDataSetPath,
+                                 array.getArrayType(),
+                                 duplicate->second.mStart,
+                                 duplicate->second.mStride,
+                                 array.getDimensions(),
+                                 duplicate->second.mDataspaceDimensions);
+        bool matches = true;
+        if(mImpl->mVerifyDuplicates) {
+          // Compare with the values on disk before sharing them
+          mImpl->flushPools();
+          try {
+            shared_ptr<XdmfArray> storedArray = XdmfArray::New();
+            storedArray->insert(duplicateController);
+            storedArray->read();
+            matches = storedArray->getSize() == array.getSize() &&
+              std::memcmp(storedArray->getValuesInternal(),
+                          array.getValuesInternal(),
+                          array.getSize() *
+                          array.getArrayType()->getElementSize()) == 0;
+          }
+          catch(XdmfError &) {
+            matches = false;
+          }
+        }
+        if(matches) {
+          ++mImpl->mDuplicateHits;
+          array.insert(duplicateController);
+          if(mReleaseData) {
+            array.release();
+          }
+          return;
+        }
+      }
+    }
+
+    if(mImpl->mPackSize > 0 &&
+       mMode == Default &&
+       fapl == H5P_DEFAULT &&
+       array.getArrayType() != XdmfArrayType::String() &&
+       array.getSize() > 0 &&
+       array.getSize() <= mImpl->mPackSize) {
+      // Small arrays are appended to the pool for their type
+      std::stringstream packFile;
+      if (getFileIndex() == 0) {
+        packFile << checkFileName << "." << checkFileExt;
+      }
+      else {
+        packFile << checkFileName << getFileIndex() << "." << checkFileExt;
+      }
+
+      XdmfHDF5WriterImpl::XdmfHDF5Pool & pool =
+        mImpl->mPools[array.getArrayType().get()];
+      const hsize_t poolEnd = pool.mNumWritten + pool.mNumValues;
+      if(pool.mFilePath.compare(packFile.str()) != 0 ||
+         poolEnd + array.getSize() > std::numeric_limits<unsigned int>::max()) {
+        // Start a new pool, its data set is created by the first flush
+        mImpl->flushPool(pool);
+        bool closeFile = false;
+        if (mImpl->mOpenFile.compare(packFile.str()) != 0) {
+          if(mImpl->mHDF5Handle < 0) {
+            closeFile = true;
+          }
+          mImpl->openFile(packFile.str(),
+                          fapl, mDataSetId);
+        }
+        // No name from the first free index of the file on is taken
+        mDataSetId = std::max(mDataSetId, mImpl->mFreeDataSetId);
+        dataSetPath.str(std::string());
+        dataSetPath << "Data" << mDataSetId;
+        mImpl->mFreeDataSetId = ++mDataSetId;
+        if(closeFile) {
+          if(mImpl->mDepth > 0) {
+            mImpl->mCloseAfterVisit = true;
+          }
+          else {
+            mImpl->closeFile();
+          }
+        }
+        pool.mFilePath = packFile.str();
+        pool.mDataSetPath = dataSetPath.str();
+        pool.mDatatype = datatype;
+        pool.mNumWritten = 0;
+      }
+
+      const unsigned int poolStart = pool.mNumWritten + pool.mNumValues;
+      const char * values = static_cast<char *>(array.getValuesInternal());
+      pool.mValues.insert(pool.mValues.end(),
+                          values,
+                          values + array.getSize() *
+                                   array.getArrayType()->getElementSize());
+      pool.mNumValues += array.getSize();
+
+      // The array is a run of values in the one dimensional pool
+      array.insert(this->createController(pool.mFilePath,
+                                          pool.mDataSetPath,
+                                          array.getArrayType(),
+                                          std::vector<unsigned int>(1, poolStart),
+                                          std::vector<unsigned int>(1, 1),
+                                          array.getDimensions(),
+                                          std::vector<unsigned int>(1, poolStart + array.getSize())));
+      if(!duplicateKey.empty()) {
+        mImpl->addDuplicate(duplicateKey,
+                            shared_dynamic_cast<XdmfHDF5Controller>(array.getHeavyDataController(0)));
+      }
+
+      if(pool.mValues.size() >= PACK_BUFFER_SIZE) {
+        mImpl->flushPool(pool);
+      }
+
+      if(mReleaseData) {
+        array.release();
+      }
+      return;
+    }
+
 
 
     if (previousControllers.size() == 0) {
@@ -1299,6 +2096,13 @@ XdmfHDF5Writer::write(XdmfArray & array,
                           fapl, mDataSetId);
         }
 
+        if(mMode == Default && mDataSetId < mImpl->mFreeDataSetId) {
+          // Names before the first free index of the file are taken
+          mDataSetId = mImpl->mFreeDataSetId;
+          dataSetPath.str(std::string());
+          dataSetPath << "Data" << mDataSetId;
+        }
+
 	htri_t testingSet = H5Lexists(mImpl->mHDF5Handle,
                                       dataSetPath.str().c_str(),
                                       H5P_DEFAULT);
@@ -1340,6 +2144,11 @@ XdmfHDF5Writer::write(XdmfArray & array,
         std::vector<hsize_t> current_dims(curDataSize.begin(),
                                           curDataSize.end());
 
+        // Bytes the write adds to the file, for splitting
+        unsigned int addedSize = 0;
+        const bool newDataSet = dataset < 0;
+        hssize_t previousPoints = 0;
+
         if(dataset < 0) {
           // If the dataset doesn't contain anything
 
@@ -1348,7 +2157,7 @@ XdmfHDF5Writer::write(XdmfArray & array,
           dataspace = H5Screate_simple(current_dims.size(),
                                        &current_dims[0],
                                        &maximum_dims[0]);
-          hid_t property = H5Pcreate(H5P_DATASET_CREATE);
+          const hid_t property = mImpl->getCreateProperty();
 
           const hsize_t totalDimensionsSize =
             std::accumulate(current_dims.begin(),
@@ -1374,6 +2183,9 @@ XdmfHDF5Writer::write(XdmfArray & array,
           }
 
           status = H5Pset_chunk(property, current_dims.size(), &chunk_size[0]);
+          addedSize = mImpl->estimateDataSetSize(current_dims,
+                                                 chunk_size,
+                                                 H5Tget_size(datatype));
           // Use that dataspace to create a new dataset
           dataset = H5Dcreate(mImpl->mHDF5Handle,
                               dataSetPath.str().c_str(),
@@ -1382,7 +2194,7 @@ XdmfHDF5Writer::write(XdmfArray & array,
                               H5P_DEFAULT,
                               property,
                               H5P_DEFAULT);
-          status = H5Pclose(property);
+          mImpl->addDataSetName(dataSetPath.str());
         }
 
         if(mMode == Append) {
@@ -1391,6 +2203,7 @@ XdmfHDF5Writer::write(XdmfArray & array,
           // Get size of old dataset
           dataspace = H5Dget_space(dataset);
           hssize_t datasize = H5Sget_simple_extent_npoints(dataspace);
+          previousPoints = datasize;
           status = H5Sclose(dataspace);
 
           // Reset the datasize if the file or set is different
@@ -1440,6 +2253,7 @@ XdmfHDF5Writer::write(XdmfArray & array,
                                "XdmfHDF5Writer::write");
           }
 
+          previousPoints = H5Sget_simple_extent_npoints(dataspace);
           status = H5Dset_extent(dataset, &current_dims[0]);
           dataspace = H5Dget_space(dataset);
         }
@@ -1454,6 +2268,7 @@ XdmfHDF5Writer::write(XdmfArray & array,
                                "current_dims.size() -- in "
                                "XdmfHDF5Writer::write");
           }
+          previousPoints = H5Sget_simple_extent_npoints(dataspace);
           status = H5Dset_extent(dataset, &current_dims[0]);
           dataspace = H5Dget_space(dataset);
 
@@ -1484,6 +2299,14 @@ XdmfHDF5Writer::write(XdmfArray & array,
           }
         }
 
+        if(!newDataSet && dataspace != H5S_ALL) {
+          // Only growing a data set adds to the file
+          const hssize_t points = H5Sget_simple_extent_npoints(dataspace);
+          if(points > previousPoints) {
+            addedSize = (points - previousPoints) * H5Tget_size(datatype);
+          }
+        }
+
         status = H5Dwrite(dataset,
                           datatype,
                           memspace,
@@ -1497,6 +2320,8 @@ XdmfHDF5Writer::write(XdmfArray & array,
                              "-- status: " + status);
         }
 
+        mImpl->addFileSize(curFileName, addedSize);
+
         if(dataspace != H5S_ALL) {
           status = H5Sclose(dataspace);
         }
@@ -1507,9 +2332,14 @@ XdmfHDF5Writer::write(XdmfArray & array,
 
         status = H5Dclose(dataset);
 
-	// This is causing a lot of overhead
         if(closeFile) {
-          mImpl->closeFile();
+          if(fapl == H5P_DEFAULT && mImpl->mDepth > 0) {
+            // Keep the file for the rest of the visit
+            mImpl->mCloseAfterVisit = true;
+          }
+          else {
+            mImpl->closeFile();
+          }
         }
 
         if(mMode == Default) {
@@ -1585,8 +2415,67 @@ XdmfHDF5Writer::write(XdmfArray & array,
 
     }
 
-    if(closeDatatype) {
-      status = H5Tclose(datatype);
+#if H5_VERSION_GE(1,10,0)
+    if(mImpl->mVirtualDataSets &&
+       mMode == Default &&
+       fapl == H5P_DEFAULT &&
+       array.getArrayType() != XdmfArrayType::String() &&
+       array.getNumberHeavyDataControllers() > 1) {
+      // The pieces of a split array are read through one data set
+      std::vector<shared_ptr<XdmfHDF5Controller> > pieces;
+      for(unsigned int i = 0; i < array.getNumberHeavyDataControllers(); ++i) {
+        pieces.push_back(shared_dynamic_cast<XdmfHDF5Controller>(array.getHeavyDataController(i)));
+      }
+
+      // The last file written is the one with room left
+      const std::string virtualFile = pieces.back()->getFilePath();
+      bool closeFile = false;
+      if(mImpl->mOpenFile.compare(virtualFile) != 0) {
+        if(mImpl->mHDF5Handle < 0) {
+          closeFile = true;
+        }
+        mImpl->openFile(virtualFile,
+                        fapl, mDataSetId);
+      }
+      mDataSetId = std::max(mDataSetId, mImpl->mFreeDataSetId);
+      dataSetPath.str(std::string());
+      dataSetPath << "Data" << mDataSetId;
+      while(H5Lexists(mImpl->mHDF5Handle,
+                      dataSetPath.str().c_str(),
+                      H5P_DEFAULT) > 0) {
+        dataSetPath.str(std::string());
+        dataSetPath << "Data" << ++mDataSetId;
+      }
+      ++mDataSetId;
+
+      mImpl->createVirtualDataSet(dataSetPath.str(), datatype, pieces);
+
+      if(closeFile) {
+        if(mImpl->mDepth > 0) {
+          mImpl->mCloseAfterVisit = true;
+        }
+        else {
+          mImpl->closeFile();
+        }
+      }
+
+      while(array.getNumberHeavyDataControllers() != 0) {
+        array.removeHeavyDataController(array.getNumberHeavyDataControllers() -1);
+      }
+      array.insert(this->createController(virtualFile,
+                                          dataSetPath.str(),
+                                          array.getArrayType(),
+                                          std::vector<unsigned int>(1, 0),
+                                          std::vector<unsigned int>(1, 1),
+                                          array.getDimensions(),
+                                          std::vector<unsigned int>(1, array.getSize())));
+    }
+#endif
+
+    if(!duplicateKey.empty() &&
+       array.getNumberHeavyDataControllers() == 1) {
+      mImpl->addDuplicate(duplicateKey,
+                          shared_dynamic_cast<XdmfHDF5Controller>(array.getHeavyDataController(0)));
     }
 
     if(mReleaseData) {
@@ -48,6 +48,28 @@ class XdmfHDF5Controller;
  *
  * This writer supports all heavy data writing modes listed in
  * XdmfHeavyDataWriter.
+ *
+ * In Default mode small arrays can be packed into a few shared data
+ * sets instead of each getting a data set of its own, see
+ * setPackSize().
+ *
+ * The hdf5 file is kept open between openFile() and closeFile(), so
+ * many visits can write into one session; flush() makes the written
+ * data visible without closing. Without openFile() the file is opened
+ * once for each visit. The first free data set name is stored in an
+ * XdmfFreeDataSetId attribute of the file when it is closed, so
+ * opening it again does not scan its names. Files without the
+ * attribute, or written by others since, are scanned once.
+ *
+ * With a file size limit the size of each file is read from disk the
+ * first time the file is used and estimated from the data sets
+ * written afterwards, counting whole chunks and the overhead of each
+ * data set. Arrays split across files can be mapped back into one
+ * data set, see setVirtualDataSets().
+ *
+ * Arrays holding the same values as an array already written can
+ * share its data set instead of being written again, see
+ * setDeduplicate().
  */
 class XDMFCORE_EXPORT XdmfHDF5Writer : public XdmfHeavyDataWriter {
 
@@ -83,6 +105,31 @@ public:
 
   virtual void closeFile();
 
+  /**
+   * Write any buffered values and flush the hdf5 file to disk, keeping
+   * it open. This lets other processes see a file that is held open
+   * with openFile() across many writes.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Writer.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#flush
+   * @until //#flush
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Writer.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//flush
+   * @until #//flush
+   */
+  void flush();
+
   /**
    * Get the chunk size used to output datasets to hdf5.
    *
@@ -106,6 +153,127 @@ public:
    */
   unsigned int getChunkSize() const;
 
+  /**
+   * Get whether arrays with the same content as an array written
+   * before share its data set.
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Writer.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#getDeduplicate
+   * @until //#getDeduplicate
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Writer.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//getDeduplicate
+   * @until #//getDeduplicate
+   *
+   * @return    True if arrays are deduplicated.
+   */
+  bool getDeduplicate() const;
+
+  /**
+   * Get the number of arrays that were given the data set of an
+   * array with the same content instead of being written.
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Writer.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#getDuplicateHits
+   * @until //#getDuplicateHits
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Writer.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//getDuplicateHits
+   * @until #//getDuplicateHits
+   *
+   * @return    The number of deduplicated arrays.
+   */
+  unsigned int getDuplicateHits() const;
+
+  /**
+   * Get the number of arrays looked up in the index of written
+   * arrays. Divide getDuplicateHits() by it for the hit rate.
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Writer.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#getDuplicateLookups
+   * @until //#getDuplicateLookups
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Writer.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//getDuplicateLookups
+   * @until #//getDuplicateLookups
+   *
+   * @return    The number of arrays looked up.
+   */
+  unsigned int getDuplicateLookups() const;
+
+  /**
+   * Get the largest number of values an array may hold to be packed
+   * into a shared data set.
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Writer.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#getPackSize
+   * @until //#getPackSize
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Writer.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//getPackSize
+   * @until #//getPackSize
+   *
+   * @return    The largest number of values of a packed array, 0 if
+   *            packing is off.
+   */
+  unsigned int getPackSize() const;
+
+  /**
+   * Get whether arrays split across files are also written as one
+   * virtual data set.
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Writer.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#getVirtualDataSets
+   * @until //#getVirtualDataSets
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Writer.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//getVirtualDataSets
+   * @until #//getVirtualDataSets
+   *
+   * @return    True if split arrays get a virtual data set.
+   */
+  bool getVirtualDataSets() const;
+
   virtual void openFile();
 
   /**
@@ -133,6 +301,126 @@ public:
    */
   void setChunkSize(const unsigned int chunkSize);
 
+  /**
+   * Set whether arrays with the same content as an array written
+   * before share its data set. Off by default.
+   *
+   * In Default mode the values of each numeric array are hashed. If an
+   * array of the same type, dimensions and hash was written before,
+   * the array is given a controller for the existing data set and
+   * nothing is written. This keeps static geometry and topology that
+   * is rebuilt every time step from being written again.
+   *
+   * The index of written arrays is kept in a sidecar named after the
+   * hdf5 file with ".dedup" appended, so later writers to the same
+   * files find the arrays written by earlier ones. Clobbering the file
+   * removes the sidecar. With verify the values in the data set are
+   * read and compared before they are shared, otherwise equal hashes
+   * are trusted. Arrays sharing a data set should not be written in
+   * Overwrite or Hyperslab mode afterwards.
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Writer.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#setDeduplicate
+   * @until //#setDeduplicate
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Writer.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//setDeduplicate
+   * @until #//setDeduplicate
+   *
+   * @param     deduplicate     Whether arrays are deduplicated.
+   * @param     verify          Whether values are compared before a data
+   *                            set is shared.
+   */
+  void setDeduplicate(const bool deduplicate,
+                      const bool verify = false);
+
+  /**
+   * Set the largest number of values an array may hold to be packed
+   * into a shared data set. Packing is off by default.
+   *
+   * In Default mode numeric arrays holding at most packSize values
+   * are appended to one pool data set per type instead of getting a
+   * data set of their own. Each array is given an XdmfHDF5Controller
+   * selecting its values in the pool. The values are buffered and
+   * written to the pool in large contiguous writes when the buffer
+   * fills and when the file is closed, or at the end of the write if
+   * the file was not opened with openFile(). Packed arrays are not
+   * split across files. Arrays written through a file access property
+   * list, as the DSM writer does, are not packed. Values still held
+   * when the writer is destroyed are written then, but a failure is
+   * only reported, call closeFile() to have it thrown.
+   *
+   * XdmfWriter describes a packed array as an ItemType="HyperSlab"
+   * DataItem selecting its values in the pool.
+   *
+   * Packed arrays that are next to each other in a pool can be read
+   * back together with XdmfHDF5Controller::readArrays().
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Writer.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#setPackSize
+   * @until //#setPackSize
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Writer.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//setPackSize
+   * @until #//setPackSize
+   *
+   * @param     packSize        The largest number of values of a packed
+   *                            array, 0 to turn packing off.
+   */
+  void setPackSize(const unsigned int packSize);
+
+  /**
+   * Set whether arrays split across files are also written as one
+   * virtual data set. Off by default.
+   *
+   * When a file size limit splits an array in Default mode the pieces
+   * are written as usual, then a one dimensional hdf5 virtual data set
+   * mapping all of them in order is added to the file of the last
+   * piece. The array is given a single XdmfHDF5Controller for the
+   * virtual data set instead of one for each piece, so it is read with
+   * one H5Dread and written to light data as one data item. The pieces
+   * are named relative to the file holding the virtual data set.
+   *
+   * Virtual data sets need hdf5 1.10 or later, with older versions
+   * the pieces are kept. String arrays and arrays written through a
+   * file access property list are not mapped.
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHDF5Writer.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#setVirtualDataSets
+   * @until //#setVirtualDataSets
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHDF5Writer.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//setVirtualDataSets
+   * @until #//setVirtualDataSets
+   *
+   * @param     virtualDataSets Whether split arrays get a virtual data set.
+   */
+  void setVirtualDataSets(const bool virtualDataSets);
+
   using XdmfHeavyDataWriter::visit;
   virtual void visit(XdmfArray & array,
                      const shared_ptr<XdmfBaseVisitor> visitor);
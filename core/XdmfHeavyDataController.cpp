@@ -21,8 +21,10 @@
 /*                                                                           */
 /*****************************************************************************/
 
+#include <cstring>
 #include <functional>
 #include <numeric>
+#include "XdmfArray.hpp"
 #include "XdmfArrayType.hpp"
 #include "XdmfError.hpp"
 #include "XdmfHeavyDataController.hpp"
@@ -75,6 +77,60 @@ XdmfHeavyDataController::getType() const
   return mType;
 }
 
+void
+XdmfHeavyDataController::read(XdmfArray * const array,
+                              const shared_ptr<const XdmfArrayType> & readType)
+{
+  if(!readType || readType == mType) {
+    this->read(array);
+    return;
+  }
+  shared_ptr<XdmfArray> tempArray = XdmfArray::New();
+  this->read(tempArray.get());
+  array->initialize(readType, mDimensions);
+  array->insert(0, tempArray, 0, tempArray->getSize(), 1, 1);
+}
+
+void
+XdmfHeavyDataController::read(XdmfArray * const array,
+                              const unsigned int start,
+                              const unsigned int stride,
+                              const unsigned int count)
+{
+  if(stride == 0 ||
+     (count > 0 && start + (count - 1) * stride >= this->getSize())) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Window out of range of heavy data set in "
+                       "XdmfHeavyDataController::read");
+  }
+  shared_ptr<XdmfArray> tempArray = XdmfArray::New();
+  this->read(tempArray.get());
+  array->initialize(mType, std::vector<unsigned int>(1, count));
+  array->insert(0, tempArray, start, count, 1, stride);
+}
+
+void
+XdmfHeavyDataController::read(void * const valuesPointer,
+                              const shared_ptr<const XdmfArrayType> & valuesType,
+                              const unsigned int numValues)
+{
+  if(numValues != this->getSize()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Number of values in memory does not match size of "
+                       "heavy data set in XdmfHeavyDataController::read");
+  }
+  if(valuesType->getElementSize() == 0) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Cannot read variable size type into memory in "
+                       "XdmfHeavyDataController::read");
+  }
+  shared_ptr<XdmfArray> tempArray = XdmfArray::New();
+  this->read(tempArray.get(), valuesType);
+  std::memcpy(valuesPointer,
+              tempArray->getValuesInternal(),
+              numValues * valuesType->getElementSize());
+}
+
 void
 XdmfHeavyDataController::setArrayOffset(unsigned int newOffset)
 {
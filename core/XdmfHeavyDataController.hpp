@@ -290,6 +290,103 @@ public:
    */
   virtual void read(XdmfArray * const array) = 0;
 
+  /**
+   * Read data owned by this controller on disk into the passed
+   * XdmfArray, converting the values to the requested array type.
+   * The array is initialized with readType rather than the type of
+   * the heavy data set, so reading wide data into a narrower type
+   * does not require holding a copy of the wide values. The default
+   * implementation reads the data in its stored type and converts
+   * it afterwards, formats that can convert while reading override
+   * this.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHeavyDataController.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#readconvert
+   * @until //#readconvert
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHeavyDataController.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//readconvert
+   * @until #//readconvert
+   *
+   * @param     array           An XdmfArray to read data into.
+   * @param     readType        The array type to store the values as.
+   */
+  virtual void read(XdmfArray * const array,
+                    const shared_ptr<const XdmfArrayType> & readType);
+
+  /**
+   * Read a window of the values owned by this controller into the
+   * passed XdmfArray. The window is taken over the values in row
+   * major order and covers indices start, start + stride, ...
+   * start + (count - 1) * stride. The array is initialized as a one
+   * dimensional array of count values. The default implementation
+   * reads all values and copies the window out, formats that can
+   * seek override this to read only the selected values.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHeavyDataController.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#readwindow
+   * @until //#readwindow
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleHeavyDataController.py
+   * @skipline #//initialization
+   * @until #//initialization
+   * @skipline #//readwindow
+   * @until #//readwindow
+   *
+   * @param     array   An XdmfArray to read data into.
+   * @param     start   The index of the first value to read.
+   * @param     stride  The distance between values to read.
+   * @param     count   The number of values to read.
+   */
+  virtual void read(XdmfArray * const array,
+                    const unsigned int start,
+                    const unsigned int stride,
+                    const unsigned int count);
+
+  /**
+   * Read data owned by this controller on disk into memory supplied
+   * by the caller. No XdmfArray storage is allocated for formats that
+   * can read directly into the buffer. The buffer must hold exactly
+   * as many values as this controller owns, stored as valuesType.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfHeavyDataController.cpp
+   * @skipline //#initialization
+   * @until //#initialization
+   * @skipline //#readbuffer
+   * @until //#readbuffer
+   *
+   * Python: does not support reading into a pointer
+   *
+   * @param     valuesPointer   A pointer to the memory to read into.
+   * @param     valuesType      The array type of the values in memory.
+   * @param     numValues       The number of values the memory holds.
+   */
+  virtual void read(void * const valuesPointer,
+                    const shared_ptr<const XdmfArrayType> & valuesType,
+                    const unsigned int numValues);
+
 protected:
 
   XdmfHeavyDataController(const std::string & filePath,
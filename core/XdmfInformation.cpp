@@ -130,6 +130,7 @@ XdmfInformation::populateItem(const std::map<std::string, std::string> & itemPro
 void
 XdmfInformation::setKey(const std::string & key)
 {
+  XdmfItemNameIndex::nameChanged(this, mKey, key);
   mKey = key;
 }
 
@@ -21,9 +21,137 @@
 /*                                                                           */
 /*****************************************************************************/
 
+#include <algorithm>
+#include <boost/unordered_map.hpp>
 #include "XdmfInformation.hpp"
 #include "XdmfItem.hpp"
 
+struct XdmfItemNameIndex::XdmfItemNameMap {
+  // Children sharing a name are all kept, the first is returned
+  boost::unordered_multimap<std::string, unsigned int> mIndices;
+};
+
+XdmfItemNameIndex::XdmfItemNameIndex() :
+  mSize(0),
+  mVersion(0)
+{
+}
+
+XdmfItemNameIndex::XdmfItemNameIndex(const XdmfItemNameIndex &) :
+  mSize(0),
+  mVersion(0)
+{
+}
+
+XdmfItemNameIndex::~XdmfItemNameIndex()
+{
+}
+
+XdmfItemNameIndex &
+XdmfItemNameIndex::operator=(const XdmfItemNameIndex &)
+{
+  // Built again for the children copied with it
+  this->clear();
+  return *this;
+}
+
+void
+XdmfItemNameIndex::add(const std::string & name,
+                       const unsigned int index)
+{
+  mNames->mIndices.insert(std::make_pair(name, index));
+}
+
+void
+XdmfItemNameIndex::addIndexed(XdmfItem * const child,
+                              const shared_ptr<XdmfItemNameMap> & names,
+                              const unsigned int index)
+{
+  // Indices dropped since are forgotten
+  std::vector<std::pair<boost::weak_ptr<XdmfItemNameMap>, unsigned int> > &
+    nameIndices = child->mNameIndices;
+  for(unsigned int i = 0; i < nameIndices.size();) {
+    if(nameIndices[i].first.expired()) {
+      nameIndices[i] = nameIndices.back();
+      nameIndices.pop_back();
+    }
+    else {
+      ++i;
+    }
+  }
+  nameIndices.push_back(std::make_pair(boost::weak_ptr<XdmfItemNameMap>(names),
+                                       index));
+}
+
+void
+XdmfItemNameIndex::clear()
+{
+  mNames.reset();
+  ++mVersion;
+}
+
+unsigned int
+XdmfItemNameIndex::getVersion() const
+{
+  return mVersion;
+}
+
+bool
+XdmfItemNameIndex::lookup(const std::string & name,
+                          unsigned int & index) const
+{
+  std::pair<boost::unordered_multimap<std::string, unsigned int>::const_iterator,
+            boost::unordered_multimap<std::string, unsigned int>::const_iterator>
+    range = mNames->mIndices.equal_range(name);
+  if(range.first == range.second) {
+    return false;
+  }
+  index = range.first->second;
+  for(++range.first; range.first != range.second; ++range.first) {
+    index = std::min(index, range.first->second);
+  }
+  return true;
+}
+
+void
+XdmfItemNameIndex::nameChanged(XdmfItem * const item,
+                               const std::string & oldName,
+                               const std::string & newName)
+{
+  std::vector<std::pair<boost::weak_ptr<XdmfItemNameMap>, unsigned int> > &
+    nameIndices = item->mNameIndices;
+  for(unsigned int i = 0; i < nameIndices.size();) {
+    const shared_ptr<XdmfItemNameMap> names = nameIndices[i].first.lock();
+    if(!names) {
+      nameIndices[i] = nameIndices.back();
+      nameIndices.pop_back();
+      continue;
+    }
+    const unsigned int index = nameIndices[i].second;
+    std::pair<boost::unordered_multimap<std::string, unsigned int>::iterator,
+              boost::unordered_multimap<std::string, unsigned int>::iterator>
+      range = names->mIndices.equal_range(oldName);
+    for(; range.first != range.second; ++range.first) {
+      if(range.first->second == index) {
+        names->mIndices.erase(range.first);
+        break;
+      }
+    }
+    names->mIndices.insert(std::make_pair(newName, index));
+    ++i;
+  }
+}
+
+void
+XdmfItemNameIndex::start(const unsigned int size)
+{
+  ++mVersion;
+  // A new map, so that the children forget the old one
+  mNames.reset(new XdmfItemNameMap());
+  mNames->mIndices.rehash(size);
+  mSize = size;
+}
+
 XDMF_CHILDREN_IMPLEMENTATION(XdmfItem, XdmfInformation, Information, Key)
 
 XdmfItem::XdmfItem()
@@ -27,6 +27,7 @@
 // Forward Declarations
 class XdmfCoreReader;
 class XdmfInformation;
+class XdmfItem;
 class XdmfVisitor;
 
 // Includes
@@ -35,9 +36,170 @@ class XdmfVisitor;
 #include <map>
 #include <string>
 #include <vector>
+#include <boost/weak_ptr.hpp>
 #include "XdmfCore.hpp"
 #include "XdmfSharedPtr.hpp"
 
+/**
+ * @brief Hashed index from the names of the children of an item to
+ * their positions.
+ *
+ * Used by XDMF_CHILDREN to find children by name. Children are
+ * searched linearly until there are enough of them to be worth
+ * hashing. From then on the index is kept up to date as children are
+ * inserted, built again when children are removed, and told by each
+ * indexed child when it is renamed, so that renaming a child only
+ * updates the indices it is in. A search returns the first child with
+ * the name, as a linear search would.
+ *
+ * Searches only read the index, so items may be searched from several
+ * threads as long as none of them changes the children or renames
+ * one.
+ */
+class XDMFCORE_EXPORT XdmfItemNameIndex {
+
+public:
+
+  XdmfItemNameIndex();
+  XdmfItemNameIndex(const XdmfItemNameIndex &);
+  ~XdmfItemNameIndex();
+  XdmfItemNameIndex & operator=(const XdmfItemNameIndex &);
+
+  /**
+   * Drop the index. Children are searched linearly until the next
+   * insert builds it again.
+   */
+  void clear();
+
+  /**
+   * Find the first child with a name.
+   *
+   * @param     children        The children of the item.
+   * @param     getName         The function returning a child's name.
+   * @param     name            The name to search for.
+   *
+   * @return                    The index of the child, the number of
+   *                            children if none has the name.
+   */
+  template <typename T, typename U>
+  unsigned int find(const std::vector<shared_ptr<T> > & children,
+                    std::string (U::*getName)() const,
+                    const std::string & name) const
+  {
+    const unsigned int size = children.size();
+    unsigned int index;
+    if(size >= MinimumSize && mNames && mSize == size) {
+      if(!this->lookup(name, index)) {
+        return size;
+      }
+      // Children changed without passing through the index are caught here
+      if((children[index].get()->*getName)().compare(name) == 0) {
+        return index;
+      }
+    }
+    for(unsigned int i = 0; i < size; ++i) {
+      if(children[i] && (children[i].get()->*getName)().compare(name) == 0) {
+        return i;
+      }
+    }
+    return size;
+  }
+
+  /**
+   * Get the number of times children were inserted or the index was
+   * dropped or built, so that other indices of the children can tell
+   * when they are out of date.
+   *
+   * @return    The number of changes.
+   */
+  unsigned int getVersion() const;
+
+  /**
+   * Add the last child inserted to the index.
+   *
+   * @param     children        The children of the item.
+   * @param     getName         The function returning a child's name.
+   */
+  template <typename T, typename U>
+  void insert(const std::vector<shared_ptr<T> > & children,
+              std::string (U::*getName)() const)
+  {
+    const unsigned int size = children.size();
+    if(children.back() && mNames && mSize == size - 1) {
+      ++mVersion;
+      this->add((children.back().get()->*getName)(), size - 1);
+      addIndexed(children.back().get(), mNames, size - 1);
+      mSize = size;
+    }
+    else {
+      this->rebuild(children, getName);
+    }
+  }
+
+  /**
+   * Called by an item before its name changes, so that the indices it
+   * is in find it by the new name.
+   *
+   * @param     item            The item renamed.
+   * @param     oldName         The name of the item.
+   * @param     newName         The name the item gets.
+   */
+  static void nameChanged(XdmfItem * const item,
+                          const std::string & oldName,
+                          const std::string & newName);
+
+  /**
+   * Index the children again, after children were removed.
+   *
+   * @param     children        The children of the item.
+   * @param     getName         The function returning a child's name.
+   */
+  template <typename T, typename U>
+  void rebuild(const std::vector<shared_ptr<T> > & children,
+               std::string (U::*getName)() const)
+  {
+    const unsigned int size = children.size();
+    if(size < MinimumSize) {
+      this->clear();
+      return;
+    }
+    this->start(size);
+    for(unsigned int i = 0; i < size; ++i) {
+      if(children[i]) {
+        this->add((children[i].get()->*getName)(), i);
+        addIndexed(children[i].get(), mNames, i);
+      }
+    }
+  }
+
+private:
+
+  friend class XdmfItem;
+
+  // Fewer children than this are searched linearly
+  static const unsigned int MinimumSize = 16;
+
+  struct XdmfItemNameMap;
+
+  // Tells a child the position it is indexed at
+  static void addIndexed(XdmfItem * const child,
+                         const shared_ptr<XdmfItemNameMap> & names,
+                         const unsigned int index);
+  // Children that are not XdmfItems are not renamed
+  static void addIndexed(const void * const,
+                         const shared_ptr<XdmfItemNameMap> &,
+                         const unsigned int) {}
+
+  void add(const std::string & name, const unsigned int index);
+  bool lookup(const std::string & name, unsigned int & index) const;
+  void start(const unsigned int size);
+
+  shared_ptr<XdmfItemNameMap> mNames;
+  unsigned int mSize;
+  unsigned int mVersion;
+
+};
+
 // Macro that allows children XdmfItems to be attached to a parent XdmfItem.
 // -- For Header File
 #define XDMF_CHILDREN(ParentClass, ChildClass, ChildName, SearchName)         \
@@ -186,6 +348,7 @@ public:                                                                       \
 protected :                                                                   \
                                                                               \
   std::vector<shared_ptr<ChildClass> > m##ChildName##s;                       \
+  XdmfItemNameIndex m##ChildName##Index;                                      \
                                                                               \
 public :
 
@@ -222,15 +385,8 @@ public :
   shared_ptr<const ChildClass>                                                \
   ParentClass::get##ChildName(const std::string & SearchName) const           \
   {                                                                           \
-    for(std::vector<shared_ptr<ChildClass> >::const_iterator iter =           \
-          m##ChildName##s.begin();                                            \
-        iter != m##ChildName##s.end();                                        \
-        ++iter) {                                                             \
-      if((*iter)->get##SearchName().compare(SearchName) == 0) {               \
-        return *iter;                                                         \
-      }                                                                       \
-    }                                                                         \
-    return shared_ptr<ChildClass>();                                          \
+    return this->get##ChildName(m##ChildName##Index.find(                     \
+      m##ChildName##s, &ChildClass::get##SearchName, SearchName));            \
   }                                                                           \
                                                                               \
   unsigned int                                                                \
@@ -243,6 +399,8 @@ public :
   ParentClass::insert(const shared_ptr<ChildClass> ChildName)                 \
   {                                                                           \
     m##ChildName##s.push_back(ChildName);                                     \
+    m##ChildName##Index.insert(m##ChildName##s,                               \
+                               &ChildClass::get##SearchName);                 \
   }                                                                           \
                                                                               \
   void                                                                        \
@@ -250,21 +408,16 @@ public :
   {                                                                           \
     if(index < m##ChildName##s.size()) {                                      \
       m##ChildName##s.erase(m##ChildName##s.begin() + index);                 \
+      m##ChildName##Index.rebuild(m##ChildName##s,                            \
+                                  &ChildClass::get##SearchName);              \
     }                                                                         \
   }                                                                           \
                                                                               \
   void                                                                        \
   ParentClass::remove##ChildName(const std::string & SearchName)              \
   {                                                                           \
-    for(std::vector<shared_ptr<ChildClass> >::iterator iter =                 \
-          m##ChildName##s.begin();                                            \
-        iter != m##ChildName##s.end();                                        \
-        ++iter) {                                                             \
-        if((*iter)->get##SearchName().compare(SearchName) == 0) {             \
-          m##ChildName##s.erase(iter);                                        \
-          return;                                                             \
-        }                                                                     \
-    }                                                                         \
+    this->remove##ChildName(m##ChildName##Index.find(                         \
+      m##ChildName##s, &ChildClass::get##SearchName, SearchName));            \
   }
 
 /**
@@ -284,6 +437,7 @@ public:
   LOKI_DEFINE_VISITABLE_BASE()
   XDMF_CHILDREN(XdmfItem, XdmfInformation, Information, Key)
   friend class XdmfCoreReader;
+  friend class XdmfItemNameIndex;
 
   /**
    * Get the tag for this item.  This is equivalent to tags in XML
@@ -387,6 +541,10 @@ private:
   XdmfItem(const XdmfItem &);  // Not implemented.
   void operator=(const XdmfItem &);  // Not implemented.
 
+  // Name indices the item is in and its position in each
+  std::vector<std::pair<boost::weak_ptr<XdmfItemNameIndex::XdmfItemNameMap>,
+                        unsigned int> > mNameIndices;
+
 };
 
 #endif /* XDMFITEM_HPP_ */
@@ -219,6 +219,7 @@ XdmfSparseMatrix::setColumnIndex(const shared_ptr<XdmfArray> columnIndex)
 void
 XdmfSparseMatrix::setName(const std::string & name)
 {
+  XdmfItemNameIndex::nameChanged(this, mName, name);
   mName = name;
 }
 
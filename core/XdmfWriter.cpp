@@ -37,6 +37,101 @@
 #include "XdmfError.hpp"
 #include "string.h"
 
+namespace {
+
+  // Marks where appended items go in the XML file, it holds the
+  // xpath of the append target and the number of its children
+  const std::string APPEND_MARKER = "<!--XdmfAppend ";
+
+  // Xpath of an element, counting the elements before it at each level
+  std::string
+  getElementPath(xmlNodePtr node)
+  {
+    std::string path;
+    for(; node->parent && node->parent->type == XML_ELEMENT_NODE;
+        node = node->parent) {
+      unsigned int index = 1;
+      for(xmlNodePtr sibling = node->prev; sibling; sibling = sibling->prev) {
+        if(sibling->type == XML_ELEMENT_NODE) {
+          ++index;
+        }
+      }
+      std::stringstream level;
+      level << "/" << index;
+      path = level.str() + path;
+    }
+    return path;
+  }
+
+  // Values selected from a one dimensional data set, or arrays of
+  // higher rank stored in one as XdmfHDF5Writer packs them, are
+  // described as a HyperSlab of the data set
+  shared_ptr<XdmfHDF5Controller>
+  getHyperSlabController(XdmfArray & array)
+  {
+    if(array.getNumberHeavyDataControllers() == 1) {
+      shared_ptr<XdmfHDF5Controller> controller =
+        shared_dynamic_cast<XdmfHDF5Controller>(array.getHeavyDataController(0));
+      if(controller &&
+         controller->getDataspaceDimensions().size() == 1 &&
+         controller->getStart().size() == 1 &&
+         (controller->getStart()[0] != 0 ||
+          controller->getStride()[0] != 1 ||
+          controller->getSize() != controller->getDataspaceDimensions()[0] ||
+          controller->getDimensions().size() != 1)) {
+        return controller;
+      }
+    }
+    return shared_ptr<XdmfHDF5Controller>();
+  }
+
+  // Turns a DataItem into a HyperSlab holding the selection and the
+  // data set it selects from
+  void
+  writeHyperSlab(xmlNodePtr dataItem,
+                 const shared_ptr<XdmfHDF5Controller> & controller,
+                 const std::string & dataSetText)
+  {
+    std::stringstream selectionStream;
+    selectionStream << controller->getStart()[0] << " "
+                    << controller->getStride()[0] << " "
+                    << controller->getSize();
+    xmlNodePtr selectionItem =
+      xmlNewTextChild(dataItem,
+                      NULL,
+                      (xmlChar*)"DataItem",
+                      (xmlChar*)selectionStream.str().c_str());
+    xmlNewProp(selectionItem, (xmlChar*)"Dimensions", (xmlChar*)"3 1");
+    xmlNewProp(selectionItem, (xmlChar*)"Format", (xmlChar*)"XML");
+    xmlNewProp(selectionItem, (xmlChar*)"NumberType", (xmlChar*)"UInt");
+    xmlNewProp(selectionItem, (xmlChar*)"Precision", (xmlChar*)"4");
+
+    std::stringstream dimensionStream;
+    dimensionStream << controller->getDataspaceDimensions()[0];
+    xmlNodePtr dataSetItem =
+      xmlNewTextChild(dataItem,
+                      NULL,
+                      (xmlChar*)"DataItem",
+                      (xmlChar*)dataSetText.c_str());
+    xmlNewProp(dataSetItem,
+               (xmlChar*)"Dimensions",
+               (xmlChar*)dimensionStream.str().c_str());
+    xmlNewProp(dataSetItem, (xmlChar*)"Format", (xmlChar*)"HDF");
+    const char * typeProperties[] = {"DataType", "NumberType", "Precision"};
+    for(unsigned int i = 0; i < 3; ++i) {
+      xmlChar * value = xmlGetProp(dataItem, (xmlChar*)typeProperties[i]);
+      if(value) {
+        xmlNewProp(dataSetItem, (xmlChar*)typeProperties[i], value);
+        xmlFree(value);
+      }
+    }
+
+    xmlUnsetProp(dataItem, (xmlChar*)"Format");
+    xmlNewProp(dataItem, (xmlChar*)"ItemType", (xmlChar*)"HyperSlab");
+  }
+
+}
+
 /**
  * PIMPL
  */
@@ -61,7 +156,9 @@ public:
     mXMLFilePath(XdmfSystemUtils::getRealPath(xmlFilePath)),
     mXPathCount(0),
     mXPathString(""),
-    mVersionString(XdmfVersion.getShort())
+    mVersionString(XdmfVersion.getShort()),
+    mAppendOffset(-1),
+    mAppendCount(0)
   {
   };
 
@@ -74,6 +171,11 @@ public:
   {
     mXPath.clear();
 
+    if(mAppendOffset >= 0) {
+      closeAppend();
+      return;
+    }
+
     // This section writes to file
     std::ofstream fileStream;
     if(!mStream) {
@@ -89,6 +191,15 @@ public:
                         "utf-8",
                         1);
     *mStream << buffer->content;
+    if(fileStream.is_open() && mAppendTarget) {
+      // Later writes are appended at the marker in the target
+      const std::string content((char *)buffer->content);
+      const size_t marker = content.rfind(APPEND_MARKER);
+      if(marker != std::string::npos) {
+        const size_t lineStart = content.rfind('\n', marker) + 1;
+        setAppendPoint(lineStart, content.substr(lineStart));
+      }
+    }
     xmlBufferFree(buffer);
     
     if(fileStream.is_open()) {
@@ -104,6 +215,115 @@ public:
     }
   };
 
+  // Writes the items of the document, which are all children of its
+  // root, at the marker and rewrites the marker and the rest of the
+  // file after them. Only the new items and the closing tags are
+  // written.
+  void
+  closeAppend()
+  {
+    const std::string indent = mAppendTail.substr(0, mAppendTail.find("<"));
+    std::string items;
+    xmlBufferPtr buffer = xmlBufferCreate();
+    for(xmlNodePtr node = xmlDocGetRootElement(mXMLDocument)->children;
+        node;
+        node = node->next) {
+      if(node->type == XML_ELEMENT_NODE) {
+        ++mAppendCount;
+      }
+      xmlNodeDump(buffer, mXMLDocument, node, indent.size() / 2, 1);
+      items += indent + (char *)buffer->content + "\n";
+      xmlBufferEmpty(buffer);
+    }
+    xmlBufferFree(buffer);
+    xmlFreeDoc(mXMLDocument);
+
+    // The marker keeps the number of children for the next xpaths
+    const size_t markerEnd = mAppendTail.find("-->");
+    std::stringstream marker;
+    marker << indent << APPEND_MARKER << mAppendPath << " " << mAppendCount;
+    mAppendTail = marker.str() + mAppendTail.substr(markerEnd);
+
+    std::fstream fileStream(mXMLFilePath.c_str(),
+                            std::ios::in | std::ios::out | std::ios::binary);
+    fileStream.seekp(mAppendOffset);
+    fileStream << items << mAppendTail;
+    fileStream.close();
+    if(fileStream.fail()) {
+      XdmfError::message(XdmfError::FATAL,
+                         "Error: Could not append to " + mXMLFilePath +
+                         " in XdmfWriter");
+    }
+    mAppendOffset += items.size();
+
+    mXPathString = "";
+    mXPathCount = 0;
+
+    if(mHeavyDataWriter->getMode() == XdmfHeavyDataWriter::Default) {
+      mHeavyDataWriter->closeFile();
+    }
+  }
+
+  // Looks for the marker of a target written earlier, reading the end
+  // of the file back until it is found
+  void
+  loadAppendPoint()
+  {
+    std::ifstream fileStream(mXMLFilePath.c_str(), std::ios::binary);
+    if(!fileStream) {
+      return;
+    }
+    fileStream.seekg(0, std::ios::end);
+    long blockStart = fileStream.tellg();
+    std::string tail;
+    while(blockStart > 0) {
+      const long blockSize = std::min(blockStart, 65536L);
+      blockStart -= blockSize;
+      std::string block(blockSize, '\0');
+      fileStream.seekg(blockStart);
+      fileStream.read(&block[0], blockSize);
+      tail = block + tail;
+      const size_t marker = tail.rfind(APPEND_MARKER);
+      if(marker != std::string::npos) {
+        const size_t lineEnd = tail.rfind('\n', marker);
+        if(lineEnd != std::string::npos || blockStart == 0) {
+          const size_t lineStart =
+            lineEnd == std::string::npos ? 0 : lineEnd + 1;
+          setAppendPoint(blockStart + lineStart, tail.substr(lineStart));
+          return;
+        }
+      }
+    }
+  }
+
+  // Marks the append target with the xpath and the number of children
+  // it was written with
+  void
+  markAppendTarget()
+  {
+    unsigned int numChildren = 0;
+    for(xmlNodePtr node = mXMLCurrentNode->children; node; node = node->next) {
+      if(node->type == XML_ELEMENT_NODE) {
+        ++numChildren;
+      }
+    }
+    std::stringstream marker;
+    marker << APPEND_MARKER.substr(4) << getElementPath(mXMLCurrentNode)
+           << " " << numChildren;
+    xmlAddChild(mXMLCurrentNode, xmlNewComment((xmlChar *)marker.str().c_str()));
+  }
+
+  void
+  setAppendPoint(const long offset,
+                 const std::string & tail)
+  {
+    std::stringstream marker(tail.substr(tail.find(APPEND_MARKER) +
+                                         APPEND_MARKER.size()));
+    marker >> mAppendPath >> mAppendCount;
+    mAppendOffset = offset;
+    mAppendTail = tail;
+  }
+
   void
   openFile()
   {
@@ -116,6 +336,11 @@ public:
                (xmlChar*)"Version",
                (xmlChar*)mVersionString.c_str());
     xmlDocSetRootElement(mXMLDocument, mXMLCurrentNode);
+    if(mAppendOffset >= 0) {
+      // Items are written as the next children of the target
+      mXPathString = mAppendPath;
+      mXPathCount = mAppendCount;
+    }
     if(mHeavyDataWriter->getMode() == XdmfHeavyDataWriter::Default) {
       mHeavyDataWriter->openFile();
     }
@@ -137,6 +362,11 @@ public:
   unsigned int mXPathCount;
   std::string mXPathString;
   std::string mVersionString;
+  shared_ptr<XdmfItem> mAppendTarget;
+  long mAppendOffset;         // Where the marker starts in the file
+  std::string mAppendTail;    // The marker and the rest of the file
+  std::string mAppendPath;    // Xpath of the target
+  unsigned int mAppendCount;  // Number of children of the target
 
 };
 
@@ -197,6 +427,12 @@ XdmfWriter::~XdmfWriter()
   delete mImpl;
 }
 
+shared_ptr<XdmfItem>
+XdmfWriter::getAppendTarget() const
+{
+  return mImpl->mAppendTarget;
+}
+
 shared_ptr<XdmfHeavyDataWriter>
 XdmfWriter::getHeavyDataWriter()
 {
@@ -240,6 +476,16 @@ XdmfWriter::getXPathParse() const
   return mImpl->mXPathParse;
 }
 
+void
+XdmfWriter::setAppendTarget(const shared_ptr<XdmfItem> target)
+{
+  mImpl->mAppendTarget = target;
+  mImpl->mAppendOffset = -1;
+  if(target && !mImpl->mStream) {
+    mImpl->loadAppendPoint();
+  }
+}
+
 void
 XdmfWriter::setDocumentTitle(std::string title)
 {
@@ -378,24 +624,41 @@ XdmfWriter::visit(XdmfArray & array,
       bool oldWriteXPaths = mImpl->mWriteXPaths;
       mImpl->mWriteXPaths = false;
 
+      const shared_ptr<XdmfHDF5Controller> hyperSlabController =
+        getHyperSlabController(array);
+
       // Write XML (metadata) description
       if(isSubclassed) {
         shared_ptr<XdmfArray> arrayToWrite = XdmfArray::New();
         array.swap(arrayToWrite);
         mImpl->mXMLCurrentNode = mImpl->mXMLCurrentNode->last;
         this->visit(dynamic_cast<XdmfItem &>(*arrayToWrite.get()), visitor);
-        for(unsigned int i = 0; i<xmlTextValues.size(); ++i) {
-          xmlAddChild(mImpl->mXMLCurrentNode->last,
-                      xmlNewText((xmlChar*)xmlTextValues[i].c_str()));
+        if(hyperSlabController) {
+          writeHyperSlab(mImpl->mXMLCurrentNode->last,
+                         hyperSlabController,
+                         xmlTextValues[0]);
+        }
+        else {
+          for(unsigned int i = 0; i<xmlTextValues.size(); ++i) {
+            xmlAddChild(mImpl->mXMLCurrentNode->last,
+                        xmlNewText((xmlChar*)xmlTextValues[i].c_str()));
+          }
         }
         mImpl->mXMLCurrentNode = mImpl->mXMLCurrentNode->parent;
         array.swap(arrayToWrite);
       }
       else {
         this->visit(dynamic_cast<XdmfItem &>(array), visitor);
-        for(unsigned int i = 0; i<xmlTextValues.size(); ++i) {
-          xmlAddChild(mImpl->mXMLCurrentNode->last,
-                      xmlNewText((xmlChar*)xmlTextValues[i].c_str()));
+        if(hyperSlabController) {
+          writeHyperSlab(mImpl->mXMLCurrentNode->last,
+                         hyperSlabController,
+                         xmlTextValues[0]);
+        }
+        else {
+          for(unsigned int i = 0; i<xmlTextValues.size(); ++i) {
+            xmlAddChild(mImpl->mXMLCurrentNode->last,
+                        xmlNewText((xmlChar*)xmlTextValues[i].c_str()));
+          }
         }
       }
       mImpl->mWriteXPaths = oldWriteXPaths;
@@ -582,6 +845,12 @@ XdmfWriter::visit(XdmfItem & item,
       item.traverse(visitor);
     }
 
+    if(mImpl->mAppendTarget.get() == &item &&
+       mImpl->mAppendOffset < 0 &&
+       tag.compare((char *)mImpl->mXMLCurrentNode->name) == 0) {
+      mImpl->markAppendTarget();
+    }
+
     mImpl->mXMLCurrentNode = mImpl->mXMLCurrentNode->parent;
   }
 
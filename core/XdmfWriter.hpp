@@ -55,6 +55,12 @@ class XdmfHeavyDataWriter;
  * DistributedHeavyData mode in which the writer will automatically
  * reference any heavy dataset even if it resides in a different file
  * than the one currently being written to.
+ *
+ * To write a time series one step at a time, set an append target,
+ * usually the temporal collection, before writing the document. Each
+ * later write appends its item to the target in place, only the XML
+ * of the item and the closing tags of the document are written, so a
+ * step costs the same however many steps the file already holds.
  */
 class XDMFCORE_EXPORT XdmfWriter : public XdmfVisitor,
                                    public Loki::Visitor<XdmfArray> {
@@ -144,6 +150,35 @@ public:
 
   virtual ~XdmfWriter();
 
+  /**
+   * Get the item that later writes are appended to.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfWriter.cpp
+   * @skipline //#heavyinitialization
+   * @until //#heavyinitialization
+   * @skipline //#setAppendTarget
+   * @until //#setAppendTarget
+   * @skipline //#getAppendTarget
+   * @until //#getAppendTarget
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleWriter.py
+   * @skipline #//heavyinitialization
+   * @until #//heavyinitialization
+   * @skipline #//setAppendTarget
+   * @until #//setAppendTarget
+   * @skipline #//getAppendTarget
+   * @until #//getAppendTarget
+   *
+   * @return    The append target, NULL if the writer writes whole files.
+   */
+  shared_ptr<XdmfItem> getAppendTarget() const;
+
   /**
    * Get the absolute path to the XML file on disk this writer is
    * writing to.
@@ -348,6 +383,41 @@ public:
    */
   void setHeavyDataWriter(shared_ptr<XdmfHeavyDataWriter> heavyDataWriter);
 
+  /**
+   * Set the item that later writes are appended to. The first write
+   * of the document containing the target writes the whole file and
+   * marks the target with an XML comment. Every later write of an
+   * item appends it as the last child of the target, rewriting only
+   * the closing tags after it. Appending is fastest when the target
+   * is the last item of the document, since everything written after
+   * it is rewritten with each step.
+   *
+   * If the file already holds a marked target, for example after a
+   * restart, writes are appended to it right away. Remove the file to
+   * start a new one. Appending is not done when writing to a stream.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfWriter.cpp
+   * @skipline //#heavyinitialization
+   * @until //#heavyinitialization
+   * @skipline //#setAppendTarget
+   * @until //#setAppendTarget
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleWriter.py
+   * @skipline #//heavyinitialization
+   * @until #//heavyinitialization
+   * @skipline #//setAppendTarget
+   * @until #//setAppendTarget
+   *
+   * @param     target  The item to append to, NULL to write whole files.
+   */
+  void setAppendTarget(const shared_ptr<XdmfItem> target);
+
   /**
    * Set the number of values that this writer writes to light data
    * (XML) before switching to a heavy data format.
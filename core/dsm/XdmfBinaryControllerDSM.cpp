@@ -0,0 +1,414 @@
+/*****************************************************************************/
+/*                                    XDMF                                   */
+/*                       eXtensible Data Model and Format                    */
+/*                                                                           */
+/*  Id : XdmfBinaryControllerDSM.cpp                                         */
+/*                                                                           */
+/*     This software is distributed WITHOUT ANY WARRANTY; without            */
+/*     even the implied warranty of MERCHANTABILITY or FITNESS               */
+/*     FOR A PARTICULAR PURPOSE.  See Copyright.txt for details.             */
+/*                                                                           */
+/*****************************************************************************/
+
+#include <H5public.h>
+#include <hdf5.h>
+#include <cstring>
+#include <sstream>
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfBinaryControllerDSM.hpp"
+#include "XdmfDSMManager.hpp"
+#include "XdmfDSMBuffer.hpp"
+#include "XdmfDSMCommMPI.hpp"
+#include "XdmfDSMDriver.hpp"
+#include "XdmfError.hpp"
+
+namespace {
+
+  // The driver calls need a manager, one is made for the buffer when
+  // none is set
+  XdmfDSMManager *
+  createDSMManager(XdmfDSMBuffer * const dsmBuffer)
+  {
+    if (xdmf_dsm_get_manager() != NULL) {
+      return NULL;
+    }
+    XdmfDSMManager * newManager = new XdmfDSMManager();
+    newManager->SetLocalBufferSizeMBytes(dsmBuffer->GetLength() / (1024 * 1024));
+    newManager->SetInterCommType(XDMF_DSM_COMM_MPI);
+    newManager->SetIsServer(false);
+    newManager->SetMpiComm(dsmBuffer->GetComm()->GetIntraComm());
+    newManager->SetDsmBuffer(dsmBuffer);
+    XDMF_dsm_set_manager(newManager);
+    return newManager;
+  }
+
+  void
+  deleteDSMManager(XdmfDSMManager * const dsmManager)
+  {
+    if (dsmManager != NULL) {
+      if (xdmf_dsm_get_manager() == dsmManager) {
+        XDMF_dsm_set_manager(NULL);
+      }
+      // The buffer belongs to the caller
+      dsmManager->SetDsmBuffer(NULL);
+      delete dsmManager;
+    }
+  }
+
+  // The driver calls work on the buffer of the current manager, it is
+  // pointed at another buffer only while the calls are made
+  class XdmfDSMBufferSwap
+  {
+  public:
+
+    XdmfDSMBufferSwap(XdmfDSMBuffer * const dsmBuffer) :
+      mCreatedManager(createDSMManager(dsmBuffer)),
+      mManager(static_cast<XdmfDSMManager *>(xdmf_dsm_get_manager())),
+      mPreviousBuffer(mManager->GetDsmBuffer())
+    {
+      mManager->SetDsmBuffer(dsmBuffer);
+    }
+
+    ~XdmfDSMBufferSwap()
+    {
+      mManager->SetDsmBuffer(mPreviousBuffer);
+      deleteDSMManager(mCreatedManager);
+    }
+
+  private:
+
+    XdmfDSMManager * const mCreatedManager;
+    XdmfDSMManager * const mManager;
+    XdmfDSMBuffer * const mPreviousBuffer;
+  };
+
+  // Finds where a raw file currently starts and ends in the DSM
+  void
+  findRawFile(const std::string & filePath,
+              XdmfDSMBuffer * const dsmBuffer,
+              haddr_t & start,
+              haddr_t & end,
+              XdmfDSMRawHeader & header)
+  {
+    int slot;
+    haddr_t limit;
+    if (xdmf_dsm_find_entry(filePath.c_str(), false, &slot) < 0 ||
+        xdmf_dsm_get_file_entry(slot, &start, &end, &limit) < 0) {
+      XdmfError::message(XdmfError::FATAL,
+                         "Error: " + filePath + " not found in DSM");
+    }
+    header.magic = 0;
+    if (end - start >= sizeof(XdmfDSMRawHeader)) {
+      dsmBuffer->Get(start, sizeof(XdmfDSMRawHeader), &header);
+    }
+    if (header.magic != XDMF_DSM_RAW_MAGIC) {
+      XdmfError::message(XdmfError::FATAL,
+                         "Error: " + filePath + " is not a raw DSM file");
+    }
+  }
+
+}
+
+shared_ptr<XdmfBinaryControllerDSM>
+XdmfBinaryControllerDSM::New(const std::string & filePath,
+                             const std::string & dataSetName,
+                             const shared_ptr<const XdmfArrayType> & type,
+                             const int64_t offset,
+                             const std::vector<unsigned int> & dimensions,
+                             XdmfDSMBuffer * const dsmBuffer)
+{
+  shared_ptr<XdmfBinaryControllerDSM>
+    p(new XdmfBinaryControllerDSM(filePath,
+                                  dataSetName,
+                                  type,
+                                  offset,
+                                  dimensions,
+                                  dsmBuffer));
+  return p;
+}
+
+shared_ptr<XdmfBinaryControllerDSM>
+XdmfBinaryControllerDSM::New(const std::string & filePath,
+                             const std::string & dataSetName,
+                             XdmfDSMBuffer * const dsmBuffer)
+{
+  XdmfDSMBufferSwap bufferSwap(dsmBuffer);
+
+  bool fileLocking = xdmf_dsm_get_file_locking();
+  int lockId = xdmf_dsm_get_lock_id(filePath.c_str());
+  if (fileLocking) {
+    xdmf_dsm_lock_file(lockId, true);
+  }
+
+  haddr_t start, end;
+  XdmfDSMRawHeader header;
+  std::vector<XdmfDSMRawEntry> entries;
+  try {
+    findRawFile(filePath, dsmBuffer, start, end, header);
+    if (header.numEntries > 0) {
+      entries.resize(header.numEntries);
+      dsmBuffer->Get(start + sizeof(XdmfDSMRawHeader),
+                     header.numEntries * sizeof(XdmfDSMRawEntry),
+                     &entries[0]);
+    }
+  }
+  catch (XdmfError & e) {
+    if (fileLocking) {
+      xdmf_dsm_unlock_file(lockId, true, false);
+    }
+    throw e;
+  }
+
+  if (fileLocking) {
+    xdmf_dsm_unlock_file(lockId, true, false);
+  }
+
+  for (unsigned int i = 0; i < entries.size(); ++i) {
+    if (dataSetName.compare(0, XDMF_DSM_RAW_NAME_LENGTH, entries[i].name) == 0) {
+      std::vector<unsigned int> dimensions;
+      for (int j = 0; j < entries[i].rank; ++j) {
+        dimensions.push_back(entries[i].dimensions[j]);
+      }
+      return XdmfBinaryControllerDSM::New(filePath,
+                                          dataSetName,
+                                          getTypeFromCode(entries[i].type),
+                                          entries[i].offset,
+                                          dimensions,
+                                          dsmBuffer);
+    }
+  }
+
+  XdmfError::message(XdmfError::FATAL,
+                     "Error: " + dataSetName + " not found in " + filePath);
+  return shared_ptr<XdmfBinaryControllerDSM>();
+}
+
+XdmfBinaryControllerDSM::XdmfBinaryControllerDSM(const std::string & filePath,
+                                                 const std::string & dataSetName,
+                                                 const shared_ptr<const XdmfArrayType> & type,
+                                                 const int64_t offset,
+                                                 const std::vector<unsigned int> & dimensions,
+                                                 XdmfDSMBuffer * const dsmBuffer) :
+  XdmfHeavyDataController(filePath,
+                          type,
+                          dimensions),
+  mDataSetName(dataSetName),
+  mOffset(offset),
+  mDSMServerBuffer(dsmBuffer),
+  mDSMServerManager(createDSMManager(dsmBuffer))
+{
+}
+
+XdmfBinaryControllerDSM::~XdmfBinaryControllerDSM()
+{
+  deleteDSMManager(mDSMServerManager);
+}
+
+std::string
+XdmfBinaryControllerDSM::getDataSetName() const
+{
+  return mDataSetName;
+}
+
+std::string
+XdmfBinaryControllerDSM::getDescriptor() const
+{
+  return "";
+}
+
+std::string
+XdmfBinaryControllerDSM::getName() const
+{
+  return "BinaryDSM";
+}
+
+int64_t
+XdmfBinaryControllerDSM::getOffset() const
+{
+  return mOffset;
+}
+
+void
+XdmfBinaryControllerDSM::getProperties(std::map<std::string, std::string> & collectedProperties) const
+{
+  // Written as a binary file with the layout of the raw file, which is
+  // what XdmfArray reads back
+  collectedProperties["Format"] = "Binary";
+  std::stringstream seekStream;
+  seekStream << mOffset;
+  collectedProperties["Seek"] = seekStream.str();
+}
+
+XdmfDSMBuffer *
+XdmfBinaryControllerDSM::getServerBuffer()
+{
+  return mDSMServerBuffer;
+}
+
+int
+XdmfBinaryControllerDSM::getTypeCode(const shared_ptr<const XdmfArrayType> & type)
+{
+  if (type == XdmfArrayType::Int8()) {
+    return 1;
+  }
+  else if (type == XdmfArrayType::Int16()) {
+    return 2;
+  }
+  else if (type == XdmfArrayType::Int32()) {
+    return 3;
+  }
+  else if (type == XdmfArrayType::Int64()) {
+    return 4;
+  }
+  else if (type == XdmfArrayType::Float32()) {
+    return 5;
+  }
+  else if (type == XdmfArrayType::Float64()) {
+    return 6;
+  }
+  else if (type == XdmfArrayType::UInt8()) {
+    return 7;
+  }
+  else if (type == XdmfArrayType::UInt16()) {
+    return 8;
+  }
+  else if (type == XdmfArrayType::UInt32()) {
+    return 9;
+  }
+  return 0;
+}
+
+shared_ptr<const XdmfArrayType>
+XdmfBinaryControllerDSM::getTypeFromCode(const int code)
+{
+  switch (code) {
+  case 1:
+    return XdmfArrayType::Int8();
+  case 2:
+    return XdmfArrayType::Int16();
+  case 3:
+    return XdmfArrayType::Int32();
+  case 4:
+    return XdmfArrayType::Int64();
+  case 5:
+    return XdmfArrayType::Float32();
+  case 6:
+    return XdmfArrayType::Float64();
+  case 7:
+    return XdmfArrayType::UInt8();
+  case 8:
+    return XdmfArrayType::UInt16();
+  case 9:
+    return XdmfArrayType::UInt32();
+  default:
+    return shared_ptr<const XdmfArrayType>();
+  }
+}
+
+void
+XdmfBinaryControllerDSM::read(XdmfArray * const array)
+{
+  array->initialize(mType, mDimensions);
+  this->readValues(array->getValuesInternal(),
+                   mOffset,
+                   (int64_t)array->getSize() * mType->getElementSize());
+}
+
+void
+XdmfBinaryControllerDSM::read(XdmfArray * const array,
+                              const unsigned int start,
+                              const unsigned int stride,
+                              const unsigned int count)
+{
+  if (stride != 1) {
+    XdmfHeavyDataController::read(array, start, stride, count);
+    return;
+  }
+
+  if (count > 0 && start + count > this->getSize()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Window out of range of raw DSM data in "
+                       "XdmfBinaryControllerDSM::read");
+  }
+
+  // A contiguous window is read on its own
+  array->initialize(mType, std::vector<unsigned int>(1, count));
+  if (count > 0) {
+    const int64_t elementSize = mType->getElementSize();
+    this->readValues(array->getValuesInternal(),
+                     mOffset + (int64_t)start * elementSize,
+                     (int64_t)count * elementSize);
+  }
+}
+
+void
+XdmfBinaryControllerDSM::read(void * const valuesPointer,
+                              const shared_ptr<const XdmfArrayType> & valuesType,
+                              const unsigned int numValues)
+{
+  if (valuesType != mType) {
+    // Conversion goes through an XdmfArray
+    XdmfHeavyDataController::read(valuesPointer, valuesType, numValues);
+    return;
+  }
+
+  if (numValues != this->getSize()) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Number of values in memory does not match size of "
+                       "raw DSM data in XdmfBinaryControllerDSM::read");
+  }
+
+  this->readValues(valuesPointer,
+                   mOffset,
+                   (int64_t)numValues * mType->getElementSize());
+}
+
+void
+XdmfBinaryControllerDSM::readValues(void * const values,
+                                    const int64_t offset,
+                                    const int64_t length)
+{
+  XdmfDSMBufferSwap bufferSwap(mDSMServerBuffer);
+
+  bool fileLocking = xdmf_dsm_get_file_locking();
+  int lockId = xdmf_dsm_get_lock_id(mFilePath.c_str());
+  if (fileLocking) {
+    xdmf_dsm_lock_file(lockId, true);
+  }
+
+  try {
+    haddr_t start, end;
+    XdmfDSMRawHeader header;
+    findRawFile(mFilePath, mDSMServerBuffer, start, end, header);
+    if (offset < 0 || offset + length > header.dataEnd) {
+      XdmfError::message(XdmfError::FATAL,
+                         "Error: " + mDataSetName + " is beyond the end of " +
+                         mFilePath + " in XdmfBinaryControllerDSM::read");
+    }
+    // The file may have been moved past the length known to this core
+    if ((int64_t)start + offset + length > mDSMServerBuffer->GetTotalLength()) {
+      mDSMServerBuffer->QueryLength();
+    }
+    mDSMServerBuffer->Get(start + offset, length, values);
+  }
+  catch (XdmfError & e) {
+    if (fileLocking) {
+      xdmf_dsm_unlock_file(lockId, true, false);
+    }
+    throw e;
+  }
+
+  if (fileLocking) {
+    xdmf_dsm_unlock_file(lockId, true, false);
+  }
+}
+
+void
+XdmfBinaryControllerDSM::setBuffer(XdmfDSMBuffer * newBuffer)
+{
+  mDSMServerBuffer = newBuffer;
+  if (mDSMServerManager != NULL) {
+    mDSMServerManager->SetDsmBuffer(mDSMServerBuffer);
+  }
+}
@@ -0,0 +1,278 @@
+/*****************************************************************************/
+/*                                    XDMF                                   */
+/*                       eXtensible Data Model and Format                    */
+/*                                                                           */
+/*  Id : XdmfBinaryControllerDSM.hpp                                         */
+/*                                                                           */
+/*     This software is distributed WITHOUT ANY WARRANTY; without            */
+/*     even the implied warranty of MERCHANTABILITY or FITNESS               */
+/*     FOR A PARTICULAR PURPOSE.  See Copyright.txt for details.             */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef XDMFBINARYCONTROLLERDSM_HPP_
+#define XDMFBINARYCONTROLLERDSM_HPP_
+
+// Includes
+#include "XdmfDSM.hpp"
+#include "XdmfHeavyDataController.hpp"
+#include "XdmfDSMBuffer.hpp"
+#include "XdmfDSMManager.hpp"
+
+// A raw DSM file starts with a header and a fixed size index,
+// the data of the arrays follows the index
+#define XDMF_DSM_RAW_MAGIC        0x58444D52 /* "XDMR" */
+#define XDMF_DSM_RAW_INDEX_LENGTH 256
+#define XDMF_DSM_RAW_NAME_LENGTH  64
+#define XDMF_DSM_RAW_MAX_RANK     8
+#define XDMF_DSM_RAW_ALIGNMENT    8
+
+typedef struct
+{
+  int64_t magic;      /* XDMF_DSM_RAW_MAGIC                          */
+  int64_t numEntries; /* number of arrays in the index               */
+  int64_t capacity;   /* number of entries the index has room for    */
+  int64_t dataEnd;    /* end of the data, relative to the file start */
+} XdmfDSMRawHeader;
+
+typedef struct
+{
+  char name[XDMF_DSM_RAW_NAME_LENGTH];
+  int  type;                                /* see getTypeCode            */
+  int  rank;                                /* number of dimensions used  */
+  int64_t dimensions[XDMF_DSM_RAW_MAX_RANK];
+  int64_t offset;                           /* relative to the file start */
+  int64_t length;                           /* in bytes                   */
+} XdmfDSMRawEntry;
+
+/**
+ * @brief Couples an XdmfArray with raw data stored in a DSM buffer.
+ *
+ * When XdmfHDF5WriterDSM is in raw mode arrays are placed directly
+ * in the DSM after a small index holding the name, type, dimensions
+ * and offset of each array. No HDF5 file is built, so the controller
+ * reads the values straight from the DSM buffer with a single Get.
+ *
+ * Offsets are kept relative to the start of the raw file so the
+ * controller stays valid when the file is moved to grow. The array is
+ * written to XML as a binary file with the offset as its seek, so a
+ * copy of the raw file on disk is read back with XdmfBinaryController.
+ *
+ * The file driver calls work on the buffer of the current DSM manager.
+ * The controller points that manager at its own buffer only while it
+ * reads and creates a manager of its own when none is set.
+ */
+class XDMFDSM_EXPORT XdmfBinaryControllerDSM : public XdmfHeavyDataController {
+
+public:
+
+  virtual ~XdmfBinaryControllerDSM();
+
+  /**
+   * Create a new controller for an array in a raw DSM file.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#setRawModewriter
+   * @until //#setRawModewriter
+   * @skipline //#initrawcontrollerwithbuffer
+   * @until //#initrawcontrollerwithbuffer
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//setRawModewriter
+   * @until #//setRawModewriter
+   * @skipline #//initrawcontrollerwithbuffer
+   * @until #//initrawcontrollerwithbuffer
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     filePath        The name of the raw file in the DSM
+   * @param     dataSetName     The name of the array in the index
+   * @param     type            The data type of the array
+   * @param     offset          The offset of the values from the start of the file
+   * @param     dimensions      The dimensions of the array
+   * @param     dsmBuffer       The DSM buffer holding the file
+   * @return                    A new controller
+   */
+  static shared_ptr<XdmfBinaryControllerDSM>
+  New(const std::string & filePath,
+      const std::string & dataSetName,
+      const shared_ptr<const XdmfArrayType> & type,
+      const int64_t offset,
+      const std::vector<unsigned int> & dimensions,
+      XdmfDSMBuffer * const dsmBuffer);
+
+  /**
+   * Create a new controller for an array in a raw DSM file, looking
+   * up its type, dimensions and offset in the index of the file.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#setRawModewriter
+   * @until //#setRawModewriter
+   * @skipline //#initrawcontrollerwithbuffer
+   * @until //#initrawcontrollerwithbuffer
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//setRawModewriter
+   * @until #//setRawModewriter
+   * @skipline #//initrawcontrollerwithbuffer
+   * @until #//initrawcontrollerwithbuffer
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     filePath        The name of the raw file in the DSM
+   * @param     dataSetName     The name of the array in the index
+   * @param     dsmBuffer       The DSM buffer holding the file
+   * @return                    A new controller
+   */
+  static shared_ptr<XdmfBinaryControllerDSM>
+  New(const std::string & filePath,
+      const std::string & dataSetName,
+      XdmfDSMBuffer * const dsmBuffer);
+
+  /**
+   * Gets the name of the array in the index of the raw file.
+   *
+   * @return    The name of the array
+   */
+  std::string getDataSetName() const;
+
+  virtual std::string getDescriptor() const;
+
+  virtual std::string getName() const;
+
+  /**
+   * Gets the offset of the values from the start of the raw file.
+   *
+   * @return    The offset in bytes
+   */
+  int64_t getOffset() const;
+
+  virtual void
+  getProperties(std::map<std::string, std::string> & collectedProperties) const;
+
+  /**
+   * Gets the buffer that the controller reads from.
+   *
+   * @return    The DSM buffer
+   */
+  XdmfDSMBuffer * getServerBuffer();
+
+  /**
+   * Gets the code used for a type in the index of a raw file.
+   *
+   * @param     type    The type of the array
+   * @return            The code of the type, 0 if it can not be stored raw
+   */
+  static int getTypeCode(const shared_ptr<const XdmfArrayType> & type);
+
+  /**
+   * Gets the type for a code used in the index of a raw file.
+   *
+   * @param     code    The code of the type
+   * @return            The type, NULL if the code is not known
+   */
+  static shared_ptr<const XdmfArrayType> getTypeFromCode(const int code);
+
+  virtual void read(XdmfArray * const array);
+
+  virtual void read(XdmfArray * const array,
+                    const unsigned int start,
+                    const unsigned int stride,
+                    const unsigned int count);
+
+  virtual void read(void * const valuesPointer,
+                    const shared_ptr<const XdmfArrayType> & valuesType,
+                    const unsigned int numValues);
+
+  /**
+   * Sets the buffer that the controller reads from.
+   *
+   * @param     newBuffer       The DSM buffer
+   */
+  void setBuffer(XdmfDSMBuffer * newBuffer);
+
+protected:
+
+  XdmfBinaryControllerDSM(const std::string & filePath,
+                          const std::string & dataSetName,
+                          const shared_ptr<const XdmfArrayType> & type,
+                          const int64_t offset,
+                          const std::vector<unsigned int> & dimensions,
+                          XdmfDSMBuffer * const dsmBuffer);
+
+private:
+
+  XdmfBinaryControllerDSM(const XdmfBinaryControllerDSM &);  // Not implemented.
+  void operator=(const XdmfBinaryControllerDSM &);  // Not implemented.
+
+  void readValues(void * const values,
+                  const int64_t offset,
+                  const int64_t length);
+
+  const std::string mDataSetName;
+  const int64_t mOffset;
+  XdmfDSMBuffer * mDSMServerBuffer;
+  XdmfDSMManager * mDSMServerManager;
+};
+
+#endif /* XDMFBINARYCONTROLLERDSM_HPP_ */
@@ -12,6 +12,7 @@ swig -v -c++ -python -o XdmfDSMPython.cpp XdmfDSM.i
     #include <XdmfArray.hpp>
     #include <XdmfArrayReference.hpp>
     #include <XdmfArrayType.hpp>
+    #include <XdmfBinaryControllerDSM.hpp>
     #include <XdmfCore.hpp>
     #include <XdmfCoreItemFactory.hpp>
     #include <XdmfCoreReader.hpp>
@@ -72,6 +73,7 @@ swig -v -c++ -python -o XdmfDSMPython.cpp XdmfDSM.i
 %mpi4py_typemap(Comm, MPI_Comm);
 
 %include <typemaps.i>
+%include <stdint.i>
 %apply int & INOUT {int & data };
 
 %extend XdmfDSMBuffer {
@@ -117,11 +119,13 @@ swig -v -c++ -python -o XdmfDSMPython.cpp XdmfDSM.i
 
 
 // Shared Pointer Templates
+%shared_ptr(XdmfBinaryControllerDSM)
 %shared_ptr(XdmfHDF5ControllerDSM)
 %shared_ptr(XdmfHDF5WriterDSM)
 
 
 %include XdmfDSM.hpp
+%include XdmfBinaryControllerDSM.hpp
 %include XdmfHDF5ControllerDSM.hpp
 %include XdmfHDF5WriterDSM.hpp
 %include XdmfDSMManager.hpp
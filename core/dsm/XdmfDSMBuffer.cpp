@@ -56,13 +56,60 @@
 #include <XdmfError.hpp>
 #include <mpi.h>
 #include <string.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <deque>
 
 #ifndef _WIN32
   #include <unistd.h>
 #endif
 
+namespace {
+
+  // Integer mixing function used to derive the block random layout,
+  // results only depend on the input so every core computes the same layout
+  unsigned int
+  mixBits(unsigned int value)
+  {
+    value ^= value >> 16;
+    value *= 0x7feb352dU;
+    value ^= value >> 15;
+    value *= 0x846ca68bU;
+    value ^= value >> 16;
+    return value;
+  }
+
+  // Build a committed datatype for a message struct so that its 64-bit
+  // fields are sent as MPI_INT64_T instead of raw bytes
+  MPI_Datatype
+  createMessageType(int count,
+                    int * blockLengths,
+                    MPI_Aint * displacements,
+                    MPI_Datatype * types,
+                    size_t extent)
+  {
+    MPI_Datatype structType;
+    MPI_Datatype messageType;
+    if (MPI_Type_create_struct(count,
+                               blockLengths,
+                               displacements,
+                               types,
+                               &structType) != MPI_SUCCESS ||
+        MPI_Type_create_resized(structType,
+                                0,
+                                (MPI_Aint)extent,
+                                &messageType) != MPI_SUCCESS ||
+        MPI_Type_commit(&messageType) != MPI_SUCCESS) {
+      XdmfError::message(XdmfError::FATAL,
+                         "Error: Failed to create DSM message type");
+    }
+    MPI_Type_free(&structType);
+    return messageType;
+  }
+
+}
+
 XdmfDSMBuffer::XdmfDSMBuffer()
 {
   this->CommChannel = XDMF_DSM_INTER_COMM;
@@ -72,17 +119,24 @@ XdmfDSMBuffer::XdmfDSMBuffer()
   this->Length = 0;
   this->TotalLength = 0;
   this->BlockLength = 0;
+  this->MaxLength = 0;
+  this->MaxMessageLength = XDMF_DSM_MAX_MESSAGE_LENGTH;
+  this->RandomSeed = XDMF_DSM_DEFAULT_RANDOM_SEED;
+  this->RandomRound = -1;
+  this->FileSlots = 1;
+  this->FileLocking = false;
+  this->AllocationLength = XDMF_DSM_DEFAULT_ALLOCATION_LENGTH;
+  this->TransportType = XDMF_DSM_TRANSPORT_MESSAGE;
+  this->DataWindow = MPI_WIN_NULL;
+  this->UseSharedMemory = false;
+  this->SharedStorage = false;
+  this->NodeComm = MPI_COMM_NULL;
+  this->SharedWindow = MPI_WIN_NULL;
   this->Comm = NULL;
   this->DataPointer = NULL;
   this->IsConnected = false;
-}
-
-XdmfDSMBuffer::~XdmfDSMBuffer()
-{
-  if (this->DataPointer) {
-    free(this->DataPointer);
-  }
-  this->DataPointer = NULL;
+  this->CommandMsgType = MPI_DATATYPE_NULL;
+  this->InfoMsgType = MPI_DATATYPE_NULL;
 }
 
 class XdmfDSMBuffer::CommandMsg
@@ -91,48 +145,178 @@ class XdmfDSMBuffer::CommandMsg
     int Opcode;
     int Source;
     int  Target;
-    int Address;
-    int Length;
+    int64_t Address;
+    int64_t Length;
 };
 
 class XdmfDSMBuffer::InfoMsg
 {
   public:
     int type;
-    unsigned int length;
-    unsigned int total_length;
-    unsigned int block_length;
+    int64_t length;
+    int64_t total_length;
+    int64_t block_length;
+    int64_t max_length;
+    int64_t allocation_length;
+    unsigned int random_seed;
+    int transport_type;
+    int use_shared_memory;
     int start_server_id;
     int end_server_id;
+    int file_locking;
+    unsigned int file_slots;
+};
+
+class XdmfDSMBuffer::LockState
+{
+  public:
+    class Request
+    {
+      public:
+        Request(int who, int value, int comm) :
+          Who(who), Value(value), Comm(comm) {}
+        int Who;
+        int Value;
+        int Comm;
+    };
+
+    LockState() : Writer(-1), WriteCount(0), Step(0) {}
+
+    bool Holds(int who)
+    {
+      return this->Writer == who || this->Readers.count(who) > 0;
+    }
+
+    bool CanGrant(int who, int mode)
+    {
+      if (this->Writer != -1 && this->Writer != who) {
+        return false;
+      }
+      if (mode == XDMF_DSM_LOCK_WRITE) {
+        // Only readers that are the requesting core may remain
+        return this->Readers.empty() ||
+               (this->Readers.size() == 1 && this->Readers.count(who) > 0);
+      }
+      return true;
+    }
+
+    // Core holding the lock for writing and how many times, -1 when none
+    int Writer;
+    int WriteCount;
+    // Cores holding the lock for reading and how many times
+    std::map<int, int> Readers;
+    // Number of write releases marked as a new step
+    int Step;
+    // Requests waiting for the lock, in the order they were received
+    std::deque<Request> Waiting;
+    // Cores waiting for a step later than the one they passed
+    std::vector<Request> StepWaiters;
 };
 
+XdmfDSMBuffer::~XdmfDSMBuffer()
+{
+  this->WaitNonBlocking();
+  this->FreeDataWindow();
+  if (this->SharedStorage) {
+    // The buffer is released along with the shared window
+    this->DataPointer = NULL;
+    this->SharedStorage = false;
+  }
+  this->FreeSharedWindow();
+  if (this->DataPointer) {
+    free(this->DataPointer);
+  }
+  this->DataPointer = NULL;
+  for (std::map<int, LockState *>::iterator iter = this->Locks.begin();
+       iter != this->Locks.end();
+       ++iter) {
+    delete iter->second;
+  }
+  this->Locks.clear();
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (!finalized) {
+    if (this->CommandMsgType != MPI_DATATYPE_NULL) {
+      MPI_Type_free(&this->CommandMsgType);
+    }
+    if (this->InfoMsgType != MPI_DATATYPE_NULL) {
+      MPI_Type_free(&this->InfoMsgType);
+    }
+  }
+}
+
+int
+XdmfDSMBuffer::AcquireLock(int lockId, int mode)
+{
+  int dataComm = XDMF_DSM_INTRA_COMM;
+  if (this->Comm->GetInterComm() != MPI_COMM_NULL) {
+    dataComm = XDMF_DSM_INTER_COMM;
+  }
+  if (mode != XDMF_DSM_LOCK_READ && mode != XDMF_DSM_LOCK_WRITE) {
+    XdmfError::message(XdmfError::FATAL, "Error: Unknown DSM lock mode");
+  }
+  int server = this->GetLockServerId(lockId);
+  this->SendCommandHeader(XDMF_DSM_LOCK_ACQUIRE, server, lockId, mode, dataComm);
+  int step;
+  this->ReceiveAcknowledgment(server, step, XDMF_DSM_LOCK_TAG, dataComm);
+  return step;
+}
+
 int
-XdmfDSMBuffer::AddressToId(int Address)
+XdmfDSMBuffer::AddressToId(int64_t Address)
+{
+  int ServerId;
+  int64_t localAddress, localLength;
+  this->AddressToLocation(Address, &ServerId, &localAddress, &localLength);
+  return(ServerId);
+}
+
+void
+XdmfDSMBuffer::AddressToLocation(int64_t Address, int *Id, int64_t *LocalAddress, int64_t *LocalLength)
 {
-  int   ServerId = XDMF_DSM_FAIL;
+  if (Address < 0 || Address >= this->TotalLength) {
+    std::stringstream message;
+    message << "Address " << Address << " is outside of the DSM of length "
+            << this->TotalLength;
+    XdmfError::message(XdmfError::FATAL, message.str());
+  }
 
   switch(this->DsmType) {
     case XDMF_DSM_TYPE_UNIFORM :
     case XDMF_DSM_TYPE_UNIFORM_RANGE :
       // All Servers have same length
       // This finds out which server the address provided starts on
-      ServerId = this->StartServerId + (Address / this->Length);
-      if(ServerId > this->EndServerId ){
-        std::stringstream message;
-        message << "ServerId " << ServerId << " for Address "
-                << Address << " is larger than EndServerId "
-                << this->EndServerId;
-        XdmfError::message(XdmfError::FATAL, message.str());
+      *Id = this->StartServerId + (int)(Address / this->Length);
+      *LocalAddress = Address % this->Length;
+      *LocalLength = this->Length - *LocalAddress;
+      break;
+    case XDMF_DSM_TYPE_BLOCK_CYCLIC :
+    case XDMF_DSM_TYPE_BLOCK_RANDOM :
+    {
+      // Blocks are dealt to the servers in rounds, each server receives
+      // one block per round and stores it at the round's position in its
+      // buffer
+      int numServers = this->EndServerId - this->StartServerId + 1;
+      int64_t block = Address / this->BlockLength;
+      int64_t round = block / numServers;
+      int serverIndex = (int)(block % numServers);
+      if (this->DsmType == XDMF_DSM_TYPE_BLOCK_RANDOM) {
+        serverIndex = this->GetRandomPermutation(round)[serverIndex];
       }
+      *Id = this->StartServerId + serverIndex;
+      *LocalLength = this->BlockLength - Address % this->BlockLength;
+      *LocalAddress = round * this->BlockLength + this->BlockLength - *LocalLength;
       break;
+    }
     default :
+    {
       // Not Implemented
       std::stringstream message;
       message << "DsmType " << this->DsmType << " not yet implemented";
       XdmfError::message(XdmfError::FATAL, message.str());
       break;
     }
-    return(ServerId);
+  }
 }
 
 void
@@ -150,8 +334,8 @@ int
 XdmfDSMBuffer::BufferService(int *returnOpcode)
 {
   int        opcode, who;
-  int        aLength;
-  int          address;
+  int64_t    aLength;
+  int64_t    address;
   char        *datap;
   static int syncId      = -1;
 
@@ -176,7 +360,7 @@ XdmfDSMBuffer::BufferService(int *returnOpcode)
 
   // H5FD_DSM_OPCODE_PUT
   case XDMF_DSM_OPCODE_PUT:
-    if (((unsigned int) aLength + address) > this->Length) {
+    if (address < 0 || aLength < 0 || aLength + address > this->Length) {
       std::stringstream message;
       message << "Length " << aLength << " too long for Address " << address 
               << "\n" << "Server Start = " << this->StartAddress << " End = "
@@ -188,17 +372,20 @@ XdmfDSMBuffer::BufferService(int *returnOpcode)
                           "Null Data Pointer when trying to put data");
     }
     datap += address;
+    // Keep one sided writers out while the data arrives
+    this->LockLocalWindows(MPI_LOCK_EXCLUSIVE);
     this->ReceiveData(who,
                       datap,
                       aLength,
                       XDMF_DSM_PUT_DATA_TAG,
                       0,
                       this->CommChannel);
+    this->UnlockLocalWindows();
     break;
 
   // H5FD_DSM_OPCODE_GET
   case XDMF_DSM_OPCODE_GET:
-    if (((unsigned int) aLength + address) > this->Length) {
+    if (address < 0 || aLength < 0 || aLength + address > this->Length) {
       std::stringstream message;
       message << "Length " << aLength << " too long for Address " << address
               << "\n" << "Server Start = " << this->StartAddress << " End = "
@@ -234,13 +421,87 @@ XdmfDSMBuffer::BufferService(int *returnOpcode)
   // H5FD_DSM_LOCK_ACQUIRE
   // Comes from client or server depending on communicator
   case XDMF_DSM_LOCK_ACQUIRE:
-    // Currently unsupported
+  {
+    // The address holds the lock and the length the mode
+    LockState * lock = this->GetLockState((int)address);
+    LockState::Request request(who, (int)aLength, this->CommChannel);
+    if (lock->Holds(who) && lock->CanGrant(who, request.Value)) {
+      // A core that already holds the lock may not wait behind others
+      lock->Waiting.push_front(request);
+    }
+    else {
+      lock->Waiting.push_back(request);
+    }
+    this->GrantLocks(lock);
     break;
+  }
 
   // H5FD_DSM_LOCK_RELEASE
   // Comes from client or server depending on communicator
   case XDMF_DSM_LOCK_RELEASE:
-    // Currently unsupported
+  {
+    // The length holds the mode, with XDMF_DSM_LOCK_STEP set for a new step
+    LockState * lock = this->GetLockState((int)address);
+    int mode = (int)aLength & ~XDMF_DSM_LOCK_STEP;
+    bool newStep = ((int)aLength & XDMF_DSM_LOCK_STEP) != 0;
+    if (mode == XDMF_DSM_LOCK_READ) {
+      std::map<int, int>::iterator reader = lock->Readers.find(who);
+      if (reader == lock->Readers.end()) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Error: DSM read lock released that was not held");
+      }
+      if (--reader->second == 0) {
+        lock->Readers.erase(reader);
+      }
+    }
+    else {
+      if (lock->Writer != who) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Error: DSM write lock released that was not held");
+      }
+      if (--lock->WriteCount == 0) {
+        lock->Writer = -1;
+      }
+      if (newStep) {
+        ++lock->Step;
+        for (unsigned int i = 0; i < lock->StepWaiters.size(); ++i) {
+          this->SendAcknowledgment(lock->StepWaiters[i].Who,
+                                   lock->Step,
+                                   XDMF_DSM_LOCK_TAG,
+                                   lock->StepWaiters[i].Comm);
+        }
+        lock->StepWaiters.clear();
+      }
+    }
+    this->GrantLocks(lock);
+    break;
+  }
+
+  // Comes from client, answered once the lock has a later step
+  case XDMF_DSM_LOCK_WAIT:
+  {
+    LockState * lock = this->GetLockState((int)address);
+    if (lock->Step > aLength) {
+      this->SendAcknowledgment(who,
+                               lock->Step,
+                               XDMF_DSM_LOCK_TAG,
+                               this->CommChannel);
+    }
+    else {
+      lock->StepWaiters.push_back(LockState::Request(who,
+                                                     (int)aLength,
+                                                     this->CommChannel));
+    }
+    break;
+  }
+
+  // Comes from client, the length holds the number of rounds of blocks
+  // to grow to, answered with the number of rounds held afterwards
+  case XDMF_DSM_OPCODE_GROW:
+    this->SendAcknowledgment(who,
+                             (int)this->GrowLocalBuffer(aLength),
+                             XDMF_DSM_GROW_TAG,
+                             this->CommChannel);
     break;
 
   // H5FD_DSM_OPCODE_DONE
@@ -273,8 +534,8 @@ XdmfDSMBuffer::BufferServiceLoop(int *returnOpcode)
 }
 
 void
-XdmfDSMBuffer::ConfigureUniform(XdmfDSMCommMPI *aComm, long aLength,
-                                int startId, int endId, long aBlockLength,
+XdmfDSMBuffer::ConfigureUniform(XdmfDSMCommMPI *aComm, int64_t aLength,
+                                int startId, int endId, int64_t aBlockLength,
                                 bool random)
 {
   if (startId < 0) {
@@ -304,17 +565,17 @@ XdmfDSMBuffer::ConfigureUniform(XdmfDSMCommMPI *aComm, long aLength,
       this->IsServer) {
     if (aBlockLength) {
       // For optimization we make the DSM length fit to a multiple of block size
-      this->SetLength(((long)(aLength / aBlockLength)) * aBlockLength);
+      this->SetLength(((int64_t)(aLength / aBlockLength)) * aBlockLength);
     }
     else {
       this->SetLength(aLength);
     }
-    this->StartAddress = (aComm->GetId() - startId) * aLength;
+    this->StartAddress = (int64_t)(aComm->GetId() - startId) * aLength;
     this->EndAddress = this->StartAddress + aLength - 1;
   }
   else {
     if (aBlockLength) {
-      this->Length = ((long)(aLength / aBlockLength)) * aBlockLength;
+      this->Length = ((int64_t)(aLength / aBlockLength)) * aBlockLength;
     }
     else {
       this->Length = aLength;
@@ -324,40 +585,211 @@ XdmfDSMBuffer::ConfigureUniform(XdmfDSMCommMPI *aComm, long aLength,
 }
 
 void
-XdmfDSMBuffer::Get(long Address, long aLength, void *Data)
+XdmfDSMBuffer::CreateDataWindow()
+{
+  this->FreeDataWindow();
+  MPI_Comm windowComm = this->Comm->GetInterComm();
+  if (windowComm == MPI_COMM_NULL) {
+    windowComm = this->Comm->GetIntraComm();
+  }
+  // Only servers expose memory, clients take part in the window without any
+  int status;
+  if (this->IsServer && this->DataPointer) {
+    status = MPI_Win_create(this->DataPointer,
+                            (MPI_Aint)this->Length,
+                            1,
+                            MPI_INFO_NULL,
+                            windowComm,
+                            &this->DataWindow);
+  }
+  else {
+    status = MPI_Win_create(NULL,
+                            0,
+                            1,
+                            MPI_INFO_NULL,
+                            windowComm,
+                            &this->DataWindow);
+  }
+  if (status != MPI_SUCCESS) {
+    this->DataWindow = MPI_WIN_NULL;
+    XdmfError::message(XdmfError::FATAL, "Error: Failed to create DSM window");
+  }
+}
+
+void
+XdmfDSMBuffer::CreateSharedWindow()
+{
+  this->FreeSharedWindow();
+  MPI_Comm windowComm = this->Comm->GetInterComm();
+  if (windowComm == MPI_COMM_NULL) {
+    windowComm = this->Comm->GetIntraComm();
+  }
+  int status = MPI_Comm_split_type(windowComm,
+                                   MPI_COMM_TYPE_SHARED,
+                                   0,
+                                   MPI_INFO_NULL,
+                                   &this->NodeComm);
+  if (status != MPI_SUCCESS) {
+    this->NodeComm = MPI_COMM_NULL;
+    XdmfError::message(XdmfError::FATAL, "Error: Failed to split DSM communicator by node");
+  }
+  // Only servers place memory in the window
+  MPI_Aint windowLength = 0;
+  if (this->IsServer && this->DataPointer) {
+    windowLength = (MPI_Aint)this->Length;
+  }
+  char * sharedPointer = NULL;
+  status = MPI_Win_allocate_shared(windowLength,
+                                   1,
+                                   MPI_INFO_NULL,
+                                   this->NodeComm,
+                                   &sharedPointer,
+                                   &this->SharedWindow);
+  if (status != MPI_SUCCESS) {
+    this->SharedWindow = MPI_WIN_NULL;
+    XdmfError::message(XdmfError::FATAL, "Error: Failed to create DSM shared window");
+  }
+  if (windowLength > 0) {
+    memcpy(sharedPointer, this->DataPointer, this->Length);
+    free(this->DataPointer);
+    this->DataPointer = sharedPointer;
+    this->SharedStorage = true;
+  }
+
+  // Find the buffers of the servers on this node by their id
+  int nodeSize, windowSize;
+  MPI_Comm_size(this->NodeComm, &nodeSize);
+  MPI_Comm_size(windowComm, &windowSize);
+  MPI_Group nodeGroup, windowGroup;
+  MPI_Comm_group(this->NodeComm, &nodeGroup);
+  MPI_Comm_group(windowComm, &windowGroup);
+  std::vector<int> nodeRanks(nodeSize);
+  std::vector<int> windowRanks(nodeSize);
+  for (int i = 0; i < nodeSize; ++i) {
+    nodeRanks[i] = i;
+  }
+  MPI_Group_translate_ranks(nodeGroup,
+                            nodeSize,
+                            &nodeRanks[0],
+                            windowGroup,
+                            &windowRanks[0]);
+  MPI_Group_free(&nodeGroup);
+  MPI_Group_free(&windowGroup);
+
+  this->NodePointers.assign(windowSize, NULL);
+  this->NodeRanks.assign(windowSize, -1);
+  for (int i = 0; i < nodeSize; ++i) {
+    MPI_Aint sharedLength;
+    int displacementUnit;
+    char * basePointer;
+    MPI_Win_shared_query(this->SharedWindow,
+                         i,
+                         &sharedLength,
+                         &displacementUnit,
+                         &basePointer);
+    if (sharedLength > 0 && windowRanks[i] != MPI_UNDEFINED) {
+      this->NodePointers[windowRanks[i]] = basePointer;
+      this->NodeRanks[windowRanks[i]] = i;
+    }
+  }
+}
+
+void
+XdmfDSMBuffer::FreeDataWindow()
+{
+  if (this->DataWindow != MPI_WIN_NULL) {
+    int status = MPI_Win_free(&this->DataWindow);
+    if (status != MPI_SUCCESS) {
+      XdmfError::message(XdmfError::FATAL, "Error: Failed to free DSM window");
+    }
+    this->DataWindow = MPI_WIN_NULL;
+  }
+}
+
+void
+XdmfDSMBuffer::FreeSharedWindow()
+{
+  if (this->SharedWindow != MPI_WIN_NULL) {
+    if (this->SharedStorage) {
+      // Keep the contents in private memory once the window is gone
+      char * privatePointer = static_cast<char *>(malloc(this->Length));
+      if (privatePointer == NULL) {
+        XdmfError::message(XdmfError::FATAL, "Error: Failed to allocate DSM buffer");
+      }
+      memcpy(privatePointer, this->DataPointer, this->Length);
+      this->DataPointer = privatePointer;
+      this->SharedStorage = false;
+    }
+    int status = MPI_Win_free(&this->SharedWindow);
+    if (status != MPI_SUCCESS) {
+      XdmfError::message(XdmfError::FATAL, "Error: Failed to free DSM shared window");
+    }
+    this->SharedWindow = MPI_WIN_NULL;
+  }
+  if (this->NodeComm != MPI_COMM_NULL) {
+    MPI_Comm_free(&this->NodeComm);
+    this->NodeComm = MPI_COMM_NULL;
+  }
+  this->NodePointers.clear();
+  this->NodeRanks.clear();
+}
+
+void
+XdmfDSMBuffer::Get(int64_t Address, int64_t aLength, void *Data)
 {
   int   who, MyId = this->Comm->GetInterId();
-  int   astart, aend, len;
+  int64_t  localAddress, localLength, len;
   char   *datap = (char *)Data;
 
   // While there is length left
   while(aLength) {
     // Figure out what server core the address is located on
-    who = this->AddressToId(Address);
-    if(who == XDMF_DSM_FAIL){
-      XdmfError::message(XdmfError::FATAL, "Address Error");
-    }
-    // Get the start and end of the block listed
-    this->GetAddressRangeForId(who, &astart, &aend);
-    // Determine the amount of data to be written to that core
-    // Basically, it's how much data will fit from
-    // the starting point of the address to the end
-    len = std::min(aLength, aend - Address + 1);
-    // If the data is on the core running this code, then the put is simple
+    // and where it is stored in that core's buffer
+    this->AddressToLocation(Address, &who, &localAddress, &localLength);
+    // Determine the amount of data to be read from that core
+    // Basically, it's how much data is contiguous on that core
+    // from the starting point of the address
+    len = std::min(aLength, localLength);
+    // If the data is on the core running this code, then the get is simple
     if(who == MyId){
       char *dp;
       dp = this->DataPointer;
-      dp += Address - this->StartAddress;
+      dp += localAddress;
       memcpy(datap, dp, len);
     }
+    else if (!this->NodePointers.empty() && this->NodePointers[who]) {
+      // Servers on this node are read directly through shared memory
+      MPI_Win_lock(MPI_LOCK_SHARED, this->NodeRanks[who], 0, this->SharedWindow);
+      memcpy(datap, this->NodePointers[who] + localAddress, len);
+      MPI_Win_unlock(this->NodeRanks[who], this->SharedWindow);
+    }
+    else if (this->DataWindow != MPI_WIN_NULL) {
+      // Read straight from the server's buffer, the server is not involved
+      MPI_Win_lock(MPI_LOCK_SHARED, who, 0, this->DataWindow);
+      for (int64_t offset = 0; offset < len; offset += this->MaxMessageLength) {
+        int frameLength = (int)std::min(len - offset, this->MaxMessageLength);
+        int status = MPI_Get(datap + offset,
+                             frameLength,
+                             MPI_UNSIGNED_CHAR,
+                             who,
+                             (MPI_Aint)(localAddress + offset),
+                             frameLength,
+                             MPI_UNSIGNED_CHAR,
+                             this->DataWindow);
+        if (status != MPI_SUCCESS) {
+          XdmfError::message(XdmfError::FATAL, "Error: Failed to get data from window");
+        }
+      }
+      MPI_Win_unlock(who, this->DataWindow);
+    }
     else{
       // Otherwise send it to the appropriate core to deal with
       int   dataComm = XDMF_DSM_INTRA_COMM;
       if (this->Comm->GetInterComm() != MPI_COMM_NULL) {
         dataComm = XDMF_DSM_INTER_COMM;
       }
-      this->SendCommandHeader(XDMF_DSM_OPCODE_GET, who, Address - astart, len, dataComm);
-      this->ReceiveData(who, datap, len, XDMF_DSM_GET_DATA_TAG, Address - astart, dataComm);
+      this->SendCommandHeader(XDMF_DSM_OPCODE_GET, who, localAddress, len, dataComm);
+      this->ReceiveData(who, datap, len, XDMF_DSM_GET_DATA_TAG, localAddress, dataComm);
     }
     // Shift all the numbers by the length of the data written
     // Until aLength = 0
@@ -367,8 +799,14 @@ XdmfDSMBuffer::Get(long Address, long aLength, void *Data)
   }
 }
 
+int64_t
+XdmfDSMBuffer::GetAllocationLength()
+{
+  return this->AllocationLength;
+}
+
 void
-XdmfDSMBuffer::GetAddressRangeForId(int Id, int *Start, int *End){
+XdmfDSMBuffer::GetAddressRangeForId(int Id, int64_t *Start, int64_t *End){
     switch(this->DsmType) {
       case XDMF_DSM_TYPE_UNIFORM :
       case XDMF_DSM_TYPE_UNIFORM_RANGE :
@@ -377,12 +815,38 @@ XdmfDSMBuffer::GetAddressRangeForId(int Id, int *Start, int *End){
         // the length of the block per server
         // It is the starting index of the server's data block relative
         // to the entire block
-        *Start = (Id - this->StartServerId) * this->Length;
+        *Start = (int64_t)(Id - this->StartServerId) * this->Length;
         // End index is simply the start index + the length of the
         // server's data block.
         // The range produced is the start of the server's data block to its end.
         *End = *Start + Length - 1;
         break;
+      case XDMF_DSM_TYPE_BLOCK_CYCLIC :
+      case XDMF_DSM_TYPE_BLOCK_RANDOM :
+      {
+        // The server holds one block per round, the range runs from its
+        // block in the first round to its block in the last round
+        int numServers = this->EndServerId - this->StartServerId + 1;
+        int serverIndex = Id - this->StartServerId;
+        int64_t lastRound = this->Length / this->BlockLength - 1;
+        int firstSlot = serverIndex;
+        int lastSlot = serverIndex;
+        if (this->DsmType == XDMF_DSM_TYPE_BLOCK_RANDOM) {
+          const std::vector<int> & firstPermutation =
+            this->GetRandomPermutation(0);
+          firstSlot = (int)(std::find(firstPermutation.begin(),
+                                      firstPermutation.end(),
+                                      serverIndex) - firstPermutation.begin());
+          const std::vector<int> & lastPermutation =
+            this->GetRandomPermutation(lastRound);
+          lastSlot = (int)(std::find(lastPermutation.begin(),
+                                     lastPermutation.end(),
+                                     serverIndex) - lastPermutation.begin());
+        }
+        *Start = (int64_t)firstSlot * this->BlockLength;
+        *End = (lastRound * numServers + lastSlot + 1) * this->BlockLength - 1;
+        break;
+      }
       default :
         // Not Implemented
         std::stringstream message;
@@ -392,7 +856,7 @@ XdmfDSMBuffer::GetAddressRangeForId(int Id, int *Start, int *End){
     }
 }
 
-long
+int64_t
 XdmfDSMBuffer::GetBlockLength()
 {
   return this->BlockLength;
@@ -404,6 +868,23 @@ XdmfDSMBuffer::GetComm()
   return this->Comm;
 }
 
+MPI_Datatype
+XdmfDSMBuffer::GetCommandMsgType()
+{
+  if (this->CommandMsgType == MPI_DATATYPE_NULL) {
+    int blockLengths[2] = {3, 2};
+    MPI_Aint displacements[2] = {offsetof(CommandMsg, Opcode),
+                                 offsetof(CommandMsg, Address)};
+    MPI_Datatype types[2] = {MPI_INT, MPI_INT64_T};
+    this->CommandMsgType = createMessageType(2,
+                                             blockLengths,
+                                             displacements,
+                                             types,
+                                             sizeof(CommandMsg));
+  }
+  return this->CommandMsgType;
+}
+
 char *
 XdmfDSMBuffer::GetDataPointer()
 {
@@ -416,7 +897,7 @@ XdmfDSMBuffer::GetDsmType()
   return this->DsmType;
 }
 
-int
+int64_t
 XdmfDSMBuffer::GetEndAddress()
 {
   return this->EndAddress;
@@ -428,6 +909,18 @@ XdmfDSMBuffer::GetEndServerId()
   return this->EndServerId;
 }
 
+bool
+XdmfDSMBuffer::GetFileLocking()
+{
+  return this->FileLocking;
+}
+
+unsigned int
+XdmfDSMBuffer::GetFileSlots()
+{
+  return this->FileSlots;
+}
+
 bool
 XdmfDSMBuffer::GetIsConnected()
 {
@@ -440,13 +933,97 @@ XdmfDSMBuffer::GetIsServer()
   return this->IsServer;
 }
 
-long
+int
+XdmfDSMBuffer::GetLockServerId(int lockId)
+{
+  if (lockId < 0) {
+    XdmfError::message(XdmfError::FATAL, "Error: DSM lock ids may not be negative");
+  }
+  return this->StartServerId +
+         lockId % (this->EndServerId - this->StartServerId + 1);
+}
+
+XdmfDSMBuffer::LockState *
+XdmfDSMBuffer::GetLockState(int lockId)
+{
+  std::map<int, LockState *>::iterator iter = this->Locks.find(lockId);
+  if (iter == this->Locks.end()) {
+    iter = this->Locks.insert(std::make_pair(lockId, new LockState())).first;
+  }
+  return iter->second;
+}
+
+MPI_Datatype
+XdmfDSMBuffer::GetInfoMsgType()
+{
+  if (this->InfoMsgType == MPI_DATATYPE_NULL) {
+    int blockLengths[5] = {1, 5, 1, 5, 1};
+    MPI_Aint displacements[5] = {offsetof(InfoMsg, type),
+                                 offsetof(InfoMsg, length),
+                                 offsetof(InfoMsg, random_seed),
+                                 offsetof(InfoMsg, transport_type),
+                                 offsetof(InfoMsg, file_slots)};
+    MPI_Datatype types[5] = {MPI_INT, MPI_INT64_T, MPI_UNSIGNED, MPI_INT, MPI_UNSIGNED};
+    this->InfoMsgType = createMessageType(5,
+                                          blockLengths,
+                                          displacements,
+                                          types,
+                                          sizeof(InfoMsg));
+  }
+  return this->InfoMsgType;
+}
+
+int64_t
 XdmfDSMBuffer::GetLength()
 {
   return this->Length;
 }
 
-int
+int64_t
+XdmfDSMBuffer::GetMaxLength()
+{
+  return this->MaxLength;
+}
+
+int64_t
+XdmfDSMBuffer::GetMaxMessageLength()
+{
+  return this->MaxMessageLength;
+}
+
+const std::vector<int> &
+XdmfDSMBuffer::GetRandomPermutation(int64_t round)
+{
+  // Consecutive addresses fall in the same round, so the last
+  // permutation is kept to avoid reshuffling for every block
+  int numServers = this->EndServerId - this->StartServerId + 1;
+  if (round != this->RandomRound ||
+      (int)this->RandomPermutation.size() != numServers) {
+    this->RandomPermutation.resize(numServers);
+    for (int i = 0; i < numServers; ++i) {
+      this->RandomPermutation[i] = i;
+    }
+    // Fisher-Yates shuffle seeded by the DSM seed and the round
+    unsigned int state = mixBits(this->RandomSeed ^
+                                 mixBits((unsigned int)round ^
+                                         mixBits((unsigned int)(round >> 16 >> 16))));
+    for (int i = numServers - 1; i > 0; --i) {
+      state = mixBits(state + 0x9e3779b9U);
+      std::swap(this->RandomPermutation[i],
+                this->RandomPermutation[state % (unsigned int)(i + 1)]);
+    }
+    this->RandomRound = round;
+  }
+  return this->RandomPermutation;
+}
+
+unsigned int
+XdmfDSMBuffer::GetRandomSeed()
+{
+  return this->RandomSeed;
+}
+
+int64_t
 XdmfDSMBuffer::GetStartAddress()
 {
   return this->StartAddress;
@@ -458,12 +1035,137 @@ XdmfDSMBuffer::GetStartServerId()
   return this->StartServerId;
 }
 
-long
+int64_t
 XdmfDSMBuffer::GetTotalLength()
 {
   return this->TotalLength;
 }
 
+int
+XdmfDSMBuffer::GetTransportType()
+{
+  return this->TransportType;
+}
+
+bool
+XdmfDSMBuffer::GetUseSharedMemory()
+{
+  return this->UseSharedMemory;
+}
+
+int64_t
+XdmfDSMBuffer::Grow(int64_t aTotalLength)
+{
+  if (aTotalLength <= this->TotalLength) {
+    return this->TotalLength;
+  }
+  if (this->DsmType != XDMF_DSM_TYPE_BLOCK_CYCLIC &&
+      this->DsmType != XDMF_DSM_TYPE_BLOCK_RANDOM) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Unable to grow a uniform DSM, only block cyclic "
+                       "and block random DSMs can grow");
+  }
+  if (this->TransportType == XDMF_DSM_TRANSPORT_RMA) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Unable to grow a DSM using RMA transport, "
+                       "only DSMs using message transport can grow");
+  }
+  if (this->UseSharedMemory) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Unable to grow a DSM using shared memory");
+  }
+  int64_t roundLength = this->BlockLength * (this->EndServerId - this->StartServerId + 1);
+  this->GrowServers((aTotalLength + roundLength - 1) / roundLength);
+  return this->TotalLength;
+}
+
+int64_t
+XdmfDSMBuffer::GrowLocalBuffer(int64_t rounds)
+{
+  // The maximum length is rounded down to whole blocks
+  int64_t newLength = std::min(rounds * this->BlockLength,
+                            (this->MaxLength / this->BlockLength) * this->BlockLength);
+  if (newLength > this->Length) {
+    int64_t oldLength = this->Length;
+    this->SetLength(newLength);
+    memset(this->DataPointer + oldLength, 0, newLength - oldLength);
+    this->EndAddress = this->StartAddress + newLength - 1;
+    this->TotalLength = newLength * (this->EndServerId - this->StartServerId + 1);
+  }
+  return this->Length / this->BlockLength;
+}
+
+void
+XdmfDSMBuffer::GrowServers(int64_t rounds)
+{
+  int MyId = this->Comm->GetInterId();
+  int dataComm = XDMF_DSM_INTRA_COMM;
+  if (this->Comm->GetInterComm() != MPI_COMM_NULL) {
+    dataComm = XDMF_DSM_INTER_COMM;
+  }
+  // Every server holds the same number of rounds unless one of them
+  // could not allocate, the smallest is the usable length
+  int heldRounds = -1;
+  for (int i = this->StartServerId; i <= this->EndServerId; ++i) {
+    int serverRounds;
+    if (i == MyId) {
+      serverRounds = (int)this->GrowLocalBuffer(rounds);
+    }
+    else {
+      this->SendCommandHeader(XDMF_DSM_OPCODE_GROW, i, 0, rounds, dataComm);
+      this->ReceiveAcknowledgment(i, serverRounds, XDMF_DSM_GROW_TAG, dataComm);
+    }
+    if (heldRounds < 0 || serverRounds < heldRounds) {
+      heldRounds = serverRounds;
+    }
+  }
+  // Clients only keep track of the length, they hold no data
+  if (!this->IsServer) {
+    this->Length = heldRounds * this->BlockLength;
+  }
+  this->TotalLength = heldRounds * this->BlockLength *
+                      (this->EndServerId - this->StartServerId + 1);
+}
+
+void
+XdmfDSMBuffer::GrantLocks(LockState * lock)
+{
+  // Requests are granted in order, a request that has to wait holds back
+  // the ones behind it so writers are not starved by readers
+  while (!lock->Waiting.empty()) {
+    LockState::Request request = lock->Waiting.front();
+    if (!lock->CanGrant(request.Who, request.Value)) {
+      break;
+    }
+    lock->Waiting.pop_front();
+    if (request.Value == XDMF_DSM_LOCK_WRITE) {
+      lock->Writer = request.Who;
+      ++lock->WriteCount;
+    }
+    else {
+      ++lock->Readers[request.Who];
+    }
+    this->SendAcknowledgment(request.Who,
+                             lock->Step,
+                             XDMF_DSM_LOCK_TAG,
+                             request.Comm);
+  }
+}
+
+void
+XdmfDSMBuffer::LockLocalWindows(int lockType)
+{
+  // Writes by this core into its own buffer take the same locks as the
+  // one sided and shared memory writes of other cores
+  int myId = this->Comm->GetInterId();
+  if (!this->NodeRanks.empty() && this->NodeRanks[myId] >= 0) {
+    MPI_Win_lock(lockType, this->NodeRanks[myId], 0, this->SharedWindow);
+  }
+  if (this->DataWindow != MPI_WIN_NULL) {
+    MPI_Win_lock(lockType, myId, 0, this->DataWindow);
+  }
+}
+
 void
 XdmfDSMBuffer::ProbeCommandHeader(int *comm)
 {
@@ -513,50 +1215,101 @@ XdmfDSMBuffer::ProbeCommandHeader(int *comm)
 }
 
 void
-XdmfDSMBuffer::Put(long Address, long aLength, const void *Data)
+XdmfDSMBuffer::Put(int64_t Address, int64_t aLength, const void *Data)
+{
+  this->PutRange(Address, aLength, Data, false);
+}
+
+void
+XdmfDSMBuffer::PutNonBlocking(int64_t Address, int64_t aLength, const void *Data)
+{
+  this->PutRange(Address, aLength, Data, true);
+}
+
+void
+XdmfDSMBuffer::PutRange(int64_t Address, int64_t aLength, const void *Data,
+                        bool nonBlocking)
 {
   int   who, MyId = this->Comm->GetInterId();
-  int   astart, aend, len;
+  int64_t  localAddress, localLength, len;
   char    *datap = (char *)Data;
 
   // While there is length left
   while(aLength){
     // Figure out what server core the address is located on
-    who = this->AddressToId(Address);
-    if(who == XDMF_DSM_FAIL){
-      XdmfError::message(XdmfError::FATAL, "Address Error");
-    }
-    // Get the start and end of the block listed
-    this->GetAddressRangeForId(who, &astart, &aend);
+    // and where it is stored in that core's buffer
+    this->AddressToLocation(Address, &who, &localAddress, &localLength);
     // Determine the amount of data to be written to that core
-    // Basically, it's how much data will fit from the starting point of
-    // the address to the end
-    len = std::min(aLength, aend - Address + 1);
+    // Basically, it's how much data is contiguous on that core
+    // from the starting point of the address
+    len = std::min(aLength, localLength);
     // If the data is on the core running this code, then the put is simple
     if(who == MyId){
       char *dp;
       dp = this->DataPointer;
-      dp += Address - this->StartAddress;
+      dp += localAddress;
+      this->LockLocalWindows(MPI_LOCK_EXCLUSIVE);
       memcpy(dp, datap, len);
+      this->UnlockLocalWindows();
+    }
+    else if (!this->NodePointers.empty() && this->NodePointers[who]) {
+      // Servers on this node are written directly through shared memory
+      MPI_Win_lock(MPI_LOCK_EXCLUSIVE, this->NodeRanks[who], 0, this->SharedWindow);
+      memcpy(this->NodePointers[who] + localAddress, datap, len);
+      MPI_Win_unlock(this->NodeRanks[who], this->SharedWindow);
+    }
+    else if (this->DataWindow != MPI_WIN_NULL) {
+      // Write straight into the server's buffer, the server is not involved
+      MPI_Win_lock(MPI_LOCK_EXCLUSIVE, who, 0, this->DataWindow);
+      for (int64_t offset = 0; offset < len; offset += this->MaxMessageLength) {
+        int frameLength = (int)std::min(len - offset, this->MaxMessageLength);
+        int status = MPI_Put(datap + offset,
+                             frameLength,
+                             MPI_UNSIGNED_CHAR,
+                             who,
+                             (MPI_Aint)(localAddress + offset),
+                             frameLength,
+                             MPI_UNSIGNED_CHAR,
+                             this->DataWindow);
+        if (status != MPI_SUCCESS) {
+          XdmfError::message(XdmfError::FATAL, "Error: Failed to put data in window");
+        }
+      }
+      MPI_Win_unlock(who, this->DataWindow);
     }
     else{
       // Otherwise send it to the appropriate core to deal with
-      int   status;
       int   dataComm = XDMF_DSM_INTRA_COMM;
       if (this->Comm->GetInterComm() != MPI_COMM_NULL) {
         dataComm = XDMF_DSM_INTER_COMM;
       }
-      this->SendCommandHeader(XDMF_DSM_OPCODE_PUT,
-                              who,
-                              Address - astart,
-                              len,
-                              dataComm);
-      this->SendData(who,
-                     datap, 
-                     len,
-                     XDMF_DSM_PUT_DATA_TAG,
-                     Address - astart,
-                     dataComm);
+      if (nonBlocking) {
+        // The server handles requests from a core in the order they were
+        // sent, so later puts and gets can't overtake these
+        this->SendCommandHeaderNonBlocking(XDMF_DSM_OPCODE_PUT,
+                                           who,
+                                           localAddress,
+                                           len,
+                                           dataComm);
+        this->SendDataNonBlocking(who,
+                                  datap,
+                                  len,
+                                  XDMF_DSM_PUT_DATA_TAG,
+                                  dataComm);
+      }
+      else {
+        this->SendCommandHeader(XDMF_DSM_OPCODE_PUT,
+                                who,
+                                localAddress,
+                                len,
+                                dataComm);
+        this->SendData(who,
+                       datap,
+                       len,
+                       XDMF_DSM_PUT_DATA_TAG,
+                       localAddress,
+                       dataComm);
+      }
     }
     // Shift all the numbers by the length of the data written
     // Until aLength = 0
@@ -566,6 +1319,17 @@ XdmfDSMBuffer::Put(long Address, long aLength, const void *Data)
   }
 }
 
+int64_t
+XdmfDSMBuffer::QueryLength()
+{
+  // Only block layouts grow
+  if (this->DsmType == XDMF_DSM_TYPE_BLOCK_CYCLIC ||
+      this->DsmType == XDMF_DSM_TYPE_BLOCK_RANDOM) {
+    this->GrowServers(0);
+  }
+  return this->TotalLength;
+}
+
 void
 XdmfDSMBuffer::ReceiveAcknowledgment(int source, int &data, int tag, int comm)
 {
@@ -606,7 +1370,7 @@ XdmfDSMBuffer::ReceiveAcknowledgment(int source, int &data, int tag, int comm)
 }
 
 void
-XdmfDSMBuffer::ReceiveCommandHeader(int *opcode, int *source, int *address, int *aLength, int comm, int remoteSource)
+XdmfDSMBuffer::ReceiveCommandHeader(int *opcode, int *source, int64_t *address, int64_t *aLength, int comm, int remoteSource)
 {
   CommandMsg cmd;
   memset(&cmd, 0, sizeof(CommandMsg));
@@ -619,8 +1383,8 @@ XdmfDSMBuffer::ReceiveCommandHeader(int *opcode, int *source, int *address, int
 
   if (comm == XDMF_DSM_INTRA_COMM) {
     status = MPI_Recv(&cmd,
-                      sizeof(CommandMsg),
-                      MPI_UNSIGNED_CHAR,
+                      1,
+                      this->GetCommandMsgType(),
                       remoteSource,
                       XDMF_DSM_COMMAND_TAG,
                       static_cast<XdmfDSMCommMPI *>(this->Comm)->GetIntraComm(),
@@ -628,8 +1392,8 @@ XdmfDSMBuffer::ReceiveCommandHeader(int *opcode, int *source, int *address, int
   }
   else if (comm == XDMF_DSM_INTER_COMM) {
     status = MPI_Recv(&cmd,
-                      sizeof(CommandMsg),
-                      MPI_UNSIGNED_CHAR,
+                      1,
+                      this->GetCommandMsgType(),
                       remoteSource,
                       XDMF_DSM_COMMAND_TAG,
                       static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm(),
@@ -639,8 +1403,8 @@ XdmfDSMBuffer::ReceiveCommandHeader(int *opcode, int *source, int *address, int
     // In this case the integer is probably a pointer to an MPI_Comm object
     MPI_Comm tempComm = MPI_Comm_f2c(comm);
     status = MPI_Recv(&cmd,
-                      sizeof(CommandMsg),
-                      MPI_UNSIGNED_CHAR,
+                      1,
+                      this->GetCommandMsgType(),
                       remoteSource,
                       XDMF_DSM_COMMAND_TAG,
                       tempComm,
@@ -659,40 +1423,40 @@ XdmfDSMBuffer::ReceiveCommandHeader(int *opcode, int *source, int *address, int
 }
 
 void
-XdmfDSMBuffer::ReceiveData(int source, char * data, int aLength, int tag, int aAddress, int comm)
+XdmfDSMBuffer::ReceiveData(int source, char * data, int64_t aLength, int tag, int64_t, int comm)
 {
   int status;
   MPI_Status signalStatus;
+  MPI_Comm dataComm;
   if (comm == XDMF_DSM_INTRA_COMM) {
-    status = MPI_Recv(data,
-                      aLength,
-                      MPI_UNSIGNED_CHAR,
-                      source,
-                      tag,
-                      static_cast<XdmfDSMCommMPI *>(this->Comm)->GetIntraComm(),
-                      &signalStatus);
+    dataComm = static_cast<XdmfDSMCommMPI *>(this->Comm)->GetIntraComm();
   }
   else if (comm == XDMF_DSM_INTER_COMM) {
-    status = MPI_Recv(data,
-                      aLength,
-                      MPI_UNSIGNED_CHAR,
-                      source,
-                      tag,
-                      static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm(),
-                      &signalStatus);
+    dataComm = static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm();
   }
   else {
-    MPI_Comm tempComm = MPI_Comm_f2c(comm);
+    dataComm = MPI_Comm_f2c(comm);
+  }
+  // Frames arrive in the order they were sent by SendData, the sender
+  // picks their length so each receive takes whatever arrived
+  while (aLength > 0) {
+    int frameLength = (int)std::min(aLength, XDMF_DSM_MAX_MESSAGE_LENGTH);
     status = MPI_Recv(data,
-                      aLength,
+                      frameLength,
                       MPI_UNSIGNED_CHAR,
                       source,
                       tag,
-                      tempComm,
+                      dataComm,
                       &signalStatus);
-  }
-  if (status != MPI_SUCCESS) {
-    XdmfError::message(XdmfError::FATAL, "Error: Failed to receive data");
+    if (status != MPI_SUCCESS) {
+      XdmfError::message(XdmfError::FATAL, "Error: Failed to receive data");
+    }
+    MPI_Get_count(&signalStatus, MPI_UNSIGNED_CHAR, &frameLength);
+    if (frameLength <= 0) {
+      XdmfError::message(XdmfError::FATAL, "Error: Received an empty data frame");
+    }
+    data += frameLength;
+    aLength -= frameLength;
   }
 }
 
@@ -722,8 +1486,8 @@ XdmfDSMBuffer::ReceiveInfo()
     }
   }
   status = MPI_Bcast(&dsmInfo, 
-                     sizeof(InfoMsg),
-                     MPI_UNSIGNED_CHAR,
+                     1,
+                     this->GetInfoMsgType(),
                      sendCore,
                      static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm());
   if (status != MPI_SUCCESS) {
@@ -734,8 +1498,39 @@ XdmfDSMBuffer::ReceiveInfo()
   this->SetLength(dsmInfo.length);
   this->TotalLength = dsmInfo.total_length;
   this->SetBlockLength(dsmInfo.block_length);
+  this->SetMaxLength(dsmInfo.max_length);
+  this->SetRandomSeed(dsmInfo.random_seed);
+  this->SetTransportType(dsmInfo.transport_type);
+  this->SetUseSharedMemory(dsmInfo.use_shared_memory != 0);
   this->StartServerId = dsmInfo.start_server_id;
   this->EndServerId = dsmInfo.end_server_id;
+  // The file table must be laid out the same way on every core
+  this->SetFileSlots(dsmInfo.file_slots);
+  this->SetFileLocking(dsmInfo.file_locking != 0);
+  this->SetAllocationLength(dsmInfo.allocation_length);
+  if (this->UseSharedMemory) {
+    this->CreateSharedWindow();
+  }
+  if (this->TransportType == XDMF_DSM_TRANSPORT_RMA) {
+    this->CreateDataWindow();
+  }
+}
+
+void
+XdmfDSMBuffer::ReleaseLock(int lockId, int mode, bool newStep)
+{
+  int dataComm = XDMF_DSM_INTRA_COMM;
+  if (this->Comm->GetInterComm() != MPI_COMM_NULL) {
+    dataComm = XDMF_DSM_INTER_COMM;
+  }
+  if (newStep && mode == XDMF_DSM_LOCK_WRITE) {
+    mode |= XDMF_DSM_LOCK_STEP;
+  }
+  this->SendCommandHeader(XDMF_DSM_LOCK_RELEASE,
+                          this->GetLockServerId(lockId),
+                          lockId,
+                          mode,
+                          dataComm);
 }
 
 void
@@ -787,7 +1582,7 @@ XdmfDSMBuffer::SendAcknowledgment(int dest, int data, int tag, int comm)
 }
 
 void
-XdmfDSMBuffer::SendCommandHeader(int opcode, int dest, int address, int aLength, int comm)
+XdmfDSMBuffer::SendCommandHeader(int opcode, int dest, int64_t address, int64_t aLength, int comm)
 {
   int status;
   CommandMsg cmd;
@@ -800,8 +1595,8 @@ XdmfDSMBuffer::SendCommandHeader(int opcode, int dest, int address, int aLength,
 
   if (comm == XDMF_DSM_INTRA_COMM) {
     status = MPI_Send(&cmd,
-                      sizeof(CommandMsg),
-                      MPI_UNSIGNED_CHAR,
+                      1,
+                      this->GetCommandMsgType(),
                       dest,
                       XDMF_DSM_COMMAND_TAG,
                       static_cast<XdmfDSMCommMPI *>(this->Comm)->GetIntraComm());
@@ -811,8 +1606,8 @@ XdmfDSMBuffer::SendCommandHeader(int opcode, int dest, int address, int aLength,
     MPI_Comm_rank(static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm(), &interSource);
     cmd.Source = interSource;
     status = MPI_Send(&cmd,
-                      sizeof(CommandMsg),
-                      MPI_UNSIGNED_CHAR,
+                      1,
+                      this->GetCommandMsgType(),
                       dest,
                       XDMF_DSM_COMMAND_TAG,
                       static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm());
@@ -821,8 +1616,8 @@ XdmfDSMBuffer::SendCommandHeader(int opcode, int dest, int address, int aLength,
     // In this case the comm should be a pointer to an MPI_Comm object
     MPI_Comm tempComm = MPI_Comm_f2c(comm);
     status = MPI_Send(&cmd,
-                      sizeof(CommandMsg),
-                      MPI_UNSIGNED_CHAR,
+                      1,
+                      this->GetCommandMsgType(),
                       dest,
                       XDMF_DSM_COMMAND_TAG,
                       tempComm);
@@ -833,31 +1628,106 @@ XdmfDSMBuffer::SendCommandHeader(int opcode, int dest, int address, int aLength,
 }
 
 void
-XdmfDSMBuffer::SendData(int dest, char * data, int aLength, int tag, int aAddress, int comm)
+XdmfDSMBuffer::SendCommandHeaderNonBlocking(int opcode, int dest, int64_t address, int64_t aLength, int comm)
 {
   int status;
+  MPI_Request request;
+  // The header has to outlive the send, it is released by WaitNonBlocking
+  CommandMsg * cmd = new CommandMsg();
+  memset(cmd, 0, sizeof(CommandMsg));
+  cmd->Opcode = opcode;
+  cmd->Source = this->Comm->GetId();
+  cmd->Target = dest;
+  cmd->Address = address;
+  cmd->Length = aLength;
+
+  MPI_Comm headerComm;
   if (comm == XDMF_DSM_INTRA_COMM) {
-    status = MPI_Send(data,
-                      aLength,
-                      MPI_UNSIGNED_CHAR,
-                      dest,
-                      tag,
-                       static_cast<XdmfDSMCommMPI *>(this->Comm)->GetIntraComm());
+    headerComm = static_cast<XdmfDSMCommMPI *>(this->Comm)->GetIntraComm();
+  }
+  else if (comm == XDMF_DSM_INTER_COMM) {
+    headerComm = static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm();
+    MPI_Comm_rank(headerComm, &cmd->Source);
+  }
+  else {
+    headerComm = MPI_Comm_f2c(comm);
+  }
+  status = MPI_Isend(cmd,
+                     1,
+                     this->GetCommandMsgType(),
+                     dest,
+                     XDMF_DSM_COMMAND_TAG,
+                     headerComm,
+                     &request);
+  this->PendingCommands.push_back(cmd);
+  if (status != MPI_SUCCESS) {
+    XdmfError::message(XdmfError::FATAL, "Error: Failed to send command header");
+  }
+  this->PendingRequests.push_back(request);
+}
+
+void
+XdmfDSMBuffer::SendData(int dest, char * data, int64_t aLength, int tag, int64_t, int comm)
+{
+  int status;
+  MPI_Comm dataComm;
+  if (comm == XDMF_DSM_INTRA_COMM) {
+    dataComm = static_cast<XdmfDSMCommMPI *>(this->Comm)->GetIntraComm();
   }
   else if (comm == XDMF_DSM_INTER_COMM) {
+    dataComm = static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm();
+  }
+  else {
+    dataComm = MPI_Comm_f2c(comm);
+  }
+  // MPI counts are int, so large transfers are split into frames
+  while (aLength > 0) {
+    int frameLength = (int)std::min(aLength, this->MaxMessageLength);
     status = MPI_Send(data,
-                      aLength,
+                      frameLength,
                       MPI_UNSIGNED_CHAR,
                       dest,
                       tag,
-                      static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm());
+                      dataComm);
+    if (status != MPI_SUCCESS) {
+      XdmfError::message(XdmfError::FATAL, "Error: Failed to send data");
+    }
+    data += frameLength;
+    aLength -= frameLength;
+  }
+}
+
+void
+XdmfDSMBuffer::SendDataNonBlocking(int dest, const char * data, int64_t aLength, int tag, int comm)
+{
+  int status;
+  MPI_Comm dataComm;
+  if (comm == XDMF_DSM_INTRA_COMM) {
+    dataComm = static_cast<XdmfDSMCommMPI *>(this->Comm)->GetIntraComm();
+  }
+  else if (comm == XDMF_DSM_INTER_COMM) {
+    dataComm = static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm();
   }
   else {
-    MPI_Comm tempComm = MPI_Comm_f2c(comm);
-    status = MPI_Send(data, aLength, MPI_UNSIGNED_CHAR, dest, tag, tempComm);
+    dataComm = MPI_Comm_f2c(comm);
   }
-  if (status != MPI_SUCCESS) {
-    XdmfError::message(XdmfError::FATAL, "Error: Failed to send data");
+  // Framed the same way as SendData so ReceiveData can take it
+  while (aLength > 0) {
+    MPI_Request request;
+    int frameLength = (int)std::min(aLength, this->MaxMessageLength);
+    status = MPI_Isend(const_cast<char *>(data),
+                       frameLength,
+                       MPI_UNSIGNED_CHAR,
+                       dest,
+                       tag,
+                       dataComm,
+                       &request);
+    if (status != MPI_SUCCESS) {
+      XdmfError::message(XdmfError::FATAL, "Error: Failed to send data");
+    }
+    this->PendingRequests.push_back(request);
+    data += frameLength;
+    aLength -= frameLength;
   }
 }
 
@@ -893,8 +1763,15 @@ XdmfDSMBuffer::SendInfo()
   dsmInfo.length = this->GetLength();
   dsmInfo.total_length = this->GetTotalLength();
   dsmInfo.block_length = this->GetBlockLength();
+  dsmInfo.max_length = this->GetMaxLength();
+  dsmInfo.allocation_length = this->GetAllocationLength();
+  dsmInfo.random_seed = this->GetRandomSeed();
+  dsmInfo.transport_type = this->GetTransportType();
+  dsmInfo.use_shared_memory = this->GetUseSharedMemory();
   dsmInfo.start_server_id = this->GetStartServerId();
   dsmInfo.end_server_id = this->GetEndServerId();
+  dsmInfo.file_locking = this->GetFileLocking();
+  dsmInfo.file_slots = this->GetFileSlots();
 
   int infoStatus = 3;
   if (this->Comm->GetId() == 0) {
@@ -920,17 +1797,33 @@ XdmfDSMBuffer::SendInfo()
   }
 
   status = MPI_Bcast(&dsmInfo,
-                     sizeof(InfoMsg),
-                     MPI_UNSIGNED_CHAR,
+                     1,
+                     this->GetInfoMsgType(),
                      sendCore,
                      static_cast<XdmfDSMCommMPI *>(this->Comm)->GetInterComm());
   if (status != MPI_SUCCESS) {
     XdmfError::message(XdmfError::FATAL, "Error: Failed to send info");
   }
+  if (this->UseSharedMemory) {
+    this->CreateSharedWindow();
+  }
+  if (this->TransportType == XDMF_DSM_TRANSPORT_RMA) {
+    this->CreateDataWindow();
+  }
+}
+
+void
+XdmfDSMBuffer::SetAllocationLength(int64_t newAllocationLength)
+{
+  if (newAllocationLength < 0) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: The allocation length can not be negative");
+  }
+  this->AllocationLength = newAllocationLength;
 }
 
 void
-XdmfDSMBuffer::SetBlockLength(long newBlock)
+XdmfDSMBuffer::SetBlockLength(int64_t newBlock)
 {
   this->BlockLength = newBlock;
 }
@@ -947,6 +1840,22 @@ XdmfDSMBuffer::SetDsmType(int newDsmType)
   this->DsmType = newDsmType;
 }
 
+void
+XdmfDSMBuffer::SetFileLocking(bool newFileLocking)
+{
+  this->FileLocking = newFileLocking;
+}
+
+void
+XdmfDSMBuffer::SetFileSlots(unsigned int newFileSlots)
+{
+  if (newFileSlots < 1) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: The DSM needs at least one file slot");
+  }
+  this->FileSlots = newFileSlots;
+}
+
 void
 XdmfDSMBuffer::SetIsConnected(bool newStatus)
 {
@@ -960,8 +1869,12 @@ XdmfDSMBuffer::SetIsServer(bool newIsServer)
 }
 
 void
-XdmfDSMBuffer::SetLength(long aLength)
+XdmfDSMBuffer::SetLength(int64_t aLength)
 {
+  if (this->SharedStorage) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Unable to resize a DSM buffer in shared memory");
+  }
   this->Length = aLength;
   if (this->DataPointer) {
     // Try to reallocate
@@ -990,3 +1903,83 @@ XdmfDSMBuffer::SetLength(long aLength)
     XdmfError::message(XdmfError::FATAL, message.str());
   }
 }
+
+void
+XdmfDSMBuffer::SetMaxLength(int64_t newMaxLength)
+{
+  this->MaxLength = newMaxLength;
+}
+
+void
+XdmfDSMBuffer::SetMaxMessageLength(int64_t newMaxMessageLength)
+{
+  if (newMaxMessageLength <= 0 || newMaxMessageLength > XDMF_DSM_MAX_MESSAGE_LENGTH) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Message length must be positive and no larger "
+                       "than XDMF_DSM_MAX_MESSAGE_LENGTH");
+  }
+  this->MaxMessageLength = newMaxMessageLength;
+}
+
+void
+XdmfDSMBuffer::SetRandomSeed(unsigned int newSeed)
+{
+  this->RandomSeed = newSeed;
+  this->RandomRound = -1;
+}
+
+void
+XdmfDSMBuffer::SetTransportType(int newTransportType)
+{
+  this->TransportType = newTransportType;
+}
+
+void
+XdmfDSMBuffer::SetUseSharedMemory(bool newUseShared)
+{
+  this->UseSharedMemory = newUseShared;
+}
+
+void
+XdmfDSMBuffer::UnlockLocalWindows()
+{
+  int myId = this->Comm->GetInterId();
+  if (this->DataWindow != MPI_WIN_NULL) {
+    MPI_Win_unlock(myId, this->DataWindow);
+  }
+  if (!this->NodeRanks.empty() && this->NodeRanks[myId] >= 0) {
+    MPI_Win_unlock(this->NodeRanks[myId], this->SharedWindow);
+  }
+}
+
+int
+XdmfDSMBuffer::WaitForStep(int lockId, int step)
+{
+  int dataComm = XDMF_DSM_INTRA_COMM;
+  if (this->Comm->GetInterComm() != MPI_COMM_NULL) {
+    dataComm = XDMF_DSM_INTER_COMM;
+  }
+  int server = this->GetLockServerId(lockId);
+  this->SendCommandHeader(XDMF_DSM_LOCK_WAIT, server, lockId, step, dataComm);
+  int newStep;
+  this->ReceiveAcknowledgment(server, newStep, XDMF_DSM_LOCK_TAG, dataComm);
+  return newStep;
+}
+
+void
+XdmfDSMBuffer::WaitNonBlocking()
+{
+  if (this->PendingRequests.size() > 0) {
+    int status = MPI_Waitall((int)this->PendingRequests.size(),
+                             &this->PendingRequests[0],
+                             MPI_STATUSES_IGNORE);
+    if (status != MPI_SUCCESS) {
+      XdmfError::message(XdmfError::FATAL, "Error: Failed to complete sends");
+    }
+    this->PendingRequests.clear();
+  }
+  for (unsigned int i = 0; i < this->PendingCommands.size(); ++i) {
+    delete this->PendingCommands[i];
+  }
+  this->PendingCommands.clear();
+}
@@ -58,7 +58,10 @@
 // Includes
 #include <XdmfDSM.hpp>
 #include <XdmfDSMCommMPI.hpp>
+#include <map>
+#include <stdint.h>
 #include <mpi.h>
+#include <vector>
 
 #define XDMF_DSM_DEFAULT_TAG    0x80
 #define XDMF_DSM_COMMAND_TAG    0x81
@@ -67,6 +70,8 @@
 #define XDMF_DSM_PUT_DATA_TAG   0x84
 #define XDMF_DSM_GET_DATA_TAG   0x85
 #define XDMF_DSM_EXCHANGE_TAG   0x86
+#define XDMF_DSM_LOCK_TAG       0x87
+#define XDMF_DSM_GROW_TAG       0x88
 
 #define XDMF_DSM_ANY_TAG        -1
 #define XDMF_DSM_ANY_SOURCE     -2
@@ -77,15 +82,33 @@
 #define XDMF_DSM_TYPE_BLOCK_CYCLIC  3
 #define XDMF_DSM_TYPE_BLOCK_RANDOM  4
 
+#define XDMF_DSM_TRANSPORT_MESSAGE  0
+#define XDMF_DSM_TRANSPORT_RMA      1
+
+#define XDMF_DSM_LOCK_READ          1
+#define XDMF_DSM_LOCK_WRITE         2
+// Combined with the mode of a released write lock to mark a new step
+#define XDMF_DSM_LOCK_STEP          4
+
 #define XDMF_DSM_DEFAULT_LENGTH 10000
 #define XDMF_DSM_DEFAULT_BLOCK_LENGTH 1024
+#define XDMF_DSM_DEFAULT_RANDOM_SEED 0x5D5A1E9B
 #define XDMF_DSM_ALIGNMENT 4096
+// Files reserve DSM space in multiples of this length
+#define XDMF_DSM_DEFAULT_ALLOCATION_LENGTH 1048576
+
+// Largest single MPI transfer, larger transfers are split into frames
+// since MPI counts are int
+#define XDMF_DSM_MAX_MESSAGE_LENGTH 0x40000000L
 
 #define XDMF_DSM_OPCODE_PUT          0x01
 #define XDMF_DSM_OPCODE_GET          0x02
 
 #define XDMF_DSM_LOCK_ACQUIRE        0x03
 #define XDMF_DSM_LOCK_RELEASE        0x05
+#define XDMF_DSM_LOCK_WAIT           0x06
+
+#define XDMF_DSM_OPCODE_GROW         0x07
 
 #define XDMF_DSM_ACCEPT              0x10
 #define XDMF_DSM_DISCONNECT          0x11
@@ -110,8 +133,76 @@ public:
   XdmfDSMBuffer();
   ~XdmfDSMBuffer();
 
+  /**
+   * Acquires a lock from the server that owns it, waiting until it is
+   * granted. Any number of cores may hold a lock for reading, a core
+   * holding it for writing excludes all others. Requests are granted in
+   * the order the server receives them. A core that already holds a lock
+   * is granted it again immediately, it must release it as many times.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#AcquireLock
+   * @until //#AcquireLock
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//AcquireLock
+   * @until #//AcquireLock
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     lockId  The lock to acquire, a non negative number chosen
+   *                    by the caller
+   * @param     mode    XDMF_DSM_LOCK_READ or XDMF_DSM_LOCK_WRITE
+   * @return            The number of steps released for the lock so far
+   */
+  int AcquireLock(int lockId, int mode);
+
   /**
    * Find the Id of the core that the provided address resides on.
+   * For block cyclic and block random DSMs this is the core holding the
+   * block that contains the address.
    *
    * Example of use:
    *
@@ -168,7 +259,59 @@ public:
    * @param     Address         The address to be found
    * @return                    The id of the core that the address resides on
    */
-  int AddressToId(int Address);
+  int AddressToId(int64_t Address);
+
+  /**
+   * Find where the provided address is stored: the Id of the core it
+   * resides on, its offset in that core's local buffer and the number of
+   * bytes from that offset that are contiguous in both the global address
+   * space and the local buffer. For uniform DSMs that run continues to the
+   * end of the core's buffer, for block cyclic and block random DSMs it
+   * ends with the block containing the address.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#AddressToLocation
+   * @until //#AddressToLocation
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python:
+   * Unusable in python unless an object of a cpointer type is passed via
+   * wrapped code
+   *
+   * @param     Address         The address to be found
+   * @param     Id              A pointer in which the id of the core is
+   *                            to be placed
+   * @param     LocalAddress    A pointer in which the offset in the core's
+   *                            buffer is to be placed
+   * @param     LocalLength     A pointer in which the number of contiguous
+   *                            bytes is to be placed
+   */
+  void AddressToLocation(int64_t Address, int *Id, int64_t *LocalAddress, int64_t *LocalLength);
 
   /**
    * Broadcasts the provided comm from the specified core to all other cores. 
@@ -406,9 +549,96 @@ public:
    * @param     random          Whether the assignment is random or cyclic.
    *                            Default is cyclic
    */
-  void ConfigureUniform(XdmfDSMCommMPI *Comm, long Length,
+  void ConfigureUniform(XdmfDSMCommMPI *Comm, int64_t Length,
                         int StartId = -1, int EndId = -1,
-                        long aBlockLength = 0, bool random = false);
+                        int64_t aBlockLength = 0, bool random = false);
+
+  /**
+   * Creates the MPI window used by the RMA transport over the
+   * communicator connecting the servers and clients. Server cores expose
+   * their data buffer, other cores join the window without memory.
+   * This is collective over the communicator and is called when the DSM
+   * information is exchanged if the transport type is
+   * XDMF_DSM_TRANSPORT_RMA. An existing window is freed first.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetTransportTypebuffer
+   * @until //#GetTransportTypebuffer
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python: Collective over the cores connected to the DSM, it is called
+   * as part of the DSM setup and not meant to be called from python
+   */
+  void CreateDataWindow();
+
+  /**
+   * Creates the MPI shared memory window used by cores on the same node.
+   * Servers move their buffer into memory allocated with
+   * MPI_Win_allocate_shared so that clients on their node can copy
+   * to and from it directly. Cores on other nodes still use the
+   * message or RMA transport. This is collective over the cores
+   * connected to the DSM and is called when the DSM information is
+   * exchanged if shared memory is enabled.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetUseSharedMemorybuffer
+   * @until //#GetUseSharedMemorybuffer
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python: Collective over the cores connected to the DSM, it is called
+   * as part of the DSM setup and not meant to be called from python
+   */
+  void CreateSharedWindow();
 
   /**
    * Gets data from the server cores.
@@ -457,10 +687,13 @@ public:
    * @param     Data            A pointer in which the data is to be stored
    *                            after retieval
    */
-  void Get(long Address, long aLength, void *Data);
+  void Get(int64_t Address, int64_t aLength, void *Data);
 
   /**
-   * Gets the starting address and ending address for the core of the provided Id.
+   * Frees the MPI window used by the RMA transport, after this Put and
+   * Get send their data as messages again. This is collective over the
+   * communicator the window was created on and is called when the buffer
+   * is destroyed.
    *
    * Example of use:
    *
@@ -483,8 +716,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetAddressRangeForId
-   * @until //#GetAddressRangeForId
+   * @skipline //#GetTransportTypebuffer
+   * @until //#GetTransportTypebuffer
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -492,21 +725,15 @@ public:
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
-   * Python:
-   * Unusable in python unless an object of a cpointer type is passed via
-   * wrapped code
-   *
-   *
-   *
-   * @param     Id      The core for which the start and end address are
-   *                    to be found
-   * @param     Start   A pointer in which the start address is to be placed
-   * @param     End     A pointer in which the end address is to be placed
+   * Python: Collective over the cores connected to the DSM, it is called
+   * as part of the DSM setup and not meant to be called from python
    */
-  void GetAddressRangeForId(int Id, int *Start, int *End);
+  void FreeDataWindow();
 
   /**
-   * Gets the size of the blocks for the data buffer.
+   * Frees the MPI shared memory window, moving the buffer of a server
+   * back to private memory. This is collective over the cores connected
+   * to the DSM and is called when the buffer is destroyed.
    *
    * Example of use:
    *
@@ -529,8 +756,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetBlockLengthbuffer
-   * @until //#GetBlockLengthbuffer
+   * @skipline //#GetUseSharedMemorybuffer
+   * @until //#GetUseSharedMemorybuffer
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -538,34 +765,14 @@ public:
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
-   * Python
-   *
-   * @dontinclude XdmfExampleDSMNoThread.py
-   * @skipline #//initMPI
-   * @until #//initMPI
-   * @skipline #//initwritevector
-   * @until #//initwritevector
-   * @skipline #//initwritergenerate
-   * @until #//initwritergenerate
-   * @skipline #//startworksection
-   * @until #//startworksection
-   * @skipline #//getServerManagerwriter
-   * @until #//getServerManagerwriter
-   * @skipline #//GetDsmBuffer
-   * @until #//GetDsmBuffer
-   * @skipline #//GetBlockLength
-   * @until #//GetBlockLength
-   * @skipline #//stopDSMwriter
-   * @until #//stopDSMwriter
-   * @skipline #//finalizeMPI
-   * @until #//finalizeMPI
-   *
-   * @return      The size of the blocks in the DSM buffer
+   * Python: Collective over the cores connected to the DSM, it is called
+   * as part of the DSM setup and not meant to be called from python
    */
-  long GetBlockLength();
+  void FreeSharedWindow();
 
   /**
-   * Gets the Comm being used to facilitate the communications for the DSM
+   * Gets the length that files in the DSM reserve space in multiples
+   * of. See xdmf_dsm_set_allocation_length.
    *
    * Example of use:
    *
@@ -588,8 +795,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetComm
-   * @until //#GetComm
+   * @skipline //#GetAllocationLength
+   * @until //#GetAllocationLength
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -612,20 +819,19 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetComm
-   * @until #//GetComm
+   * @skipline #//GetAllocationLength
+   * @until #//GetAllocationLength
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @return      The Comm controlling the communications for the DSM
+   * @return    The allocation granularity in bytes
    */
-  XdmfDSMCommMPI * GetComm();
+  int64_t GetAllocationLength();
 
   /**
-   * Gets the data pointer that the buffer controls.
-   * Should be NULL on non-server cores.
+   * Gets the starting address and ending address for the core of the provided Id.
    *
    * Example of use:
    *
@@ -648,8 +854,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetDataPointer
-   * @until //#GetDataPointer
+   * @skipline //#GetAddressRangeForId
+   * @until //#GetAddressRangeForId
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -657,34 +863,23 @@ public:
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
-   * Python
+   * Python:
+   * Unusable in python unless an object of a cpointer type is passed via
+   * wrapped code
    *
-   * @dontinclude XdmfExampleDSMNoThread.py
-   * @skipline #//initMPI
-   * @until #//initMPI
-   * @skipline #//initwritevector
-   * @until #//initwritevector
-   * @skipline #//initwritergenerate
-   * @until #//initwritergenerate
-   * @skipline #//startworksection
-   * @until #//startworksection
-   * @skipline #//getServerManagerwriter
-   * @until #//getServerManagerwriter
-   * @skipline #//GetDsmBuffer
-   * @until #//GetDsmBuffer
-   * @skipline #//GetDataPointer
-   * @until #//GetDataPointer
-   * @skipline #//stopDSMwriter
-   * @until #//stopDSMwriter
-   * @skipline #//finalizeMPI
-   * @until #//finalizeMPI
+   * For block cyclic and block random DSMs the range runs from the first
+   * address of the core's first block to the last address of its last
+   * block, blocks of other cores are interleaved within it.
    *
-   * @return    The buffer's internal data pointer.
+   * @param     Id      The core for which the start and end address are
+   *                    to be found
+   * @param     Start   A pointer in which the start address is to be placed
+   * @param     End     A pointer in which the end address is to be placed
    */
-  char * GetDataPointer();
+  void GetAddressRangeForId(int Id, int64_t *Start, int64_t *End);
 
   /**
-   * Gets the DSM type currently being used.
+   * Gets the size of the blocks for the data buffer.
    *
    * Example of use:
    *
@@ -707,8 +902,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetDsmTypebuffer
-   * @until //#GetDsmTypebuffer
+   * @skipline //#GetBlockLengthbuffer
+   * @until //#GetBlockLengthbuffer
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -731,19 +926,19 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetDsmTypebuffer
-   * @until #//GetDsmTypebuffer
+   * @skipline #//GetBlockLength
+   * @until #//GetBlockLength
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @return    The integer representation of the DSM type
+   * @return      The size of the blocks in the DSM buffer
    */
-  int GetDsmType();
+  int64_t GetBlockLength();
 
   /**
-   * Gets the address at the end of DSM buffer for this buffer.
+   * Gets the Comm being used to facilitate the communications for the DSM
    *
    * Example of use:
    *
@@ -766,8 +961,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetEndAddress
-   * @until //#GetEndAddress
+   * @skipline //#GetComm
+   * @until //#GetComm
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -790,19 +985,20 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetEndAddress
-   * @until #//GetEndAddress
+   * @skipline #//GetComm
+   * @until #//GetComm
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @return    The end address of the DSM buffer
+   * @return      The Comm controlling the communications for the DSM
    */
-  int GetEndAddress();
+  XdmfDSMCommMPI * GetComm();
 
   /**
-   * Gets the id of the last of the server cores that handle the DSM buffer.
+   * Gets the data pointer that the buffer controls.
+   * Should be NULL on non-server cores.
    *
    * Example of use:
    *
@@ -825,8 +1021,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetEndServerId
-   * @until //#GetEndServerId
+   * @skipline //#GetDataPointer
+   * @until //#GetDataPointer
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -849,19 +1045,19 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetEndServerId
-   * @until #//GetEndServerId
+   * @skipline #//GetDataPointer
+   * @until #//GetDataPointer
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @return    The id of the last core that serves as a DSM server
+   * @return    The buffer's internal data pointer.
    */
-  int GetEndServerId();
+  char * GetDataPointer();
 
   /**
-   * Gets if the Buffer is connected to an intercomm
+   * Gets the DSM type currently being used.
    *
    * Example of use:
    *
@@ -884,8 +1080,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetIsConnectedbuffer
-   * @until //#GetIsConnectedbuffer
+   * @skipline //#GetDsmTypebuffer
+   * @until //#GetDsmTypebuffer
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -908,19 +1104,19 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetIsConnectedbuffer
-   * @until #//GetIsConnectedbuffer
+   * @skipline #//GetDsmTypebuffer
+   * @until #//GetDsmTypebuffer
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @return    Whether the buffer is connected
+   * @return    The integer representation of the DSM type
    */
-  bool GetIsConnected();
+  int GetDsmType();
 
   /**
-   * Gets if the buffer is a DSM server.
+   * Gets the address at the end of DSM buffer for this buffer.
    *
    * Example of use:
    *
@@ -943,8 +1139,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetIsServerbuffer
-   * @until //#GetIsServerbuffer
+   * @skipline //#GetEndAddress
+   * @until //#GetEndAddress
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -967,19 +1163,19 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetIsServerbuffer
-   * @until #//GetIsServerbuffer
+   * @skipline #//GetEndAddress
+   * @until #//GetEndAddress
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @return    If the Buffer is a DSM server
+   * @return    The end address of the DSM buffer
    */
-  bool GetIsServer();
+  int64_t GetEndAddress();
 
   /**
-   * The length of the buffer per core.
+   * Gets the id of the last of the server cores that handle the DSM buffer.
    *
    * Example of use:
    *
@@ -1002,8 +1198,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetLength
-   * @until //#GetLength
+   * @skipline //#GetEndServerId
+   * @until //#GetEndServerId
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1026,19 +1222,20 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetLength
-   * @until #//GetLength
+   * @skipline #//GetEndServerId
+   * @until #//GetEndServerId
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @return    The length of the data buffer per core
+   * @return    The id of the last core that serves as a DSM server
    */
-  long GetLength();
+  int GetEndServerId();
 
   /**
-   * Gets the address at the beginning of the DSM buffer for this buffer.
+   * Gets whether files in the DSM are locked while they are open.
+   * See xdmf_dsm_set_file_locking.
    *
    * Example of use:
    *
@@ -1061,8 +1258,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetStartAddress
-   * @until //#GetStartAddress
+   * @skipline //#GetFileLocking
+   * @until //#GetFileLocking
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1085,19 +1282,20 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetStartAddress
-   * @until #//GetStartAddress
+   * @skipline #//GetFileLocking
+   * @until #//GetFileLocking
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @return    The beginning address of the DSM buffer
+   * @return    Whether files are locked while open
    */
-  int GetStartAddress();
+  bool GetFileLocking();
 
   /**
-   * Gets the id of the first of the server cores that handle the DSM buffer.
+   * Gets the number of files the DSM holds at once. See
+   * xdmf_dsm_set_file_slots.
    *
    * Example of use:
    *
@@ -1120,8 +1318,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetStartServerId
-   * @until //#GetStartServerId
+   * @skipline //#GetFileSlots
+   * @until //#GetFileSlots
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1144,19 +1342,19 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetStartServerId
-   * @until #//GetStartServerId
+   * @skipline #//GetFileSlots
+   * @until #//GetFileSlots
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @return    The id of the first core that serves as a DSM server
+   * @return    The number of entries in the file table
    */
-  int GetStartServerId();
+  unsigned int GetFileSlots();
 
   /**
-   * The total length of the data buffer when combining the buffers in all cores.
+   * Gets if the Buffer is connected to an intercomm
    *
    * Example of use:
    *
@@ -1179,8 +1377,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetTotalLength
-   * @until //#GetTotalLength
+   * @skipline //#GetIsConnectedbuffer
+   * @until //#GetIsConnectedbuffer
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1203,20 +1401,19 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetTotalLength
-   * @until #//GetTotalLength
+   * @skipline #//GetIsConnectedbuffer
+   * @until #//GetIsConnectedbuffer
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @return    The total length of the data buffer
+   * @return    Whether the buffer is connected
    */
-  long GetTotalLength();
+  bool GetIsConnected();
 
   /**
-   * Probes inter and intra comms until a command is found.
-   * Then sets the comm that the command was found on to the provided variable
+   * Gets if the buffer is a DSM server.
    *
    * Example of use:
    *
@@ -1239,8 +1436,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#CommandHeader
-   * @until //#CommandHeader
+   * @skipline //#GetIsServerbuffer
+   * @until //#GetIsServerbuffer
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1248,19 +1445,34 @@ public:
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
-   * Python:
-   * Unusable in python unless an object of a cpointer type is passed via wrapped code
-   *
+   * Python
    *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetIsServerbuffer
+   * @until #//GetIsServerbuffer
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
    *
-   * @param     comm    a pointer to the variable that the integer code for the
-   *                    comm is placed in
+   * @return    If the Buffer is a DSM server
    */
-  void ProbeCommandHeader(int *comm);
+  bool GetIsServer();
 
   /**
-   * Puts data to the server cores.
-   * It is not advised to use this function manually.
+   * The length of the buffer per core.
    *
    * Example of use:
    *
@@ -1283,8 +1495,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#PutGet
-   * @until //#PutGet
+   * @skipline //#GetLength
+   * @until //#GetLength
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1292,23 +1504,34 @@ public:
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
-   * Python:
-   * Unusable in python unless an object of a cpointer type is passed
-   * via wrapped code
-   * Use the XdmfHDF5WriterDSM for this functionality
-   *
+   * Python
    *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetLength
+   * @until #//GetLength
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
    *
-   * @param     Address         The starting address that the data will
-   *                            be placed at
-   * @param     aLength         The length of the data to be sent
-   * @param     Data            A pointer to the data to be sent
+   * @return    The length of the data buffer per core
    */
-  void Put(long Address, long aLength, const void *Data);
+  int64_t GetLength();
 
   /**
-   * Recieves an integer as an acknowledgement from the specified core.
-   * It is not advised to use this function manually.
+   * Gets the Id of the server core that handles the provided lock.
    *
    * Example of use:
    *
@@ -1331,8 +1554,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#SendRecvAcknowledgement
-   * @until //#SendRecvAcknowledgement
+   * @skipline //#GetLockServerId
+   * @until //#GetLockServerId
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1340,7 +1563,8 @@ public:
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
-   * Python:
+   * Python
+   *
    * @dontinclude XdmfExampleDSMNoThread.py
    * @skipline #//initMPI
    * @until #//initMPI
@@ -1354,26 +1578,22 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//SendAcknowledgment
-   * @until #//SendAcknowledgment
-   * @skipline #//ReceiveAcknowledgment
-   * @until #//ReceiveAcknowledgment
+   * @skipline #//GetLockServerId
+   * @until #//GetLockServerId
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @param     source  The core to recieve from
-   * @param     data    The integer that the recieved data will be stored in
-   * @param     tag     The tag associated with the acknowledgement
-   * @param     comm    The comm over which the acknowldedgement will occur
+   * @param     lockId  The lock to find the server of
+   * @return            The Id of the server core
    */
-  void ReceiveAcknowledgment(int source, int &data, int tag, int comm);
+  int GetLockServerId(int lockId);
 
   /**
-   * Recieves command data from either a specified or unspecified source.
-   * If remoteSource is not provided any source currently sending a command is used.
-   * It is not advised to use this function manually.
+   * Gets the largest length that the data buffer of each server core
+   * may grow to. A DSM whose maximum length is no larger than its
+   * length keeps its size.
    *
    * Example of use:
    *
@@ -1396,8 +1616,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#CommandHeader
-   * @until //#CommandHeader
+   * @skipline //#GetMaxLength
+   * @until //#GetMaxLength
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1405,28 +1625,35 @@ public:
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
-   * Python:
-   * Unusable in python unless an object of a cpointer type is passed
-   *  via wrapped code
+   * Python
    *
-   * @param     opcode          A pointer to the location where the code
-   *                            associated with the operation will be stored
-   * @param     source          A pointer to the location where the index of
-   *                            the source core will be stored
-   *                            (will be the same as remoteSource if provided)
-   * @param     address         A pointer to the location where the address
-   *                            specified by the command will be stored
-   * @param     aLength         A pointer to the location where the length of
-   *                            the data specified by the command will be stored
-   * @param     comm            The communicator over which the transmission
-   *                            will occur
-   * @param     remoteSource    If provided, the core being recieved from
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetMaxLength
+   * @until #//GetMaxLength
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    The largest length of the data buffer per core
    */
-  void ReceiveCommandHeader(int *opcode, int *source, int *address, int *aLength, int comm, int remoteSource = -1);
+  int64_t GetMaxLength();
 
   /**
-   * Recieves data from a specific core and stores it in a pointer.
-   * It is not advised to use this function manually.
+   * Gets the largest number of bytes this core sends in a single MPI
+   * call. Longer transfers are sent as several frames.
    *
    * Example of use:
    *
@@ -1449,8 +1676,8 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#SendRecvData
-   * @until //#SendRecvData
+   * @skipline //#GetMaxMessageLength
+   * @until //#GetMaxMessageLength
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1458,30 +1685,36 @@ public:
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
-   * Python:
-   * Unusable in python unless an object of a cpointer type is passed
-   * via wrapped code
-   *
+   * Python
    *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetMaxMessageLength
+   * @until #//GetMaxMessageLength
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
    *
-   * @param     source          The core data will be recieved from
-   * @param     data            The pointer where the recieved data will be
-   *                            stored
-   * @param     aLength         The length of the data transmitted
-   * @param     tag             The communication tag to be used for the
-   *                            transmission
-   * @param     aAddress        The location where the data will be written on
-   *                            the data buffer
-   * @param     comm            The comunicator over which the data transfer
-   *                            will occur
+   * @return    The largest frame sent by this core in bytes
    */
-  void ReceiveData(int source, char * data, int aLength, int tag, int aAddress, int comm);
+  int64_t GetMaxMessageLength();
 
   /**
-   * With the Comm with ID 0 recieve information
-   * about a server from another core on the intercomm.
-   * Used to recieve server data from different managers.
-   * It is not advised to use this function manually.
+   * Gets the seed used to place blocks in a block random DSM. Every core
+   * connected to the DSM uses the same seed, clients receive it from the
+   * servers with the rest of the DSM configuration.
    *
    * Example of use:
    *
@@ -1494,8 +1727,1195 @@ public:
    * @until //#initwritevector
    * @skipline //#initwritergenerate
    * @until //#initwritergenerate
-   * @skipline //#stopDSMwriter
-   * @until //#stopDSMwriter
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetRandomSeed
+   * @until //#GetRandomSeed
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetRandomSeed
+   * @until #//GetRandomSeed
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    The seed of the block random layout
+   */
+  unsigned int GetRandomSeed();
+
+  /**
+   * Gets the address at the beginning of the DSM buffer for this buffer.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetStartAddress
+   * @until //#GetStartAddress
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetStartAddress
+   * @until #//GetStartAddress
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    The beginning address of the DSM buffer
+   */
+  int64_t GetStartAddress();
+
+  /**
+   * Gets the id of the first of the server cores that handle the DSM buffer.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetStartServerId
+   * @until //#GetStartServerId
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetStartServerId
+   * @until #//GetStartServerId
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    The id of the first core that serves as a DSM server
+   */
+  int GetStartServerId();
+
+  /**
+   * The total length of the data buffer when combining the buffers in all cores.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetTotalLength
+   * @until //#GetTotalLength
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetTotalLength
+   * @until #//GetTotalLength
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    The total length of the data buffer
+   */
+  int64_t GetTotalLength();
+
+  /**
+   * Gets how Put and Get move data to and from the servers.
+   * XDMF_DSM_TRANSPORT_MESSAGE sends a command header and the data to the
+   * server's service loop, XDMF_DSM_TRANSPORT_RMA reads and writes the
+   * server's buffer directly through an MPI window.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetTransportTypebuffer
+   * @until //#GetTransportTypebuffer
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetTransportTypebuffer
+   * @until #//GetTransportTypebuffer
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    The transport used by the buffer
+   */
+  int GetTransportType();
+
+  /**
+   * Gets whether cores on the same node as a server copy data directly
+   * to and from its buffer through shared memory.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetUseSharedMemorybuffer
+   * @until //#GetUseSharedMemorybuffer
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetUseSharedMemorybuffer
+   * @until #//GetUseSharedMemorybuffer
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    Whether shared memory is used for cores on the same node
+   */
+  bool GetUseSharedMemory();
+
+  /**
+   * Grows the data buffers of all server cores so that the DSM holds
+   * at least the provided number of bytes. Buffers grow by whole rounds
+   * of blocks, one block per server, so that the addresses already in
+   * use stay on the same server. Growth stops at the maximum length of
+   * the servers, the returned length may be smaller than requested.
+   *
+   * Only block cyclic and block random DSMs using message transport
+   * without shared memory can grow. Other cores connected to the DSM
+   * see the new length after calling QueryLength.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#Grow
+   * @until //#Grow
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//Grow
+   * @until #//Grow
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     aTotalLength    The number of bytes the DSM should hold
+   * @return                    The total length of the DSM after growing
+   */
+  int64_t Grow(int64_t aTotalLength);
+
+  /**
+   * Probes inter and intra comms until a command is found.
+   * Then sets the comm that the command was found on to the provided variable
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#CommandHeader
+   * @until //#CommandHeader
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python:
+   * Unusable in python unless an object of a cpointer type is passed via wrapped code
+   *
+   *
+   *
+   * @param     comm    a pointer to the variable that the integer code for the
+   *                    comm is placed in
+   */
+  void ProbeCommandHeader(int *comm);
+
+  /**
+   * Puts data to the server cores.
+   * It is not advised to use this function manually.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#PutGet
+   * @until //#PutGet
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python:
+   * Unusable in python unless an object of a cpointer type is passed
+   * via wrapped code
+   * Use the XdmfHDF5WriterDSM for this functionality
+   *
+   *
+   *
+   * @param     Address         The starting address that the data will
+   *                            be placed at
+   * @param     aLength         The length of the data to be sent
+   * @param     Data            A pointer to the data to be sent
+   */
+  void Put(int64_t Address, int64_t aLength, const void *Data);
+
+  /**
+   * Puts data to the server cores without waiting for the transfers to
+   * complete. Data must stay unchanged until WaitNonBlocking is called.
+   * Puts and Gets issued afterwards are processed after this one by
+   * each server, so reads see the data once the call returns. With the
+   * RMA transport and for local data the transfer completes immediately.
+   * It is not advised to use this function manually.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#PutNonBlocking
+   * @until //#PutNonBlocking
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python:
+   * Unusable in python unless an object of a cpointer type is passed
+   * via wrapped code
+   * Use the XdmfHDF5WriterDSM for this functionality
+   *
+   * @param     Address         The starting address that the data will
+   *                            be placed at
+   * @param     aLength         The length of the data to be sent
+   * @param     Data            A pointer to the data to be sent
+   */
+  void PutNonBlocking(int64_t Address, int64_t aLength, const void *Data);
+
+  /**
+   * Asks the servers for the current length of their data buffers,
+   * which may have been grown by another core, and updates the lengths
+   * seen by this core.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#QueryLength
+   * @until //#QueryLength
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//QueryLength
+   * @until #//QueryLength
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    The total length of the DSM
+   */
+  int64_t QueryLength();
+
+  /**
+   * Recieves an integer as an acknowledgement from the specified core.
+   * It is not advised to use this function manually.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#SendRecvAcknowledgement
+   * @until //#SendRecvAcknowledgement
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python:
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//SendAcknowledgment
+   * @until #//SendAcknowledgment
+   * @skipline #//ReceiveAcknowledgment
+   * @until #//ReceiveAcknowledgment
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     source  The core to recieve from
+   * @param     data    The integer that the recieved data will be stored in
+   * @param     tag     The tag associated with the acknowledgement
+   * @param     comm    The comm over which the acknowldedgement will occur
+   */
+  void ReceiveAcknowledgment(int source, int &data, int tag, int comm);
+
+  /**
+   * Recieves command data from either a specified or unspecified source.
+   * If remoteSource is not provided any source currently sending a command is used.
+   * It is not advised to use this function manually.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#CommandHeader
+   * @until //#CommandHeader
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python:
+   * Unusable in python unless an object of a cpointer type is passed
+   *  via wrapped code
+   *
+   * @param     opcode          A pointer to the location where the code
+   *                            associated with the operation will be stored
+   * @param     source          A pointer to the location where the index of
+   *                            the source core will be stored
+   *                            (will be the same as remoteSource if provided)
+   * @param     address         A pointer to the location where the address
+   *                            specified by the command will be stored
+   * @param     aLength         A pointer to the location where the length of
+   *                            the data specified by the command will be stored
+   * @param     comm            The communicator over which the transmission
+   *                            will occur
+   * @param     remoteSource    If provided, the core being recieved from
+   */
+  void ReceiveCommandHeader(int *opcode, int *source, int64_t *address, int64_t *aLength, int comm, int remoteSource = -1);
+
+  /**
+   * Recieves data from a specific core and stores it in a pointer.
+   * It is not advised to use this function manually.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#SendRecvData
+   * @until //#SendRecvData
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python:
+   * Unusable in python unless an object of a cpointer type is passed
+   * via wrapped code
+   *
+   *
+   *
+   * @param     source          The core data will be recieved from
+   * @param     data            The pointer where the recieved data will be
+   *                            stored
+   * @param     aLength         The length of the data transmitted, longer
+   *                            transfers arrive in frames of the sender's
+   *                            maximum message length
+   * @param     tag             The communication tag to be used for the
+   *                            transmission
+   * @param     aAddress        Unused, the data is placed at data
+   * @param     comm            The comunicator over which the data transfer
+   *                            will occur
+   */
+  void ReceiveData(int source, char * data, int64_t aLength, int tag, int64_t aAddress, int comm);
+
+  /**
+   * With the Comm with ID 0 recieve information
+   * about a server from another core on the intercomm.
+   * Used to recieve server data from different managers.
+   * It is not advised to use this function manually.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#SendRecvInfo
+   * @until //#SendRecvInfo
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//SendRecvInfo
+   * @until #//SendRecvInfo
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   */
+  void ReceiveInfo();
+
+  /**
+   * Releases a lock acquired with AcquireLock. A writer may mark the
+   * release as a new step, which wakes the cores waiting in WaitForStep.
+   * The release is sent without waiting for the server.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#AcquireLock
+   * @until //#AcquireLock
+   * @skipline //#ReleaseLock
+   * @until //#ReleaseLock
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//AcquireLock
+   * @until #//AcquireLock
+   * @skipline #//ReleaseLock
+   * @until #//ReleaseLock
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     lockId  The lock to release
+   * @param     mode    The mode the lock was acquired with
+   * @param     newStep If the data protected by the lock holds a new
+   *                    step, only used when releasing a write lock
+   */
+  void ReleaseLock(int lockId, int mode, bool newStep = false);
+
+  /**
+   * Tells the server cores to prepare to accept a new connection.
+   * Then readies to accept a new connection.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude XdmfAcceptTest.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#OpenPort
+   * @until //#OpenPort
+   * @skipline //#SendAccept
+   * @until //#SendAccept
+   * @skipline //#finishwork
+   * @until //#finishwork
+   * @skipline //#ClosePort
+   * @until //#ClosePort
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleAcceptTest.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//OpenPort
+   * @until #//OpenPort
+   * @skipline #//SendAccept
+   * @until #//SendAccept
+   * @skipline #//finishwork
+   * @until #//finishwork
+   * @skipline #//ClosePort
+   * @until #//ClosePort
+   *
+   * @param     numConnects     The number of incoming connections to accept
+   */
+  void SendAccept(unsigned int numConnects);
+
+  /**
+   * Sends an integer as an acknowledgement to the specified core.
+   * It is not advised to use this function manually.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#SendRecvAcknowledgement
+   * @until //#SendRecvAcknowledgement
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//SendAcknowledgment
+   * @until #//SendAcknowledgment
+   * @skipline #//ReceiveAcknowledgment
+   * @until #//ReceiveAcknowledgment
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     dest    The core to send to
+   * @param     data    The integer to send
+   * @param     tag     The tag associated with the acknowledgement
+   * @param     comm    The comm over which the acknowldedgement will occur
+   */
+  void SendAcknowledgment(int dest, int data, int tag, int comm);
+
+  /**
+   * Sends command data to a specified core.
+   * It is not advised to use this function manually.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#CommandHeader
+   * @until //#CommandHeader
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//SendCommandHeader
+   * @until #//SendCommandHeader
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     opcode          The code for the command to be sent
+   * @param     dest            The core that the command is to be sent to
+   * @param     address         The address to be referenced by the command
+   * @param     aLength         The length of the data to be used by the command
+   * @param     comm            The communicator over which the transmission will occur
+   */
+  void SendCommandHeader(int opcode, int dest, int64_t address, int64_t aLength, int comm);
+
+  /**
+   * Sends data from a pointer to a specified core.
+   * It is not advised to use this function manually.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#SendRecvData
+   * @until //#SendRecvData
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//SendData
+   * @until #//SendData
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     dest            The core that the data will be sent to
+   * @param     data            A pointer to the location of the data being sent
+   * @param     aLength         The length of the data being sent, lengths
+   *                            over GetMaxMessageLength() are split into
+   *                            several messages
+   * @param     tag             The communication tag to be used for the transmission
+   * @param     aAddress        Unused, the address is sent in the command
+   *                            header
+   * @param     comm            The communicator over which the data transfer
+   *                            will take place
+   */
+  void SendData(int dest, char * data, int64_t aLength, int tag, int64_t aAddress, int comm);
+
+  /**
+   * Ends the service loop server cores associated with this buffer
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#SendDone
+   * @until //#SendDone
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//SendDone
+   * @until #//SendDone
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   */
+  void SendDone();
+
+  /**
+   * From the Comm with ID 0 send out information
+   * about the server to another core on the intercomm.
+   * Used to send server data to different managers.
+   * It is not advised to use this function manually.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
    * @skipline //#SendRecvInfo
    * @until //#SendRecvInfo
    * @skipline //#finalizeMPI
@@ -1517,51 +2937,265 @@ public:
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    */
-  void ReceiveInfo();
+  void SendInfo();
 
   /**
-   * Tells the server cores to prepare to accept a new connection.
-   * Then readies to accept a new connection.
+   * Sets the length that files in the DSM reserve space in multiples
+   * of, 0 reserves exactly what a file needs. Servers set it before
+   * clients connect, connecting clients take the length of the
+   * servers. Changing it afterwards must be done on every client
+   * core.
    *
    * Example of use:
    *
    * C++
    *
-   * @dontinclude XdmfAcceptTest.cpp
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
    * @skipline //#initMPI
    * @until //#initMPI
-   * @skipline //#OpenPort
-   * @until //#OpenPort
-   * @skipline //#SendAccept
-   * @until //#SendAccept
-   * @skipline //#finishwork
-   * @until //#finishwork
-   * @skipline //#ClosePort
-   * @until //#ClosePort
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetAllocationLength
+   * @until //#GetAllocationLength
+   * @skipline //#SetAllocationLength
+   * @until //#SetAllocationLength
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetAllocationLength
+   * @until #//GetAllocationLength
+   * @skipline #//SetAllocationLength
+   * @until #//SetAllocationLength
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     newAllocationLength     The allocation granularity in bytes
+   */
+  void SetAllocationLength(int64_t newAllocationLength);
+
+  /**
+   * Sets the size of the blocks used in the data buffer.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetBlockLengthbuffer
+   * @until //#GetBlockLengthbuffer
+   * @skipline //#SetBlockLengthbuffer
+   * @until //#SetBlockLengthbuffer
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetBlockLength
+   * @until #//GetBlockLength
+   * @skipline #//SetBlockLength
+   * @until #//SetBlockLength
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     newBlock        The new block size to be used
+   */
+  void SetBlockLength(int64_t newBlock);
+
+  /**
+   * Sets the Comm to be used to facilitate the communications for the DSM
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetComm
+   * @until //#GetComm
+   * @skipline //#SetComm
+   * @until //#SetComm
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetComm
+   * @until #//GetComm
+   * @skipline #//SetComm
+   * @until #//SetComm
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     newComm         The communicator that is to be used by the DSM
+   */
+  void SetComm(XdmfDSMCommMPI * newComm);
+
+  /**
+   * Sets the DSM type to the provided type.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#SetDsmTypebuffer
+   * @until //#SetDsmTypebuffer
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
    * Python
    *
-   * @dontinclude XdmfExampleAcceptTest.py
+   * @dontinclude XdmfExampleDSMNoThread.py
    * @skipline #//initMPI
    * @until #//initMPI
-   * @skipline #//OpenPort
-   * @until #//OpenPort
-   * @skipline #//SendAccept
-   * @until #//SendAccept
-   * @skipline #//finishwork
-   * @until #//finishwork
-   * @skipline #//ClosePort
-   * @until #//ClosePort
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//SetDsmTypebuffer
+   * @until #//SetDsmTypebuffer
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
    *
-   * @param     numConnects     The number of incoming connections to accept
+   * @param     newDsmType      The Dsm type that the buffer will be changed to
    */
-  void SendAccept(unsigned int numConnects);
+  void SetDsmType(int newDsmType);
 
   /**
-   * Sends an integer as an acknowledgement to the specified core.
-   * It is not advised to use this function manually.
+   * Sets whether files in the DSM are locked while they are open.
+   * Servers set it before clients connect, connecting clients take
+   * the setting of the servers. Changing it afterwards must be done
+   * on every client core while no file is open.
    *
    * Example of use:
    *
@@ -1584,8 +3218,10 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#SendRecvAcknowledgement
-   * @until //#SendRecvAcknowledgement
+   * @skipline //#GetFileLocking
+   * @until //#GetFileLocking
+   * @skipline //#SetFileLocking
+   * @until //#SetFileLocking
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1608,25 +3244,25 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//SendAcknowledgment
-   * @until #//SendAcknowledgment
-   * @skipline #//ReceiveAcknowledgment
-   * @until #//ReceiveAcknowledgment
+   * @skipline #//GetFileLocking
+   * @until #//GetFileLocking
+   * @skipline #//SetFileLocking
+   * @until #//SetFileLocking
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @param     dest    The core to send to
-   * @param     data    The integer to send
-   * @param     tag     The tag associated with the acknowledgement
-   * @param     comm    The comm over which the acknowldedgement will occur
+   * @param     newFileLocking  Whether files are locked while open
    */
-  void SendAcknowledgment(int dest, int data, int tag, int comm);
+  void SetFileLocking(bool newFileLocking);
 
   /**
-   * Sends command data to a specified core.
-   * It is not advised to use this function manually.
+   * Sets the number of files the DSM holds at once, the size of the
+   * file table at the start of the DSM. Servers set it before
+   * clients connect, connecting clients take the number of the
+   * servers. Changing it afterwards must be done on every client
+   * core while the DSM holds no file.
    *
    * Example of use:
    *
@@ -1649,8 +3285,10 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#CommandHeader
-   * @until //#CommandHeader
+   * @skipline //#GetFileSlots
+   * @until //#GetFileSlots
+   * @skipline //#SetFileSlots
+   * @until //#SetFileSlots
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1673,24 +3311,23 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//SendCommandHeader
-   * @until #//SendCommandHeader
+   * @skipline #//GetFileSlots
+   * @until #//GetFileSlots
+   * @skipline #//SetFileSlots
+   * @until #//SetFileSlots
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @param     opcode          The code for the command to be sent
-   * @param     dest            The core that the command is to be sent to
-   * @param     address         The address to be referenced by the command
-   * @param     aLength         The length of the data to be used by the command
-   * @param     comm            The communicator over which the transmission will occur
+   * @param     newFileSlots    The number of entries in the file table,
+   *                            at least 1
    */
-  void SendCommandHeader(int opcode, int dest, int address, int aLength, int comm);
+  void SetFileSlots(unsigned int newFileSlots);
 
   /**
-   * Sends data from a pointer to a specified core.
-   * It is not advised to use this function manually.
+   * Sets the Buffer's connection status. Used if the XdmfDSMCommMPI is
+   * connected or disconnected manually.
    *
    * Example of use:
    *
@@ -1713,8 +3350,10 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#SendRecvData
-   * @until //#SendRecvData
+   * @skipline //#GetIsConnectedbuffer
+   * @until //#GetIsConnectedbuffer
+   * @skipline //#SetIsConnectedbuffer
+   * @until //#SetIsConnectedbuffer
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1737,26 +3376,21 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//SendData
-   * @until #//SendData
+   * @skipline #//GetIsConnectedbuffer
+   * @until #//GetIsConnectedbuffer
+   * @skipline #//SetIsConnectedbuffer
+   * @until #//SetIsConnectedbuffer
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @param     dest            The core that the data will be sent to
-   * @param     data            A pointer to the location of the data being sent
-   * @param     aLength         The length of the data being sent
-   * @param     tag             The communication tag to be used for the transmission
-   * @param     aAddress        The address on the recieveing core's buffer that
-   *                            the data is to be placed in
-   * @param     comm            The communicator over which the data transfer
-   *                            will take place
+   * @param     newStatus       The new connection status
    */
-  void SendData(int dest, char * data, int aLength, int tag, int aAddress, int comm);
+  void SetIsConnected(bool newStatus);
 
   /**
-   * Ends the service loop server cores associated with this buffer
+   * Sets whether the buffer is a DSM server.
    *
    * Example of use:
    *
@@ -1769,8 +3403,22 @@ public:
    * @until //#initwritevector
    * @skipline //#initwritergenerate
    * @until //#initwritergenerate
-   * @skipline //#SendDone
-   * @until //#SendDone
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetIsServerbuffer
+   * @until //#GetIsServerbuffer
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
@@ -1783,18 +3431,29 @@ public:
    * @until #//initwritevector
    * @skipline #//initwritergenerate
    * @until #//initwritergenerate
-   * @skipline #//SendDone
-   * @until #//SendDone
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetIsServerbuffer
+   * @until #//GetIsServerbuffer
+   * @skipline #//SetIsServerbuffer
+   * @until #//SetIsServerbuffer
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
+   *
+   * @param     newIsServer     Whether the buffer is to be a DSM server or not
    */
-  void SendDone();
+  void SetIsServer(bool newIsServer);
 
   /**
-   * From the Comm with ID 0 send out information
-   * about the server to another core on the intercomm.
-   * Used to send server data to different managers.
-   * It is not advised to use this function manually.
+   * Sets the largest length that the data buffer of each server core
+   * may grow to with Grow. Clients receive the maximum length from the
+   * servers with the rest of the DSM configuration.
    *
    * Example of use:
    *
@@ -1807,10 +3466,24 @@ public:
    * @until //#initwritevector
    * @skipline //#initwritergenerate
    * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#GetMaxLength
+   * @until //#GetMaxLength
+   * @skipline //#SetMaxLength
+   * @until //#SetMaxLength
+   * @skipline //#endworksection
+   * @until //#endworksection
    * @skipline //#stopDSMwriter
    * @until //#stopDSMwriter
-   * @skipline //#SendRecvInfo
-   * @until //#SendRecvInfo
    * @skipline //#finalizeMPI
    * @until //#finalizeMPI
    *
@@ -1823,17 +3496,30 @@ public:
    * @until #//initwritevector
    * @skipline #//initwritergenerate
    * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetDsmBuffer
+   * @until #//GetDsmBuffer
+   * @skipline #//GetMaxLength
+   * @until #//GetMaxLength
+   * @skipline #//SetMaxLength
+   * @until #//SetMaxLength
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
-   * @skipline #//SendRecvInfo
-   * @until #//SendRecvInfo
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
+   *
+   * @param     newMaxLength    The largest length of the data buffer per core
    */
-  void SendInfo();
+  void SetMaxLength(int64_t newMaxLength);
 
   /**
-   * Sets the size of the blocks used in the data buffer.
+   * Sets the largest number of bytes this core sends in a single MPI
+   * call, at most and by default XDMF_DSM_MAX_MESSAGE_LENGTH. Only the
+   * sending side splits transfers, receivers take frames of any size,
+   * so cores of one DSM may use different values.
    *
    * Example of use:
    *
@@ -1856,10 +3542,10 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetBlockLengthbuffer
-   * @until //#GetBlockLengthbuffer
-   * @skipline //#SetBlockLengthbuffer
-   * @until //#SetBlockLengthbuffer
+   * @skipline //#GetMaxMessageLength
+   * @until //#GetMaxMessageLength
+   * @skipline //#SetMaxMessageLength
+   * @until //#SetMaxMessageLength
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1882,21 +3568,24 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetBlockLength
-   * @until #//GetBlockLength
-   * @skipline #//SetBlockLength
-   * @until #//SetBlockLength
+   * @skipline #//GetMaxMessageLength
+   * @until #//GetMaxMessageLength
+   * @skipline #//SetMaxMessageLength
+   * @until #//SetMaxMessageLength
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @param     newBlock        The new block size to be used
+   * @param     newMaxMessageLength     The largest frame to send in bytes
    */
-  void SetBlockLength(long newBlock);
+  void SetMaxMessageLength(int64_t newMaxMessageLength);
+
 
   /**
-   * Sets the Comm to be used to facilitate the communications for the DSM
+   * Sets the seed used to place blocks in a block random DSM. It must be
+   * set to the same value on every core before any data is written since
+   * changing it moves where each block is stored.
    *
    * Example of use:
    *
@@ -1919,10 +3608,10 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetComm
-   * @until //#GetComm
-   * @skipline //#SetComm
-   * @until //#SetComm
+   * @skipline //#GetRandomSeed
+   * @until //#GetRandomSeed
+   * @skipline //#SetRandomSeed
+   * @until //#SetRandomSeed
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -1945,21 +3634,23 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetComm
-   * @until #//GetComm
-   * @skipline #//SetComm
-   * @until #//SetComm
+   * @skipline #//GetRandomSeed
+   * @until #//GetRandomSeed
+   * @skipline #//SetRandomSeed
+   * @until #//SetRandomSeed
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @param     newComm         The communicator that is to be used by the DSM
+   * @param     newSeed The seed of the block random layout
    */
-  void SetComm(XdmfDSMCommMPI * newComm);
+  void SetRandomSeed(unsigned int newSeed);
 
   /**
-   * Sets the DSM type to the provided type.
+   * Sets how Put and Get move data to and from the servers. The servers
+   * and clients agree on the transport when the DSM information is
+   * exchanged, an RMA window is only created at that point.
    *
    * Example of use:
    *
@@ -1982,8 +3673,10 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#SetDsmTypebuffer
-   * @until //#SetDsmTypebuffer
+   * @skipline //#GetTransportTypebuffer
+   * @until //#GetTransportTypebuffer
+   * @skipline //#SetTransportTypebuffer
+   * @until //#SetTransportTypebuffer
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -2006,20 +3699,23 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//SetDsmTypebuffer
-   * @until #//SetDsmTypebuffer
+   * @skipline #//GetTransportTypebuffer
+   * @until #//GetTransportTypebuffer
+   * @skipline #//SetTransportTypebuffer
+   * @until #//SetTransportTypebuffer
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @param     newDsmType      The Dsm type that the buffer will be changed to
+   * @param     newTransportType        The transport to be used
    */
-  void SetDsmType(int newDsmType);
+  void SetTransportType(int newTransportType);
 
   /**
-   * Sets the Buffer's connection status. Used if the XdmfDSMCommMPI is
-   * connected or disconnected manually.
+   * Sets whether cores on the same node as a server copy data directly
+   * to and from its buffer through shared memory. The setting of the
+   * servers is sent to clients when they connect.
    *
    * Example of use:
    *
@@ -2042,10 +3738,10 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetIsConnectedbuffer
-   * @until //#GetIsConnectedbuffer
-   * @skipline //#SetIsConnectedbuffer
-   * @until //#SetIsConnectedbuffer
+   * @skipline //#GetUseSharedMemorybuffer
+   * @until //#GetUseSharedMemorybuffer
+   * @skipline //#SetUseSharedMemorybuffer
+   * @until //#SetUseSharedMemorybuffer
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -2068,21 +3764,23 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetIsConnectedbuffer
-   * @until #//GetIsConnectedbuffer
-   * @skipline #//SetIsConnectedbuffer
-   * @until #//SetIsConnectedbuffer
+   * @skipline #//GetUseSharedMemorybuffer
+   * @until #//GetUseSharedMemorybuffer
+   * @skipline #//SetUseSharedMemorybuffer
+   * @until #//SetUseSharedMemorybuffer
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @param     newStatus       The new connection status
+   * @param     newUseShared    Whether to use shared memory for cores
+   *                            on the same node
    */
-  void SetIsConnected(bool newStatus);
+  void SetUseSharedMemory(bool newUseShared);
 
   /**
-   * Sets whether the buffer is a DSM server.
+   * Waits for every transfer started by PutNonBlocking to complete,
+   * after which the data passed to it may be reused.
    *
    * Example of use:
    *
@@ -2105,8 +3803,52 @@ public:
    * @until //#declarebuffer
    * @skipline //#GetDsmBuffer
    * @until //#GetDsmBuffer
-   * @skipline //#GetIsServerbuffer
-   * @until //#GetIsServerbuffer
+   * @skipline //#PutNonBlocking
+   * @until //#PutNonBlocking
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python:
+   * Unusable in python unless an object of a cpointer type is passed
+   * via wrapped code
+   * Use the XdmfHDF5WriterDSM for this functionality
+   */
+  /**
+   * Waits until a writer has released the provided lock with a new step
+   * after the step passed in. Consumers use this to learn that a new
+   * step is available without polling the DSM.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#declarebuffer
+   * @until //#declarebuffer
+   * @skipline //#GetDsmBuffer
+   * @until //#GetDsmBuffer
+   * @skipline //#AcquireLock
+   * @until //#AcquireLock
+   * @skipline //#ReleaseLock
+   * @until //#ReleaseLock
+   * @skipline //#WaitForStep
+   * @until //#WaitForStep
    * @skipline //#endworksection
    * @until //#endworksection
    * @skipline //#stopDSMwriter
@@ -2129,40 +3871,82 @@ public:
    * @until #//getServerManagerwriter
    * @skipline #//GetDsmBuffer
    * @until #//GetDsmBuffer
-   * @skipline #//GetIsServerbuffer
-   * @until #//GetIsServerbuffer
-   * @skipline #//SetIsServerbuffer
-   * @until #//SetIsServerbuffer
+   * @skipline #//AcquireLock
+   * @until #//AcquireLock
+   * @skipline #//ReleaseLock
+   * @until #//ReleaseLock
+   * @skipline #//WaitForStep
+   * @until #//WaitForStep
    * @skipline #//stopDSMwriter
    * @until #//stopDSMwriter
    * @skipline #//finalizeMPI
    * @until #//finalizeMPI
    *
-   * @param     newIsServer     Whether the buffer is to be a DSM server or not
+   * @param     lockId  The lock to wait on
+   * @param     step    The last step seen by the caller
+   * @return            The number of steps released for the lock, larger
+   *                    than step
    */
-  void SetIsServer(bool newIsServer);
+  int WaitForStep(int lockId, int step);
+
+  void WaitNonBlocking();
 
 protected:
 
 
 private:
 
-  void SetLength(long aLength);
+  void PutRange(int64_t Address, int64_t aLength, const void *Data,
+                bool nonBlocking);
+
+  void SendCommandHeaderNonBlocking(int opcode, int dest, int64_t address,
+                                    int64_t aLength, int comm);
+
+  void SendDataNonBlocking(int dest, const char * data, int64_t aLength,
+                           int tag, int comm);
+
+  void SetLength(int64_t aLength);
+
+  const std::vector<int> & GetRandomPermutation(int64_t round);
+
+  int64_t GrowLocalBuffer(int64_t rounds);
+
+  void GrowServers(int64_t rounds);
+
+  class                 LockState;
+
+  LockState * GetLockState(int lockId);
+
+  void GrantLocks(LockState * lock);
+
+  void LockLocalWindows(int lockType);
+
+  void UnlockLocalWindows();
 
   class                 CommandMsg;
   class                 InfoMsg;
 
+  MPI_Datatype GetCommandMsgType();
+
+  MPI_Datatype GetInfoMsgType();
+
   bool                  IsServer;
 
-  int                   EndAddress;
-  int                   StartAddress;
+  int64_t               EndAddress;
+  int64_t               StartAddress;
 
   int                   StartServerId;
   int                   EndServerId;
 
-  unsigned int          Length;
-  unsigned int          TotalLength;
-  unsigned int          BlockLength;
+  int64_t               Length;
+  int64_t               TotalLength;
+  int64_t               BlockLength;
+  int64_t               MaxLength;
+  int64_t               MaxMessageLength;
+
+  unsigned int          RandomSeed;
+  int64_t               RandomRound;
+  std::vector<int>      RandomPermutation;
 
   XdmfDSMCommMPI        *Comm;
 
@@ -2170,6 +3954,32 @@ private:
 
   int                   DsmType;
 
+  unsigned int          FileSlots;
+  bool                  FileLocking;
+  int64_t               AllocationLength;
+
+  int                   TransportType;
+  MPI_Win               DataWindow;
+
+  bool                  UseSharedMemory;
+  bool                  SharedStorage;
+  MPI_Comm              NodeComm;
+  MPI_Win               SharedWindow;
+  // Buffers of the servers on this node and their rank in NodeComm,
+  // indexed by id
+  std::vector<char *>   NodePointers;
+  std::vector<int>      NodeRanks;
+
+  std::vector<MPI_Request> PendingRequests;
+  std::vector<CommandMsg *> PendingCommands;
+
+  // Created on first use, see GetCommandMsgType and GetInfoMsgType
+  MPI_Datatype          CommandMsgType;
+  MPI_Datatype          InfoMsgType;
+
+  // Locks served by this core
+  std::map<int, LockState *> Locks;
+
   int                   CommChannel;
   bool                  IsConnected;
 };
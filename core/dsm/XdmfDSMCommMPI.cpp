@@ -55,9 +55,185 @@
 #include <XdmfError.hpp>
 #include <mpi.h>
 #include <string.h>
+#include <stdlib.h>
 #include <fstream>
 #include <iostream>
 
+#ifndef _WIN32
+  #include <errno.h>
+  #include <netdb.h>
+  #include <pthread.h>
+  #include <unistd.h>
+  #include <sys/socket.h>
+  #include <sys/types.h>
+#endif
+
+#ifndef _WIN32
+// The socket and thread that hand the port name to connecting clients
+struct XdmfDSMPortService
+{
+  int         Socket;
+  pthread_t   Thread;
+  std::string PortName;
+};
+#else
+struct XdmfDSMPortService
+{
+};
+#endif
+
+namespace {
+
+#ifndef _WIN32
+  void
+  SplitServiceAddress(const std::string & address,
+                      std::string & host,
+                      std::string & port)
+  {
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos) {
+      host = address;
+      port = "";
+    }
+    else {
+      host = address.substr(0, colon);
+      port = address.substr(colon + 1);
+    }
+  }
+
+  void *
+  ServePortName(void * data)
+  {
+    XdmfDSMPortService * service = (XdmfDSMPortService *)data;
+    while (true) {
+      int client = accept(service->Socket, NULL, NULL);
+      if (client < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        // The listening socket was shut down when the port was closed
+        break;
+      }
+      const char * name = service->PortName.c_str();
+      size_t remaining = service->PortName.size();
+      while (remaining > 0) {
+#ifdef MSG_NOSIGNAL
+        ssize_t sent = send(client, name, remaining, MSG_NOSIGNAL);
+#else
+        ssize_t sent = send(client, name, remaining, 0);
+#endif
+        if (sent <= 0) {
+          break;
+        }
+        name += sent;
+        remaining -= sent;
+      }
+      close(client);
+    }
+    return NULL;
+  }
+
+  // Listens only on the interface of the host in the address, or on
+  // loopback when the address has no host
+  int
+  OpenServiceSocket(const std::string & address)
+  {
+    std::string host, port;
+    SplitServiceAddress(address, host, port);
+    struct addrinfo hints;
+    struct addrinfo * result;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host.empty() ? NULL : host.c_str(), port.c_str(),
+                    &hints, &result) != 0) {
+      return -1;
+    }
+    int listening = -1;
+    for (struct addrinfo * current = result; current != NULL; current = current->ai_next) {
+      listening = socket(current->ai_family, current->ai_socktype, current->ai_protocol);
+      if (listening < 0) {
+        continue;
+      }
+      int reuse = 1;
+      setsockopt(listening, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+      if (bind(listening, current->ai_addr, current->ai_addrlen) == 0 &&
+          listen(listening, SOMAXCONN) == 0) {
+        break;
+      }
+      close(listening);
+      listening = -1;
+    }
+    freeaddrinfo(result);
+    return listening;
+  }
+
+  bool
+  ReadServiceSocket(const std::string & address, std::string & portName)
+  {
+    std::string host, port;
+    SplitServiceAddress(address, host, port);
+    struct addrinfo hints;
+    struct addrinfo * result;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0) {
+      return false;
+    }
+    int connection = -1;
+    for (struct addrinfo * current = result; current != NULL; current = current->ai_next) {
+      connection = socket(current->ai_family, current->ai_socktype, current->ai_protocol);
+      if (connection < 0) {
+        continue;
+      }
+      if (connect(connection, current->ai_addr, current->ai_addrlen) == 0) {
+        break;
+      }
+      close(connection);
+      connection = -1;
+    }
+    freeaddrinfo(result);
+    if (connection < 0) {
+      return false;
+    }
+    char buffer[MPI_MAX_PORT_NAME];
+    ssize_t received;
+    portName = "";
+    while ((received = recv(connection, buffer, sizeof(buffer), 0)) > 0) {
+      portName.append(buffer, received);
+    }
+    close(connection);
+    return !portName.empty();
+  }
+#endif
+
+  void
+  StopPortService(XdmfDSMPortService *& service)
+  {
+    if (service != NULL) {
+#ifndef _WIN32
+      shutdown(service->Socket, SHUT_RDWR);
+      pthread_join(service->Thread, NULL);
+      close(service->Socket);
+#endif
+      delete service;
+      service = NULL;
+    }
+  }
+
+  void
+  WaitForPort()
+  {
+#ifdef _WIN32
+    Sleep(1);
+#else
+    usleep(1000);
+#endif
+  }
+
+}
+
 XdmfDSMCommMPI::XdmfDSMCommMPI()
 {
   IntraComm = MPI_COMM_NULL;
@@ -71,10 +247,15 @@ XdmfDSMCommMPI::XdmfDSMCommMPI()
   DsmFileName = "dsmconnect.cfg";
   InterCommType = XDMF_DSM_COMM_MPI;
   HasOpenedPort = false;
+  ConnectMethod = XDMF_DSM_CONNECT_FILE;
+  ConnectTimeout = XDMF_DSM_DEFAULT_CONNECT_TIMEOUT;
+  DsmServiceName = "";
+  PortService = NULL;
 }
 
 XdmfDSMCommMPI::~XdmfDSMCommMPI()
 {
+  StopPortService(PortService);
 #ifndef OPEN_MPI
   if (InterComm != MPI_COMM_NULL) {
     int status = MPI_Comm_free(&InterComm);
@@ -169,6 +350,13 @@ XdmfDSMCommMPI::ClosePort()
 {
   if (Id == 0) {
     int status;
+    if (ConnectMethod == XDMF_DSM_CONNECT_NAME_SERVICE && HasOpenedPort) {
+      std::string serviceName = GetDsmServiceName();
+      MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_RETURN);
+      MPI_Unpublish_name((char *)serviceName.c_str(), MPI_INFO_NULL, DsmPortName);
+      MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_ARE_FATAL);
+    }
+    StopPortService(PortService);
     status = MPI_Close_port(DsmPortName);
     if (status != MPI_SUCCESS) {
       std::string message = "Failed to close port ";
@@ -184,9 +372,9 @@ XdmfDSMCommMPI::Connect()
 {
   if (InterComm == MPI_COMM_NULL) {
     MPI_Comm tempComm;
-    MPI_Errhandler_set(IntraComm, MPI_ERRORS_RETURN);
+    MPI_Comm_set_errhandler(IntraComm, MPI_ERRORS_RETURN);
     int status = MPI_Comm_connect(DsmPortName, MPI_INFO_NULL, 0, IntraComm, &tempComm);
-    MPI_Errhandler_set(IntraComm, MPI_ERRORS_ARE_FATAL);
+    MPI_Comm_set_errhandler(IntraComm, MPI_ERRORS_ARE_FATAL);
     if (status != MPI_SUCCESS) {
       std::string message = "Failed to connect to port ";
       message = message + DsmPortName;
@@ -203,9 +391,9 @@ XdmfDSMCommMPI::Connect()
   }
   else {
     MPI_Comm tempComm;
-    MPI_Errhandler_set(InterComm, MPI_ERRORS_RETURN);
+    MPI_Comm_set_errhandler(InterComm, MPI_ERRORS_RETURN);
     int status = MPI_Comm_connect(DsmPortName, MPI_INFO_NULL, 0, InterComm, &tempComm);
-    MPI_Errhandler_set(InterComm, MPI_ERRORS_ARE_FATAL);
+    MPI_Comm_set_errhandler(InterComm, MPI_ERRORS_ARE_FATAL);
     if (status != MPI_SUCCESS) {
       std::string message = "Failed to connect to port ";
       message = message + DsmPortName;
@@ -296,6 +484,18 @@ XdmfDSMCommMPI::DupInterComm(MPI_Comm comm)
   }
 }
 
+int
+XdmfDSMCommMPI::GetConnectMethod()
+{
+  return ConnectMethod;
+}
+
+double
+XdmfDSMCommMPI::GetConnectTimeout()
+{
+  return ConnectTimeout;
+}
+
 std::string
 XdmfDSMCommMPI::GetDsmFileName()
 {
@@ -308,6 +508,24 @@ XdmfDSMCommMPI::GetDsmPortName()
   return DsmPortName;
 }
 
+std::string
+XdmfDSMCommMPI::GetDsmServiceName()
+{
+  if (DsmServiceName.size() > 0) {
+    return DsmServiceName;
+  }
+  switch (ConnectMethod) {
+    case XDMF_DSM_CONNECT_ENVIRONMENT:
+      return XDMF_DSM_DEFAULT_ENVIRONMENT_NAME;
+    case XDMF_DSM_CONNECT_NAME_SERVICE:
+      return XDMF_DSM_DEFAULT_SERVICE_NAME;
+    case XDMF_DSM_CONNECT_SOCKET:
+      return XDMF_DSM_DEFAULT_SOCKET_ADDRESS;
+    default:
+      return DsmFileName;
+  }
+}
+
 int
 XdmfDSMCommMPI::GetId()
 {
@@ -375,13 +593,59 @@ XdmfDSMCommMPI::OpenPort()
       message = message + DsmPortName;
       XdmfError::message(XdmfError::FATAL, message);
     }
-    std::ofstream connectFile (DsmFileName.c_str());
-    if (connectFile.is_open()) {
-      connectFile << DsmPortName;
-      connectFile.close();
+    std::string serviceName = GetDsmServiceName();
+    if (ConnectMethod == XDMF_DSM_CONNECT_ENVIRONMENT) {
+      // Inherited by the processes that the servers launch
+#ifdef _WIN32
+      status = _putenv_s(serviceName.c_str(), DsmPortName);
+#else
+      status = setenv(serviceName.c_str(), DsmPortName, 1);
+#endif
+      if (status != 0) {
+        XdmfError::message(XdmfError::FATAL, "Failed to set " + serviceName);
+      }
+    }
+    else if (ConnectMethod == XDMF_DSM_CONNECT_NAME_SERVICE) {
+      MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_RETURN);
+      status = MPI_Publish_name((char *)serviceName.c_str(), MPI_INFO_NULL, DsmPortName);
+      MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_ARE_FATAL);
+      if (status != MPI_SUCCESS) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Failed to publish port as " + serviceName +
+                           ", is an MPI name server running?");
+      }
+    }
+    else if (ConnectMethod == XDMF_DSM_CONNECT_SOCKET) {
+#ifdef _WIN32
+      XdmfError::message(XdmfError::FATAL,
+                         "Socket connections are not supported on this platform");
+#else
+      StopPortService(PortService);
+      PortService = new XdmfDSMPortService();
+      PortService->PortName = DsmPortName;
+      PortService->Socket = OpenServiceSocket(serviceName);
+      if (PortService->Socket < 0) {
+        delete PortService;
+        PortService = NULL;
+        XdmfError::message(XdmfError::FATAL, "Failed to open socket at " + serviceName);
+      }
+      if (pthread_create(&(PortService->Thread), NULL, ServePortName, PortService) != 0) {
+        close(PortService->Socket);
+        delete PortService;
+        PortService = NULL;
+        XdmfError::message(XdmfError::FATAL, "Failed to serve port at " + serviceName);
+      }
+#endif
     }
     else {
-      XdmfError::message(XdmfError::FATAL, "Failed to write port to file");
+      std::ofstream connectFile (DsmFileName.c_str());
+      if (connectFile.is_open()) {
+        connectFile << DsmPortName;
+        connectFile.close();
+      }
+      else {
+        XdmfError::message(XdmfError::FATAL, "Failed to write port to file");
+      }
     }
     HasOpenedPort = true;
   }
@@ -391,12 +655,73 @@ XdmfDSMCommMPI::OpenPort()
 void
 XdmfDSMCommMPI::ReadDsmPortName()
 {
-  std::ifstream connectFile(DsmFileName.c_str());
-  std::string connectLine;
-  if (connectFile.is_open()) {
-    getline(connectFile, connectLine);
+  // Only the first core waits for the servers, the rest get the port from it
+  int found = 1;
+  if (Id <= 0) {
+    std::string serviceName = GetDsmServiceName();
+    std::string portName = "";
+    double startTime = MPI_Wtime();
+    while (true) {
+      if (ConnectMethod == XDMF_DSM_CONNECT_ENVIRONMENT) {
+        char * value = getenv(serviceName.c_str());
+        if (value != NULL) {
+          portName = value;
+        }
+        // The environment does not change while waiting
+        break;
+      }
+      else if (ConnectMethod == XDMF_DSM_CONNECT_NAME_SERVICE) {
+        char lookupName[MPI_MAX_PORT_NAME];
+        MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_RETURN);
+        int status = MPI_Lookup_name((char *)serviceName.c_str(), MPI_INFO_NULL, lookupName);
+        MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_ARE_FATAL);
+        if (status == MPI_SUCCESS) {
+          portName = lookupName;
+        }
+      }
+      else if (ConnectMethod == XDMF_DSM_CONNECT_SOCKET) {
+#ifndef _WIN32
+        ReadServiceSocket(serviceName, portName);
+#else
+        break;
+#endif
+      }
+      else {
+        std::ifstream connectFile(DsmFileName.c_str());
+        if (connectFile.is_open()) {
+          getline(connectFile, portName);
+        }
+      }
+      if (portName.size() > 0 || MPI_Wtime() - startTime >= ConnectTimeout) {
+        break;
+      }
+      WaitForPort();
+    }
+    found = portName.size() > 0 && portName.size() < MPI_MAX_PORT_NAME;
+    if (found) {
+      strcpy(DsmPortName, portName.c_str());
+    }
+  }
+  if (IntraComm != MPI_COMM_NULL && IntraSize > 1) {
+    MPI_Bcast(&found, 1, MPI_INT, 0, IntraComm);
+    MPI_Bcast(DsmPortName, MPI_MAX_PORT_NAME, MPI_CHAR, 0, IntraComm);
+  }
+  if (!found) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Failed to read port name from " + GetDsmServiceName());
   }
-  strcpy(DsmPortName, connectLine.c_str());
+}
+
+void
+XdmfDSMCommMPI::SetConnectMethod(int newMethod)
+{
+  ConnectMethod = newMethod;
+}
+
+void
+XdmfDSMCommMPI::SetConnectTimeout(double newTimeout)
+{
+  ConnectTimeout = newTimeout;
 }
 
 void
@@ -410,3 +735,9 @@ XdmfDSMCommMPI::SetDsmPortName(const char *hostName)
 {
   strcpy(DsmPortName, hostName);
 }
+
+void
+XdmfDSMCommMPI::SetDsmServiceName(std::string newName)
+{
+  DsmServiceName = newName;
+}
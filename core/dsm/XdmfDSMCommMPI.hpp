@@ -25,9 +25,20 @@
 #define XDMFDSMCOMMMPI_HPP_
 
 // Forward Declarations
+struct XdmfDSMPortService;
 
 #define XDMF_DSM_COMM_MPI       0x11
 
+#define XDMF_DSM_CONNECT_FILE         0x30
+#define XDMF_DSM_CONNECT_ENVIRONMENT  0x31
+#define XDMF_DSM_CONNECT_NAME_SERVICE 0x32
+#define XDMF_DSM_CONNECT_SOCKET       0x33
+
+#define XDMF_DSM_DEFAULT_CONNECT_TIMEOUT  60
+#define XDMF_DSM_DEFAULT_ENVIRONMENT_NAME "XDMF_DSM_PORT_NAME"
+#define XDMF_DSM_DEFAULT_SERVICE_NAME     "XdmfDSM"
+#define XDMF_DSM_DEFAULT_SOCKET_ADDRESS   "localhost:22000"
+
 #define XDMF_DSM_INTRA_COMM  0x00
 #define XDMF_DSM_INTER_COMM  0x01
 #define XDMF_DSM_ANY_COMM    0x02
@@ -96,7 +107,8 @@ public:
   void Accept(unsigned int numConnections = 1);
 
   /**
-   * Closes the port currently named by DsmPortName.
+   * Closes the port currently named by DsmPortName and withdraws
+   * it from the name service or socket it was published through.
    *
    * Example of use:
    *
@@ -311,6 +323,94 @@ public:
    */
   void DupInterComm(MPI_Comm comm);
 
+  /**
+   * Gets the method used to pass the port name from the servers to the
+   * clients when the port is opened and read.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude XdmfAcceptTest.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#GetConnectMethod
+   * @until //#GetConnectMethod
+   * @skipline //#OpenPort
+   * @until //#OpenPort
+   * @skipline //#SendAccept
+   * @until //#SendAccept
+   * @skipline //#finishwork
+   * @until //#finishwork
+   * @skipline //#ClosePort
+   * @until //#ClosePort
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleAcceptTest.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//GetConnectMethod
+   * @until #//GetConnectMethod
+   * @skipline #//OpenPort
+   * @until #//OpenPort
+   * @skipline #//SendAccept
+   * @until #//SendAccept
+   * @skipline #//finishwork
+   * @until #//finishwork
+   * @skipline #//ClosePort
+   * @until #//ClosePort
+   *
+   * @return    The connect method, XDMF_DSM_CONNECT_FILE by default
+   */
+  int GetConnectMethod();
+
+  /**
+   * Gets the number of seconds that ReadDsmPortName waits for the
+   * servers to publish their port before failing.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude XdmfAcceptTest.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#GetConnectTimeout
+   * @until //#GetConnectTimeout
+   * @skipline //#OpenPort
+   * @until //#OpenPort
+   * @skipline //#SendAccept
+   * @until //#SendAccept
+   * @skipline //#finishwork
+   * @until //#finishwork
+   * @skipline //#ClosePort
+   * @until //#ClosePort
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleAcceptTest.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//GetConnectTimeout
+   * @until #//GetConnectTimeout
+   * @skipline #//OpenPort
+   * @until #//OpenPort
+   * @skipline #//SendAccept
+   * @until #//SendAccept
+   * @skipline #//finishwork
+   * @until #//finishwork
+   * @skipline #//ClosePort
+   * @until #//ClosePort
+   *
+   * @return    The time to wait for the port in seconds
+   */
+  double GetConnectTimeout();
+
   /**
    * Gets the current file name that connection info will be written to.
    *
@@ -393,6 +493,53 @@ public:
    */
   char * GetDsmPortName();
 
+  /**
+   * Gets the name the port is published under. This is the environment
+   * variable for XDMF_DSM_CONNECT_ENVIRONMENT, the MPI service name for
+   * XDMF_DSM_CONNECT_NAME_SERVICE and the host:port address of the
+   * socket for XDMF_DSM_CONNECT_SOCKET. A default is used for each
+   * method unless a name was set.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude XdmfAcceptTest.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#GetDsmServiceName
+   * @until //#GetDsmServiceName
+   * @skipline //#OpenPort
+   * @until //#OpenPort
+   * @skipline //#SendAccept
+   * @until //#SendAccept
+   * @skipline //#finishwork
+   * @until //#finishwork
+   * @skipline //#ClosePort
+   * @until //#ClosePort
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleAcceptTest.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//GetDsmServiceName
+   * @until #//GetDsmServiceName
+   * @skipline #//OpenPort
+   * @until #//OpenPort
+   * @skipline #//SendAccept
+   * @until #//SendAccept
+   * @skipline #//finishwork
+   * @until #//finishwork
+   * @skipline #//ClosePort
+   * @until #//ClosePort
+   *
+   * @return    The name the port is published under
+   */
+  std::string GetDsmServiceName();
+
   /**
    * Gets the Id with regards to the IntraComm.
    *
@@ -876,6 +1023,7 @@ public:
 
   /**
    * Opens a port and stores the port name in DsmPortName.
+   * The port name is then published with the current connect method.
    *
    * Example of use:
    *
@@ -912,7 +1060,10 @@ public:
   void OpenPort();
 
   /**
-   * Reads the connection information from the current DSMfile.
+   * Reads the connection information published by the servers with the
+   * current connect method. Only the first core reads it, waiting up to
+   * the connect timeout for the servers, and broadcasts it to the others
+   * so all cores of the IntraComm must call this.
    *
    * Example of use:
    *
@@ -944,6 +1095,116 @@ public:
    */
   void ReadDsmPortName();
 
+  /**
+   * Sets the method used to pass the port name from the servers to the
+   * clients. XDMF_DSM_CONNECT_FILE writes it to the file named by
+   * GetDsmFileName, XDMF_DSM_CONNECT_ENVIRONMENT sets an environment
+   * variable on the first server core, XDMF_DSM_CONNECT_NAME_SERVICE publishes it through the MPI name
+   * service and XDMF_DSM_CONNECT_SOCKET serves it over a TCP socket from
+   * the first server core, which avoids a shared file system. The socket
+   * only listens on the interface of the host in its address.
+   * Clients and servers must use the same method.
+   *
+   * XDMF_DSM_CONNECT_ENVIRONMENT only works when the clients are started
+   * by the first server core after OpenPort, since the variable is only
+   * inherited by its child processes. Clients launched on their own,
+   * for example by a separate mpirun, do not see it and should use one
+   * of the other methods. To run the servers and clients in one job,
+   * give the servers a range of cores instead of connecting through a
+   * port.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude XdmfAcceptTest.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#GetConnectMethod
+   * @until //#GetConnectMethod
+   * @skipline //#SetConnectMethod
+   * @until //#SetConnectMethod
+   * @skipline //#OpenPort
+   * @until //#OpenPort
+   * @skipline //#SendAccept
+   * @until //#SendAccept
+   * @skipline //#finishwork
+   * @until //#finishwork
+   * @skipline //#ClosePort
+   * @until //#ClosePort
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleAcceptTest.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//GetConnectMethod
+   * @until #//GetConnectMethod
+   * @skipline #//SetConnectMethod
+   * @until #//SetConnectMethod
+   * @skipline #//OpenPort
+   * @until #//OpenPort
+   * @skipline #//SendAccept
+   * @until #//SendAccept
+   * @skipline #//finishwork
+   * @until #//finishwork
+   * @skipline #//ClosePort
+   * @until #//ClosePort
+   *
+   * @param     newMethod       The method to use to publish and read the port
+   */
+  void SetConnectMethod(int newMethod);
+
+  /**
+   * Sets the number of seconds that ReadDsmPortName waits for the
+   * servers to publish their port before failing.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude XdmfAcceptTest.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#GetConnectTimeout
+   * @until //#GetConnectTimeout
+   * @skipline //#SetConnectTimeout
+   * @until //#SetConnectTimeout
+   * @skipline //#OpenPort
+   * @until //#OpenPort
+   * @skipline //#SendAccept
+   * @until //#SendAccept
+   * @skipline //#finishwork
+   * @until //#finishwork
+   * @skipline //#ClosePort
+   * @until //#ClosePort
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleAcceptTest.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//GetConnectTimeout
+   * @until #//GetConnectTimeout
+   * @skipline #//SetConnectTimeout
+   * @until #//SetConnectTimeout
+   * @skipline #//OpenPort
+   * @until #//OpenPort
+   * @skipline #//SendAccept
+   * @until #//SendAccept
+   * @skipline #//finishwork
+   * @until #//finishwork
+   * @skipline #//ClosePort
+   * @until #//ClosePort
+   *
+   * @param     newTimeout      The time to wait for the port in seconds
+   */
+  void SetConnectTimeout(double newTimeout);
+
   /**
    * Sets the file name that connection info will be written to.
    *
@@ -1033,6 +1294,53 @@ public:
    */
   void SetDsmPortName(const char *hostName);
 
+  /**
+   * Sets the name the port is published under, see GetDsmServiceName.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude XdmfAcceptTest.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#GetDsmServiceName
+   * @until //#GetDsmServiceName
+   * @skipline //#SetDsmServiceName
+   * @until //#SetDsmServiceName
+   * @skipline //#OpenPort
+   * @until //#OpenPort
+   * @skipline //#SendAccept
+   * @until //#SendAccept
+   * @skipline //#finishwork
+   * @until //#finishwork
+   * @skipline //#ClosePort
+   * @until //#ClosePort
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleAcceptTest.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//GetDsmServiceName
+   * @until #//GetDsmServiceName
+   * @skipline #//SetDsmServiceName
+   * @until #//SetDsmServiceName
+   * @skipline #//OpenPort
+   * @until #//OpenPort
+   * @skipline #//SendAccept
+   * @until #//SendAccept
+   * @skipline #//finishwork
+   * @until #//finishwork
+   * @skipline #//ClosePort
+   * @until #//ClosePort
+   *
+   * @param     newName         The name to publish the port under
+   */
+  void SetDsmServiceName(std::string newName);
+
 protected:
 
 
@@ -1047,6 +1355,10 @@ private:
   char          DsmPortName[MPI_MAX_PORT_NAME];
   std::string   DsmFileName;
   bool          HasOpenedPort;
+  int           ConnectMethod;
+  double        ConnectTimeout;
+  std::string   DsmServiceName;
+  XdmfDSMPortService * PortService;
 };
 
 #endif /* XDMFDSMCOMMMPI_HPP_ */
@@ -56,10 +56,14 @@
 #include <XdmfDSMCommMPI.hpp>
 #include <XdmfError.hpp>
 #include <mpi.h>
+#include <algorithm>
+#include <vector>
 
 #include <H5public.h>
 #include <hdf5.h>
 
+#include "XdmfDSMDriverPrivate.hpp"
+
 typedef struct XDMF_dsm_t
 {
   H5FD_t pub;           /* public stuff, must be first             */
@@ -75,6 +79,11 @@ typedef struct XDMF_dsm_t
   haddr_t end;          /* current DSM end address                 */
   hbool_t read_only;    /* file access is read-only                */
   hbool_t dirty;        /* dirty marker                            */
+  int slot;             /* entry of the file in the DSM file table */
+  haddr_t limit;        /* end of the DSM space reserved for it    */
+  int lock_id;          /* DSM lock protecting the file            */
+  hbool_t locked;       /* file holds its DSM lock while open      */
+  XdmfDSMWriteCache write_cache; /* small writes not yet sent       */
 } XDMF_dsm_t;
 
 typedef struct XDMF_dsm_fapl_t
@@ -84,12 +93,25 @@ typedef struct XDMF_dsm_fapl_t
   size_t local_buf_len;     /* local buffer length         */
 } XDMF_dsm_fapl_t;
 
+/* Longer file names are cut, the hash still covers the whole name */
+#define XDMF_DSM_ENTRY_NAME_LENGTH 256
+
 typedef struct
 {
-  long start;
-  long end;
+  int64_t start;
+  int64_t end;
+  int64_t limit;        /* end of the DSM space reserved for the file */
+  int64_t name_hash;    /* hash of the file name, 0 for a free entry  */
+  char name[XDMF_DSM_ENTRY_NAME_LENGTH]; /* file name, null terminated */
 } XdmfDSMEntry;
 
+typedef struct
+{
+  size_t writes;          /* calls to xdmf_dsm_write                     */
+  size_t bytes;           /* bytes passed to xdmf_dsm_write              */
+  size_t messages;        /* transfers issued to the DSM buffer          */
+} XdmfDSMWriteStatistics;
+
 /* The driver identification number, initialized at runtime */
 static hid_t XDMF_DSM_g = 0;
 
@@ -136,6 +158,30 @@ static int      XDMF_dsm_mpi_rank(const H5FD_t *_file);
 static int      XDMF_dsm_mpi_size(const H5FD_t *_file);
 static MPI_Comm XDMF_dsm_communicator(const H5FD_t *_file);
 
+/* Configuration of the write caches of files opened from now on and
+ * counters summed over all files */
+static size_t writeCacheLength = XDMF_DSM_DEFAULT_WRITE_CACHE_LENGTH;
+static unsigned int writeCacheBlocks = XDMF_DSM_DEFAULT_WRITE_CACHE_BLOCKS;
+static XdmfDSMWriteStatistics writeStatistics = {0, 0, 0};
+
+/* Allocation of DSM space from the file table, called with it locked */
+static herr_t   xdmf_dsm_read_table(XdmfDSMBuffer *dsmBuffer,
+    std::vector<XdmfDSMEntry> & entries);
+static void     xdmf_dsm_set_entry_name(XdmfDSMEntry & entry, const char *name);
+static hbool_t  xdmf_dsm_match_entry(const XdmfDSMEntry & entry, const char *name);
+static void     xdmf_dsm_find_gaps(const std::vector<XdmfDSMEntry> & entries,
+    haddr_t total, std::vector<std::pair<haddr_t, haddr_t> > & gaps);
+static int      xdmf_dsm_best_gap(const std::vector<std::pair<haddr_t, haddr_t> > & gaps,
+    haddr_t length);
+static haddr_t  xdmf_dsm_grow(XdmfDSMBuffer *dsmBuffer, haddr_t length);
+static herr_t   xdmf_dsm_allocate(XdmfDSMBuffer *dsmBuffer,
+    const std::vector<XdmfDSMEntry> & entries, haddr_t need, haddr_t want,
+    haddr_t *start_ptr, haddr_t *limit_ptr);
+static herr_t   xdmf_dsm_claim_entry(XdmfDSMBuffer *dsmBuffer, const char *name,
+    hbool_t create, int *slot_ptr);
+static herr_t   xdmf_dsm_move_entry(XdmfDSMBuffer *dsmBuffer, int slot,
+    haddr_t used, haddr_t length, haddr_t *start_ptr, haddr_t *limit_ptr);
+
 /* The DSM file driver information */
 static const H5FD_class_mpi_t XDMF_dsm_g = {
     {
@@ -600,6 +646,8 @@ XDMF_dsm_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
   file->intra_rank = mpi_rank;
   file->intra_size = mpi_size;
 
+  xdmf_dsm_init_write_cache(&file->write_cache);
+
   if (name && *name) {
     file->name = HDstrdup(name);
   }
@@ -611,14 +659,28 @@ XDMF_dsm_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
   file->local_buf_ptr = fa->local_buf_ptr;
   file->local_buf_len = fa->local_buf_len;
 
-  /* locking is handled by the user
-  if (SUCCEED != dsm_lock())
-    HGOTO_ERROR(H5E_VFL, H5E_CANTLOCK, NULL, "cannot lock DSM")
-  */
+  if (H5F_ACC_RDWR & flags) {
+    file->read_only = FALSE;
+  } else {
+    file->read_only = TRUE;
+  }
+
+  file->lock_id = xdmf_dsm_get_lock_id(name);
+  file->locked = xdmf_dsm_get_file_locking();
 
-  // find the start and end of the entry on core 0
-  if ((file->intra_rank == 0) && (SUCCEED != xdmf_dsm_get_entry(&file->start, &file->end)))
-    dsm_code = FAIL;
+  // lock the file and find its entry on core 0
+  if (file->intra_rank == 0) {
+    if (file->locked && (SUCCEED != xdmf_dsm_lock_file(file->lock_id, file->read_only))) {
+      dsm_code = FAIL;
+    }
+    else if ((SUCCEED != xdmf_dsm_find_entry(name, (H5F_ACC_CREAT & flags) ? TRUE : FALSE, &file->slot)) ||
+             (SUCCEED != xdmf_dsm_get_file_entry(file->slot, &file->start, &file->end, &file->limit))) {
+      dsm_code = FAIL;
+      if (file->locked) {
+        xdmf_dsm_unlock_file(file->lock_id, file->read_only, FALSE);
+      }
+    }
+  }
 
   /* Wait for the DSM entry to be updated */
   if (MPI_SUCCESS != (mpi_code = MPI_Bcast(&dsm_code, sizeof(herr_t),
@@ -633,17 +695,20 @@ XDMF_dsm_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
   if (MPI_SUCCESS != (mpi_code = MPI_Bcast(&file->end, sizeof(haddr_t),
       MPI_UNSIGNED_CHAR, 0, file->intra_comm)))
     HMPI_GOTO_ERROR(NULL, "MPI_Bcast failed", mpi_code)
+  if (MPI_SUCCESS != (mpi_code = MPI_Bcast(&file->limit, sizeof(haddr_t),
+      MPI_UNSIGNED_CHAR, 0, file->intra_comm)))
+    HMPI_GOTO_ERROR(NULL, "MPI_Bcast failed", mpi_code)
+  if (MPI_SUCCESS != (mpi_code = MPI_Bcast(&file->slot, 1,
+      MPI_INT, 0, file->intra_comm)))
+    HMPI_GOTO_ERROR(NULL, "MPI_Bcast failed", mpi_code)
 
-  if (H5F_ACC_RDWR & flags) {
-    file->read_only = FALSE;
-  } else {
-    file->read_only = TRUE;
-  }
+  /* The DSM may have grown since this process last used it */
+  if (SUCCEED != xdmf_dsm_sync_length(file->intra_comm, file->intra_rank))
+    HGOTO_ERROR(H5E_VFL, H5E_CANTRESTORE, NULL, "cannot update DSM length")
 
   if (H5F_ACC_CREAT & flags) {
-    /* Reset start and end markers */
-    file->start = 0;
-    file->end = 0;
+    /* Reset end marker, the file keeps the space it was given */
+    file->end = file->start;
     file->eof = 0;
   } else {
     file->eof = file->end - file->start;
@@ -692,9 +757,16 @@ XDMF_dsm_close(H5FD_t *_file)
   assert(XDMF_DSM == file->pub.driver_id);
 
   if (!file->read_only) {
+    /* Send everything still held in the write cache */
+    if (SUCCEED != xdmf_dsm_flush_write_cache(&file->write_cache))
+      HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "cannot flush DSM writes")
+
     file->end = MAX((file->start + file->eof), file->end);
 
-    if ((file->intra_rank == 0) && (SUCCEED != xdmf_dsm_update_entry(file->start, file->end)))
+    /* Space reserved past the end of the file is given back */
+    if ((file->intra_rank == 0) &&
+        ((SUCCEED != xdmf_dsm_update_file_entry(file->slot, file->start, file->end)) ||
+         (SUCCEED != xdmf_dsm_trim_entry(file->slot, file->start, file->end, file->limit))))
       dsm_code = FAIL;
     /* Wait for the DSM entry to be updated */
     if (MPI_SUCCESS != (mpi_code = MPI_Bcast(&dsm_code, sizeof(herr_t),
@@ -713,6 +785,18 @@ XDMF_dsm_close(H5FD_t *_file)
         HMPI_GOTO_ERROR(FAIL, "MPI_Allreduce failed", mpi_code)
   }
 
+  if (file->locked) {
+    /* Readers must all be done before the lock is released */
+    if (file->read_only) {
+      if (MPI_SUCCESS != (mpi_code = MPI_Barrier(file->intra_comm)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Barrier failed", mpi_code)
+    }
+    /* A file that was written holds a new step */
+    if ((file->intra_rank == 0) &&
+        (SUCCEED != xdmf_dsm_unlock_file(file->lock_id, file->read_only, file->dirty)))
+      HGOTO_ERROR(H5E_VFL, H5E_CANTUNLOCK, FAIL, "cannot unlock DSM file")
+  }
+
   /* if ReleaseLockOnClose was set, unlocks using whatever notification
    * unlock_flag was set.
    */
@@ -720,6 +804,7 @@ XDMF_dsm_close(H5FD_t *_file)
   if (SUCCEED != xdmf_dsm_unlock(unlock_flag)) HGOTO_ERROR(H5E_VFL, H5E_CANTUNLOCK, FAIL, "cannot unlock DSM")
 
   /* Release resources */
+  xdmf_dsm_free_write_cache(&file->write_cache);
   if (file->name) HDfree(file->name);
   if (MPI_COMM_NULL != file->intra_comm) MPI_Comm_free(&file->intra_comm);
   HDmemset(file, 0, sizeof(XDMF_dsm_t));
@@ -782,6 +867,7 @@ XDMF_dsm_set_eoa(H5FD_t *_file, H5FD_mem_t UNUSED type, haddr_t addr)
   herr_t ret_value = SUCCEED; /* Return value */
   int mpi_code;
   herr_t dsm_code = SUCCEED;
+  haddr_t start;
 
 #if H5_VERSION_GE(1,8,9)
   FUNC_ENTER_NOAPI_NOINIT
@@ -795,12 +881,43 @@ XDMF_dsm_set_eoa(H5FD_t *_file, H5FD_mem_t UNUSED type, haddr_t addr)
   if (ADDR_OVERFLOW(addr))
     HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "address overflow")
 
+  if (file->start + addr > file->limit) {
+    if (file->read_only)
+      HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "address beyond the DSM space of the file")
+    /* Writes to the current location have to be done before the file is moved */
+    if (SUCCEED != xdmf_dsm_flush_write_cache(&file->write_cache))
+      HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "cannot flush DSM writes")
+    if (MPI_SUCCESS != (mpi_code = MPI_Barrier(file->intra_comm)))
+      HMPI_GOTO_ERROR(FAIL, "MPI_Barrier failed", mpi_code)
+    /* Reserve more space, growing the DSM or moving the file if needed */
+    start = file->start;
+    if ((file->intra_rank == 0) &&
+        (SUCCEED != xdmf_dsm_extend_entry(file->slot, file->end - file->start, addr,
+                                          &start, &file->limit)))
+      dsm_code = FAIL;
+    if (MPI_SUCCESS != (mpi_code = MPI_Bcast(&dsm_code, sizeof(herr_t),
+        MPI_UNSIGNED_CHAR, 0, file->intra_comm)))
+      HMPI_GOTO_ERROR(FAIL, "MPI_Bcast failed", mpi_code)
+    if (SUCCEED != dsm_code)
+      HGOTO_ERROR(H5E_VFL, H5E_NOSPACE, FAIL, "not enough space in DSM")
+    if (MPI_SUCCESS != (mpi_code = MPI_Bcast(&start, sizeof(haddr_t),
+        MPI_UNSIGNED_CHAR, 0, file->intra_comm)))
+      HMPI_GOTO_ERROR(FAIL, "MPI_Bcast failed", mpi_code)
+    if (MPI_SUCCESS != (mpi_code = MPI_Bcast(&file->limit, sizeof(haddr_t),
+        MPI_UNSIGNED_CHAR, 0, file->intra_comm)))
+      HMPI_GOTO_ERROR(FAIL, "MPI_Bcast failed", mpi_code)
+    if (SUCCEED != xdmf_dsm_sync_length(file->intra_comm, file->intra_rank))
+      HGOTO_ERROR(H5E_VFL, H5E_CANTUPDATE, FAIL, "cannot update DSM length")
+    file->end = start + (file->end - file->start);
+    file->start = start;
+  }
+
   file->eoa = addr;
 
   file->end = MAX((file->start + file->eoa), file->end);
   file->eof = file->end - file->start;
   if (!file->read_only) {
-    if ((file->intra_rank == 0) && (SUCCEED != xdmf_dsm_update_entry(file->start, file->end)))
+    if ((file->intra_rank == 0) && (SUCCEED != xdmf_dsm_update_file_entry(file->slot, file->start, file->end)))
       dsm_code = FAIL;
     /* Wait for the DSM entry to be updated */
     if (MPI_SUCCESS != (mpi_code = MPI_Bcast(&dsm_code, sizeof(herr_t),
@@ -869,7 +986,9 @@ XDMF_dsm_read(H5FD_t *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
     H5_CHECK_OVERFLOW(temp_nbytes,hsize_t,size_t);
     nbytes = MIN(size,(size_t)temp_nbytes);
 
-    /* Read from DSM to BUF */
+    /* Read from DSM to BUF, after cached writes to the same bytes */
+    if (SUCCEED != xdmf_dsm_sync_write_cache(&file->write_cache, file->start + addr, nbytes))
+      HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush DSM writes")
     if (SUCCEED != xdmf_dsm_read(file->start + addr, nbytes, buf)) {
       HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "cannot read from DSM")
     } else {
@@ -915,12 +1034,12 @@ XDMF_dsm_write(H5FD_t *_file, H5FD_mem_t UNUSED type, hid_t UNUSED dxpl_id,
   if (addr + size > file->eoa)
     HGOTO_ERROR(H5E_IO, H5E_OVERFLOW, FAIL, "file address overflowed")
 
-  /* For now, do not allow dynamic reallocation of the DSM */
+  /* Space is reserved when the end of address moves, writes may not pass it */
   if (addr + size > file->eof)
     HGOTO_ERROR(H5E_IO, H5E_NOSPACE, FAIL, "not enough space in DSM")
 
   /* Write from BUF to DSM */
-  if (SUCCEED != xdmf_dsm_write(file->start + addr, size, buf))
+  if (SUCCEED != xdmf_dsm_cache_write(&file->write_cache, file->start + addr, size, buf))
     HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot write to DSM")
 
   /* Set dirty flag so that we know someone has written something */
@@ -937,7 +1056,7 @@ done:
 static herr_t
 XDMF_dsm_flush(H5FD_t *_file, hid_t UNUSED dxpl_id, unsigned UNUSED closing)
 {
-  /* H5FD_dsm_t *file = (H5FD_dsm_t*) _file; */
+  XDMF_dsm_t *file = (XDMF_dsm_t*) _file;
   herr_t ret_value = SUCCEED; /* Return value */
 
 #if H5_VERSION_GE(1,8,9)
@@ -946,6 +1065,10 @@ XDMF_dsm_flush(H5FD_t *_file, hid_t UNUSED dxpl_id, unsigned UNUSED closing)
   FUNC_ENTER_NOAPI_NOINIT_NOFUNC(XDMF_dsm_flush)
 #endif
 
+  /* Send everything still held in the write cache */
+  if (SUCCEED != xdmf_dsm_flush_write_cache(&file->write_cache))
+    ret_value = FAIL;
+
   /* Write to backing store */
   /*
   if (file->dirty) {
@@ -1187,6 +1310,19 @@ xdmf_dsm_connect()
 
 herr_t
 xdmf_dsm_update_entry(haddr_t start, haddr_t end)
+{
+  return xdmf_dsm_update_file_entry(0, start, end);
+}
+
+herr_t
+xdmf_dsm_get_entry(haddr_t *start_ptr, haddr_t *end_ptr)
+{
+  haddr_t limit;
+  return xdmf_dsm_get_file_entry(0, start_ptr, end_ptr, &limit);
+}
+
+herr_t
+xdmf_dsm_update_file_entry(int slot, haddr_t start, haddr_t end)
 {
   haddr_t addr;
   XdmfDSMEntry entry;
@@ -1207,12 +1343,13 @@ xdmf_dsm_update_entry(haddr_t start, haddr_t end)
   entry.start = start;
   entry.end   = end;
 
-  addr = (int) (dsmBuffer->GetTotalLength() - sizeof(XdmfDSMEntry) - 1);
+  addr = xdmf_dsm_get_table_address() + slot * sizeof(XdmfDSMEntry);
 
   // Do not send anything if the end of the file is 0
+  // The rest of the entry is left as it is
   if (entry.end > 0) {
     try {
-      dsmBuffer->Put(addr, sizeof(entry), &entry);
+      dsmBuffer->Put(addr, 2 * sizeof(int64_t), &entry);
     }
     catch (XdmfError & e) {
       return FAIL;
@@ -1223,7 +1360,7 @@ xdmf_dsm_update_entry(haddr_t start, haddr_t end)
 }
 
 herr_t
-xdmf_dsm_get_entry(haddr_t *start_ptr, haddr_t *end_ptr)
+xdmf_dsm_get_file_entry(int slot, haddr_t *start_ptr, haddr_t *end_ptr, haddr_t *limit_ptr)
 {
   haddr_t addr;
   XdmfDSMEntry entry;
@@ -1241,7 +1378,7 @@ xdmf_dsm_get_entry(haddr_t *start_ptr, haddr_t *end_ptr)
     }
   }
 
-  addr = (int) (dsmBuffer->GetTotalLength() - sizeof(XdmfDSMEntry) - 1);
+  addr = xdmf_dsm_get_table_address() + slot * sizeof(XdmfDSMEntry);
 
   try {
     dsmBuffer->Get(addr, sizeof(entry), &entry);
@@ -1252,14 +1389,18 @@ xdmf_dsm_get_entry(haddr_t *start_ptr, haddr_t *end_ptr)
 
   *start_ptr = entry.start;
   *end_ptr   = entry.end;
+  *limit_ptr = entry.limit;
 
   return SUCCEED;
 }
 
 herr_t
-xdmf_dsm_lock()
+xdmf_dsm_find_entry(const char *name, hbool_t create, int *slot_ptr)
 {
   XdmfDSMBuffer *dsmBuffer = NULL;
+  XdmfDSMEntry entry;
+  herr_t ret_value;
+
   if (dsmManager != NULL) {
     dsmBuffer = dsmManager->GetDsmBuffer();
   }
@@ -1272,16 +1413,42 @@ xdmf_dsm_lock()
     }
   }
 
-/* behavior will be different here
-  As of right now, controlling race conditions falls on the user
-*/
-  return(SUCCEED);
+  // A single file uses the whole DSM whatever its name
+  if (dsmBuffer->GetFileSlots() == 1) {
+    *slot_ptr = 0;
+    if (create) {
+      entry.start = xdmf_dsm_get_data_address();
+      entry.end   = entry.start;
+      entry.limit = dsmBuffer->GetTotalLength();
+      xdmf_dsm_set_entry_name(entry, name);
+      try {
+        dsmBuffer->Put(xdmf_dsm_get_table_address(), sizeof(entry), &entry);
+      }
+      catch (XdmfError & e) {
+        return FAIL;
+      }
+    }
+    return SUCCEED;
+  }
+
+  if (SUCCEED != xdmf_dsm_lock_table()) {
+    return FAIL;
+  }
+  ret_value = xdmf_dsm_claim_entry(dsmBuffer, name, create, slot_ptr);
+  if (SUCCEED != xdmf_dsm_unlock_table()) {
+    ret_value = FAIL;
+  }
+
+  return ret_value;
 }
 
 herr_t
-xdmf_dsm_unlock(unsigned long flag)
+xdmf_dsm_extend_entry(int slot, haddr_t used, haddr_t length,
+                      haddr_t *start_ptr, haddr_t *limit_ptr)
 {
   XdmfDSMBuffer *dsmBuffer = NULL;
+  herr_t ret_value;
+
   if (dsmManager != NULL) {
     dsmBuffer = dsmManager->GetDsmBuffer();
   }
@@ -1294,16 +1461,24 @@ xdmf_dsm_unlock(unsigned long flag)
     }
   }
 
-/*behavior will be different here
-  As of right now, controlling race conditions falls on the user
-*/
-  return(SUCCEED);
+  if (SUCCEED != xdmf_dsm_lock_table()) {
+    return FAIL;
+  }
+  ret_value = xdmf_dsm_move_entry(dsmBuffer, slot, used, length, start_ptr, limit_ptr);
+  if (SUCCEED != xdmf_dsm_unlock_table()) {
+    ret_value = FAIL;
+  }
+
+  return ret_value;
 }
 
 herr_t
-xdmf_dsm_read(haddr_t addr, size_t len, void *buf_ptr)
+xdmf_dsm_trim_entry(int slot, haddr_t start, haddr_t end, haddr_t limit)
 {
+  haddr_t addr;
+  int64_t new_limit;
   XdmfDSMBuffer *dsmBuffer = NULL;
+
   if (dsmManager != NULL) {
     dsmBuffer = dsmManager->GetDsmBuffer();
   }
@@ -1316,20 +1491,92 @@ xdmf_dsm_read(haddr_t addr, size_t len, void *buf_ptr)
     }
   }
 
+  // Whole allocations are kept so that the file can be reopened and
+  // appended to without moving
+  new_limit = MIN(limit, start + xdmf_dsm_round_allocation(end - start));
+  if ((haddr_t)new_limit == limit) {
+    return SUCCEED;
+  }
+
+  addr = xdmf_dsm_get_table_address() + slot * sizeof(XdmfDSMEntry) + 2 * sizeof(int64_t);
+
   try {
-    dsmBuffer->Get(addr, len, buf_ptr);
+    dsmBuffer->Put(addr, sizeof(int64_t), &new_limit);
   }
   catch (XdmfError & e) {
     return FAIL;
   }
 
-  return(SUCCEED);
+  return SUCCEED;
 }
 
 herr_t
-xdmf_dsm_write(haddr_t addr, size_t len, const void *buf_ptr)
+xdmf_dsm_remove_file(const char *name)
+{
+  XdmfDSMBuffer *dsmBuffer = NULL;
+  std::vector<XdmfDSMEntry> entries;
+  hbool_t locked;
+  int lock_id;
+  unsigned int i;
+  herr_t ret_value = FAIL;
+
+  if (dsmManager != NULL) {
+    dsmBuffer = dsmManager->GetDsmBuffer();
+  }
+  else {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+  // The file must not be open while its space is given away
+  locked = dsmBuffer->GetFileLocking();
+  lock_id = xdmf_dsm_get_lock_id(name);
+  if (locked && (SUCCEED != xdmf_dsm_lock_file(lock_id, FALSE))) {
+    return FAIL;
+  }
+
+  if (SUCCEED == xdmf_dsm_lock_table()) {
+    if (SUCCEED == xdmf_dsm_read_table(dsmBuffer, entries)) {
+      for (i = 0; i < entries.size(); ++i) {
+        if (xdmf_dsm_match_entry(entries[i], name)) {
+          // A free entry has no name and holds no space
+          memset(&entries[i], 0, sizeof(XdmfDSMEntry));
+          try {
+            dsmBuffer->Put(xdmf_dsm_get_table_address() + i * sizeof(XdmfDSMEntry),
+                           sizeof(XdmfDSMEntry), &entries[i]);
+            ret_value = SUCCEED;
+          }
+          catch (XdmfError & e) {
+          }
+          break;
+        }
+      }
+    }
+    if (SUCCEED != xdmf_dsm_unlock_table()) {
+      ret_value = FAIL;
+    }
+  }
+
+  if (locked && (SUCCEED != xdmf_dsm_unlock_file(lock_id, FALSE, FALSE))) {
+    ret_value = FAIL;
+  }
+
+  return ret_value;
+}
+
+herr_t
+xdmf_dsm_get_allocation_statistics(size_t *total, size_t *used,
+    size_t *reserved, size_t *largest_free)
 {
   XdmfDSMBuffer *dsmBuffer = NULL;
+  std::vector<XdmfDSMEntry> entries;
+  std::vector<std::pair<haddr_t, haddr_t> > gaps;
+  unsigned int i;
+
   if (dsmManager != NULL) {
     dsmBuffer = dsmManager->GetDsmBuffer();
   }
@@ -1342,12 +1589,851 @@ xdmf_dsm_write(haddr_t addr, size_t len, const void *buf_ptr)
     }
   }
 
+  if (SUCCEED != xdmf_dsm_read_table(dsmBuffer, entries)) {
+    return FAIL;
+  }
+  xdmf_dsm_find_gaps(entries, dsmBuffer->GetTotalLength(), gaps);
+
+  *total = dsmBuffer->GetTotalLength() - xdmf_dsm_get_data_address();
+  *used = 0;
+  *reserved = 0;
+  for (i = 0; i < entries.size(); ++i) {
+    if (entries[i].name_hash != 0 && entries[i].limit > entries[i].start) {
+      *used += entries[i].end - entries[i].start;
+      *reserved += entries[i].limit - entries[i].start;
+    }
+  }
+  *largest_free = 0;
+  for (i = 0; i < gaps.size(); ++i) {
+    *largest_free = MAX(*largest_free, (size_t)(gaps[i].second - gaps[i].first));
+  }
+
+  return SUCCEED;
+}
+
+haddr_t
+xdmf_dsm_get_table_address()
+{
+  // The table is kept at the start so that growing the DSM leaves it in place
+  return 0;
+}
+
+haddr_t
+xdmf_dsm_get_data_address()
+{
+  return (haddr_t) (xdmf_dsm_get_file_slots() * sizeof(XdmfDSMEntry));
+}
+
+herr_t
+xdmf_dsm_lock_table()
+{
+  // A single file has the table to itself
+  if (xdmf_dsm_get_file_slots() == 1) {
+    return SUCCEED;
+  }
+  return xdmf_dsm_lock_file(XDMF_DSM_TABLE_LOCK, FALSE);
+}
+
+herr_t
+xdmf_dsm_unlock_table()
+{
+  if (xdmf_dsm_get_file_slots() == 1) {
+    return SUCCEED;
+  }
+  return xdmf_dsm_unlock_file(XDMF_DSM_TABLE_LOCK, FALSE, FALSE);
+}
+
+haddr_t
+xdmf_dsm_round_allocation(haddr_t length)
+{
+  haddr_t allocation_length = xdmf_dsm_get_allocation_length();
+
+  if (allocation_length == 0) {
+    return length;
+  }
+  return ((length + allocation_length - 1) / allocation_length) * allocation_length;
+}
+
+herr_t
+xdmf_dsm_sync_length(MPI_Comm comm, int rank)
+{
+  XdmfDSMBuffer *dsmBuffer = NULL;
+  int64_t total = 0;
+
+  if (dsmManager == NULL) {
+    return FAIL;
+  }
+  dsmBuffer = dsmManager->GetDsmBuffer();
+
+  // DSMs without a maximum length never change size
+  if (dsmBuffer->GetMaxLength() <= 0) {
+    return SUCCEED;
+  }
+
+  if (rank == 0) {
+    try {
+      total = dsmBuffer->QueryLength();
+    }
+    catch (XdmfError & e) {
+      total = 0;
+    }
+  }
+  if (MPI_SUCCESS != MPI_Bcast(&total, 1, MPI_INT64_T, 0, comm)) {
+    return FAIL;
+  }
+  if (total <= 0) {
+    return FAIL;
+  }
+  if (total > dsmBuffer->GetTotalLength()) {
+    try {
+      dsmBuffer->QueryLength();
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+  return SUCCEED;
+}
+
+static herr_t
+xdmf_dsm_read_table(XdmfDSMBuffer *dsmBuffer, std::vector<XdmfDSMEntry> & entries)
+{
+  entries.resize(dsmBuffer->GetFileSlots());
   try {
-    dsmBuffer->Put(addr, len, buf_ptr);
+    dsmBuffer->Get(xdmf_dsm_get_table_address(),
+                   entries.size() * sizeof(XdmfDSMEntry),
+                   &entries[0]);
   }
   catch (XdmfError & e) {
     return FAIL;
   }
+  return SUCCEED;
+}
 
-  return(SUCCEED);
+static void
+xdmf_dsm_set_entry_name(XdmfDSMEntry & entry, const char *name)
+{
+  entry.name_hash = xdmf_dsm_get_name_hash(name);
+  memset(entry.name, 0, XDMF_DSM_ENTRY_NAME_LENGTH);
+  strncpy(entry.name, name, XDMF_DSM_ENTRY_NAME_LENGTH - 1);
+}
+
+static hbool_t
+xdmf_dsm_match_entry(const XdmfDSMEntry & entry, const char *name)
+{
+  // Files whose names only differ past the stored part still differ in hash
+  return (entry.name_hash == xdmf_dsm_get_name_hash(name)) &&
+         (strncmp(entry.name, name, XDMF_DSM_ENTRY_NAME_LENGTH - 1) == 0);
+}
+
+static void
+xdmf_dsm_find_gaps(const std::vector<XdmfDSMEntry> & entries, haddr_t total,
+    std::vector<std::pair<haddr_t, haddr_t> > & gaps)
+{
+  std::vector<std::pair<haddr_t, haddr_t> > extents;
+  haddr_t position = xdmf_dsm_get_data_address();
+  unsigned int i;
+
+  for (i = 0; i < entries.size(); ++i) {
+    if (entries[i].name_hash != 0 && entries[i].limit > entries[i].start) {
+      extents.push_back(std::make_pair((haddr_t)entries[i].start,
+                                       (haddr_t)entries[i].limit));
+    }
+  }
+  std::sort(extents.begin(), extents.end());
+
+  gaps.clear();
+  for (i = 0; i < extents.size(); ++i) {
+    if (extents[i].first > position) {
+      gaps.push_back(std::make_pair(position, extents[i].first));
+    }
+    position = MAX(position, extents[i].second);
+  }
+  if (total > position) {
+    gaps.push_back(std::make_pair(position, total));
+  }
+}
+
+static int
+xdmf_dsm_best_gap(const std::vector<std::pair<haddr_t, haddr_t> > & gaps, haddr_t length)
+{
+  int best = -1;
+  for (unsigned int i = 0; i < gaps.size(); ++i) {
+    haddr_t gap_len = gaps[i].second - gaps[i].first;
+    if (gap_len >= length &&
+        (best < 0 || gap_len < gaps[best].second - gaps[best].first)) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+static haddr_t
+xdmf_dsm_grow(XdmfDSMBuffer *dsmBuffer, haddr_t length)
+{
+  // Only servers with room left are asked to grow
+  if (dsmBuffer->GetMaxLength() > dsmBuffer->GetLength()) {
+    try {
+      dsmBuffer->Grow(length);
+    }
+    catch (XdmfError & e) {
+    }
+  }
+  return dsmBuffer->GetTotalLength();
+}
+
+static herr_t
+xdmf_dsm_allocate(XdmfDSMBuffer *dsmBuffer, const std::vector<XdmfDSMEntry> & entries,
+    haddr_t need, haddr_t want, haddr_t *start_ptr, haddr_t *limit_ptr)
+{
+  std::vector<std::pair<haddr_t, haddr_t> > gaps;
+  haddr_t total = dsmBuffer->GetTotalLength();
+  haddr_t tail;
+  int best;
+
+  // The smallest free extent that holds the whole allocation is used
+  xdmf_dsm_find_gaps(entries, total, gaps);
+  best = xdmf_dsm_best_gap(gaps, want);
+  if (best < 0) {
+    // Otherwise the DSM grows so that the free space at its end does
+    tail = total;
+    if (!gaps.empty() && gaps.back().second == total) {
+      tail = gaps.back().first;
+    }
+    if (xdmf_dsm_grow(dsmBuffer, tail + want) > total) {
+      xdmf_dsm_find_gaps(entries, dsmBuffer->GetTotalLength(), gaps);
+      best = xdmf_dsm_best_gap(gaps, want);
+    }
+  }
+  if (best < 0) {
+    best = xdmf_dsm_best_gap(gaps, need);
+  }
+  if (best < 0) {
+    try {
+      XdmfError::message(XdmfError::FATAL, "Not enough free space in the DSM");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+  *start_ptr = gaps[best].first;
+  *limit_ptr = MIN(gaps[best].first + want, gaps[best].second);
+
+  return SUCCEED;
+}
+
+static herr_t
+xdmf_dsm_claim_entry(XdmfDSMBuffer *dsmBuffer, const char *name, hbool_t create,
+    int *slot_ptr)
+{
+  std::vector<XdmfDSMEntry> entries;
+  haddr_t start, limit;
+  unsigned int i;
+
+  if (SUCCEED != xdmf_dsm_read_table(dsmBuffer, entries)) {
+    return FAIL;
+  }
+
+  for (i = 0; i < entries.size(); ++i) {
+    if (xdmf_dsm_match_entry(entries[i], name)) {
+      *slot_ptr = i;
+      return SUCCEED;
+    }
+  }
+
+  // Files that do not exist are only given an entry when created
+  if (!create) {
+    return FAIL;
+  }
+
+  for (i = 0; i < entries.size(); ++i) {
+    if (entries[i].name_hash == 0) {
+      break;
+    }
+  }
+  if (i == entries.size()) {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No free DSM file slot");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+  // Any free space will do for a new file, it is moved if it outgrows it
+  if (SUCCEED != xdmf_dsm_allocate(dsmBuffer, entries, 1,
+                                   xdmf_dsm_round_allocation(1), &start, &limit)) {
+    return FAIL;
+  }
+  entries[i].start = start;
+  entries[i].end = start;
+  entries[i].limit = limit;
+  xdmf_dsm_set_entry_name(entries[i], name);
+  try {
+    dsmBuffer->Put(xdmf_dsm_get_table_address() + i * sizeof(XdmfDSMEntry),
+                   sizeof(XdmfDSMEntry), &entries[i]);
+  }
+  catch (XdmfError & e) {
+    return FAIL;
+  }
+
+  *slot_ptr = i;
+  return SUCCEED;
+}
+
+static herr_t
+xdmf_dsm_move_entry(XdmfDSMBuffer *dsmBuffer, int slot, haddr_t used,
+    haddr_t length, haddr_t *start_ptr, haddr_t *limit_ptr)
+{
+  std::vector<XdmfDSMEntry> entries;
+  haddr_t start, limit, next, want, offset;
+  unsigned int i;
+
+  if (SUCCEED != xdmf_dsm_read_table(dsmBuffer, entries)) {
+    return FAIL;
+  }
+  XdmfDSMEntry & entry = entries[slot];
+  want = xdmf_dsm_round_allocation(length);
+
+  // The file grows in place when the space behind it is free
+  next = dsmBuffer->GetTotalLength();
+  for (i = 0; i < entries.size(); ++i) {
+    if ((int)i != slot && entries[i].name_hash != 0 && entries[i].limit > entries[i].start &&
+        entries[i].start >= entry.start && (haddr_t)entries[i].start < next) {
+      next = entries[i].start;
+    }
+  }
+  if (next == (haddr_t)dsmBuffer->GetTotalLength() && entry.start + length > next) {
+    next = xdmf_dsm_grow(dsmBuffer, entry.start + want);
+  }
+
+  if (entry.start + length <= next) {
+    entry.limit = MIN(entry.start + want, next);
+  }
+  else {
+    // Otherwise it is copied to free space that holds it
+    if (SUCCEED != xdmf_dsm_allocate(dsmBuffer, entries, length, want, &start, &limit)) {
+      return FAIL;
+    }
+    std::vector<char> chunk(MIN(used, (haddr_t)XDMF_DSM_DEFAULT_ALLOCATION_LENGTH));
+    for (offset = 0; offset < used; offset += chunk.size()) {
+      int64_t chunk_len = MIN((haddr_t)chunk.size(), used - offset);
+      try {
+        dsmBuffer->Get(entry.start + offset, chunk_len, &chunk[0]);
+        dsmBuffer->Put(start + offset, chunk_len, &chunk[0]);
+      }
+      catch (XdmfError & e) {
+        return FAIL;
+      }
+    }
+    entry.start = start;
+    entry.end = start + used;
+    entry.limit = limit;
+  }
+
+  try {
+    dsmBuffer->Put(xdmf_dsm_get_table_address() + slot * sizeof(XdmfDSMEntry),
+                   sizeof(XdmfDSMEntry), &entry);
+  }
+  catch (XdmfError & e) {
+    return FAIL;
+  }
+
+  *start_ptr = entry.start;
+  *limit_ptr = entry.limit;
+  return SUCCEED;
+}
+
+int64_t
+xdmf_dsm_get_name_hash(const char *name)
+{
+  // 64 bit FNV-1a, kept positive and non zero so 0 marks a free entry
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char *c = name; c && *c; ++c) {
+    hash ^= (unsigned char)*c;
+    hash *= 1099511628211ULL;
+  }
+  hash &= 0x7FFFFFFFFFFFFFFFULL;
+  if (hash == 0) {
+    hash = 1;
+  }
+  return (int64_t)hash;
+}
+
+int
+xdmf_dsm_get_lock_id(const char *name)
+{
+  int lock_id = (int)(xdmf_dsm_get_name_hash(name) & 0x7FFFFFFF);
+  // The lock of the file table is never used for a file
+  if (lock_id == XDMF_DSM_TABLE_LOCK) {
+    lock_id = XDMF_DSM_TABLE_LOCK + 1;
+  }
+  return lock_id;
+}
+
+herr_t
+xdmf_dsm_set_file_slots(unsigned int num_slots)
+{
+  if (dsmManager == NULL) {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+  try {
+    dsmManager->GetDsmBuffer()->SetFileSlots(num_slots);
+  }
+  catch (XdmfError & e) {
+    return FAIL;
+  }
+  return SUCCEED;
+}
+
+unsigned int
+xdmf_dsm_get_file_slots()
+{
+  if (dsmManager == NULL) {
+    return 1;
+  }
+  return dsmManager->GetDsmBuffer()->GetFileSlots();
+}
+
+void
+xdmf_dsm_set_file_locking(hbool_t locking)
+{
+  if (dsmManager == NULL) {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return;
+    }
+  }
+
+  dsmManager->GetDsmBuffer()->SetFileLocking(locking ? true : false);
+}
+
+hbool_t
+xdmf_dsm_get_file_locking()
+{
+  if (dsmManager == NULL) {
+    return FALSE;
+  }
+  return dsmManager->GetDsmBuffer()->GetFileLocking() ? TRUE : FALSE;
+}
+
+void
+xdmf_dsm_set_allocation_length(size_t length)
+{
+  if (dsmManager == NULL) {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return;
+    }
+  }
+
+  dsmManager->GetDsmBuffer()->SetAllocationLength(length);
+}
+
+size_t
+xdmf_dsm_get_allocation_length()
+{
+  if (dsmManager == NULL) {
+    return XDMF_DSM_DEFAULT_ALLOCATION_LENGTH;
+  }
+  return (size_t) dsmManager->GetDsmBuffer()->GetAllocationLength();
+}
+
+herr_t
+xdmf_dsm_lock_file(int lock_id, hbool_t read_only)
+{
+  XdmfDSMBuffer *dsmBuffer = NULL;
+  if (dsmManager != NULL) {
+    dsmBuffer = dsmManager->GetDsmBuffer();
+  }
+  else {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+  try {
+    dsmBuffer->AcquireLock(lock_id, read_only ? XDMF_DSM_LOCK_READ : XDMF_DSM_LOCK_WRITE);
+  }
+  catch (XdmfError & e) {
+    return FAIL;
+  }
+
+  return SUCCEED;
+}
+
+herr_t
+xdmf_dsm_unlock_file(int lock_id, hbool_t read_only, hbool_t new_step)
+{
+  XdmfDSMBuffer *dsmBuffer = NULL;
+  if (dsmManager != NULL) {
+    dsmBuffer = dsmManager->GetDsmBuffer();
+  }
+  else {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+  try {
+    dsmBuffer->ReleaseLock(lock_id,
+                           read_only ? XDMF_DSM_LOCK_READ : XDMF_DSM_LOCK_WRITE,
+                           new_step ? true : false);
+  }
+  catch (XdmfError & e) {
+    return FAIL;
+  }
+
+  return SUCCEED;
+}
+
+herr_t
+xdmf_dsm_wait_for_step(const char *name, int step, int *new_step_ptr)
+{
+  XdmfDSMBuffer *dsmBuffer = NULL;
+  if (dsmManager != NULL) {
+    dsmBuffer = dsmManager->GetDsmBuffer();
+  }
+  else {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+  try {
+    *new_step_ptr = dsmBuffer->WaitForStep(xdmf_dsm_get_lock_id(name), step);
+  }
+  catch (XdmfError & e) {
+    return FAIL;
+  }
+
+  return SUCCEED;
+}
+
+herr_t
+xdmf_dsm_lock()
+{
+  XdmfDSMBuffer *dsmBuffer = NULL;
+  if (dsmManager != NULL) {
+    dsmBuffer = dsmManager->GetDsmBuffer();
+  }
+  else {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+/* behavior will be different here
+  As of right now, controlling race conditions falls on the user
+*/
+  return(SUCCEED);
+}
+
+herr_t
+xdmf_dsm_unlock(unsigned long flag)
+{
+  XdmfDSMBuffer *dsmBuffer = NULL;
+  if (dsmManager != NULL) {
+    dsmBuffer = dsmManager->GetDsmBuffer();
+  }
+  else {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+/*behavior will be different here
+  As of right now, controlling race conditions falls on the user
+*/
+  return(SUCCEED);
+}
+
+herr_t
+xdmf_dsm_read(haddr_t addr, size_t len, void *buf_ptr)
+{
+  XdmfDSMBuffer *dsmBuffer = NULL;
+  if (dsmManager != NULL) {
+    dsmBuffer = dsmManager->GetDsmBuffer();
+  }
+  else {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+  try {
+    dsmBuffer->Get(addr, len, buf_ptr);
+  }
+  catch (XdmfError & e) {
+    return FAIL;
+  }
+
+  return(SUCCEED);
+}
+
+herr_t
+xdmf_dsm_write(haddr_t addr, size_t len, const void *buf_ptr)
+{
+  XdmfDSMBuffer *dsmBuffer = NULL;
+  if (dsmManager != NULL) {
+    dsmBuffer = dsmManager->GetDsmBuffer();
+  }
+  else {
+    try {
+      XdmfError::message(XdmfError::FATAL, "No DSM manager found");
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+
+  try {
+    dsmBuffer->Put(addr, len, buf_ptr);
+  }
+  catch (XdmfError & e) {
+    return FAIL;
+  }
+
+  return(SUCCEED);
+}
+
+void
+xdmf_dsm_init_write_cache(XdmfDSMWriteCache *cache)
+{
+  HDmemset(cache, 0, sizeof(XdmfDSMWriteCache));
+  cache->block_len = writeCacheLength;
+  cache->num_blocks = writeCacheBlocks;
+}
+
+herr_t
+xdmf_dsm_alloc_write_cache(XdmfDSMWriteCache *cache)
+{
+  unsigned int i;
+
+  cache->blocks = (char **)calloc(cache->num_blocks, sizeof(char *));
+  cache->sent = (hbool_t *)calloc(cache->num_blocks, sizeof(hbool_t));
+  if (cache->blocks == NULL || cache->sent == NULL) {
+    xdmf_dsm_free_write_cache(cache);
+    return FAIL;
+  }
+  for (i = 0; i < cache->num_blocks; ++i) {
+    cache->blocks[i] = (char *)malloc(cache->block_len);
+    if (cache->blocks[i] == NULL) {
+      xdmf_dsm_free_write_cache(cache);
+      return FAIL;
+    }
+  }
+  cache->current = 0;
+  cache->addr = 0;
+  cache->used = 0;
+
+  return(SUCCEED);
+}
+
+void
+xdmf_dsm_free_write_cache(XdmfDSMWriteCache *cache)
+{
+  unsigned int i;
+
+  if (cache->blocks) {
+    for (i = 0; i < cache->num_blocks; ++i) {
+      free(cache->blocks[i]);
+    }
+    free(cache->blocks);
+  }
+  if (cache->sent) {
+    free(cache->sent);
+  }
+  cache->blocks = NULL;
+  cache->sent = NULL;
+  cache->buffer = NULL;
+  cache->current = 0;
+  cache->addr = 0;
+  cache->used = 0;
+}
+
+herr_t
+xdmf_dsm_cache_write(XdmfDSMWriteCache *cache, haddr_t addr, size_t len,
+    const void *buf_ptr)
+{
+  writeStatistics.writes++;
+  writeStatistics.bytes += len;
+
+  if (cache->block_len > 0 && len < cache->block_len) {
+    if (cache->blocks == NULL) {
+      if (SUCCEED != xdmf_dsm_alloc_write_cache(cache)) {
+        return FAIL;
+      }
+    }
+    // Writes landing in or right after the cached range are combined
+    if (cache->used > 0 &&
+        addr >= cache->addr &&
+        addr <= cache->addr + cache->used &&
+        addr + len <= cache->addr + cache->block_len) {
+      memcpy(cache->blocks[cache->current] + (addr - cache->addr),
+             buf_ptr,
+             len);
+      cache->used = MAX(cache->used, (size_t)(addr + len - cache->addr));
+      return(SUCCEED);
+    }
+    // Otherwise the cached data is sent and a new range is started
+    if (SUCCEED != xdmf_dsm_send_write_cache(cache)) {
+      return FAIL;
+    }
+    // The range goes to the DSM the file is written to now
+    if (dsmManager == NULL) {
+      return FAIL;
+    }
+    cache->buffer = dsmManager->GetDsmBuffer();
+    memcpy(cache->blocks[cache->current], buf_ptr, len);
+    cache->addr = addr;
+    cache->used = len;
+    return(SUCCEED);
+  }
+
+  // Large writes go out directly, after anything already cached
+  if (SUCCEED != xdmf_dsm_send_write_cache(cache)) {
+    return FAIL;
+  }
+  if (SUCCEED != xdmf_dsm_write(addr, len, buf_ptr)) {
+    return FAIL;
+  }
+  writeStatistics.messages++;
+
+  return(SUCCEED);
+}
+
+herr_t
+xdmf_dsm_send_write_cache(XdmfDSMWriteCache *cache)
+{
+  unsigned int i;
+
+  if (cache->used == 0) {
+    return(SUCCEED);
+  }
+
+  try {
+    cache->buffer->PutNonBlocking(cache->addr,
+                                  cache->used,
+                                  cache->blocks[cache->current]);
+    writeStatistics.messages++;
+    cache->sent[cache->current] = TRUE;
+    cache->current = (cache->current + 1) % cache->num_blocks;
+    cache->addr = 0;
+    cache->used = 0;
+    // Bound the transfers in flight, the next block can only be filled
+    // once the transfer from it has completed
+    if (cache->sent[cache->current]) {
+      cache->buffer->WaitNonBlocking();
+      for (i = 0; i < cache->num_blocks; ++i) {
+        cache->sent[i] = FALSE;
+      }
+    }
+  }
+  catch (XdmfError & e) {
+    return FAIL;
+  }
+
+  return(SUCCEED);
+}
+
+herr_t
+xdmf_dsm_sync_write_cache(XdmfDSMWriteCache *cache, haddr_t addr, size_t len)
+{
+  // Cached writes overlapping the range have to reach the DSM first,
+  // transfers already sent are handled before a later get by the servers
+  if (cache->used > 0 &&
+      addr < cache->addr + cache->used &&
+      cache->addr < addr + len) {
+    return xdmf_dsm_send_write_cache(cache);
+  }
+  return(SUCCEED);
+}
+
+herr_t
+xdmf_dsm_flush_write_cache(XdmfDSMWriteCache *cache)
+{
+  unsigned int i;
+
+  if (cache->blocks == NULL) {
+    return(SUCCEED);
+  }
+
+  XdmfDSMBuffer *dsmBuffer = cache->buffer;
+
+  if (SUCCEED != xdmf_dsm_send_write_cache(cache)) {
+    return FAIL;
+  }
+
+  if (dsmBuffer != NULL) {
+    try {
+      dsmBuffer->WaitNonBlocking();
+    }
+    catch (XdmfError & e) {
+      return FAIL;
+    }
+  }
+  for (i = 0; i < cache->num_blocks; ++i) {
+    cache->sent[i] = FALSE;
+  }
+
+  return(SUCCEED);
+}
+
+herr_t
+xdmf_dsm_set_write_cache(size_t block_len, unsigned int num_blocks)
+{
+  if (num_blocks < 1) {
+    num_blocks = 1;
+  }
+  writeCacheLength = block_len;
+  writeCacheBlocks = num_blocks;
+
+  return(SUCCEED);
+}
+
+void
+xdmf_dsm_get_write_statistics(size_t *writes, size_t *bytes, size_t *messages)
+{
+  if (writes) *writes = writeStatistics.writes;
+  if (bytes) *bytes = writeStatistics.bytes;
+  if (messages) *messages = writeStatistics.messages;
+}
+
+void
+xdmf_dsm_reset_write_statistics()
+{
+  writeStatistics.writes = 0;
+  writeStatistics.bytes = 0;
+  writeStatistics.messages = 0;
 }
@@ -79,6 +79,14 @@
 /* User notifications */
 #define XDMF_DSM_NOTIFY_USER         0x0010 
 
+/* Small writes are combined into blocks of this length before being sent */
+#define XDMF_DSM_DEFAULT_WRITE_CACHE_LENGTH 65536
+/* Number of blocks, bounds the transfers in flight */
+#define XDMF_DSM_DEFAULT_WRITE_CACHE_BLOCKS 4
+
+/* Lock protecting the DSM file table, never used by a file */
+#define XDMF_DSM_TABLE_LOCK 0
+
 #define XDMF_DSM (XDMF_dsm_init())
 
 #define IS_XDMF_DSM(f) /* (H5F_t *f) */    \
@@ -133,14 +141,65 @@ extern "C" {
   XDMFDSM_EXPORT hbool_t xdmf_dsm_is_connected();
   XDMFDSM_EXPORT herr_t  xdmf_dsm_connect();
 
+  // Files are kept in a table of entries at the start of the DSM, each
+  // entry holds the extent of DSM space reserved for its file. With a
+  // single slot the file uses the whole DSM, with more every file is
+  // given space from the free extents as it grows and closing a file
+  // gives back the space it did not use.
+  // Entries are found by file name, names are stored up to 255 characters.
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_update_file_entry(int slot, haddr_t start, haddr_t end);
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_get_file_entry(int slot, haddr_t *start_ptr, haddr_t *end_ptr,
+      haddr_t *limit_ptr);
+  // Entry of the first slot, the file of a DSM with a single slot
   XDMFDSM_EXPORT herr_t  xdmf_dsm_update_entry(haddr_t start, haddr_t end);
   XDMFDSM_EXPORT herr_t  xdmf_dsm_get_entry(haddr_t *start_ptr, haddr_t *end_ptr);
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_find_entry(const char *name, hbool_t create, int *slot_ptr);
+  // Reserves length bytes for the file, growing the DSM or moving the
+  // used bytes of the file elsewhere when the space behind it is taken
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_extend_entry(int slot, haddr_t used, haddr_t length,
+      haddr_t *start_ptr, haddr_t *limit_ptr);
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_trim_entry(int slot, haddr_t start, haddr_t end, haddr_t limit);
+  // Frees the entry and space of a file that is no longer needed, with
+  // file locking on it waits until the file is closed everywhere
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_remove_file(const char *name);
+  // The number of slots, the allocation length and file locking are kept
+  // in the DSM buffer of the current manager, clients take the settings
+  // of the servers when they connect. Changing them afterwards must be
+  // done on every client core while no file is open.
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_set_file_slots(unsigned int num_slots);
+  XDMFDSM_EXPORT unsigned int xdmf_dsm_get_file_slots();
+  XDMFDSM_EXPORT void    xdmf_dsm_set_allocation_length(size_t length);
+  XDMFDSM_EXPORT size_t  xdmf_dsm_get_allocation_length();
+  // Occupancy is used over total bytes, fragmentation is one minus the
+  // largest free extent over all free bytes
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_get_allocation_statistics(size_t *total,
+      size_t *used, size_t *reserved, size_t *largest_free);
+
+  // When file locking is on a file is locked for reading or writing while
+  // it is open, closing a file that was written releases a new step
+  XDMFDSM_EXPORT void    xdmf_dsm_set_file_locking(hbool_t locking);
+  XDMFDSM_EXPORT hbool_t xdmf_dsm_get_file_locking();
+  XDMFDSM_EXPORT int     xdmf_dsm_get_lock_id(const char *name);
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_lock_file(int lock_id, hbool_t read_only);
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_unlock_file(int lock_id, hbool_t read_only, hbool_t new_step);
+  // Waits until the file has been written more than step times
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_wait_for_step(const char *name, int step, int *new_step_ptr);
 
   XDMFDSM_EXPORT herr_t  xdmf_dsm_lock();
   XDMFDSM_EXPORT herr_t  xdmf_dsm_unlock(unsigned long flag);
 
   XDMFDSM_EXPORT herr_t  xdmf_dsm_read(haddr_t addr, size_t len, void *buf_ptr);
   XDMFDSM_EXPORT herr_t  xdmf_dsm_write(haddr_t addr, size_t len, const void *buf_ptr);
+
+  // Writes to a file smaller than a block are combined in a cache kept
+  // with the open file and sent without waiting, the cache is flushed
+  // when the file is flushed or closed. The configuration applies to
+  // files opened afterwards, a block length of 0 disables the cache.
+  XDMFDSM_EXPORT herr_t  xdmf_dsm_set_write_cache(size_t block_len, unsigned int num_blocks);
+  // Counters summed over all files
+  XDMFDSM_EXPORT void    xdmf_dsm_get_write_statistics(size_t *writes,
+      size_t *bytes, size_t *messages);
+  XDMFDSM_EXPORT void    xdmf_dsm_reset_write_statistics();
 }
 
 #endif /* XDMFDSMDRIVER_HPP_ */
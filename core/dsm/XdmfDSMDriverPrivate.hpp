@@ -0,0 +1,62 @@
+/*****************************************************************************/
+/*                                    XDMF                                   */
+/*                       eXtensible Data Model and Format                    */
+/*                                                                           */
+/*  Id : XdmfDSMDriverPrivate.hpp                                            */
+/*                                                                           */
+/*     This software is distributed WITHOUT ANY WARRANTY; without            */
+/*     even the implied warranty of MERCHANTABILITY or FITNESS               */
+/*     FOR A PARTICULAR PURPOSE.  See Copyright.txt for details.             */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef XDMFDSMDRIVERPRIVATE_HPP_
+#define XDMFDSMDRIVERPRIVATE_HPP_
+
+// Helpers of the DSM file driver, used by XdmfDSMDriver.cpp only. This
+// header is not installed.
+
+// Forward Declarations
+class XdmfDSMBuffer;
+
+// Includes
+#include <mpi.h>
+#include <hdf5.h>
+
+typedef struct
+{
+  XdmfDSMBuffer *buffer;  /* buffer the cached range is sent to          */
+  char **blocks;          /* blocks that writes are combined into        */
+  hbool_t *sent;          /* block was sent and may still be in transfer */
+  unsigned int num_blocks;/* number of blocks                            */
+  unsigned int current;   /* block currently being filled                */
+  size_t block_len;       /* length of each block, 0 disables the cache  */
+  haddr_t addr;           /* DSM address of the current block's data     */
+  size_t used;            /* bytes held in the current block             */
+} XdmfDSMWriteCache;
+
+// File table, called by core 0 of the files' communicator
+haddr_t xdmf_dsm_get_table_address();
+haddr_t xdmf_dsm_get_data_address();
+herr_t  xdmf_dsm_lock_table();
+herr_t  xdmf_dsm_unlock_table();
+haddr_t xdmf_dsm_round_allocation(haddr_t length);
+herr_t  xdmf_dsm_sync_length(MPI_Comm comm, int rank);
+int64_t xdmf_dsm_get_name_hash(const char *name);
+
+// Write cache of an open file, takes the configuration set with
+// xdmf_dsm_set_write_cache when initialized and allocates its blocks
+// on the first small write
+void    xdmf_dsm_init_write_cache(XdmfDSMWriteCache *cache);
+herr_t  xdmf_dsm_alloc_write_cache(XdmfDSMWriteCache *cache);
+void    xdmf_dsm_free_write_cache(XdmfDSMWriteCache *cache);
+herr_t  xdmf_dsm_cache_write(XdmfDSMWriteCache *cache, haddr_t addr, size_t len,
+    const void *buf_ptr);
+// Sends the cached range without waiting for the transfer
+herr_t  xdmf_dsm_send_write_cache(XdmfDSMWriteCache *cache);
+// Sends the cached range if it overlaps len bytes at addr
+herr_t  xdmf_dsm_sync_write_cache(XdmfDSMWriteCache *cache, haddr_t addr, size_t len);
+// Sends the cached range and waits for every transfer to complete
+herr_t  xdmf_dsm_flush_write_cache(XdmfDSMWriteCache *cache);
+
+#endif /* XDMFDSMDRIVERPRIVATE_HPP_ */
@@ -67,6 +67,7 @@ XdmfDSMManager::XdmfDSMManager()
   this->UpdatePiece             = 0;
   this->UpdateNumPieces         = 0;
   this->LocalBufferSizeMBytes   = 128;
+  this->MaxBufferSizeMBytes     = 0;
 
   this->DsmBuffer               = NULL;
   this->DsmComm                 = NULL;
@@ -74,6 +75,8 @@ XdmfDSMManager::XdmfDSMManager()
   this->DsmType                 = XDMF_DSM_TYPE_UNIFORM;
   this->BlockLength             = XDMF_DSM_DEFAULT_BLOCK_LENGTH;
   this->InterCommType           = XDMF_DSM_COMM_MPI;
+  this->TransportType           = XDMF_DSM_TRANSPORT_MESSAGE;
+  this->UseSharedMemory         = false;
 }
 
 XdmfDSMManager::~XdmfDSMManager()
@@ -118,6 +121,26 @@ XdmfDSMManager::Create(int startId, int endId)
 {
   if (!this->DsmBuffer) {
 
+    // Buffers that can not grow are rejected before any is created
+    if (this->GetMaxBufferSizeMBytes() > this->GetLocalBufferSizeMBytes()) {
+      if (this->DsmType != XDMF_DSM_TYPE_BLOCK_CYCLIC &&
+          this->DsmType != XDMF_DSM_TYPE_BLOCK_RANDOM) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Error: A maximum buffer size is only supported "
+                           "by block cyclic and block random DSMs");
+      }
+      if (this->TransportType == XDMF_DSM_TRANSPORT_RMA) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Error: A maximum buffer size is not supported "
+                           "with RMA transport");
+      }
+      if (this->UseSharedMemory) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Error: A maximum buffer size is not supported "
+                           "with shared memory");
+      }
+    }
+
     MPI_Comm_size(this->MpiComm, &this->UpdateNumPieces);
     MPI_Comm_rank(this->MpiComm, &this->UpdatePiece);
     //
@@ -143,8 +166,11 @@ XdmfDSMManager::Create(int startId, int endId)
     this->DsmBuffer = new XdmfDSMBuffer();
     //
     this->DsmBuffer->SetIsServer(this->IsServer);
+    this->DsmBuffer->SetTransportType(this->TransportType);
+    this->DsmBuffer->SetUseSharedMemory(this->UseSharedMemory);
+    this->DsmBuffer->SetMaxLength((int64_t) (this->GetMaxBufferSizeMBytes())*1024LU*1024LU);
     // Uniform Dsm : every node has a buffer the same size. (Addresses are sequential)
-    long length = (long) (this->GetLocalBufferSizeMBytes())*1024LU*1024LU;
+    int64_t length = (int64_t) (this->GetLocalBufferSizeMBytes())*1024LU*1024LU;
     switch (this->DsmType) {
     case XDMF_DSM_TYPE_UNIFORM:
     case XDMF_DSM_TYPE_UNIFORM_RANGE:
@@ -197,7 +223,7 @@ XdmfDSMManager::Disconnect()
   dynamic_cast<XdmfDSMBuffer*> (this->DsmBuffer)->SetIsConnected(false);
 }
 
-long
+int64_t
 XdmfDSMManager::GetBlockLength()
 {
   return this->BlockLength;
@@ -244,12 +270,24 @@ XdmfDSMManager::GetLocalBufferSizeMBytes()
   return this->LocalBufferSizeMBytes;
 }
 
+unsigned int
+XdmfDSMManager::GetMaxBufferSizeMBytes()
+{
+  return this->MaxBufferSizeMBytes;
+}
+
 MPI_Comm
 XdmfDSMManager::GetMpiComm()
 {
   return this->MpiComm;
 }
 
+int
+XdmfDSMManager::GetTransportType()
+{
+  return this->TransportType;
+}
+
 int
 XdmfDSMManager::GetUpdatePiece()
 {
@@ -262,8 +300,14 @@ XdmfDSMManager::GetUpdateNumPieces()
   return this->UpdateNumPieces;
 }
 
+bool
+XdmfDSMManager::GetUseSharedMemory()
+{
+  return this->UseSharedMemory;
+}
+
 void
-XdmfDSMManager::SetBlockLength(long newSize)
+XdmfDSMManager::SetBlockLength(int64_t newSize)
 {
   this->BlockLength = newSize;
 }
@@ -298,6 +342,12 @@ XdmfDSMManager::SetLocalBufferSizeMBytes(unsigned int newSize)
   this->LocalBufferSizeMBytes = newSize;
 }
 
+void
+XdmfDSMManager::SetMaxBufferSizeMBytes(unsigned int newSize)
+{
+  this->MaxBufferSizeMBytes = newSize;
+}
+
 void
 XdmfDSMManager::SetMpiComm(MPI_Comm comm)
 {
@@ -309,3 +359,15 @@ XdmfDSMManager::SetMpiComm(MPI_Comm comm)
     }
   }
 }
+
+void
+XdmfDSMManager::SetTransportType(int newType)
+{
+  this->TransportType = newType;
+}
+
+void
+XdmfDSMManager::SetUseSharedMemory(bool newUseShared)
+{
+  this->UseSharedMemory = newUseShared;
+}
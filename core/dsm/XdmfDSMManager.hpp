@@ -303,7 +303,7 @@ public:
    *
    * @return    The size of the blocks currently being used
    */
-  long GetBlockLength();
+  int64_t GetBlockLength();
 
   /**
    * Gets the manager's internal buffer.
@@ -625,6 +625,61 @@ public:
    */
   unsigned int GetLocalBufferSizeMBytes();
 
+  /**
+   * Gets the largest size that the data buffer on each server core may
+   * grow to, in MB. A maximum no larger than the local buffer size
+   * keeps the DSM at a fixed size.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#GetMaxBufferSizeMBytes
+   * @until //#GetMaxBufferSizeMBytes
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetMaxBufferSizeMBytes
+   * @until #//GetMaxBufferSizeMBytes
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    The largest size of the data buffer on server cores
+   */
+  unsigned int GetMaxBufferSizeMBytes();
+
   /**
    * Gets the MpiComm that the manager is currently using.
    *
@@ -678,6 +733,61 @@ public:
    */
   MPI_Comm GetMpiComm();
 
+  /**
+   * Gets the transport that the buffers created by the Manager use to
+   * move data between clients and servers.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#GetTransportType
+   * @until //#GetTransportType
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetTransportType
+   * @until #//GetTransportType
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    The transport, XDMF_DSM_TRANSPORT_MESSAGE or
+   *            XDMF_DSM_TRANSPORT_RMA
+   */
+  int GetTransportType();
+
   /**
    * Gets the id of the core with regards to the MpiComm
    *
@@ -784,6 +894,60 @@ public:
    */
   int GetUpdateNumPieces();
 
+  /**
+   * Gets whether the buffer lets cores on the same node as a server
+   * copy data directly to and from its memory.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#GetUseSharedMemory
+   * @until //#GetUseSharedMemory
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetUseSharedMemory
+   * @until #//GetUseSharedMemory
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    Whether shared memory is used for cores on the same node
+   */
+  bool GetUseSharedMemory();
+
   /**
    * Sets the block length for the DSM data buffer.
    * Memory will be alloted in a multiple of the block size.
@@ -840,7 +1004,7 @@ public:
    *
    * @param     newSize         The size to the blocks to be used
    */
-  void SetBlockLength(long newSize);
+  void SetBlockLength(int64_t newSize);
 
   /**
    * Sets the manager's internal buffer to the buffer provided.
@@ -1124,6 +1288,68 @@ public:
    */
   void SetLocalBufferSizeMBytes(unsigned int newSize);
 
+  /**
+   * Sets the largest size that the data buffer on each server core may
+   * grow to, in MB. Only block cyclic and block random DSMs grow, by
+   * whole blocks as the files written to them need the space. Has to be
+   * set before the DSM is created. Creating a DSM with a maximum size
+   * above the local buffer size fails for uniform DSMs and for DSMs using
+   * RMA transport or shared memory.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#GetMaxBufferSizeMBytes
+   * @until //#GetMaxBufferSizeMBytes
+   * @skipline //#SetMaxBufferSizeMBytes
+   * @until //#SetMaxBufferSizeMBytes
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetMaxBufferSizeMBytes
+   * @until #//GetMaxBufferSizeMBytes
+   * @skipline #//SetMaxBufferSizeMBytes
+   * @until #//SetMaxBufferSizeMBytes
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     newSize         The largest size of the data buffer on the server cores
+   */
+  void SetMaxBufferSizeMBytes(unsigned int newSize);
+
   /**
    * Sets the MpiComm to the provided communicator and
    * updates UpdatePiece and UpdateNumPieces
@@ -1182,6 +1408,129 @@ public:
    */
   void SetMpiComm(MPI_Comm comm);
 
+  /**
+   * Sets the transport that buffers created by Create will use.
+   * XDMF_DSM_TRANSPORT_MESSAGE sends each Put and Get to the server's
+   * service loop. XDMF_DSM_TRANSPORT_RMA uses MPI one sided communication
+   * to read and write the server's buffer without involving the service
+   * loop, it requires an MPI-3 implementation with passive target
+   * support.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#GetTransportType
+   * @until //#GetTransportType
+   * @skipline //#SetTransportType
+   * @until //#SetTransportType
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetTransportType
+   * @until #//GetTransportType
+   * @skipline #//SetTransportType
+   * @until #//SetTransportType
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     newType The transport to be used
+   */
+  void SetTransportType(int newType);
+
+  /**
+   * Sets whether the buffer lets cores on the same node as a server
+   * copy data directly to and from its memory through an MPI shared
+   * memory window. Cores on other nodes use the transport set by
+   * SetTransportType. Must be set before the buffer is created.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#declaremanager
+   * @until //#declaremanager
+   * @skipline //#getServerManagerwriter
+   * @until //#getServerManagerwriter
+   * @skipline //#GetUseSharedMemory
+   * @until //#GetUseSharedMemory
+   * @skipline //#SetUseSharedMemory
+   * @until //#SetUseSharedMemory
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getServerManagerwriter
+   * @until #//getServerManagerwriter
+   * @skipline #//GetUseSharedMemory
+   * @until #//GetUseSharedMemory
+   * @skipline #//SetUseSharedMemory
+   * @until #//SetUseSharedMemory
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     newUseShared    Whether to use shared memory for cores
+   *                            on the same node
+   */
+  void SetUseSharedMemory(bool newUseShared);
+
 protected:
 
 
@@ -1190,6 +1539,7 @@ private:
   int    UpdatePiece;
   int    UpdateNumPieces;
   unsigned int   LocalBufferSizeMBytes;
+  unsigned int   MaxBufferSizeMBytes;
     
   MPI_Comm MpiComm;
 
@@ -1198,8 +1548,10 @@ private:
 
   bool  IsServer;
   int    DsmType;
-  long   BlockLength;
+  int64_t BlockLength;
   int    InterCommType;
+  int    TransportType;
+  bool   UseSharedMemory;
 };
 
 #endif /* XDMFDSMMANAGER_HPP_ */
@@ -507,6 +507,69 @@ void XdmfHDF5ControllerDSM::restartDSM()
 }
 
 void XdmfHDF5ControllerDSM::read(XdmfArray * const array)
+{
+  this->read(array, mType);
+}
+
+void XdmfHDF5ControllerDSM::read(XdmfArray * const array,
+                                 const shared_ptr<const XdmfArrayType> & readType)
+{
+  // Set file access property list for DSM
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+
+  // Use DSM driver
+  if (mServerMode) {
+    if (mWorkerComm != MPI_COMM_NULL) {
+      XDMFH5Pset_fapl_dsm(fapl, mWorkerComm, mDSMServerBuffer, 0);
+    }
+  }
+  else {
+#ifdef XDMF_BUILD_DSM_THREADS
+    H5Pset_fapl_dsm(fapl, MPI_COMM_WORLD, mDSMBuffer, 0);
+#else
+    XdmfError::message(XdmfError::FATAL, "Error: Threaded DSM not enabled");
+#endif
+  }
+
+  // Read from DSM Buffer
+  XdmfHDF5Controller::read(array, readType, fapl);
+
+  // Close file access property list
+  H5Pclose(fapl);
+}
+
+void XdmfHDF5ControllerDSM::read(XdmfArray * const array,
+                                 const unsigned int start,
+                                 const unsigned int stride,
+                                 const unsigned int count)
+{
+  // Set file access property list for DSM
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+
+  // Use DSM driver
+  if (mServerMode) {
+    if (mWorkerComm != MPI_COMM_NULL) {
+      XDMFH5Pset_fapl_dsm(fapl, mWorkerComm, mDSMServerBuffer, 0);
+    }
+  }
+  else {
+#ifdef XDMF_BUILD_DSM_THREADS
+    H5Pset_fapl_dsm(fapl, MPI_COMM_WORLD, mDSMBuffer, 0);
+#else
+    XdmfError::message(XdmfError::FATAL, "Error: Threaded DSM not enabled");
+#endif
+  }
+
+  // Read from DSM Buffer
+  XdmfHDF5Controller::read(array, start, stride, count, fapl);
+
+  // Close file access property list
+  H5Pclose(fapl);
+}
+
+void XdmfHDF5ControllerDSM::read(void * const valuesPointer,
+                                 const shared_ptr<const XdmfArrayType> & valuesType,
+                                 const unsigned int numValues)
 {
   // Set file access property list for DSM
   hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
@@ -526,7 +589,7 @@ void XdmfHDF5ControllerDSM::read(XdmfArray * const array)
   }
 
   // Read from DSM Buffer
-  XdmfHDF5Controller::read(array, fapl);
+  XdmfHDF5Controller::read(valuesPointer, valuesType, numValues, fapl);
 
   // Close file access property list
   H5Pclose(fapl);
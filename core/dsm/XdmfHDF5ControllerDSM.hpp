@@ -937,6 +937,18 @@ public:
 
   void read(XdmfArray * const array);
 
+  void read(XdmfArray * const array,
+            const shared_ptr<const XdmfArrayType> & readType);
+
+  void read(XdmfArray * const array,
+            const unsigned int start,
+            const unsigned int stride,
+            const unsigned int count);
+
+  void read(void * const valuesPointer,
+            const shared_ptr<const XdmfArrayType> & valuesType,
+            const unsigned int numValues);
+
   /**
    * Restarts the DSM when called on server cores.
    * 
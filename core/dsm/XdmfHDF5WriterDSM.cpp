@@ -30,10 +30,15 @@
 #endif
 #include <H5public.h>
 #include <hdf5.h>
+#include <cstring>
+#include <sstream>
 #include <XdmfDSMCommMPI.hpp>
 #include <XdmfDSMBuffer.hpp>
 #include <XdmfDSMManager.hpp>
 #include <XdmfDSMDriver.hpp>
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfBinaryControllerDSM.hpp"
 #include "XdmfHDF5ControllerDSM.hpp"
 #include "XdmfHDF5WriterDSM.hpp"
 #include "XdmfError.hpp"
@@ -77,10 +82,26 @@ XdmfHDF5WriterDSM::New(const std::string & filePath,
                        unsigned int bufferSize,
                        int startCoreIndex,
                        int endCoreIndex)
+{
+  XdmfDSMManager * dsmManager = new XdmfDSMManager();
+  dsmManager->SetLocalBufferSizeMBytes(bufferSize);
+  return XdmfHDF5WriterDSM::New(filePath,
+                                comm,
+                                dsmManager,
+                                startCoreIndex,
+                                endCoreIndex);
+}
+
+shared_ptr<XdmfHDF5WriterDSM>
+XdmfHDF5WriterDSM::New(const std::string & filePath,
+                       MPI_Comm comm,
+                       XdmfDSMManager * const dsmManager,
+                       int startCoreIndex,
+                       int endCoreIndex)
 {
   shared_ptr<XdmfHDF5WriterDSM> p(new XdmfHDF5WriterDSM(filePath,
                                                         comm,
-                                                        bufferSize,
+                                                        dsmManager,
                                                         startCoreIndex,
                                                         endCoreIndex));
   return p;
@@ -93,6 +114,7 @@ XdmfHDF5WriterDSM::XdmfHDF5WriterDSM(const std::string & filePath,
   mDSMManager(NULL),
   mDSMBuffer(dsmBuffer),
   mFAPL(-1),
+  mRawMode(false),
   mDSMServerManager(NULL),
   mDSMServerBuffer(NULL),
   mWorkerComm(MPI_COMM_NULL),
@@ -105,6 +127,7 @@ XdmfHDF5WriterDSM::XdmfHDF5WriterDSM(const std::string & filePath,
                                      unsigned int bufferSize) :
   XdmfHDF5Writer(filePath),
   mFAPL(-1),
+  mRawMode(false),
   mDSMServerManager(NULL),
   mDSMServerBuffer(NULL),
   mWorkerComm(MPI_COMM_NULL),
@@ -135,6 +158,7 @@ XdmfHDF5WriterDSM::XdmfHDF5WriterDSM(const std::string & filePath,
   mDSMBuffer(NULL),
 #endif
   mFAPL(-1),
+  mRawMode(false),
   mDSMServerManager(NULL),
   mDSMServerBuffer(dsmBuffer),
   mServerMode(true)
@@ -156,11 +180,12 @@ XdmfHDF5WriterDSM::XdmfHDF5WriterDSM(const std::string & filePath,
 
 XdmfHDF5WriterDSM::XdmfHDF5WriterDSM(const std::string & filePath,
                                      MPI_Comm comm,
-                                     unsigned int bufferSize,
+                                     XdmfDSMManager * const dsmManager,
                                      int startCoreIndex,
                                      int endCoreIndex) :
   XdmfHDF5Writer(filePath),
   mFAPL(-1),
+  mRawMode(false),
 #ifdef XDMF_BUILD_DSM_THREADS
   mDSMManager(NULL),
   mDSMBuffer(NULL),
@@ -207,9 +232,8 @@ XdmfHDF5WriterDSM::XdmfHDF5WriterDSM(const std::string & filePath,
 
   // Create the manager
 
-  mDSMServerManager = new XdmfDSMManager();
+  mDSMServerManager = dsmManager;
 
-  mDSMServerManager->SetLocalBufferSizeMBytes(bufferSize);
   mDSMServerManager->SetInterCommType(XDMF_DSM_COMM_MPI);
 
   MPI_Barrier(comm);
@@ -338,6 +362,11 @@ H5FDdsmManager * XdmfHDF5WriterDSM::getManager()
 }
 #endif
 
+bool XdmfHDF5WriterDSM::getRawMode()
+{
+  return mRawMode;
+}
+
 XdmfDSMBuffer * XdmfHDF5WriterDSM::getServerBuffer()
 {
   return mDSMServerBuffer;
@@ -396,6 +425,15 @@ void XdmfHDF5WriterDSM::setManager(XdmfDSMManager * newManager)
   mDSMServerBuffer = newBuffer;
 }
 
+void XdmfHDF5WriterDSM::setRawMode(bool newMode)
+{
+  if (newMode != mRawMode) {
+    // A raw file is never held open
+    this->closeFile();
+  }
+  mRawMode = newMode;
+}
+
 void XdmfHDF5WriterDSM::setServerMode(bool newMode)
 {
   mServerMode = newMode;
@@ -459,6 +497,10 @@ XdmfHDF5WriterDSM::openFile()
     this->closeFile();
   }
 
+  if (mRawMode) {
+    return;
+  }
+
   // Set file access property list for DSM
   mFAPL = H5Pcreate(H5P_FILE_ACCESS);
 
@@ -480,6 +522,11 @@ XdmfHDF5WriterDSM::openFile()
 void XdmfHDF5WriterDSM::visit(XdmfArray & array,
                               const shared_ptr<XdmfBaseVisitor>)
 {
+  if (mRawMode) {
+    this->writeRaw(array);
+    return;
+  }
+
   bool closeFAPL = false;
 
   if(mFAPL < 0) {
@@ -512,3 +559,166 @@ void XdmfHDF5WriterDSM::visit(XdmfArray & array,
   }
 
 }
+
+void XdmfHDF5WriterDSM::writeRaw(XdmfArray & array)
+{
+  if (!array.isInitialized()) {
+    return;
+  }
+
+  if (!mServerMode || mDSMServerBuffer == NULL) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Raw DSM mode only available in server mode.");
+  }
+
+  if (mMode == Append || mMode == Hyperslab) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Append and Hyperslab modes are not supported "
+                       "in raw DSM mode");
+  }
+
+  const int typeCode = XdmfBinaryControllerDSM::getTypeCode(array.getArrayType());
+  if (typeCode == 0) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Array of unsupported type in "
+                       "XdmfHDF5WriterDSM::writeRaw");
+  }
+
+  const std::vector<unsigned int> dimensions = array.getDimensions();
+  if (dimensions.size() > XDMF_DSM_RAW_MAX_RANK) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Too many dimensions for raw DSM mode");
+  }
+
+  const int64_t length =
+    (int64_t)array.getSize() * array.getArrayType()->getElementSize();
+
+  // Overwrite puts the array back where it was written last
+  shared_ptr<XdmfBinaryControllerDSM> previousController;
+  if (mMode == Overwrite && array.getNumberHeavyDataControllers() == 1) {
+    previousController =
+      shared_dynamic_cast<XdmfBinaryControllerDSM>(array.getHeavyDataController(0));
+    if (previousController &&
+        previousController->getFilePath().compare(mFilePath) != 0) {
+      previousController.reset();
+    }
+  }
+
+  const int lockId = xdmf_dsm_get_lock_id(mFilePath.c_str());
+  if (xdmf_dsm_lock_file(lockId, false) < 0) {
+    XdmfError::message(XdmfError::FATAL,
+                       "Error: Unable to lock " + mFilePath);
+  }
+
+  XdmfDSMRawEntry entry;
+  try {
+    int slot;
+    haddr_t start, end, limit;
+    XdmfDSMRawHeader header;
+    header.magic = 0;
+    if (xdmf_dsm_find_entry(mFilePath.c_str(), false, &slot) >= 0 &&
+        xdmf_dsm_get_file_entry(slot, &start, &end, &limit) >= 0 &&
+        end - start >= sizeof(XdmfDSMRawHeader)) {
+      mDSMServerBuffer->Get(start, sizeof(XdmfDSMRawHeader), &header);
+    }
+    if (header.magic != XDMF_DSM_RAW_MAGIC) {
+      // A new raw file replaces whatever was written under its name
+      if (xdmf_dsm_find_entry(mFilePath.c_str(), true, &slot) < 0 ||
+          xdmf_dsm_get_file_entry(slot, &start, &end, &limit) < 0) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Error: Unable to create " + mFilePath + " in DSM");
+      }
+      header.magic = XDMF_DSM_RAW_MAGIC;
+      header.numEntries = 0;
+      header.capacity = XDMF_DSM_RAW_INDEX_LENGTH;
+      header.dataEnd = sizeof(XdmfDSMRawHeader) +
+                       header.capacity * sizeof(XdmfDSMRawEntry);
+      end = start;
+    }
+
+    int64_t index = -1;
+    if (previousController && header.numEntries > 0) {
+      std::vector<XdmfDSMRawEntry> entries(header.numEntries);
+      mDSMServerBuffer->Get(start + sizeof(XdmfDSMRawHeader),
+                            header.numEntries * sizeof(XdmfDSMRawEntry),
+                            &entries[0]);
+      for (int64_t i = 0; i < header.numEntries; ++i) {
+        if (previousController->getDataSetName().compare(entries[i].name) == 0) {
+          if (entries[i].length == length) {
+            index = i;
+            entry = entries[i];
+          }
+          break;
+        }
+      }
+    }
+
+    if (index < 0) {
+      if (header.numEntries >= header.capacity) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Error: The index of " + mFilePath + " is full");
+      }
+      // Arrays are named after their place in the index so that
+      // cores writing independently never pick the same name
+      index = header.numEntries++;
+      std::stringstream dataSetName;
+      dataSetName << "Data" << index;
+      memset(&entry, 0, sizeof(XdmfDSMRawEntry));
+      strncpy(entry.name, dataSetName.str().c_str(), XDMF_DSM_RAW_NAME_LENGTH - 1);
+      entry.offset = ((header.dataEnd + XDMF_DSM_RAW_ALIGNMENT - 1) /
+                      XDMF_DSM_RAW_ALIGNMENT) * XDMF_DSM_RAW_ALIGNMENT;
+      entry.length = length;
+      header.dataEnd = entry.offset + length;
+    }
+    entry.type = typeCode;
+    entry.rank = dimensions.size();
+    for (unsigned int i = 0; i < dimensions.size(); ++i) {
+      entry.dimensions[i] = dimensions[i];
+    }
+
+    if (start + header.dataEnd > limit) {
+      if (xdmf_dsm_extend_entry(slot, end - start, header.dataEnd,
+                                           &start, &limit) < 0) {
+        XdmfError::message(XdmfError::FATAL,
+                           "Error: Not enough space in DSM for " + mFilePath);
+      }
+    }
+    if ((int64_t)(start + header.dataEnd) > mDSMServerBuffer->GetTotalLength()) {
+      mDSMServerBuffer->QueryLength();
+    }
+
+    if (length > 0) {
+      mDSMServerBuffer->Put(start + entry.offset, length, array.getValuesInternal());
+    }
+    mDSMServerBuffer->Put(start + sizeof(XdmfDSMRawHeader) +
+                            index * sizeof(XdmfDSMRawEntry),
+                          sizeof(XdmfDSMRawEntry), &entry);
+    mDSMServerBuffer->Put(start, sizeof(XdmfDSMRawHeader), &header);
+
+    if (xdmf_dsm_update_file_entry(slot, start, start + header.dataEnd) < 0) {
+      XdmfError::message(XdmfError::FATAL,
+                         "Error: Unable to update " + mFilePath + " in DSM");
+    }
+  }
+  catch (XdmfError & e) {
+    xdmf_dsm_unlock_file(lockId, false, false);
+    throw e;
+  }
+
+  // Cores waiting on the file see a new step
+  xdmf_dsm_unlock_file(lockId, false, true);
+
+  while (array.getNumberHeavyDataControllers() != 0) {
+    array.removeHeavyDataController(array.getNumberHeavyDataControllers() - 1);
+  }
+  array.insert(XdmfBinaryControllerDSM::New(mFilePath,
+                                            entry.name,
+                                            array.getArrayType(),
+                                            entry.offset,
+                                            dimensions,
+                                            mDSMServerBuffer));
+
+  if (mReleaseData) {
+    array.release();
+  }
+}
@@ -45,7 +45,8 @@
  * accept() operation on any XdmfItem and supplying this writer as the
  * parameter. The writer will write all XdmfArrays under the XdmfItem
  * to a DSM Buffer. It will also attach an XdmfHDF5ControllerDSM to
- * all XdmfArrays.
+ * all XdmfArrays. In raw mode the arrays are placed in the DSM
+ * without HDF5 and an XdmfBinaryControllerDSM is attached instead.
  *
  * This writer supports all heavy data writing modes listed in
  * XdmfHeavyDataWriter.
@@ -240,6 +241,58 @@ public:
             int startCoreIndex,
             int endCoreIndex);
 
+  /**
+   * Contruct XdmfHDF5WriterDSM, nonthreaded version, creating the DSM
+   * with the configuration of the manager provided. The manager is set
+   * up with its setters, such as SetLocalBufferSizeMBytes, SetDsmType,
+   * SetBlockLength, SetTransportType, SetUseSharedMemory and
+   * SetMaxBufferSizeMBytes, but not created. The writer takes ownership
+   * of the manager, it is deleted by deleteManager.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritermanagergenerate
+   * @until //#initwritermanagergenerate
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritermanagergenerate
+   * @until #//initwritermanagergenerate
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     filePath        The location of the hdf5 file to output to on disk.
+   * @param     comm            The communicator that the buffer will be created in.
+   * @param     dsmManager      The manager holding the configuration of the buffer.
+   * @param     startCoreIndex  The index of the first core in the server block
+   * @param     endCoreIndex    The index of the last core in the server block
+   * @return                    A New XdmfHDF5WriterDSM
+   */
+  static shared_ptr<XdmfHDF5WriterDSM>
+  New(const std::string & filePath,
+            MPI_Comm comm,
+            XdmfDSMManager * const dsmManager,
+            int startCoreIndex,
+            int endCoreIndex);
+
   virtual ~XdmfHDF5WriterDSM();
 
   /**
@@ -361,6 +414,54 @@ public:
   H5FDdsmManager * getManager();
 #endif
 
+  /**
+   * Gets whether arrays are written to the DSM raw instead of as HDF5 data sets.
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#getRawModewriter
+   * @until //#getRawModewriter
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//getRawModewriter
+   * @until #//getRawModewriter
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @return    If the writer is in raw mode or not
+   */
+  bool getRawMode();
+
+
   /**
    * Gets the buffer for the non-threaded version of DSM
    *
@@ -760,6 +861,67 @@ public:
    */
   void setManager(XdmfDSMManager * newManager);
 
+  /**
+   * Sets whether arrays are written to the DSM raw instead of as HDF5 data sets.
+   *
+   * In raw mode no HDF5 file is built. The values of each array are
+   * placed directly in the DSM file after a small index that holds the
+   * name, type, dimensions and offset of every array in the file, and an
+   * XdmfBinaryControllerDSM is attached to the array to read them back
+   * with a single transfer. Arrays are named after their position in the
+   * index, so cores may write to the same file independently.
+   *
+   * Default mode adds every array to the file. Overwrite mode writes an
+   * array that already has a controller for the file back in place when
+   * its size is unchanged. Append and Hyperslab modes and string arrays
+   * are not supported. Raw files can not be read with XdmfHDF5ControllerDSM.
+   * Default setting is false
+   *
+   * Example of use:
+   *
+   * C++
+   *
+   * @dontinclude ExampleXdmfDSMNoThread.cpp
+   * @skipline //#initMPI
+   * @until //#initMPI
+   * @skipline //#initwritevector
+   * @until //#initwritevector
+   * @skipline //#initwritergenerate
+   * @until //#initwritergenerate
+   * @skipline //#startworksection
+   * @until //#startworksection
+   * @skipline //#setRawModewriter
+   * @until //#setRawModewriter
+   * @skipline //#endworksection
+   * @until //#endworksection
+   * @skipline //#stopDSMwriter
+   * @until //#stopDSMwriter
+   * @skipline //#finalizeMPI
+   * @until //#finalizeMPI
+   *
+   * Python
+   *
+   * @dontinclude XdmfExampleDSMNoThread.py
+   * @skipline #//initMPI
+   * @until #//initMPI
+   * @skipline #//initwritevector
+   * @until #//initwritevector
+   * @skipline #//initwritergenerate
+   * @until #//initwritergenerate
+   * @skipline #//startworksection
+   * @until #//startworksection
+   * @skipline #//setRawModewriter
+   * @until #//setRawModewriter
+   * @skipline #//stopDSMwriter
+   * @until #//stopDSMwriter
+   * @skipline #//finalizeMPI
+   * @until #//finalizeMPI
+   *
+   * @param     newMode         Whether to write arrays raw
+   */
+  void setRawMode(bool newMode);
+
+
   /**
    * Used to switch between server and threaded mode.
    * True is server mode, false is threaded mode.
@@ -955,7 +1117,7 @@ protected:
 
   XdmfHDF5WriterDSM(const std::string & filePath,
                     MPI_Comm comm,
-                    unsigned int bufferSize,
+                    XdmfDSMManager * const dsmManager,
                     int startCoreIndex,
                     int endCoreIndex);
 
@@ -970,6 +1132,8 @@ protected:
 
 private:
 
+  void writeRaw(XdmfArray & array);
+
   XdmfHDF5WriterDSM(const XdmfHDF5WriterDSM &);  // Not implemented.
   void operator=(const XdmfHDF5WriterDSM &);  // Not implemented.
 
@@ -979,6 +1143,7 @@ private:
 #endif
 
   int mFAPL;
+  bool mRawMode;
 
   XdmfDSMBuffer * mDSMServerBuffer;
   XdmfDSMManager * mDSMServerManager;
@@ -0,0 +1,176 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfDSMBuffer.hpp"
+#include "XdmfDSMDriver.hpp"
+#include "XdmfDSMManager.hpp"
+#include "XdmfHDF5WriterDSM.hpp"
+
+// Several files share a block cyclic DSM that starts smaller than the
+// files written to it. The DSM grows up to its maximum size and files
+// that run into each other are moved, a removed file gives its space
+// back to the next one.
+
+static shared_ptr<XdmfArray>
+makeArray(int length, int offset)
+{
+        shared_ptr<XdmfArray> array = XdmfArray::New();
+        for (int i = 0; i < length; ++i)
+        {
+                array->pushBack<double>(offset + i);
+        }
+        return array;
+}
+
+static void
+checkArray(shared_ptr<XdmfArray> array, int length, int offset)
+{
+        array->release();
+        array->read();
+        assert(array->getSize() == (unsigned int)length);
+        for (int i = 0; i < length; ++i)
+        {
+                assert(array->getValue<double>(i) == offset + i);
+        }
+}
+
+static void
+printStatistics(const char * label)
+{
+        size_t total, used, reserved, largestFree;
+        xdmf_dsm_get_allocation_statistics(&total, &used, &reserved, &largestFree);
+        double occupancy = total > 0 ? (double)used / total : 0;
+        double fragmentation = total > reserved ? 1.0 - (double)largestFree / (total - reserved) : 0;
+        std::cout << label << ": " << total << " bytes, " << used << " used, "
+                  << reserved << " reserved, occupancy " << occupancy
+                  << ", fragmentation " << fragmentation << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+        int size, id;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        MPI_Init(&argc, &argv);
+
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+
+        std::string newPath = "dsm";
+
+        // Change this to determine the number of cores used as servers
+        int numServersCores = 2;
+        unsigned int serverSizeMB = 1;
+        unsigned int maxServerSizeMB = 4;
+
+        XdmfDSMManager * dsmManager = new XdmfDSMManager();
+        dsmManager->SetLocalBufferSizeMBytes(serverSizeMB);
+        dsmManager->SetDsmType(XDMF_DSM_TYPE_BLOCK_CYCLIC);
+        dsmManager->SetBlockLength(65536);
+        dsmManager->SetMaxBufferSizeMBytes(maxServerSizeMB);
+
+        shared_ptr<XdmfHDF5WriterDSM> exampleWriter = XdmfHDF5WriterDSM::New(newPath, comm, dsmManager, size-numServersCores, size-1);
+
+        //server cores will not progress to this point until after the servers are done running
+
+        if (id < size - numServersCores)
+        {
+                MPI_Comm workerComm = exampleWriter->getWorkerComm();
+                int workerId;
+                MPI_Comm_rank(workerComm, &workerId);
+
+                XdmfDSMBuffer * dsmBuffer = exampleWriter->getServerBuffer();
+                int64_t startLength = dsmBuffer->GetTotalLength();
+                int64_t maxLength = dsmBuffer->GetMaxLength() * numServersCores;
+
+                xdmf_dsm_set_file_slots(4);
+                xdmf_dsm_set_allocation_length(65536);
+
+                shared_ptr<XdmfHDF5WriterDSM> secondWriter = XdmfHDF5WriterDSM::New("dsmsecond", dsmBuffer);
+                secondWriter->setWorkerComm(workerComm);
+                shared_ptr<XdmfHDF5WriterDSM> thirdWriter = XdmfHDF5WriterDSM::New("dsmthird", dsmBuffer);
+                thirdWriter->setWorkerComm(workerComm);
+
+                int smallLength = 40000;
+                int largeLength = 100000;
+
+                shared_ptr<XdmfArray> firstArray = makeArray(smallLength, 0);
+                shared_ptr<XdmfArray> secondArray = makeArray(smallLength, 1);
+                shared_ptr<XdmfArray> thirdArray = makeArray(largeLength, 2);
+                firstArray->accept(exampleWriter);
+                secondArray->accept(secondWriter);
+                thirdArray->accept(thirdWriter);
+
+                // The files did not fit in the DSM it started with
+                std::cout << dsmBuffer->GetTotalLength() << " ?> " << startLength << std::endl;
+                assert(dsmBuffer->GetTotalLength() > startLength);
+                assert(dsmBuffer->GetTotalLength() <= maxLength);
+
+                // Rewriting the first file larger moves it past the second
+                firstArray = makeArray(largeLength, 0);
+                firstArray->accept(exampleWriter);
+
+                checkArray(firstArray, largeLength, 0);
+                checkArray(secondArray, smallLength, 1);
+                checkArray(thirdArray, largeLength, 2);
+
+                if (workerId == 0)
+                {
+                        printStatistics("Three files");
+                }
+
+                MPI_Barrier(workerComm);
+
+                // The space of a removed file is used by the next one
+                size_t total, used, reserved, largestFree;
+                size_t removedReserved;
+                if (workerId == 0)
+                {
+                        xdmf_dsm_get_allocation_statistics(&total, &used, &reserved, &largestFree);
+                        assert(xdmf_dsm_remove_file(secondWriter->getFilePath().c_str()) == 0);
+                        xdmf_dsm_get_allocation_statistics(&total, &used, &removedReserved, &largestFree);
+                        std::cout << removedReserved << " ?< " << reserved << std::endl;
+                        assert(removedReserved < reserved);
+                        printStatistics("Second file removed");
+                }
+
+                MPI_Barrier(workerComm);
+
+                shared_ptr<XdmfHDF5WriterDSM> fourthWriter = XdmfHDF5WriterDSM::New("dsmfourth", dsmBuffer);
+                fourthWriter->setWorkerComm(workerComm);
+                shared_ptr<XdmfArray> fourthArray = makeArray(smallLength, 3);
+                fourthArray->accept(fourthWriter);
+                assert(dsmBuffer->GetTotalLength() <= maxLength);
+
+                checkArray(firstArray, largeLength, 0);
+                checkArray(thirdArray, largeLength, 2);
+                checkArray(fourthArray, smallLength, 3);
+
+                if (workerId == 0)
+                {
+                        printStatistics("Fourth file written");
+                }
+
+                xdmf_dsm_set_allocation_length(XDMF_DSM_DEFAULT_ALLOCATION_LENGTH);
+                xdmf_dsm_set_file_slots(1);
+
+                MPI_Barrier(workerComm);
+
+                if (workerId == 0)
+                {
+                        exampleWriter->stopDSM();
+                }
+        }
+
+        MPI_Barrier(comm);
+
+        //the dsmManager must be deleted or else there will be a segfault
+        exampleWriter->deleteManager();
+
+        MPI_Finalize();
+
+        return 0;
+}
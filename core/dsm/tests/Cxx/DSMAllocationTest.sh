@@ -0,0 +1 @@
+$MPIEXEC -n 4 ./DSMAllocationTest
\ No newline at end of file
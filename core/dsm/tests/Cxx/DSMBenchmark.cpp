@@ -0,0 +1,579 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfDSMBuffer.hpp"
+#include "XdmfDSMCommMPI.hpp"
+#include "XdmfDSMManager.hpp"
+#include "XdmfHDF5WriterDSM.hpp"
+
+// Sweeps the DSM over layouts, transports, server counts, transfer sizes
+// and array shapes. Measures Put/Get latency and bandwidth, writing and
+// reading arrays through HDF5 and the cost of connecting and
+// disconnecting, and checks every transfer while doing so.
+//
+// Results are written as comma separated values, one row per
+// measurement. Rows of an earlier run can be given as a baseline, any
+// measurement whose bandwidth dropped, or for connects whose latency
+// rose, by more than the tolerance is reported and makes the run fail.
+//
+//   mpiexec -n 8 ./DSMBenchmark --full --output current.csv
+//       --baseline previous.csv --tolerance 0.25
+//
+// Without --full a short sweep is run, small enough for the test suite.
+
+struct BenchmarkOptions
+{
+        bool full;
+        std::string output;
+        std::string baseline;
+        double tolerance;
+};
+
+struct BenchmarkRow
+{
+        std::string test;
+        std::string layout;
+        std::string transport;
+        int servers;
+        int clients;
+        int64_t bytes;
+        std::string shape;
+        int repetitions;
+        double seconds;
+};
+
+static std::string
+rowKey(const BenchmarkRow & row)
+{
+        std::stringstream key;
+        key << row.test << "," << row.layout << "," << row.transport << ","
+            << row.servers << "," << row.clients << "," << row.bytes << ","
+            << row.shape;
+        return key.str();
+}
+
+static double
+rowBandwidth(const BenchmarkRow & row)
+{
+        if (row.seconds <= 0)
+        {
+                return 0;
+        }
+        return (double)row.bytes * row.clients * row.repetitions / row.seconds / (1024 * 1024);
+}
+
+static void
+writeRow(std::ofstream & output, const BenchmarkRow & row)
+{
+        output << rowKey(row) << "," << row.repetitions << "," << row.seconds << ","
+               << row.seconds / row.repetitions * 1e6 << "," << rowBandwidth(row) << std::endl;
+}
+
+// Reads the key, latency and bandwidth of every row of an earlier run
+static std::map<std::string, std::pair<double, double> >
+readBaseline(const std::string & fileName)
+{
+        std::map<std::string, std::pair<double, double> > baseline;
+        std::ifstream input(fileName.c_str());
+        std::string line;
+        // Skip the header
+        getline(input, line);
+        while (getline(input, line))
+        {
+                std::vector<std::string> fields;
+                std::stringstream lineStream(line);
+                std::string field;
+                while (getline(lineStream, field, ','))
+                {
+                        fields.push_back(field);
+                }
+                if (fields.size() == 11)
+                {
+                        std::string key = fields[0];
+                        for (unsigned int i = 1; i < 7; ++i)
+                        {
+                                key += "," + fields[i];
+                        }
+                        baseline[key] = std::make_pair(atof(fields[9].c_str()),
+                                                       atof(fields[10].c_str()));
+                }
+        }
+        return baseline;
+}
+
+// The longest time any client took
+static double
+maxTime(double seconds, MPI_Comm comm)
+{
+        double maxSeconds;
+        MPI_Allreduce(&seconds, &maxSeconds, 1, MPI_DOUBLE, MPI_MAX, comm);
+        return maxSeconds;
+}
+
+static void
+fillPattern(std::vector<char> & data, int64_t seed)
+{
+        for (unsigned long i = 0; i < data.size(); ++i)
+        {
+                data[i] = (char)((seed + i) % 251);
+        }
+}
+
+static bool
+checkPattern(const std::vector<char> & data, int64_t seed)
+{
+        for (unsigned long i = 0; i < data.size(); ++i)
+        {
+                if (data[i] != (char)((seed + i) % 251))
+                {
+                        return false;
+                }
+        }
+        return true;
+}
+
+// Put and Get of every transfer size into a slice of the DSM per client
+static void
+benchmarkPutGet(XdmfDSMBuffer * dsmBuffer,
+                MPI_Comm workerComm,
+                const std::vector<int64_t> & sizes,
+                BenchmarkRow row,
+                std::vector<BenchmarkRow> & rows)
+{
+        int workerId, workerSize;
+        MPI_Comm_rank(workerComm, &workerId);
+        MPI_Comm_size(workerComm, &workerSize);
+        int64_t sliceLength = dsmBuffer->GetTotalLength() / workerSize;
+        int64_t sliceStart = workerId * sliceLength;
+
+        for (unsigned int i = 0; i < sizes.size(); ++i)
+        {
+                int64_t bytes = sizes[i];
+                if (bytes > sliceLength)
+                {
+                        break;
+                }
+                // Small transfers are repeated more often to measure latency
+                int repetitions = (int)(16 * 1024 * 1024 / bytes);
+                repetitions = repetitions < 4 ? 4 : repetitions > 1000 ? 1000 : repetitions;
+                int64_t slots = sliceLength / bytes;
+                std::vector<char> data(bytes);
+
+                row.bytes = bytes;
+                row.repetitions = repetitions;
+
+                MPI_Barrier(workerComm);
+                double startTime = MPI_Wtime();
+                for (int repetition = 0; repetition < repetitions; ++repetition)
+                {
+                        int64_t address = sliceStart + (repetition % slots) * bytes;
+                        data[0] = (char)repetition;
+                        dsmBuffer->Put(address, bytes, &data[0]);
+                }
+                row.test = "put";
+                row.seconds = maxTime(MPI_Wtime() - startTime, workerComm);
+                rows.push_back(row);
+
+                MPI_Barrier(workerComm);
+                startTime = MPI_Wtime();
+                for (int repetition = 0; repetition < repetitions; ++repetition)
+                {
+                        int64_t address = sliceStart + (repetition % slots) * bytes;
+                        dsmBuffer->Get(address, bytes, &data[0]);
+                }
+                row.test = "get";
+                row.seconds = maxTime(MPI_Wtime() - startTime, workerComm);
+                rows.push_back(row);
+
+                // Data that was put is read back unchanged
+                fillPattern(data, sliceStart + bytes);
+                dsmBuffer->Put(sliceStart, bytes, &data[0]);
+                std::vector<char> readData(bytes);
+                dsmBuffer->Get(sliceStart, bytes, &readData[0]);
+                assert(checkPattern(readData, sliceStart + bytes));
+        }
+}
+
+// Transfers of random length at random addresses, which cross block and
+// server boundaries, checked against a copy of the slice
+static void
+stressPutGet(XdmfDSMBuffer * dsmBuffer,
+             MPI_Comm workerComm,
+             int numTransfers)
+{
+        int workerId, workerSize;
+        MPI_Comm_rank(workerComm, &workerId);
+        MPI_Comm_size(workerComm, &workerSize);
+        int64_t sliceLength = dsmBuffer->GetTotalLength() / workerSize;
+        int64_t sliceStart = workerId * sliceLength;
+
+        std::vector<char> expected(sliceLength, 0);
+        dsmBuffer->Put(sliceStart, sliceLength, &expected[0]);
+        srand(workerId + 1);
+        for (int i = 0; i < numTransfers; ++i)
+        {
+                int64_t length = 1 + rand() % (sliceLength < 65536 ? sliceLength : 65536);
+                int64_t offset = rand() % (sliceLength - length + 1);
+                std::vector<char> data(length);
+                fillPattern(data, i);
+                dsmBuffer->Put(sliceStart + offset, length, &data[0]);
+                memcpy(&expected[offset], &data[0], length);
+        }
+        std::vector<char> result(sliceLength);
+        dsmBuffer->Get(sliceStart, sliceLength, &result[0]);
+        assert(result == expected);
+        MPI_Barrier(workerComm);
+}
+
+// Writes and reads arrays of every shape through HDF5
+static void
+benchmarkHDF5(shared_ptr<XdmfHDF5WriterDSM> writer,
+              MPI_Comm workerComm,
+              int64_t numValues,
+              BenchmarkRow row,
+              std::vector<BenchmarkRow> & rows)
+{
+        std::vector<std::vector<unsigned int> > shapes;
+        std::vector<std::string> shapeNames;
+        std::vector<unsigned int> shape;
+        shape.push_back(numValues);
+        shapes.push_back(shape);
+        shapeNames.push_back("1d");
+        shape.clear();
+        shape.push_back(numValues / 64);
+        shape.push_back(64);
+        shapes.push_back(shape);
+        shapeNames.push_back("2d");
+        shape.clear();
+        shape.push_back(numValues / 256);
+        shape.push_back(16);
+        shape.push_back(16);
+        shapes.push_back(shape);
+        shapeNames.push_back("3d");
+
+        int workerId;
+        MPI_Comm_rank(workerComm, &workerId);
+
+        for (unsigned int i = 0; i < shapes.size(); ++i)
+        {
+                shared_ptr<XdmfArray> array = XdmfArray::New();
+                array->initialize<double>(shapes[i]);
+                for (unsigned int j = 0; j < array->getSize(); ++j)
+                {
+                        array->insert<double>(j, workerId * numValues + j);
+                }
+
+                row.shape = shapeNames[i];
+                row.bytes = array->getSize() * sizeof(double);
+                row.repetitions = 1;
+
+                MPI_Barrier(workerComm);
+                double startTime = MPI_Wtime();
+                array->accept(writer);
+                row.test = "hdf5_write";
+                row.seconds = maxTime(MPI_Wtime() - startTime, workerComm);
+                rows.push_back(row);
+
+                array->release();
+                MPI_Barrier(workerComm);
+                startTime = MPI_Wtime();
+                array->read();
+                row.test = "hdf5_read";
+                row.seconds = maxTime(MPI_Wtime() - startTime, workerComm);
+                rows.push_back(row);
+
+                unsigned int expectedSize = 1;
+                for (unsigned int j = 0; j < shapes[i].size(); ++j)
+                {
+                        expectedSize *= shapes[i][j];
+                }
+                assert(array->getSize() == expectedSize);
+                for (unsigned int j = 0; j < array->getSize(); ++j)
+                {
+                        assert(array->getValue<double>(j) == workerId * numValues + j);
+                }
+        }
+}
+
+// Connects every core but the first to a port opened by the first and
+// disconnects again
+static void
+benchmarkConnect(MPI_Comm comm,
+                 int repetitions,
+                 BenchmarkRow row,
+                 std::vector<BenchmarkRow> & rows)
+{
+        int id, size;
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+        bool isServer = id == 0;
+        MPI_Comm splitComm;
+        MPI_Comm_split(comm, isServer, id, &splitComm);
+
+        XdmfDSMCommMPI * dsmComm = new XdmfDSMCommMPI();
+        dsmComm->DupComm(splitComm);
+        dsmComm->Init();
+        // The port is passed on directly, it does not need to be published
+        dsmComm->SetConnectMethod(XDMF_DSM_CONNECT_ENVIRONMENT);
+        if (isServer)
+        {
+                dsmComm->DupInterComm(splitComm);
+                dsmComm->OpenPort();
+        }
+        char portName[MPI_MAX_PORT_NAME];
+        strcpy(portName, dsmComm->GetDsmPortName());
+        MPI_Bcast(portName, MPI_MAX_PORT_NAME, MPI_CHAR, 0, comm);
+        dsmComm->SetDsmPortName(portName);
+
+        row.servers = 1;
+        row.clients = size - 1;
+        row.bytes = 0;
+        row.shape = "";
+        row.repetitions = repetitions;
+        double connectTime = 0;
+        double disconnectTime = 0;
+        for (int repetition = 0; repetition < repetitions; ++repetition)
+        {
+                MPI_Barrier(comm);
+                double startTime = MPI_Wtime();
+                if (isServer)
+                {
+                        dsmComm->Accept(1);
+                }
+                else
+                {
+                        dsmComm->Connect();
+                }
+                connectTime += MPI_Wtime() - startTime;
+                assert(dsmComm->GetInterSize() == size);
+
+                MPI_Barrier(dsmComm->GetInterComm());
+                startTime = MPI_Wtime();
+                dsmComm->Disconnect();
+                disconnectTime += MPI_Wtime() - startTime;
+                if (isServer)
+                {
+                        dsmComm->DupInterComm(splitComm);
+                }
+        }
+        row.test = "connect";
+        row.seconds = maxTime(connectTime, comm);
+        rows.push_back(row);
+        row.test = "disconnect";
+        row.seconds = maxTime(disconnectTime, comm);
+        rows.push_back(row);
+
+        if (isServer)
+        {
+                dsmComm->ClosePort();
+        }
+        delete dsmComm;
+        MPI_Comm_free(&splitComm);
+}
+
+int main(int argc, char *argv[])
+{
+        int size, id;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        MPI_Init(&argc, &argv);
+
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+
+        BenchmarkOptions options;
+        options.full = false;
+        options.output = "dsmbenchmark.csv";
+        options.tolerance = 0.25;
+        for (int i = 1; i < argc; ++i)
+        {
+                std::string argument = argv[i];
+                if (argument == "--full")
+                {
+                        options.full = true;
+                }
+                else if (argument == "--output" && i + 1 < argc)
+                {
+                        options.output = argv[++i];
+                }
+                else if (argument == "--baseline" && i + 1 < argc)
+                {
+                        options.baseline = argv[++i];
+                }
+                else if (argument == "--tolerance" && i + 1 < argc)
+                {
+                        options.tolerance = atof(argv[++i]);
+                }
+        }
+
+        std::vector<int> layouts;
+        std::vector<std::string> layoutNames;
+        layouts.push_back(XDMF_DSM_TYPE_UNIFORM);
+        layoutNames.push_back("uniform");
+        layouts.push_back(XDMF_DSM_TYPE_BLOCK_CYCLIC);
+        layoutNames.push_back("block_cyclic");
+
+        std::vector<int> transports;
+        std::vector<std::string> transportNames;
+        transports.push_back(XDMF_DSM_TRANSPORT_MESSAGE);
+        transportNames.push_back("message");
+
+        std::vector<int> serverCounts;
+        serverCounts.push_back(1);
+        if (size / 2 > 1)
+        {
+                serverCounts.push_back(size / 2);
+        }
+
+        int64_t maxTransfer = 64 * 1024;
+        int64_t numValues = 16 * 1024;
+        int numStressTransfers = 100;
+        int numConnects = 4;
+
+        if (options.full)
+        {
+                layouts.push_back(XDMF_DSM_TYPE_BLOCK_RANDOM);
+                layoutNames.push_back("block_random");
+                transports.push_back(XDMF_DSM_TRANSPORT_RMA);
+                transportNames.push_back("rma");
+                if (size - 1 > size / 2)
+                {
+                        serverCounts.push_back(size - 1);
+                }
+                maxTransfer = 16 * 1024 * 1024;
+                numValues = 1024 * 1024;
+                numStressTransfers = 2000;
+                numConnects = 20;
+        }
+
+        std::vector<int64_t> sizes;
+        for (int64_t bytes = 8; bytes <= maxTransfer; bytes *= 4)
+        {
+                sizes.push_back(bytes);
+        }
+
+        std::vector<BenchmarkRow> rows;
+
+        for (unsigned int layout = 0; layout < layouts.size(); ++layout)
+        {
+                for (unsigned int transport = 0; transport < transports.size(); ++transport)
+                {
+                        for (unsigned int server = 0; server < serverCounts.size(); ++server)
+                        {
+                                int numServersCores = serverCounts[server];
+                                int numClients = size - numServersCores;
+                                // Every client gets room for the largest transfer and array
+                                int64_t clientBytes = maxTransfer > numValues * (int64_t)sizeof(double) ?
+                                        maxTransfer : numValues * (int64_t)sizeof(double);
+                                unsigned int serverSizeMB =
+                                        (unsigned int)(2 * clientBytes * numClients / numServersCores / (1024 * 1024)) + 1;
+
+                                XdmfDSMManager * dsmManager = new XdmfDSMManager();
+                                dsmManager->SetLocalBufferSizeMBytes(serverSizeMB);
+                                dsmManager->SetDsmType(layouts[layout]);
+                                dsmManager->SetBlockLength(4096);
+                                dsmManager->SetTransportType(transports[transport]);
+
+                                shared_ptr<XdmfHDF5WriterDSM> benchmarkWriter =
+                                        XdmfHDF5WriterDSM::New("dsmbenchmark", comm, dsmManager,
+                                                               size - numServersCores, size - 1);
+
+                                //server cores will not progress to this point until after the servers are done running
+
+                                if (id < size - numServersCores)
+                                {
+                                        MPI_Comm workerComm = benchmarkWriter->getWorkerComm();
+                                        int workerId;
+                                        MPI_Comm_rank(workerComm, &workerId);
+                                        XdmfDSMBuffer * dsmBuffer = benchmarkWriter->getServerBuffer();
+
+                                        BenchmarkRow row;
+                                        row.layout = layoutNames[layout];
+                                        row.transport = transportNames[transport];
+                                        row.servers = numServersCores;
+                                        row.clients = numClients;
+                                        row.shape = "";
+
+                                        benchmarkPutGet(dsmBuffer, workerComm, sizes, row, rows);
+                                        stressPutGet(dsmBuffer, workerComm, numStressTransfers);
+                                        benchmarkHDF5(benchmarkWriter, workerComm, numValues, row, rows);
+
+                                        MPI_Barrier(workerComm);
+
+                                        if (workerId == 0)
+                                        {
+                                                benchmarkWriter->stopDSM();
+                                        }
+                                }
+
+                                MPI_Barrier(comm);
+
+                                benchmarkWriter->deleteManager();
+                        }
+                }
+        }
+
+        BenchmarkRow connectRow;
+        connectRow.layout = "";
+        connectRow.transport = "";
+        benchmarkConnect(comm, numConnects, connectRow, rows);
+
+        int regressions = 0;
+        if (id == 0)
+        {
+                std::ofstream output(options.output.c_str());
+                output << "test,layout,transport,servers,clients,bytes,shape,"
+                       << "repetitions,seconds,latency_us,bandwidth_mb_s" << std::endl;
+                for (unsigned int i = 0; i < rows.size(); ++i)
+                {
+                        writeRow(output, rows[i]);
+                }
+                output.close();
+                std::cout << rows.size() << " results written to " << options.output << std::endl;
+
+                if (options.baseline.size() > 0)
+                {
+                        std::map<std::string, std::pair<double, double> > baseline =
+                                readBaseline(options.baseline);
+                        for (unsigned int i = 0; i < rows.size(); ++i)
+                        {
+                                std::map<std::string, std::pair<double, double> >::iterator previous =
+                                        baseline.find(rowKey(rows[i]));
+                                if (previous == baseline.end())
+                                {
+                                        continue;
+                                }
+                                // Connect rows move no data, their latency is compared instead
+                                bool slower;
+                                if (rows[i].bytes > 0)
+                                {
+                                        slower = rowBandwidth(rows[i]) <
+                                                 previous->second.second * (1 - options.tolerance);
+                                }
+                                else
+                                {
+                                        slower = rows[i].seconds / rows[i].repetitions * 1e6 >
+                                                 previous->second.first * (1 + options.tolerance);
+                                }
+                                if (slower)
+                                {
+                                        std::cout << "Regression in " << rowKey(rows[i]) << std::endl;
+                                        ++regressions;
+                                }
+                        }
+                }
+        }
+        MPI_Bcast(&regressions, 1, MPI_INT, 0, comm);
+
+        MPI_Finalize();
+
+        return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1 @@
+$MPIEXEC -n 4 ./DSMBenchmark
\ No newline at end of file
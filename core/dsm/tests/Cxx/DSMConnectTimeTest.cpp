@@ -0,0 +1,108 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <iostream>
+#include <vector>
+#include "XdmfDSMCommMPI.hpp"
+#include "XdmfError.hpp"
+
+// Measures how long clients take to find and connect to a port opened
+// by a server with each connect method. The first core is the server and
+// every other core is a client, so the number of clients scales with the
+// number of cores:
+//
+//   for n in 2 3 5 9 17 33 65 129 257 513 1025; do
+//     mpiexec --oversubscribe -n $n ./DSMConnectTimeTest
+//   done
+//
+// Pass "nameservice" to also time the MPI name service, which needs a
+// name server such as ompi-server to be running.
+
+int main(int argc, char *argv[])
+{
+        int size, id;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        MPI_Init(&argc, &argv);
+
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+
+        bool isServer = id == 0;
+        MPI_Comm splitComm;
+        MPI_Comm_split(comm, isServer, id, &splitComm);
+
+        std::vector<int> methods;
+        std::vector<std::string> methodNames;
+        methods.push_back(XDMF_DSM_CONNECT_FILE);
+        methodNames.push_back("file");
+        methods.push_back(XDMF_DSM_CONNECT_SOCKET);
+        methodNames.push_back("socket");
+        if (argc > 1 && std::string(argv[1]) == "nameservice")
+        {
+                methods.push_back(XDMF_DSM_CONNECT_NAME_SERVICE);
+                methodNames.push_back("name service");
+        }
+
+        for (unsigned int i = 0; i < methods.size(); ++i)
+        {
+                XdmfDSMCommMPI * dsmComm = new XdmfDSMCommMPI();
+                dsmComm->DupComm(splitComm);
+                dsmComm->Init();
+                dsmComm->SetConnectMethod(methods[i]);
+                dsmComm->SetDsmFileName("dsmconnecttime.cfg");
+                dsmComm->SetConnectTimeout(30);
+
+                if (isServer)
+                {
+                        // Servers accept into their InterComm, as they do in a DSM
+                        dsmComm->DupInterComm(splitComm);
+                        // Clients must not find a port left by an earlier run
+                        remove(dsmComm->GetDsmFileName().c_str());
+                }
+                MPI_Barrier(comm);
+
+                double startTime = MPI_Wtime();
+                double readTime = 0;
+                if (isServer)
+                {
+                        dsmComm->OpenPort();
+                        dsmComm->Accept(1);
+                }
+                else
+                {
+                        dsmComm->ReadDsmPortName();
+                        readTime = MPI_Wtime() - startTime;
+                        dsmComm->Connect();
+                }
+                double connectTime = MPI_Wtime() - startTime;
+
+                // All clients are connected once the merged comm holds every core
+                int connectedSize = dsmComm->GetInterSize();
+                std::cout << connectedSize << " ?= " << size << std::endl;
+                assert(connectedSize == size);
+
+                double maxReadTime, maxConnectTime;
+                MPI_Reduce(&readTime, &maxReadTime, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+                MPI_Reduce(&connectTime, &maxConnectTime, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+                if (isServer)
+                {
+                        printf("%s: %d clients read the port in %f ms and connected in %f ms\n",
+                               methodNames[i].c_str(), size - 1,
+                               maxReadTime * 1000, maxConnectTime * 1000);
+                        dsmComm->ClosePort();
+                        remove(dsmComm->GetDsmFileName().c_str());
+                }
+
+                MPI_Barrier(dsmComm->GetInterComm());
+                dsmComm->Disconnect();
+                delete dsmComm;
+        }
+
+        MPI_Comm_free(&splitComm);
+
+        MPI_Finalize();
+
+        return 0;
+}
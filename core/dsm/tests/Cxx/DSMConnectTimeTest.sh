@@ -0,0 +1 @@
+$MPIEXEC -n 4 ./DSMConnectTimeTest
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <iostream>
+#include <vector>
+#include "XdmfDSMBuffer.hpp"
+#include "XdmfDSMManager.hpp"
+#include "XdmfHDF5WriterDSM.hpp"
+
+// Writes a single dataset into the DSM from every worker core and reports
+// how many bytes of it land on each server and the aggregate bandwidth.
+// The layout is chosen with the first argument: uniform, cyclic or random.
+
+int main(int argc, char *argv[])
+{
+        int size, id;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        MPI_Init(&argc, &argv);
+
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+
+        int dsmType = XDMF_DSM_TYPE_UNIFORM;
+        std::string layout = "uniform";
+        if (argc > 1)
+        {
+                layout = argv[1];
+        }
+        if (layout == "cyclic")
+        {
+                dsmType = XDMF_DSM_TYPE_BLOCK_CYCLIC;
+        }
+        else if (layout == "random")
+        {
+                dsmType = XDMF_DSM_TYPE_BLOCK_RANDOM;
+        }
+
+        std::string newPath = "dsm";
+
+        // Change this to determine the number of cores used as servers
+        int numServersCores = 3;
+        // Size of each server's buffer in MB
+        unsigned int serverSizeMB = 4;
+        int64_t blockLength = 65536;
+        // Size of the dataset shared by all workers, smaller than the
+        // whole DSM but larger than a single server's buffer
+        int64_t datasetLength = 6 * 1024 * 1024;
+
+        XdmfDSMManager * dsmManager = new XdmfDSMManager();
+        dsmManager->SetLocalBufferSizeMBytes(serverSizeMB);
+        dsmManager->SetDsmType(dsmType);
+        dsmManager->SetBlockLength(blockLength);
+
+        shared_ptr<XdmfHDF5WriterDSM> exampleWriter = XdmfHDF5WriterDSM::New(newPath, comm, dsmManager, size-numServersCores, size-1);
+
+        //server cores will not progress to this point until after the servers are done running
+
+        if (id < size - numServersCores)
+        {
+                MPI_Comm workerComm = exampleWriter->getWorkerComm();
+                int workerId, workerSize;
+                MPI_Comm_rank(workerComm, &workerId);
+                MPI_Comm_size(workerComm, &workerSize);
+
+                XdmfDSMBuffer * dsmBuffer = exampleWriter->getServerBuffer();
+                assert(dsmBuffer->GetDsmType() == dsmType);
+
+                // Each worker writes a contiguous slice of the dataset
+                int64_t sliceLength = datasetLength / workerSize;
+                int64_t sliceStart = workerId * sliceLength;
+                std::vector<char> writeData(sliceLength);
+                for (int64_t i = 0; i < sliceLength; ++i)
+                {
+                        writeData[i] = (char)((sliceStart + i) % 251);
+                }
+
+                MPI_Barrier(workerComm);
+                double startTime = MPI_Wtime();
+                dsmBuffer->Put(sliceStart, sliceLength, &writeData[0]);
+                MPI_Barrier(workerComm);
+                double writeTime = MPI_Wtime() - startTime;
+
+                std::vector<char> readData(sliceLength);
+                MPI_Barrier(workerComm);
+                startTime = MPI_Wtime();
+                dsmBuffer->Get(sliceStart, sliceLength, &readData[0]);
+                MPI_Barrier(workerComm);
+                double readTime = MPI_Wtime() - startTime;
+
+                assert(memcmp(&writeData[0], &readData[0], sliceLength) == 0);
+
+                if (workerId == 0)
+                {
+                        // Bytes of the dataset stored on each server
+                        std::vector<int64_t> serverLoad(numServersCores, 0);
+                        int64_t address = 0;
+                        while (address < datasetLength)
+                        {
+                                int serverId;
+                                int64_t localAddress, localLength;
+                                dsmBuffer->AddressToLocation(address, &serverId, &localAddress, &localLength);
+                                localLength = std::min(localLength, datasetLength - address);
+                                serverLoad[serverId - (size - numServersCores)] += localLength;
+                                address += localLength;
+                        }
+
+                        int64_t totalLoad = 0;
+                        int64_t minLoad = datasetLength;
+                        int64_t maxLoad = 0;
+                        for (int i = 0; i < numServersCores; ++i)
+                        {
+                                std::cout << layout << " server " << i << " holds " << serverLoad[i] << " bytes" << std::endl;
+                                totalLoad += serverLoad[i];
+                                minLoad = std::min(minLoad, serverLoad[i]);
+                                maxLoad = std::max(maxLoad, serverLoad[i]);
+                        }
+                        std::cout << layout << " write " << datasetLength / (1024.0 * 1024.0) / writeTime << " MB/s, read "
+                                  << datasetLength / (1024.0 * 1024.0) / readTime << " MB/s" << std::endl;
+
+                        assert(totalLoad == datasetLength);
+                        if (dsmType == XDMF_DSM_TYPE_UNIFORM)
+                        {
+                                // The dataset fills the first server before reaching the next
+                                assert(serverLoad[0] == dsmBuffer->GetLength());
+                        }
+                        else
+                        {
+                                // Blocks are spread over every server
+                                assert(maxLoad - minLoad <= blockLength);
+                        }
+                }
+
+                MPI_Barrier(workerComm);
+
+                if (workerId == 0)
+                {
+                        exampleWriter->stopDSM();
+                }
+        }
+
+        MPI_Barrier(comm);
+
+        //the dsmManager must be deleted or else there will be a segfault
+        exampleWriter->deleteManager();
+
+        MPI_Finalize();
+
+        return 0;
+}
@@ -0,0 +1,5 @@
+$MPIEXEC -n 6 ./DSMDistributionTest uniform &&
+
+$MPIEXEC -n 6 ./DSMDistributionTest cyclic &&
+
+$MPIEXEC -n 6 ./DSMDistributionTest random
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <vector>
+#include "XdmfDSMBuffer.hpp"
+#include "XdmfError.hpp"
+#include "XdmfHDF5WriterDSM.hpp"
+
+// Transfers longer than the largest message are sent in frames. Frames
+// of XDMF_DSM_MAX_MESSAGE_LENGTH need more than 2 GB, so the client
+// lowers its maximum message length to split blocks of a few hundred
+// kilobytes the same way.
+
+int main(int argc, char *argv[])
+{
+        int size, id;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        MPI_Init(&argc, &argv);
+
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+
+        std::string newPath = "dsm";
+
+        unsigned int numServersCores = 2;
+        unsigned int serverSizeMB = 4;
+
+        shared_ptr<XdmfHDF5WriterDSM> exampleWriter = XdmfHDF5WriterDSM::New(newPath, comm, serverSizeMB, size-numServersCores, size-1);
+
+        //server cores will not progress to this point until after the servers are done running
+
+        if (id == 0)
+        {
+                XdmfDSMBuffer * dsmBuffer = exampleWriter->getServerBuffer();
+
+                std::cout << "max message length " << dsmBuffer->GetMaxMessageLength() << " ?= " << XDMF_DSM_MAX_MESSAGE_LENGTH << std::endl;
+                assert(dsmBuffer->GetMaxMessageLength() == XDMF_DSM_MAX_MESSAGE_LENGTH);
+
+                // Lengths that are not a multiple of the frame leave a short
+                // last frame
+                const int64_t maxMessageLength = 1000;
+                dsmBuffer->SetMaxMessageLength(maxMessageLength);
+                assert(dsmBuffer->GetMaxMessageLength() == maxMessageLength);
+
+                int64_t serverLength = dsmBuffer->GetLength();
+
+                std::vector<int64_t> blockSizes;
+                blockSizes.push_back(maxMessageLength);
+                blockSizes.push_back(maxMessageLength + 1);
+                blockSizes.push_back(256 * 1024 + 12);
+
+                // A block on the first server and one straddling the two
+                std::vector<int64_t> addresses;
+                addresses.push_back(100);
+                addresses.push_back(serverLength - 130 * 1024);
+
+                for (unsigned int i = 0; i < addresses.size(); ++i)
+                {
+                        for (unsigned int j = 0; j < blockSizes.size(); ++j)
+                        {
+                                int64_t blockSize = blockSizes[j];
+                                std::vector<char> writeData(blockSize);
+                                std::vector<char> readData(blockSize);
+                                for (int64_t k = 0; k < blockSize; ++k)
+                                {
+                                        writeData[k] = (char)((k * 7 + i + j) % 127);
+                                }
+                                dsmBuffer->Put(addresses[i], blockSize, &writeData[0]);
+                                dsmBuffer->Get(addresses[i], blockSize, &readData[0]);
+                                for (int64_t k = 0; k < blockSize; ++k)
+                                {
+                                        if (readData[k] != writeData[k])
+                                        {
+                                                std::cout << "address " << addresses[i] << " length " << blockSize << " byte " << k << " differs" << std::endl;
+                                                assert(readData[k] == writeData[k]);
+                                        }
+                                }
+                                std::cout << "address " << addresses[i] << " length " << blockSize << " verified" << std::endl;
+                        }
+                }
+
+                bool caught = false;
+                try
+                {
+                        dsmBuffer->SetMaxMessageLength(XDMF_DSM_MAX_MESSAGE_LENGTH + 1);
+                }
+                catch (XdmfError &)
+                {
+                        caught = true;
+                }
+                assert(caught);
+                assert(dsmBuffer->GetMaxMessageLength() == maxMessageLength);
+
+                exampleWriter->stopDSM();
+        }
+
+        MPI_Barrier(comm);
+
+        //the dsmManager must be deleted or else there will be a segfault
+        exampleWriter->deleteManager();
+
+        MPI_Finalize();
+
+        return 0;
+}
@@ -0,0 +1 @@
+$MPIEXEC -n 3 ./DSMFrameSplitTest
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <vector>
+#include "XdmfDSMBuffer.hpp"
+#include "XdmfHDF5WriterDSM.hpp"
+
+int main(int argc, char *argv[])
+{
+        int size, id;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        MPI_Init(&argc, &argv);
+
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+
+        std::string newPath = "dsm";
+
+        // Two servers of 1100 MB each, so the DSM spans more than 2 GB
+        // and addresses past the end of the first server overflow an int
+        unsigned int numServersCores = 2;
+        unsigned int serverSizeMB = 1100;
+
+        shared_ptr<XdmfHDF5WriterDSM> exampleWriter = XdmfHDF5WriterDSM::New(newPath, comm, serverSizeMB, size-numServersCores, size-1);
+
+        //server cores will not progress to this point until after the servers are done running
+
+        if (id == 0)
+        {
+                XdmfDSMBuffer * dsmBuffer = exampleWriter->getServerBuffer();
+
+                int64_t serverLength = dsmBuffer->GetLength();
+                int64_t totalLength = dsmBuffer->GetTotalLength();
+
+                std::cout << "total length " << totalLength << " ?> " << 2147483647L << std::endl;
+                assert(totalLength > 2147483647L);
+                assert(totalLength == serverLength * numServersCores);
+
+                int64_t secondStart, secondEnd;
+                dsmBuffer->GetAddressRangeForId(size-1, &secondStart, &secondEnd);
+                std::cout << "second server range " << secondStart << " - " << secondEnd << std::endl;
+                assert(secondStart == serverLength);
+                assert(secondEnd == totalLength - 1);
+                assert(dsmBuffer->AddressToId(totalLength - 1) == size-1);
+
+                const int64_t blockSize = 1024 * 1024;
+                std::vector<int> writeData(blockSize / sizeof(int));
+                std::vector<int> readData(blockSize / sizeof(int));
+
+                // Addresses at the end of the DSM, past 2^31, a block straddling
+                // the two servers and a block at the start of the DSM
+                std::vector<int64_t> addresses;
+                addresses.push_back(totalLength - blockSize);
+                addresses.push_back(2147483648L);
+                addresses.push_back(serverLength - blockSize / 2);
+                addresses.push_back(0);
+
+                for (unsigned int i = 0; i < addresses.size(); ++i)
+                {
+                        for (unsigned int j = 0; j < writeData.size(); ++j)
+                        {
+                                writeData[j] = i * 1000 + j;
+                        }
+                        dsmBuffer->Put(addresses[i], blockSize, &writeData[0]);
+                }
+
+                for (unsigned int i = 0; i < addresses.size(); ++i)
+                {
+                        dsmBuffer->Get(addresses[i], blockSize, &readData[0]);
+                        for (unsigned int j = 0; j < readData.size(); ++j)
+                        {
+                                if (readData[j] != (int)(i * 1000 + j))
+                                {
+                                        std::cout << "address " << addresses[i] << " value[" << j << "] = " << readData[j] << " ?= " << i * 1000 + j << std::endl;
+                                        assert(readData[j] == (int)(i * 1000 + j));
+                                }
+                        }
+                        std::cout << "address " << addresses[i] << " verified" << std::endl;
+                }
+
+                exampleWriter->stopDSM();
+        }
+
+        MPI_Barrier(comm);
+
+        //the dsmManager must be deleted or else there will be a segfault
+        exampleWriter->deleteManager();
+
+        MPI_Finalize();
+
+        return 0;
+}
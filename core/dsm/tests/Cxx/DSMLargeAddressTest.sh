@@ -0,0 +1 @@
+$MPIEXEC -n 3 ./DSMLargeAddressTest
\ No newline at end of file
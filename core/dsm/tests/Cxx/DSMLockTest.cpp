@@ -0,0 +1,183 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <vector>
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfDSMBuffer.hpp"
+#include "XdmfDSMDriver.hpp"
+#include "XdmfHDF5WriterDSM.hpp"
+
+// A producer and a consumer pass steps through the DSM using its locks,
+// first with a single buffer and then with two so that the producer can
+// write a step while the consumer reads the previous one. Afterwards two
+// files are kept in the DSM at once with file locking turned on.
+
+static void
+compute(double seconds)
+{
+        double startTime = MPI_Wtime();
+        while (MPI_Wtime() - startTime < seconds)
+        {
+        }
+}
+
+int main(int argc, char *argv[])
+{
+        int size, id;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        MPI_Init(&argc, &argv);
+
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+
+        std::string newPath = "dsm";
+
+        // Change this to determine the number of cores used as servers
+        int numServersCores = 2;
+        unsigned int serverSizeMB = 4;
+        int numSteps = 20;
+        int stepLength = 1000;
+        double computeTime = 0.002;
+
+        shared_ptr<XdmfHDF5WriterDSM> exampleWriter = XdmfHDF5WriterDSM::New(newPath, comm, serverSizeMB, size-numServersCores, size-1);
+
+        //server cores will not progress to this point until after the servers are done running
+
+        if (id < size - numServersCores)
+        {
+                MPI_Comm workerComm = exampleWriter->getWorkerComm();
+                int workerId, workerSize;
+                MPI_Comm_rank(workerComm, &workerId);
+                MPI_Comm_size(workerComm, &workerSize);
+
+                XdmfDSMBuffer * dsmBuffer = exampleWriter->getServerBuffer();
+
+                bool isProducer = workerId == 0;
+                bool isConsumer = workerId == workerSize - 1;
+                assert(isProducer != isConsumer);
+
+                std::vector<int> stepData(stepLength);
+
+                for (int numBuffers = 1; numBuffers <= 2; ++numBuffers)
+                {
+                        // Locks 0 and 1 protect the buffers, lock 2 counts consumed steps
+                        int lockBase = numBuffers * 10;
+                        int consumedLock = lockBase + 2;
+                        int64_t bufferBase = numBuffers * 2 * stepLength * sizeof(int);
+                        double waitTime = 0;
+
+                        MPI_Barrier(workerComm);
+                        double startTime = MPI_Wtime();
+                        for (int step = 0; step < numSteps; ++step)
+                        {
+                                int buffer = step % numBuffers;
+                                int64_t address = bufferBase + buffer * stepLength * sizeof(int);
+                                if (isProducer)
+                                {
+                                        compute(computeTime);
+                                        // The buffer is free once the step that used it was consumed
+                                        double waitStart = MPI_Wtime();
+                                        if (step >= numBuffers)
+                                        {
+                                                dsmBuffer->WaitForStep(consumedLock, step - numBuffers);
+                                        }
+                                        dsmBuffer->AcquireLock(lockBase + buffer, XDMF_DSM_LOCK_WRITE);
+                                        waitTime += MPI_Wtime() - waitStart;
+                                        for (int i = 0; i < stepLength; ++i)
+                                        {
+                                                stepData[i] = step * stepLength + i;
+                                        }
+                                        dsmBuffer->Put(address, stepLength * sizeof(int), &stepData[0]);
+                                        dsmBuffer->ReleaseLock(lockBase + buffer, XDMF_DSM_LOCK_WRITE, true);
+                                }
+                                else if (isConsumer)
+                                {
+                                        double waitStart = MPI_Wtime();
+                                        int bufferStep = dsmBuffer->WaitForStep(lockBase + buffer, step / numBuffers);
+                                        assert(bufferStep > step / numBuffers);
+                                        dsmBuffer->AcquireLock(lockBase + buffer, XDMF_DSM_LOCK_READ);
+                                        waitTime += MPI_Wtime() - waitStart;
+                                        dsmBuffer->Get(address, stepLength * sizeof(int), &stepData[0]);
+                                        dsmBuffer->ReleaseLock(lockBase + buffer, XDMF_DSM_LOCK_READ);
+                                        for (int i = 0; i < stepLength; ++i)
+                                        {
+                                                assert(stepData[i] == step * stepLength + i);
+                                        }
+                                        dsmBuffer->AcquireLock(consumedLock, XDMF_DSM_LOCK_WRITE);
+                                        dsmBuffer->ReleaseLock(consumedLock, XDMF_DSM_LOCK_WRITE, true);
+                                        compute(computeTime);
+                                }
+                        }
+                        MPI_Barrier(workerComm);
+                        double totalTime = MPI_Wtime() - startTime;
+
+                        if (isProducer)
+                        {
+                                std::cout << numBuffers << " buffers: " << numSteps << " steps in "
+                                          << totalTime * 1000 << " ms, producer waited "
+                                          << waitTime * 1000 << " ms" << std::endl;
+                        }
+                }
+
+                //
+                // Two files in the DSM at once, each locked while it is open
+                //
+                xdmf_dsm_set_file_slots(2);
+                xdmf_dsm_set_file_locking(true);
+
+                shared_ptr<XdmfHDF5WriterDSM> secondWriter = XdmfHDF5WriterDSM::New("dsmsecond", dsmBuffer);
+                secondWriter->setWorkerComm(workerComm);
+
+                shared_ptr<XdmfArray> firstArray = XdmfArray::New();
+                shared_ptr<XdmfArray> secondArray = XdmfArray::New();
+                for (int i = 0; i < 100; ++i)
+                {
+                        firstArray->pushBack<int>(i);
+                        secondArray->pushBack<int>(-i);
+                }
+                firstArray->accept(exampleWriter);
+                secondArray->accept(secondWriter);
+
+                // Writing the second file left the first one in place
+                firstArray->release();
+                firstArray->read();
+                secondArray->release();
+                secondArray->read();
+                std::cout << firstArray->getSize() << " ?= " << 100 << std::endl;
+                assert(firstArray->getSize() == 100);
+                assert(secondArray->getSize() == 100);
+                for (int i = 0; i < 100; ++i)
+                {
+                        assert(firstArray->getValue<int>(i) == i);
+                        assert(secondArray->getValue<int>(i) == -i);
+                }
+
+                // Closing a written file released a step
+                int fileStep;
+                xdmf_dsm_wait_for_step(exampleWriter->getFilePath().c_str(), 0, &fileStep);
+                std::cout << fileStep << " ?> " << 0 << std::endl;
+                assert(fileStep > 0);
+
+                xdmf_dsm_set_file_locking(false);
+                xdmf_dsm_set_file_slots(1);
+
+                MPI_Barrier(workerComm);
+
+                if (workerId == 0)
+                {
+                        exampleWriter->stopDSM();
+                }
+        }
+
+        MPI_Barrier(comm);
+
+        //the dsmManager must be deleted or else there will be a segfault
+        exampleWriter->deleteManager();
+
+        MPI_Finalize();
+
+        return 0;
+}
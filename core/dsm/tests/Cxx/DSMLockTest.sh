@@ -0,0 +1 @@
+$MPIEXEC -n 4 ./DSMLockTest
\ No newline at end of file
@@ -0,0 +1,224 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <iostream>
+#include <sstream>
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfBinaryControllerDSM.hpp"
+#include "XdmfDSMBuffer.hpp"
+#include "XdmfDSMDriver.hpp"
+#include "XdmfHDF5WriterDSM.hpp"
+
+// Every worker writes arrays of several types and shapes to the same
+// raw DSM file. They are read back through the controllers attached by
+// the writer and by name from the index of the file, then small per
+// step writes are timed against the HDF5 path.
+
+static shared_ptr<XdmfArray>
+makeArray(const std::vector<unsigned int> & dimensions, int offset)
+{
+        shared_ptr<XdmfArray> array = XdmfArray::New();
+        array->initialize<int>(dimensions);
+        for (unsigned int i = 0; i < array->getSize(); ++i)
+        {
+                array->insert<int>(i, offset + i);
+        }
+        return array;
+}
+
+static void
+checkArray(shared_ptr<XdmfArray> array, unsigned int length, int offset)
+{
+        array->release();
+        array->read();
+        assert(array->getSize() == length);
+        for (unsigned int i = 0; i < length; ++i)
+        {
+                assert(array->getValue<int>(i) == (int)(offset + i));
+        }
+}
+
+static double
+timeWrites(shared_ptr<XdmfHDF5WriterDSM> writer, int numSteps, int length, MPI_Comm workerComm)
+{
+        shared_ptr<XdmfArray> array = XdmfArray::New();
+        for (int i = 0; i < length; ++i)
+        {
+                array->pushBack<double>(i);
+        }
+        MPI_Barrier(workerComm);
+        double startTime = MPI_Wtime();
+        for (int step = 0; step < numSteps; ++step)
+        {
+                array->insert<double>(0, step);
+                array->accept(writer);
+                array->release();
+                array->read();
+                assert(array->getValue<double>(0) == step);
+        }
+        double elapsed = MPI_Wtime() - startTime;
+        double maxElapsed;
+        MPI_Allreduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, workerComm);
+        return maxElapsed;
+}
+
+int main(int argc, char *argv[])
+{
+        int size, id;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        MPI_Init(&argc, &argv);
+
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+
+        std::string newPath = "dsm";
+        std::string rawPath = "dsmraw";
+
+        // Change this to determine the number of cores used as servers
+        int numServersCores = 2;
+        unsigned int serverSizeMB = 4;
+
+        shared_ptr<XdmfHDF5WriterDSM> exampleWriter = XdmfHDF5WriterDSM::New(newPath, comm, serverSizeMB, size-numServersCores, size-1);
+
+        //server cores will not progress to this point until after the servers are done running
+
+        if (id < size - numServersCores)
+        {
+                MPI_Comm workerComm = exampleWriter->getWorkerComm();
+                int workerId, numWorkers;
+                MPI_Comm_rank(workerComm, &workerId);
+                MPI_Comm_size(workerComm, &numWorkers);
+
+                XdmfDSMBuffer * dsmBuffer = exampleWriter->getServerBuffer();
+
+                // The raw file and the HDF5 file used for timing are kept apart
+                xdmf_dsm_set_file_slots(4);
+
+                shared_ptr<XdmfHDF5WriterDSM> rawWriter = XdmfHDF5WriterDSM::New(rawPath, dsmBuffer);
+                rawWriter->setWorkerComm(workerComm);
+                rawWriter->setRawMode(true);
+                assert(rawWriter->getRawMode());
+
+                std::vector<std::vector<unsigned int> > shapes(3);
+                shapes[0].push_back(1000);
+                shapes[1].push_back(20);
+                shapes[1].push_back(30);
+                shapes[2].push_back(4);
+                shapes[2].push_back(5);
+                shapes[2].push_back(6);
+
+                std::vector<shared_ptr<XdmfArray> > arrays;
+                for (unsigned int i = 0; i < shapes.size(); ++i)
+                {
+                        arrays.push_back(makeArray(shapes[i], workerId * 10000 + i * 1000));
+                        arrays[i]->accept(rawWriter);
+                        assert(arrays[i]->getNumberHeavyDataControllers() == 1);
+                        shared_ptr<XdmfBinaryControllerDSM> controller =
+                                shared_dynamic_cast<XdmfBinaryControllerDSM>(arrays[i]->getHeavyDataController(0));
+                        assert(controller);
+                        assert(controller->getDimensions() == shapes[i]);
+                        assert(controller->getType() == XdmfArrayType::Int32());
+                }
+
+                for (unsigned int i = 0; i < arrays.size(); ++i)
+                {
+                        checkArray(arrays[i], arrays[i]->getSize(), workerId * 10000 + i * 1000);
+                        assert(arrays[i]->getDimensions() == shapes[i]);
+                }
+
+                // Windows of an array are read without the rest of it
+                shared_ptr<XdmfHeavyDataController> firstController = arrays[0]->getHeavyDataController(0);
+                shared_ptr<XdmfArray> window = XdmfArray::New();
+                firstController->read(window.get(), 100, 1, 50);
+                assert(window->getSize() == 50);
+                assert(window->getValue<int>(0) == workerId * 10000 + 100);
+                firstController->read(window.get(), 100, 3, 50);
+                assert(window->getValue<int>(49) == workerId * 10000 + 100 + 49 * 3);
+
+                // Written to XML as a binary file read from the offset
+                std::map<std::string, std::string> properties;
+                firstController->getProperties(properties);
+                assert(properties["Format"].compare("Binary") == 0);
+                std::stringstream seek;
+                seek << shared_dynamic_cast<XdmfBinaryControllerDSM>(firstController)->getOffset();
+                assert(properties["Seek"].compare(seek.str()) == 0);
+                assert(firstController->getDescriptor().empty());
+
+                MPI_Barrier(workerComm);
+
+                // The index alone is enough to find every array in the file
+                for (int i = 0; i < numWorkers * (int)shapes.size(); ++i)
+                {
+                        std::stringstream dataSetName;
+                        dataSetName << "Data" << i;
+                        shared_ptr<XdmfBinaryControllerDSM> namedController =
+                                XdmfBinaryControllerDSM::New(rawPath, dataSetName.str(), dsmBuffer);
+                        shared_ptr<XdmfArray> namedArray = XdmfArray::New();
+                        namedArray->insert(namedController);
+                        namedArray->read();
+                        assert(namedArray->getDimensions() == namedController->getDimensions());
+                        int first = namedArray->getValue<int>(0);
+                        assert(first % 1000 == 0);
+                        checkArray(namedArray, namedArray->getSize(), first);
+                }
+
+                MPI_Barrier(workerComm);
+
+                // Overwrite puts an array of the same size back in place
+                rawWriter->setMode(XdmfHeavyDataWriter::Overwrite);
+                int64_t previousOffset =
+                        shared_dynamic_cast<XdmfBinaryControllerDSM>(arrays[1]->getHeavyDataController(0))->getOffset();
+                for (unsigned int i = 0; i < arrays[1]->getSize(); ++i)
+                {
+                        arrays[1]->insert<int>(i, workerId * 10000 + 5000 + i);
+                }
+                arrays[1]->accept(rawWriter);
+                assert(shared_dynamic_cast<XdmfBinaryControllerDSM>(arrays[1]->getHeavyDataController(0))->getOffset() == previousOffset);
+                checkArray(arrays[1], arrays[1]->getSize(), workerId * 10000 + 5000);
+                checkArray(arrays[0], arrays[0]->getSize(), workerId * 10000);
+
+                MPI_Barrier(workerComm);
+
+                // Small per step writes through HDF5 and raw
+                int numSteps = 50;
+                int stepLength = 256;
+
+                shared_ptr<XdmfHDF5WriterDSM> hdf5Writer = XdmfHDF5WriterDSM::New("dsmhdf5", dsmBuffer);
+                hdf5Writer->setWorkerComm(workerComm);
+                shared_ptr<XdmfHDF5WriterDSM> stepWriter = XdmfHDF5WriterDSM::New("dsmrawstep", dsmBuffer);
+                stepWriter->setWorkerComm(workerComm);
+                stepWriter->setRawMode(true);
+                stepWriter->setMode(XdmfHeavyDataWriter::Overwrite);
+
+                double hdf5Time = timeWrites(hdf5Writer, numSteps, stepLength, workerComm);
+                double rawTime = timeWrites(stepWriter, numSteps, stepLength, workerComm);
+
+                if (workerId == 0)
+                {
+                        std::cout << numSteps << " steps of " << stepLength << " doubles, hdf5 "
+                                  << hdf5Time / numSteps * 1e6 << " us, raw "
+                                  << rawTime / numSteps * 1e6 << " us per step" << std::endl;
+                }
+
+                xdmf_dsm_set_file_slots(1);
+
+                MPI_Barrier(workerComm);
+
+                if (workerId == 0)
+                {
+                        exampleWriter->stopDSM();
+                }
+        }
+
+        MPI_Barrier(comm);
+
+        //the dsmManager must be deleted or else there will be a segfault
+        exampleWriter->deleteManager();
+
+        MPI_Finalize();
+
+        return 0;
+}
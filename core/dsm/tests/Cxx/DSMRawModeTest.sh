@@ -0,0 +1 @@
+$MPIEXEC -n 4 ./DSMRawModeTest
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <iostream>
+#include <vector>
+#include "XdmfDSMBuffer.hpp"
+#include "XdmfDSMManager.hpp"
+#include "XdmfHDF5WriterDSM.hpp"
+
+// Compares the latency of small Put/Get calls and the bandwidth of large
+// ones with and without shared memory for cores on the same node as a
+// server. The mode is chosen with the first argument: remote or shared.
+
+int main(int argc, char *argv[])
+{
+        int size, id;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        MPI_Init(&argc, &argv);
+
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+
+        bool useSharedMemory = false;
+        std::string mode = "remote";
+        if (argc > 1)
+        {
+                mode = argv[1];
+        }
+        if (mode == "shared")
+        {
+                useSharedMemory = true;
+        }
+
+        std::string newPath = "dsm";
+
+        // Change this to determine the number of cores used as servers
+        int numServersCores = 2;
+        unsigned int serverSizeMB = 8;
+        // Number of small transfers used to measure latency
+        int numSmallTransfers = 1000;
+        int64_t smallLength = 8;
+
+        XdmfDSMManager * dsmManager = new XdmfDSMManager();
+        dsmManager->SetLocalBufferSizeMBytes(serverSizeMB);
+        dsmManager->SetUseSharedMemory(useSharedMemory);
+
+        shared_ptr<XdmfHDF5WriterDSM> exampleWriter = XdmfHDF5WriterDSM::New(newPath, comm, dsmManager, size-numServersCores, size-1);
+
+        //server cores will not progress to this point until after the servers are done running
+
+        if (id < size - numServersCores)
+        {
+                MPI_Comm workerComm = exampleWriter->getWorkerComm();
+                int workerId, workerSize;
+                MPI_Comm_rank(workerComm, &workerId);
+                MPI_Comm_size(workerComm, &workerSize);
+
+                XdmfDSMBuffer * dsmBuffer = exampleWriter->getServerBuffer();
+                assert(dsmBuffer->GetUseSharedMemory() == useSharedMemory);
+
+                // Each worker uses its own slice of the DSM, spanning both servers
+                int64_t sliceLength = dsmBuffer->GetTotalLength() / workerSize;
+                int64_t sliceStart = workerId * sliceLength;
+
+                // Latency of small transfers
+                std::vector<char> smallData(smallLength);
+                MPI_Barrier(workerComm);
+                double startTime = MPI_Wtime();
+                for (int i = 0; i < numSmallTransfers; ++i)
+                {
+                        int64_t address = sliceStart + (i * smallLength) % sliceLength;
+                        memset(&smallData[0], i % 127, smallLength);
+                        dsmBuffer->Put(address, smallLength, &smallData[0]);
+                        dsmBuffer->Get(address, smallLength, &smallData[0]);
+                        assert(smallData[smallLength - 1] == i % 127);
+                }
+                double latency = (MPI_Wtime() - startTime) / (2 * numSmallTransfers);
+
+                // Bandwidth of a transfer covering the whole slice
+                std::vector<char> writeData(sliceLength);
+                for (int64_t i = 0; i < sliceLength; ++i)
+                {
+                        writeData[i] = (char)((sliceStart + i) % 251);
+                }
+                MPI_Barrier(workerComm);
+                startTime = MPI_Wtime();
+                dsmBuffer->Put(sliceStart, sliceLength, &writeData[0]);
+                MPI_Barrier(workerComm);
+                double writeTime = MPI_Wtime() - startTime;
+
+                std::vector<char> readData(sliceLength);
+                MPI_Barrier(workerComm);
+                startTime = MPI_Wtime();
+                dsmBuffer->Get(sliceStart, sliceLength, &readData[0]);
+                MPI_Barrier(workerComm);
+                double readTime = MPI_Wtime() - startTime;
+
+                assert(memcmp(&writeData[0], &readData[0], sliceLength) == 0);
+
+                if (workerId == 0)
+                {
+                        double totalMB = dsmBuffer->GetTotalLength() / (1024.0 * 1024.0);
+                        std::cout << mode << " latency " << latency * 1.0e6 << " us" << std::endl;
+                        std::cout << mode << " write " << totalMB / writeTime << " MB/s, read "
+                                  << totalMB / readTime << " MB/s" << std::endl;
+                }
+
+                MPI_Barrier(workerComm);
+
+                if (workerId == 0)
+                {
+                        exampleWriter->stopDSM();
+                }
+        }
+
+        MPI_Barrier(comm);
+
+        //the dsmManager must be deleted or else there will be a segfault
+        exampleWriter->deleteManager();
+
+        MPI_Finalize();
+
+        return 0;
+}
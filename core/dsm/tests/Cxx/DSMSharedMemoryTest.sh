@@ -0,0 +1,3 @@
+$MPIEXEC -n 4 ./DSMSharedMemoryTest remote &&
+
+$MPIEXEC -n 4 ./DSMSharedMemoryTest shared
\ No newline at end of file
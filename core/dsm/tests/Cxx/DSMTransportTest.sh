@@ -0,0 +1,3 @@
+$MPIEXEC -n 4 ./DSMTransportTest message &&
+
+$MPIEXEC -n 4 ./DSMTransportTest rma
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfDSMDriver.hpp"
+#include "XdmfHDF5WriterDSM.hpp"
+
+// Writes many small arrays to the DSM through the HDF5 driver, first with
+// the driver's write cache disabled and then enabled, and compares the
+// number of messages sent to the number of writes made by HDF5.
+
+int main(int argc, char *argv[])
+{
+        int size, id;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        MPI_Init(&argc, &argv);
+
+        MPI_Comm_rank(comm, &id);
+        MPI_Comm_size(comm, &size);
+
+        std::string newPath = "dsm";
+
+        // Change this to determine the number of cores used as servers
+        int numServersCores = 2;
+        unsigned int serverSizeMB = 16;
+        // Number of data sets written in each pass
+        unsigned int numArrays = 200;
+        unsigned int arraySize = 16;
+
+        shared_ptr<XdmfHDF5WriterDSM> exampleWriter = XdmfHDF5WriterDSM::New(newPath, comm, serverSizeMB, size-numServersCores, size-1);
+
+        //server cores will not progress to this point until after the servers are done running
+
+        if (id < size - numServersCores)
+        {
+                MPI_Comm workerComm = exampleWriter->getWorkerComm();
+                int workerId;
+                MPI_Comm_rank(workerComm, &workerId);
+
+                size_t messages[2];
+
+                for (unsigned int pass = 0; pass < 2; ++pass)
+                {
+                        if (pass == 0)
+                        {
+                                // Every write goes straight to the servers
+                                xdmf_dsm_set_write_cache(0, 0);
+                        }
+                        else
+                        {
+                                xdmf_dsm_set_write_cache(XDMF_DSM_DEFAULT_WRITE_CACHE_LENGTH,
+                                                         XDMF_DSM_DEFAULT_WRITE_CACHE_BLOCKS);
+                        }
+                        xdmf_dsm_reset_write_statistics();
+
+                        std::vector<shared_ptr<XdmfArray> > arrays;
+
+                        MPI_Barrier(workerComm);
+                        double startTime = MPI_Wtime();
+                        for (unsigned int i = 0; i < numArrays; ++i)
+                        {
+                                shared_ptr<XdmfArray> writeArray = XdmfArray::New();
+                                for (unsigned int j = 0; j < arraySize; ++j)
+                                {
+                                        writeArray->pushBack<int>(pass * numArrays + i * arraySize + j);
+                                }
+                                writeArray->accept(exampleWriter);
+                                arrays.push_back(writeArray);
+                        }
+                        MPI_Barrier(workerComm);
+                        double writeTime = MPI_Wtime() - startTime;
+
+                        size_t writes, bytes;
+                        xdmf_dsm_get_write_statistics(&writes, &bytes, &messages[pass]);
+
+                        // Everything written must be visible once the file is closed
+                        for (unsigned int i = 0; i < numArrays; ++i)
+                        {
+                                arrays[i]->release();
+                                arrays[i]->read();
+                                assert(arrays[i]->getSize() == arraySize);
+                                for (unsigned int j = 0; j < arraySize; ++j)
+                                {
+                                        assert(arrays[i]->getValue<int>(j) == (int)(pass * numArrays + i * arraySize + j));
+                                }
+                        }
+
+                        if (workerId == 0)
+                        {
+                                std::cout << (pass == 0 ? "uncached" : "cached")
+                                          << " writes " << writes
+                                          << " bytes " << bytes
+                                          << " messages " << messages[pass]
+                                          << " time " << writeTime << " s" << std::endl;
+                        }
+                }
+
+                std::cout << messages[1] << " ?< " << messages[0] << std::endl;
+                assert(messages[1] < messages[0]);
+
+                MPI_Barrier(workerComm);
+
+                if (workerId == 0)
+                {
+                        exampleWriter->stopDSM();
+                }
+        }
+
+        MPI_Barrier(comm);
+
+        //the dsmManager must be deleted or else there will be a segfault
+        exampleWriter->deleteManager();
+
+        MPI_Finalize();
+
+        return 0;
+}
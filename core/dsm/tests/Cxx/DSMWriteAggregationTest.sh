@@ -0,0 +1 @@
+$MPIEXEC -n 4 ./DSMWriteAggregationTest
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include <iostream>
+#include "XdmfArray.hpp"
+#include "XdmfArrayAllocator.hpp"
+#include "XdmfArrayPoolAllocator.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfHDF5Writer.hpp"
+
+int main(int, char **)
+{
+  //
+  // Aligned allocator attached to a single array
+  //
+  shared_ptr<XdmfArrayAllocator> allocator = XdmfArrayAllocator::New();
+  std::cout << allocator->getAlignment() << " ?= " << 64 << std::endl;
+  assert(allocator->getAlignment() == 64);
+
+  shared_ptr<XdmfArray> array = XdmfArray::New();
+  array->setAllocator(allocator);
+  assert(array->getAllocator() == allocator);
+  array->initialize(XdmfArrayType::Float64(), 100);
+  std::cout << array->getSize() << " ?= " << 100 << std::endl;
+  assert(array->getSize() == 100);
+  assert(array->getArrayType() == XdmfArrayType::Float64());
+  assert(reinterpret_cast<std::size_t>(array->getValuesInternal()) % 64 == 0);
+  std::cout << allocator->getBytesLive() << " ?= " << 800 << std::endl;
+  assert(allocator->getBytesLive() == 800);
+  for(unsigned int i = 0; i < 100; ++i) {
+    assert(array->getValue<double>(i) == 0);
+  }
+
+  // Values written through the pointer are kept when the array is
+  // modified and its values move to internal storage
+  static_cast<double *>(array->getValuesInternal())[5] = 2.5;
+  array->pushBack<double>(7.5);
+  std::cout << allocator->getBytesLive() << " ?= " << 0 << std::endl;
+  assert(allocator->getBytesLive() == 0);
+  std::cout << allocator->getPeakBytes() << " ?= " << 800 << std::endl;
+  assert(allocator->getPeakBytes() == 800);
+  assert(array->getSize() == 101);
+  assert(array->getValue<double>(5) == 2.5);
+  assert(array->getValue<double>(100) == 7.5);
+
+  // Every other modification also returns the block, the values are
+  // kept and the array stays usable
+  array->initialize(XdmfArrayType::Int32(), 10);
+  assert(allocator->getBytesLive() == 40);
+  static_cast<int *>(array->getValuesInternal())[9] = 9;
+  array->insert<int>(2, 4);
+  assert(allocator->getBytesLive() == 0);
+  assert(array->getSize() == 10);
+  assert(array->getValue<int>(2) == 4);
+  assert(array->getValue<int>(9) == 9);
+  array->insert<int>(10, 10);
+  assert(array->getValue<int>(10) == 10);
+
+  array->initialize(XdmfArrayType::Int32(), 10);
+  array->resize<int>(20, 3);
+  assert(allocator->getBytesLive() == 0);
+  assert(array->getValue<int>(9) == 0);
+  assert(array->getValue<int>(19) == 3);
+
+  array->initialize(XdmfArrayType::Int32(), 10);
+  array->reserve(100);
+  assert(allocator->getBytesLive() == 0);
+  assert(array->getSize() == 10);
+  assert(array->getCapacity() >= 100);
+
+  // The templated initialize does not use the allocator
+  array->initialize<int>(10);
+  assert(allocator->getBytesLive() == 0);
+
+  // Strings always use internal storage
+  array->initialize(XdmfArrayType::String(), 10);
+  assert(allocator->getBytesLive() == 0);
+
+  allocator->resetPeakBytes();
+  assert(allocator->getPeakBytes() == 0);
+
+  //
+  // Pooled allocator reuses released blocks
+  //
+  shared_ptr<XdmfArrayPoolAllocator> pool = XdmfArrayPoolAllocator::New();
+  shared_ptr<XdmfArray> pooledArray = XdmfArray::New();
+  pooledArray->setAllocator(pool);
+  pooledArray->initialize(XdmfArrayType::Int32(), 100);
+  const void * const firstBlock = pooledArray->getValuesInternal();
+  assert(pool->getBytesLive() == 400);
+  pooledArray->release();
+  std::cout << pool->getBytesLive() << " ?= " << 0 << std::endl;
+  assert(pool->getBytesLive() == 0);
+  // 400 bytes rounded up to the 64 byte alignment
+  std::cout << pool->getBytesCached() << " ?= " << 448 << std::endl;
+  assert(pool->getBytesCached() == 448);
+
+  pooledArray->initialize(XdmfArrayType::Float32(), 110);
+  assert(pooledArray->getValuesInternal() == firstBlock);
+  assert(pool->getBytesCached() == 0);
+  pooledArray->release();
+
+  pool->setMaxCachedBytes(0);
+  std::cout << pool->getBytesCached() << " ?= " << 0 << std::endl;
+  assert(pool->getBytesCached() == 0);
+
+  //
+  // Default allocator is used by arrays filled while reading
+  //
+  shared_ptr<XdmfArray> writtenArray = XdmfArray::New();
+  for(int i = 0; i < 20; ++i) {
+    writtenArray->pushBack<int>(i);
+  }
+  shared_ptr<XdmfHDF5Writer> writer = XdmfHDF5Writer::New("allocator.h5");
+  writtenArray->accept(writer);
+  writtenArray->release();
+
+  shared_ptr<XdmfArrayPoolAllocator> defaultPool = XdmfArrayPoolAllocator::New();
+  XdmfArray::setDefaultAllocator(defaultPool);
+  assert(XdmfArray::getDefaultAllocator() == defaultPool);
+  writtenArray->read();
+  std::cout << defaultPool->getBytesLive() << " ?= " << 80 << std::endl;
+  assert(defaultPool->getBytesLive() == 80);
+  for(int i = 0; i < 20; ++i) {
+    assert(writtenArray->getValue<int>(i) == i);
+  }
+  writtenArray->release();
+  assert(defaultPool->getBytesLive() == 0);
+  assert(defaultPool->getPeakBytes() == 80);
+
+  XdmfArray::setDefaultAllocator(shared_ptr<XdmfArrayAllocator>());
+  writtenArray->read();
+  assert(defaultPool->getBytesLive() == 0);
+  assert(writtenArray->getValue<int>(19) == 19);
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfBinaryController.hpp"
+#include "XdmfError.hpp"
+#include "XdmfHDF5Controller.hpp"
+#include "XdmfHDF5Writer.hpp"
+
+int main(int, char **)
+{
+  //
+  // Int32 data set read into a caller owned double buffer
+  //
+  shared_ptr<XdmfArray> intArray = XdmfArray::New();
+  for(int i = 0; i < 10; ++i) {
+    intArray->pushBack<int>(i * 3);
+  }
+
+  shared_ptr<XdmfHDF5Writer> writer = XdmfHDF5Writer::New("buffer.h5");
+  intArray->accept(writer);
+  intArray->release();
+
+  std::vector<double> doubleBuffer(10);
+  intArray->read(&doubleBuffer[0], 10);
+  std::cout << intArray->getArrayType() << " ?= " << XdmfArrayType::Float64() << std::endl;
+  assert(intArray->getArrayType() == XdmfArrayType::Float64());
+  // The array wraps the buffer rather than copying it
+  assert(intArray->getValuesInternal() == &doubleBuffer[0]);
+  std::cout << intArray->getDimensionsString() << " ?= " << "10" << std::endl;
+  assert(intArray->getDimensionsString().compare("10") == 0);
+  for(unsigned int i = 0; i < 10; ++i) {
+    assert(doubleBuffer[i] == i * 3);
+    assert(intArray->getValue<double>(i) == i * 3);
+  }
+
+  // Buffers of the wrong size are rejected
+  std::vector<int> smallBuffer(5);
+  bool caught = false;
+  try {
+    intArray->getHeavyDataController()->read(&smallBuffer[0],
+                                             XdmfArrayType::Int32(),
+                                             5);
+  }
+  catch (XdmfError &) {
+    caught = true;
+  }
+  assert(caught);
+
+  //
+  // Array split over two controllers read into a single buffer
+  //
+  shared_ptr<XdmfArray> splitArray = XdmfArray::New();
+  splitArray->insert(intArray->getHeavyDataController());
+  shared_ptr<XdmfHeavyDataController> secondController =
+    XdmfHDF5Controller::New("buffer.h5",
+                            shared_dynamic_cast<XdmfHDF5Controller>(intArray->getHeavyDataController())->getDataSetPath(),
+                            XdmfArrayType::Int32(),
+                            std::vector<unsigned int>(1, 5),
+                            std::vector<unsigned int>(1, 1),
+                            std::vector<unsigned int>(1, 5),
+                            std::vector<unsigned int>(1, 10));
+  secondController->setArrayOffset(10);
+  splitArray->insert(secondController);
+
+  std::vector<long> longBuffer(15);
+  splitArray->read(&longBuffer[0], 15);
+  std::cout << splitArray->getSize() << " ?= " << 15 << std::endl;
+  assert(splitArray->getSize() == 15);
+  for(unsigned int i = 0; i < 10; ++i) {
+    assert(longBuffer[i] == static_cast<long>(i * 3));
+  }
+  for(unsigned int i = 10; i < 15; ++i) {
+    assert(longBuffer[i] == static_cast<long>((i - 5) * 3));
+  }
+
+  //
+  // Big endian binary Int16 data read directly into a short buffer
+  //
+  const unsigned char bigEndianShorts[] = {0x00, 0x01,
+                                           0x01, 0x00,
+                                           0xFF, 0xFF};
+  std::ofstream output("buffer.bin", std::ofstream::binary);
+  output.write(reinterpret_cast<const char *>(bigEndianShorts), 6);
+  output.close();
+
+  shared_ptr<XdmfBinaryController> binaryController =
+    XdmfBinaryController::New("buffer.bin",
+                              XdmfArrayType::Int16(),
+                              XdmfBinaryController::BIG,
+                              0,
+                              std::vector<unsigned int>(1, 3));
+  short shortBuffer[3];
+  binaryController->read(shortBuffer, XdmfArrayType::Int16(), 3);
+  std::cout << shortBuffer[0] << " " << shortBuffer[1] << " " << shortBuffer[2]
+            << " ?= " << "1 256 -1" << std::endl;
+  assert(shortBuffer[0] == 1);
+  assert(shortBuffer[1] == 256);
+  assert(shortBuffer[2] == -1);
+
+  // Converting reads go through the generic path
+  float floatBuffer[3];
+  binaryController->read(floatBuffer, XdmfArrayType::Float32(), 3);
+  assert(floatBuffer[0] == 1);
+  assert(floatBuffer[1] == 256);
+  assert(floatBuffer[2] == -1);
+
+  return 0;
+}
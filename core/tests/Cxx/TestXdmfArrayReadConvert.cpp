@@ -0,0 +1,83 @@
+#include <fstream>
+#include <iostream>
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfBinaryController.hpp"
+#include "XdmfHDF5Controller.hpp"
+#include "XdmfHDF5Writer.hpp"
+
+int main(int, char **)
+{
+  //
+  // Float64 data set read as Float32
+  //
+  shared_ptr<XdmfArray> doubleArray = XdmfArray::New();
+  for(unsigned int i = 0; i < 10; ++i) {
+    doubleArray->pushBack<double>(i + 0.5);
+  }
+
+  shared_ptr<XdmfHDF5Writer> writer = XdmfHDF5Writer::New("convert.h5");
+  doubleArray->accept(writer);
+  doubleArray->release();
+
+  doubleArray->read(XdmfArrayType::Float32());
+  std::cout << doubleArray->getArrayType() << " ?= " << XdmfArrayType::Float32() << std::endl;
+  assert(doubleArray->getArrayType() == XdmfArrayType::Float32());
+  std::cout << doubleArray->getSize() << " ?= " << 10 << std::endl;
+  assert(doubleArray->getSize() == 10);
+  for(unsigned int i = 0; i < 10; ++i) {
+    assert(doubleArray->getValue<float>(i) == i + 0.5f);
+  }
+
+  // Reading without a type uses the type on disk
+  doubleArray->release();
+  doubleArray->read();
+  assert(doubleArray->getArrayType() == XdmfArrayType::Float64());
+
+  //
+  // Int64 data set read as Int32 through the controller directly
+  //
+  shared_ptr<XdmfArray> longArray = XdmfArray::New();
+  for(long i = 0; i < 10; ++i) {
+    longArray->pushBack<long>(-i);
+  }
+  longArray->accept(writer);
+
+  shared_ptr<XdmfArray> intArray = XdmfArray::New();
+  longArray->getHeavyDataController()->read(intArray.get(),
+                                            XdmfArrayType::Int32());
+  std::cout << intArray->getArrayType() << " ?= " << XdmfArrayType::Int32() << std::endl;
+  assert(intArray->getArrayType() == XdmfArrayType::Int32());
+  std::cout << intArray->getValuesString() << " ?= " << longArray->getValuesString() << std::endl;
+  assert(intArray->getValuesString().compare(longArray->getValuesString()) == 0);
+  std::cout << intArray->getDimensionsString() << " ?= " << "10" << std::endl;
+  assert(intArray->getDimensionsString().compare("10") == 0);
+
+  //
+  // Big endian binary Int16 data read as Float64
+  //
+  const unsigned char bigEndianShorts[] = {0x00, 0x01,
+                                           0x01, 0x00,
+                                           0xFF, 0xFF};
+  std::ofstream output("convert.bin", std::ofstream::binary);
+  output.write(reinterpret_cast<const char *>(bigEndianShorts), 6);
+  output.close();
+
+  shared_ptr<XdmfBinaryController> binaryController =
+    XdmfBinaryController::New("convert.bin",
+                              XdmfArrayType::Int16(),
+                              XdmfBinaryController::BIG,
+                              0,
+                              std::vector<unsigned int>(1, 3));
+  shared_ptr<XdmfArray> binaryArray = XdmfArray::New();
+  binaryArray->setHeavyDataController(binaryController);
+  binaryArray->read(XdmfArrayType::Float64());
+  std::cout << binaryArray->getArrayType() << " ?= " << XdmfArrayType::Float64() << std::endl;
+  assert(binaryArray->getArrayType() == XdmfArrayType::Float64());
+  std::cout << binaryArray->getValuesString() << " ?= " << "1 256 -1" << std::endl;
+  assert(binaryArray->getValue<double>(0) == 1);
+  assert(binaryArray->getValue<double>(1) == 256);
+  assert(binaryArray->getValue<double>(2) == -1);
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfBinaryController.hpp"
+#include "XdmfHDF5Controller.hpp"
+#include "XdmfHDF5Writer.hpp"
+
+void checkWindow(const shared_ptr<XdmfArray> & array,
+                 const shared_ptr<XdmfArray> & full,
+                 const unsigned int start,
+                 const unsigned int stride,
+                 const unsigned int count)
+{
+  array->read(start, stride, count);
+  std::stringstream expected;
+  for(unsigned int i = 0; i < count; ++i) {
+    if(i > 0) {
+      expected << " ";
+    }
+    expected << full->getValue<int>(start + i * stride);
+  }
+  std::cout << array->getValuesString() << " ?= " << expected.str() << std::endl;
+  assert(array->getValuesString().compare(expected.str()) == 0);
+  assert(array->getSize() == count);
+  assert(array->getDimensions().size() == 1);
+}
+
+int main(int, char **)
+{
+  //
+  // Three dimensional data set
+  //
+  std::vector<unsigned int> dimensions;
+  dimensions.push_back(3);
+  dimensions.push_back(4);
+  dimensions.push_back(5);
+  shared_ptr<XdmfArray> array = XdmfArray::New();
+  array->initialize<int>(dimensions);
+  for(int i = 0; i < 60; ++i) {
+    array->insert(i, i);
+  }
+  shared_ptr<XdmfHDF5Writer> writer = XdmfHDF5Writer::New("window.h5");
+  array->accept(writer);
+  shared_ptr<XdmfArray> full = XdmfArray::New();
+  full->insert(0, array, 0, 60, 1, 1);
+
+  // Contiguous windows inside a row, across rows and across planes
+  checkWindow(array, full, 1, 1, 3);
+  checkWindow(array, full, 7, 1, 20);
+  checkWindow(array, full, 0, 1, 60);
+  // Strided windows
+  checkWindow(array, full, 3, 7, 8);
+  checkWindow(array, full, 0, 20, 3);
+
+  //
+  // Window of a controller that selects a hyperslab of the data set
+  //
+  shared_ptr<XdmfHDF5Controller> writtenController =
+    shared_dynamic_cast<XdmfHDF5Controller>(array->getHeavyDataController());
+  std::vector<unsigned int> sliceStart(3, 1);
+  std::vector<unsigned int> sliceStride(3, 1);
+  sliceStride[1] = 2;
+  std::vector<unsigned int> sliceDimensions;
+  sliceDimensions.push_back(2);
+  sliceDimensions.push_back(2);
+  sliceDimensions.push_back(3);
+  shared_ptr<XdmfHDF5Controller> sliceController =
+    XdmfHDF5Controller::New(writtenController->getFilePath(),
+                            writtenController->getDataSetPath(),
+                            XdmfArrayType::Int32(),
+                            sliceStart,
+                            sliceStride,
+                            sliceDimensions,
+                            dimensions);
+  shared_ptr<XdmfArray> slice = XdmfArray::New();
+  slice->setHeavyDataController(sliceController);
+  slice->read();
+  shared_ptr<XdmfArray> sliceFull = XdmfArray::New();
+  sliceFull->insert(0, slice, 0, slice->getSize(), 1, 1);
+  checkWindow(slice, sliceFull, 2, 1, 8);
+  checkWindow(slice, sliceFull, 1, 5, 3);
+
+  //
+  // Array split over two controllers
+  //
+  shared_ptr<XdmfArray> split = XdmfArray::New();
+  for(unsigned int i = 0; i < 2; ++i) {
+    shared_ptr<XdmfHDF5Controller> piece =
+      XdmfHDF5Controller::New(writtenController->getFilePath(),
+                              writtenController->getDataSetPath(),
+                              XdmfArrayType::Int32(),
+                              std::vector<unsigned int>(3, 0),
+                              std::vector<unsigned int>(3, 1),
+                              dimensions,
+                              dimensions);
+    piece->setArrayOffset(i * 60);
+    split->insert(piece);
+  }
+  split->read();
+  shared_ptr<XdmfArray> splitFull = XdmfArray::New();
+  splitFull->insert(0, split, 0, split->getSize(), 1, 1);
+  checkWindow(split, splitFull, 55, 1, 10);
+  checkWindow(split, splitFull, 50, 7, 10);
+  checkWindow(split, splitFull, 70, 2, 5);
+
+  //
+  // Repeated windows with files kept open
+  //
+  XdmfHDF5Controller::setMaxOpenedFiles(1);
+  for(unsigned int i = 0; i < 10; ++i) {
+    checkWindow(array, full, i * 5, 1, 5);
+  }
+  XdmfHDF5Controller::closeFiles();
+  XdmfHDF5Controller::setMaxOpenedFiles(0);
+
+  //
+  // Binary file
+  //
+  std::vector<int> binaryValues(100);
+  for(int i = 0; i < 100; ++i) {
+    binaryValues[i] = 100 - i;
+  }
+  std::ofstream output("window.bin", std::ofstream::binary);
+  output.write(reinterpret_cast<char *>(&binaryValues[0]),
+               sizeof(int) * binaryValues.size());
+  output.close();
+
+  shared_ptr<XdmfArray> binaryArray = XdmfArray::New();
+  binaryArray->setHeavyDataController(
+    XdmfBinaryController::New("window.bin",
+                              XdmfArrayType::Int32(),
+                              XdmfBinaryController::NATIVE,
+                              0,
+                              std::vector<unsigned int>(1, 100)));
+  binaryArray->read();
+  shared_ptr<XdmfArray> binaryFull = XdmfArray::New();
+  binaryFull->insert(0, binaryArray, 0, 100, 1, 1);
+  checkWindow(binaryArray, binaryFull, 10, 1, 20);
+  checkWindow(binaryArray, binaryFull, 3, 9, 11);
+
+  return 0;
+}
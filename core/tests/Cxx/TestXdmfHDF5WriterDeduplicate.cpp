@@ -0,0 +1,109 @@
+#include "XdmfArray.hpp"
+#include "XdmfHDF5Controller.hpp"
+#include "XdmfHDF5Writer.hpp"
+#include <cassert>
+#include <iostream>
+
+// Writes a static array and a changing array for a number of time
+// steps. The static array is only written once, also by a later writer
+// that finds it in the index left by the first one.
+
+static shared_ptr<XdmfArray>
+makeArray(unsigned int size, double offset)
+{
+  shared_ptr<XdmfArray> array = XdmfArray::New();
+  for(unsigned int i = 0; i < size; ++i) {
+    array->pushBack<double>(offset + i);
+  }
+  return array;
+}
+
+static std::string
+dataSetPath(const shared_ptr<XdmfArray> & array)
+{
+  return shared_dynamic_cast<XdmfHDF5Controller>(array->getHeavyDataController(0))->getDataSetPath();
+}
+
+int main(int, char **)
+{
+  const unsigned int numSteps = 10;
+
+  shared_ptr<XdmfHDF5Writer> writer =
+    XdmfHDF5Writer::New("hdf5WriterTestDeduplicate.h5", true);
+  assert(!writer->getDeduplicate());
+  writer->setDeduplicate(true);
+  assert(writer->getDeduplicate());
+
+  std::string staticPath;
+  for(unsigned int step = 0; step < numSteps; ++step) {
+    shared_ptr<XdmfArray> geometry = makeArray(3000, 0);
+    shared_ptr<XdmfArray> values = makeArray(1000, step);
+    geometry->accept(writer);
+    values->accept(writer);
+    if(step == 0) {
+      staticPath = dataSetPath(geometry);
+    }
+    assert(dataSetPath(geometry).compare(staticPath) == 0);
+    assert(dataSetPath(values).compare(staticPath) != 0);
+    values->release();
+    values->read();
+    assert(values->getValue<double>(999) == step + 999);
+  }
+
+  std::cout << writer->getDuplicateHits() << " of "
+            << writer->getDuplicateLookups() << " arrays deduplicated"
+            << std::endl;
+  assert(writer->getDuplicateHits() == numSteps - 1);
+  assert(writer->getDuplicateLookups() == 2 * numSteps);
+
+  // The same dimensions with other values or another type are written
+  shared_ptr<XdmfArray> floats = XdmfArray::New();
+  floats->resize<float>(3000, 0);
+  floats->accept(writer);
+  assert(dataSetPath(floats).compare(staticPath) != 0);
+
+  // A new writer finds the arrays in the sidecar
+  shared_ptr<XdmfHDF5Writer> nextWriter =
+    XdmfHDF5Writer::New("hdf5WriterTestDeduplicate.h5");
+  nextWriter->setDeduplicate(true, true);
+  shared_ptr<XdmfArray> geometry = makeArray(3000, 0);
+  geometry->accept(nextWriter);
+  assert(nextWriter->getDuplicateHits() == 1);
+  assert(dataSetPath(geometry).compare(staticPath) == 0);
+  geometry->release();
+  geometry->read();
+  assert(geometry->getValue<double>(2999) == 2999);
+
+  // Verifying catches a data set that was changed in place
+  shared_ptr<XdmfHDF5Writer> overwriter =
+    XdmfHDF5Writer::New("hdf5WriterTestDeduplicate.h5");
+  overwriter->setMode(XdmfHeavyDataWriter::Overwrite);
+  geometry->insert<double>(0, -1.0);
+  geometry->accept(overwriter);
+
+  shared_ptr<XdmfHDF5Writer> verifyWriter =
+    XdmfHDF5Writer::New("hdf5WriterTestDeduplicate.h5");
+  verifyWriter->setDeduplicate(true, true);
+  shared_ptr<XdmfArray> original = makeArray(3000, 0);
+  original->accept(verifyWriter);
+  assert(verifyWriter->getDuplicateHits() == 0);
+  assert(dataSetPath(original).compare(staticPath) != 0);
+  original->release();
+  original->read();
+  assert(original->getValue<double>(0) == 0);
+
+  // Packed arrays are shared as well
+  shared_ptr<XdmfHDF5Writer> packWriter =
+    XdmfHDF5Writer::New("hdf5WriterTestDeduplicate.h5");
+  packWriter->setDeduplicate(true, true);
+  packWriter->setPackSize(100);
+  packWriter->openFile();
+  for(unsigned int step = 0; step < numSteps; ++step) {
+    shared_ptr<XdmfArray> small = makeArray(10, 0.5);
+    small->accept(packWriter);
+  }
+  packWriter->closeFile();
+  assert(packWriter->getDuplicateHits() == numSteps - 1);
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+#include "XdmfArray.hpp"
+#include "XdmfHDF5Controller.hpp"
+#include "XdmfHDF5Writer.hpp"
+#include "XdmfInformation.hpp"
+#include <hdf5.h>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+
+// Appends arrays to a growing file, first in one session, then in a
+// second session on the existing file and through a single visit of a
+// tree. Pass the number of arrays to time a larger run, for example
+// 100000.
+
+static std::string
+dataSetPath(const shared_ptr<XdmfArray> & array)
+{
+  return shared_dynamic_cast<XdmfHDF5Controller>(array->getHeavyDataController(0))->getDataSetPath();
+}
+
+static std::string
+dataSetName(int index)
+{
+  std::stringstream name;
+  name << "Data" << index;
+  return name.str();
+}
+
+static double
+appendArrays(shared_ptr<XdmfHDF5Writer> writer, int first, int numArrays)
+{
+  shared_ptr<XdmfArray> array = XdmfArray::New();
+  array->resize<int>(10);
+  const clock_t start = clock();
+  writer->openFile();
+  for(int i = first; i < first + numArrays; ++i) {
+    array->insert<int>(0, i);
+    array->accept(writer);
+    assert(dataSetPath(array).compare(dataSetName(i)) == 0);
+  }
+  writer->closeFile();
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char * argv[])
+{
+  int numArrays = 2000;
+  if(argc > 1) {
+    numArrays = std::atoi(argv[1]);
+  }
+  const int half = numArrays / 2;
+
+  shared_ptr<XdmfHDF5Writer> writer =
+    XdmfHDF5Writer::New("hdf5WriterTestSession.h5", true);
+  const double firstTime = appendArrays(writer, 0, half);
+
+  // A new writer continues after the data sets already in the file
+  shared_ptr<XdmfHDF5Writer> appendWriter =
+    XdmfHDF5Writer::New("hdf5WriterTestSession.h5");
+  const double secondTime = appendArrays(appendWriter, half, numArrays - half);
+
+  std::cout << numArrays << " arrays appended in " << firstTime + secondTime
+            << " s (" << firstTime << " s into a new file, " << secondTime
+            << " s into the existing file)" << std::endl;
+
+  // Flushing keeps the session open
+  shared_ptr<XdmfArray> flushed = XdmfArray::New();
+  flushed->pushBack(42);
+  appendWriter->openFile();
+  flushed->accept(appendWriter);
+  appendWriter->flush();
+  flushed->release();
+  flushed->read();
+  assert(flushed->getValue<int>(0) == 42);
+  appendWriter->closeFile();
+  assert(dataSetPath(flushed).compare(dataSetName(numArrays)) == 0);
+
+  // The arrays of a tree are written with the file opened once
+  shared_ptr<XdmfInformation> information = XdmfInformation::New("key", "value");
+  for(int i = 0; i < 100; ++i) {
+    shared_ptr<XdmfArray> array = XdmfArray::New();
+    array->pushBack(i);
+    information->insert(array);
+  }
+  shared_ptr<XdmfHDF5Writer> treeWriter =
+    XdmfHDF5Writer::New("hdf5WriterTestSession.h5");
+  information->accept(treeWriter);
+  for(unsigned int i = 0; i < information->getNumberArrays(); ++i) {
+    shared_ptr<XdmfArray> array = information->getArray(i);
+    assert(dataSetPath(array).compare(dataSetName(numArrays + 1 + i)) == 0);
+    array->release();
+    array->read();
+    assert(array->getValue<int>(0) == (int)i);
+  }
+
+  // The first free name is stored in the file
+  hid_t file = H5Fopen("hdf5WriterTestSession.h5", H5F_ACC_RDWR, H5P_DEFAULT);
+  assert(H5Aexists(file, "XdmfFreeDataSetId") > 0);
+
+  // A data set added without updating it has the names scanned again
+  const int foreignId = numArrays + 101;
+  const hsize_t foreignSize = 1;
+  hid_t dataspace = H5Screate_simple(1, &foreignSize, NULL);
+  hid_t dataset = H5Dcreate(file, dataSetName(foreignId).c_str(),
+                            H5T_NATIVE_INT, dataspace,
+                            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  H5Dclose(dataset);
+  H5Sclose(dataspace);
+  H5Fclose(file);
+  shared_ptr<XdmfArray> afterForeign = XdmfArray::New();
+  afterForeign->pushBack(7);
+  shared_ptr<XdmfHDF5Writer> foreignWriter =
+    XdmfHDF5Writer::New("hdf5WriterTestSession.h5");
+  afterForeign->accept(foreignWriter);
+  assert(dataSetPath(afterForeign).compare(dataSetName(foreignId + 1)) == 0);
+
+  return 0;
+}
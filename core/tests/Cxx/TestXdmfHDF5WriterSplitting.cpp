@@ -0,0 +1,92 @@
+#include "XdmfArray.hpp"
+#include "XdmfHDF5Controller.hpp"
+#include "XdmfHDF5Writer.hpp"
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+// Splits arrays over files of 1 MB without looking at the files while
+// writing. The files are measured afterwards to check the estimate of
+// their size, a file that is nearly full only gets small arrays.
+
+static long
+fileSize(const std::string & filePath)
+{
+  FILE * file = fopen(filePath.c_str(), "rb");
+  if(file == NULL) {
+    return 0;
+  }
+  fseek(file, 0, SEEK_END);
+  const long size = ftell(file);
+  fclose(file);
+  return size;
+}
+
+static std::string
+splitFileName(int index)
+{
+  std::stringstream name;
+  name << "hdf5WriterTestSplitting";
+  if(index > 0) {
+    name << index;
+  }
+  name << ".h5";
+  return name.str();
+}
+
+int main(int, char **)
+{
+  const long limit = 1024 * 1024;
+  for(int i = 0; i < 10; ++i) {
+    std::remove(splitFileName(i).c_str());
+  }
+
+  shared_ptr<XdmfHDF5Writer> writer =
+    XdmfHDF5Writer::New(splitFileName(0), true);
+  writer->setFileSizeLimit(1);
+
+  // Arrays of several sizes, 1000 values fill one chunk
+  const unsigned int sizes[] = {1000, 10, 2500, 300};
+  std::set<std::string> files;
+  unsigned int numValues = 0;
+  writer->openFile();
+  for(unsigned int i = 0; i < 300; ++i) {
+    shared_ptr<XdmfArray> array = XdmfArray::New();
+    array->resize<double>(sizes[i % 4], i);
+    numValues += array->getSize();
+    array->accept(writer);
+    assert(array->getNumberHeavyDataControllers() == 1);
+    files.insert(array->getHeavyDataController(0)->getFilePath());
+  }
+  writer->closeFile();
+
+  // About 3.3 MB of chunks are written, so at least four files are needed
+  std::cout << numValues << " values written to " << files.size()
+            << " files" << std::endl;
+  assert(files.size() >= 4);
+
+  // The estimate keeps files under the limit without leaving much
+  // of them empty
+  for(unsigned int i = 0; i < files.size(); ++i) {
+    const long size = fileSize(splitFileName(i));
+    std::cout << splitFileName(i) << " " << size << " bytes" << std::endl;
+    assert(files.count(splitFileName(i)) == 1);
+    assert(size <= limit);
+    if(i + 1 < files.size()) {
+      assert(size > limit * 9 / 10);
+    }
+  }
+
+  // A new writer starts from the sizes on disk
+  shared_ptr<XdmfHDF5Writer> appendWriter =
+    XdmfHDF5Writer::New(splitFileName(0));
+  appendWriter->setFileSizeLimit(1);
+  shared_ptr<XdmfArray> array = XdmfArray::New();
+  array->resize<double>(100000, 1.0);
+  array->accept(appendWriter);
+  assert(array->getHeavyDataController(0)->getFilePath().compare(splitFileName(0)) != 0);
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+#include "XdmfArray.hpp"
+#include "XdmfInformation.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+
+// Finds, renames and removes children of an item by name, checking the
+// results against a linear search. Pass the number of children to time
+// a larger run, for example 100000.
+
+static std::string
+childKey(unsigned int index)
+{
+  std::stringstream key;
+  key << "Key" << index;
+  return key.str();
+}
+
+static shared_ptr<XdmfInformation>
+findLinear(const shared_ptr<XdmfInformation> & parent,
+           const std::string & key)
+{
+  for(unsigned int i = 0; i < parent->getNumberInformations(); ++i) {
+    if(parent->getInformation(i)->getKey().compare(key) == 0) {
+      return parent->getInformation(i);
+    }
+  }
+  return shared_ptr<XdmfInformation>();
+}
+
+static void
+checkChildren(const shared_ptr<XdmfInformation> & parent,
+              unsigned int numChildren)
+{
+  for(unsigned int i = 0; i < numChildren + 2; i += numChildren / 50 + 1) {
+    const std::string key = childKey(i);
+    assert(parent->getInformation(key) == findLinear(parent, key));
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  unsigned int numChildren = 20000;
+  if(argc > 1) {
+    numChildren = std::max(std::atoi(argv[1]), 20);
+  }
+
+  shared_ptr<XdmfInformation> parent = XdmfInformation::New();
+  clock_t start = clock();
+  for(unsigned int i = 0; i < numChildren; ++i) {
+    parent->insert(XdmfInformation::New(childKey(i), "Value"));
+  }
+  const double insertTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for(unsigned int i = 0; i < numChildren; ++i) {
+    assert(parent->getInformation(childKey(i)) == parent->getInformation(i));
+  }
+  const double findTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  const unsigned int numLinear = numChildren / 100 + 1;
+  for(unsigned int i = 0; i < numLinear; ++i) {
+    findLinear(parent, childKey(numChildren - 1 - i));
+  }
+  const double linearTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  // Each child found and renamed in turn, the index is kept
+  start = clock();
+  for(unsigned int i = 0; i < numChildren; ++i) {
+    parent->getInformation(childKey(i))->setKey(childKey(i) + "Renamed");
+  }
+  for(unsigned int i = 0; i < numChildren; ++i) {
+    shared_ptr<XdmfInformation> child =
+      parent->getInformation(childKey(i) + "Renamed");
+    assert(child == parent->getInformation(i));
+    child->setKey(childKey(i));
+  }
+  const double renameTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  std::cout << numChildren << " children inserted in " << insertTime
+            << " s, all found by name in " << findTime << " s, found and "
+            << "renamed twice in " << renameTime << " s (linear search: "
+            << linearTime << " s for " << numLinear << ")" << std::endl;
+
+  assert(!parent->getInformation("Missing"));
+
+  // The first child with a name is found
+  parent->insert(XdmfInformation::New(childKey(0), "Duplicate"));
+  assert(parent->getInformation(childKey(0))->getValue().compare("Value") == 0);
+
+  // Children inserted after the index is built are found
+  parent->insert(XdmfInformation::New("Inserted", "Value"));
+  assert(parent->getInformation("Inserted") ==
+         parent->getInformation(parent->getNumberInformations() - 1));
+
+  // Renamed children are found by their new names only
+  shared_ptr<XdmfInformation> renamed = parent->getInformation(childKey(5));
+  renamed->setKey("Renamed");
+  assert(parent->getInformation("Renamed") == renamed);
+  assert(!parent->getInformation(childKey(5)));
+  renamed->setKey(childKey(5));
+  checkChildren(parent, numChildren);
+
+  // A duplicate renamed away leaves the first child found
+  parent->getInformation(0)->setKey("First");
+  assert(parent->getInformation(childKey(0))->getValue().compare("Duplicate") == 0);
+  parent->getInformation(0)->setKey(childKey(0));
+  assert(parent->getInformation(childKey(0))->getValue().compare("Value") == 0);
+
+  // Items renamed before insertion
+  shared_ptr<XdmfInformation> late = XdmfInformation::New("Late", "Value");
+  late->setKey("Later");
+  parent->insert(late);
+  assert(parent->getInformation("Later") == late);
+  assert(!parent->getInformation("Late"));
+
+  // Removed children are not found, the children after them are
+  parent->removeInformation(childKey(10));
+  assert(!parent->getInformation(childKey(10)));
+  assert(parent->getInformation(childKey(11)) == parent->getInformation(10));
+  parent->removeInformation(0);
+  assert(parent->getInformation(childKey(0))->getValue().compare("Duplicate") == 0);
+  checkChildren(parent, numChildren);
+
+  // Children shared by two items are found in both
+  shared_ptr<XdmfInformation> other = XdmfInformation::New();
+  for(unsigned int i = 0; i < numChildren; i += 2) {
+    if(shared_ptr<XdmfInformation> child = findLinear(parent, childKey(i))) {
+      other->insert(child);
+    }
+  }
+  assert(other->getInformation(childKey(2)) == parent->getInformation(childKey(2)));
+  parent->getInformation(childKey(2))->setKey("Shared");
+  assert(other->getInformation("Shared") == parent->getInformation("Shared"));
+  assert(!other->getInformation(childKey(2)));
+
+  // Other children searched by name
+  shared_ptr<XdmfInformation> arrays = XdmfInformation::New();
+  for(unsigned int i = 0; i < 100; ++i) {
+    shared_ptr<XdmfArray> array = XdmfArray::New();
+    array->setName(childKey(i));
+    arrays->insert(array);
+  }
+  assert(arrays->getArray(childKey(50)) == arrays->getArray(50));
+  arrays->getArray(50)->setName("Renamed");
+  assert(arrays->getArray("Renamed") == arrays->getArray(50));
+  assert(!arrays->getArray(childKey(50)));
+
+  return 0;
+}
@@ -81,6 +81,33 @@ int main(int, char **)
 
         //#read end
 
+        //#readconvert begin
+
+        if (!exampleArray->isInitialized())
+        {
+                exampleArray->read(XdmfArrayType::Float32());
+                //values are stored as Float32 regardless of the type on disk
+        }
+
+        //#readconvert end
+
+        //#readwindow begin
+
+        //Read every other value of the first 10 values from disk
+        exampleArray->read(0, 2, 5);
+        //exampleArray now contains values 0, 2, 4, 6 and 8 of the stored data
+
+        //#readwindow end
+
+        //#readbuffer begin
+
+        //Memory owned by the caller, sized to the values held by the controllers
+        std::vector<double> readBuffer(exampleArray->getHeavyDataController()->getSize());
+        exampleArray->read(&readBuffer[0], readBuffer.size());
+        //exampleArray now wraps readBuffer without copying it, holding the values as doubles
+
+        //#readbuffer end
+
         //#datapointersetup begin
 
         int initArray [10] = {0,1,2,3,4,5,6,7,8,9};
@@ -298,6 +325,12 @@ int main(int, char **)
 
         //#readController end
 
+        //#readControllerconvert begin
+
+        newArray->readController(XdmfArrayType::Int32());
+
+        //#readControllerconvert end
+
         //#getHeavyDataControllerconst begin
 
         shared_ptr<const XdmfHeavyDataController> exampleControllerConst = exampleArray->getHeavyDataController();
@@ -0,0 +1,71 @@
+#include "XdmfArray.hpp"
+#include "XdmfArrayAllocator.hpp"
+#include "XdmfArrayPoolAllocator.hpp"
+#include "XdmfArrayType.hpp"
+
+int main(int, char **)
+{
+        //#initialization begin
+
+        //Blocks are aligned to 64 bytes
+        shared_ptr<XdmfArrayAllocator> exampleAllocator = XdmfArrayAllocator::New();
+
+        //#initialization end
+
+        //#initializationpool begin
+
+        //Keep up to 64 MB of released blocks for reuse
+        shared_ptr<XdmfArrayPoolAllocator> examplePool = XdmfArrayPoolAllocator::New(67108864);
+
+        //#initializationpool end
+
+        //#allocate begin
+
+        void * exampleBlock = exampleAllocator->allocate(1024);
+        exampleAllocator->deallocate(exampleBlock, 1024);
+
+        //#allocate end
+
+        //#setAllocator begin
+
+        shared_ptr<XdmfArray> exampleArray = XdmfArray::New();
+        exampleArray->setAllocator(examplePool);
+        exampleArray->initialize(XdmfArrayType::Float64(), 1000);
+        //The 1000 values of exampleArray are stored in a block from examplePool
+
+        shared_ptr<XdmfArrayAllocator> exampleArrayAllocator = exampleArray->getAllocator();
+
+        //#setAllocator end
+
+        //#setDefaultAllocator begin
+
+        //Arrays without their own allocator, including those filled while reading, use examplePool
+        XdmfArray::setDefaultAllocator(examplePool);
+
+        shared_ptr<XdmfArrayAllocator> exampleDefaultAllocator = XdmfArray::getDefaultAllocator();
+
+        //#setDefaultAllocator end
+
+        //#getBytesLive begin
+
+        std::size_t exampleLive = examplePool->getBytesLive();
+        //exampleLive is 8000, the size of exampleArray's values
+        std::size_t examplePeak = examplePool->getPeakBytes();
+
+        //#getBytesLive end
+
+        //#getBytesCached begin
+
+        exampleArray->release();
+        std::size_t exampleCached = examplePool->getBytesCached();
+        //exampleCached is 8000, the next Float64 array of 1000 values reuses the block
+
+        examplePool->release();
+        //The cached block is given back to the system
+
+        //#getBytesCached end
+
+        XdmfArray::setDefaultAllocator(shared_ptr<XdmfArrayAllocator>());
+
+        return 0;
+}
@@ -13,6 +13,19 @@ int main(int, char **)
 
         //#initialization end
 
+        //#setLightDataCache begin
+
+        exampleReader->setLightDataCache(true);
+        //Whole files are now read from a cache kept next to them
+
+        //#setLightDataCache end
+
+        //#getLightDataCache begin
+
+        bool exampleCache = exampleReader->getLightDataCache();
+
+        //#getLightDataCache end
+
         //#parse begin
 
         std::string readLight = "your light data here";
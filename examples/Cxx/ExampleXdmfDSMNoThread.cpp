@@ -3,6 +3,7 @@
 #include <iostream>
 #include "XdmfArray.hpp"
 #include "XdmfArrayType.hpp"
+#include "XdmfBinaryControllerDSM.hpp"
 #include "XdmfHDF5WriterDSM.hpp"
 #include "XdmfHDF5ControllerDSM.hpp"
 #include "XdmfError.hpp"
@@ -80,6 +81,16 @@ int main(int argc, char *argv[])
         //#initwritergenerate end
 /*
 
+        //#initwritermanagergenerate begin
+
+        XdmfDSMManager * configuredManager = new XdmfDSMManager();
+        configuredManager->SetLocalBufferSizeMBytes(dsmSize/numServersCores);
+        configuredManager->SetDsmType(XDMF_DSM_TYPE_BLOCK_CYCLIC);
+        configuredManager->SetBlockLength(XDMF_DSM_DEFAULT_BLOCK_LENGTH);
+        shared_ptr<XdmfHDF5WriterDSM> exampleWriter = XdmfHDF5WriterDSM::New(newPath, comm, configuredManager, size-numServersCores, size-1);
+
+        //#initwritermanagergenerate end
+
         //#initcontrollergenerate begin
         shared_ptr<XdmfHDF5ControllerDSM> exampleController = XdmfHDF5ControllerDSM::New(
                 newPath,
@@ -182,6 +193,37 @@ int main(int argc, char *argv[])
                 writeController->setServerMode(true);
                 bool exampleControllerServerMode = writeController->getServerMode();
 
+                //#setRawModewriter begin
+
+                shared_ptr<XdmfHDF5WriterDSM> rawWriter = XdmfHDF5WriterDSM::New("dsmraw", exampleWriter->getServerBuffer());
+                // Arrays are placed in the DSM without building an HDF5 file
+                rawWriter->setRawMode(true);
+
+                //#setRawModewriter end
+
+                //#getRawModewriter begin
+
+                bool exampleRawMode = rawWriter->getRawMode();
+
+                //#getRawModewriter end
+
+                //#initrawcontrollerwithbuffer begin
+
+                shared_ptr<XdmfArray> rawArray = XdmfArray::New();
+                rawArray->insert(0, testArray, 0, testArray->getSize());
+                rawArray->accept(rawWriter);
+
+                shared_ptr<XdmfBinaryControllerDSM> rawController =
+                        shared_dynamic_cast<XdmfBinaryControllerDSM>(rawArray->getHeavyDataController(0));
+
+                // Other cores can find the array by name in the index of the raw file
+                shared_ptr<XdmfBinaryControllerDSM> namedController = XdmfBinaryControllerDSM::New(
+                        "dsmraw",
+                        rawController->getDataSetName(),
+                        exampleWriter->getServerBuffer());
+
+                //#initrawcontrollerwithbuffer end
+
                 //#declaremanager begin
 
                 XdmfDSMManager * exampleManager;
@@ -250,6 +292,19 @@ int main(int argc, char *argv[])
 
                 //#SetLocalBufferSizeMBytes end
 
+                //#GetMaxBufferSizeMBytes begin
+
+                unsigned int exampleMaxBufferSize = exampleManager->GetMaxBufferSizeMBytes();
+
+                //#GetMaxBufferSizeMBytes end
+
+                //#SetMaxBufferSizeMBytes begin
+
+                // Server buffers may grow up to twice their initial size
+                exampleManager->SetMaxBufferSizeMBytes(2 * exampleBufferSize);
+
+                //#SetMaxBufferSizeMBytes end
+
                 //#GetIsServer begin
 
                 bool exampleIsServer = exampleManager->GetIsServer();
@@ -276,7 +331,7 @@ int main(int argc, char *argv[])
 
                 //#GetBlockLength begin
 
-                long exampleBlockLength = exampleManager->GetBlockLength();
+                int64_t exampleBlockLength = exampleManager->GetBlockLength();
 
                 //#GetBlockLength end
 
@@ -286,6 +341,30 @@ int main(int argc, char *argv[])
 
                 //#SetBlockLength end
 
+                //#GetTransportType begin
+
+                int exampleTransport = exampleManager->GetTransportType();
+
+                //#GetTransportType end
+
+                //#SetTransportType begin
+
+                exampleManager->SetTransportType(XDMF_DSM_TRANSPORT_MESSAGE);
+
+                //#SetTransportType end
+
+                //#GetUseSharedMemory begin
+
+                bool exampleUseShared = exampleManager->GetUseSharedMemory();
+
+                //#GetUseSharedMemory end
+
+                //#SetUseSharedMemory begin
+
+                exampleManager->SetUseSharedMemory(exampleUseShared);
+
+                //#SetUseSharedMemory end
+
                 //#GetInterCommType begin
 
                 int exampleCommType = exampleManager->GetInterCommType();
@@ -392,6 +471,131 @@ int main(int argc, char *argv[])
 
                 //#SetDsmTypebuffer end
 
+                //#GetTransportTypebuffer begin
+
+                int exampleBufferTransport = exampleBuffer->GetTransportType();
+
+                //#GetTransportTypebuffer end
+
+                //#SetTransportTypebuffer begin
+
+                exampleBuffer->SetTransportType(exampleBufferTransport);
+
+                //#SetTransportTypebuffer end
+
+                //#GetUseSharedMemorybuffer begin
+
+                bool exampleBufferUseShared = exampleBuffer->GetUseSharedMemory();
+
+                //#GetUseSharedMemorybuffer end
+
+                //#SetUseSharedMemorybuffer begin
+
+                exampleBuffer->SetUseSharedMemory(exampleBufferUseShared);
+
+                //#SetUseSharedMemorybuffer end
+
+                //#GetLockServerId begin
+
+                int exampleLockServer = exampleBuffer->GetLockServerId(0);
+
+                //#GetLockServerId end
+
+                //#AcquireLock begin
+
+                // Any non negative number may be used to identify a lock
+                int exampleStep = exampleBuffer->AcquireLock(0, XDMF_DSM_LOCK_WRITE);
+
+                //#AcquireLock end
+
+                //#ReleaseLock begin
+
+                // Let cores waiting on the lock know that a new step was written
+                exampleBuffer->ReleaseLock(0, XDMF_DSM_LOCK_WRITE, true);
+
+                //#ReleaseLock end
+
+                //#WaitForStep begin
+
+                exampleStep = exampleBuffer->WaitForStep(0, exampleStep);
+
+                //#WaitForStep end
+
+                //#GetMaxLength begin
+
+                int64_t exampleMaxLength = exampleBuffer->GetMaxLength();
+
+                //#GetMaxLength end
+
+                //#SetMaxLength begin
+
+                exampleBuffer->SetMaxLength(exampleMaxLength);
+
+                //#SetMaxLength end
+
+                //#GetMaxMessageLength begin
+
+                int64_t exampleMaxMessageLength = exampleBuffer->GetMaxMessageLength();
+
+                //#GetMaxMessageLength end
+
+                //#SetMaxMessageLength begin
+
+                exampleBuffer->SetMaxMessageLength(exampleMaxMessageLength);
+
+                //#SetMaxMessageLength end
+
+                //#GetFileSlots begin
+
+                unsigned int exampleFileSlots = exampleBuffer->GetFileSlots();
+
+                //#GetFileSlots end
+
+                //#SetFileSlots begin
+
+                // Set on the servers before clients connect
+                exampleBuffer->SetFileSlots(exampleFileSlots);
+
+                //#SetFileSlots end
+
+                //#GetFileLocking begin
+
+                bool exampleFileLocking = exampleBuffer->GetFileLocking();
+
+                //#GetFileLocking end
+
+                //#SetFileLocking begin
+
+                exampleBuffer->SetFileLocking(exampleFileLocking);
+
+                //#SetFileLocking end
+
+                //#GetAllocationLength begin
+
+                int64_t exampleAllocationLength = exampleBuffer->GetAllocationLength();
+
+                //#GetAllocationLength end
+
+                //#SetAllocationLength begin
+
+                // Files reserve space in multiples of the allocation length
+                exampleBuffer->SetAllocationLength(exampleAllocationLength);
+
+                //#SetAllocationLength end
+
+                //#Grow begin
+
+                // Only block cyclic and block random DSMs can grow past their current length
+                int64_t exampleGrownLength = exampleBuffer->Grow(exampleBuffer->GetTotalLength());
+
+                //#Grow end
+
+                //#QueryLength begin
+
+                exampleGrownLength = exampleBuffer->QueryLength();
+
+                //#QueryLength end
+
                 //#GetIsServerbuffer begin
 
                 bool exampleBufferIsServer = exampleBuffer->GetIsServer();
@@ -406,13 +610,13 @@ int main(int argc, char *argv[])
 
                 //#GetStartAddress begin
 
-                int exampleBufferStart = exampleBuffer->GetStartAddress();
+                int64_t exampleBufferStart = exampleBuffer->GetStartAddress();
 
                 //#GetStartAddress end
 
                 //#GetEndAddress begin
 
-                int exampleBufferEnd = exampleBuffer->GetEndAddress();
+                int64_t exampleBufferEnd = exampleBuffer->GetEndAddress();
 
                 //#GetEndAddress end
 
@@ -438,19 +642,19 @@ int main(int argc, char *argv[])
 
                 //#GetLength begin
 
-                long exampleBufferLength = exampleBuffer->GetLength();
+                int64_t exampleBufferLength = exampleBuffer->GetLength();
 
                 //#GetLength end
 
                 //#GetTotalLength begin
 
-                long exampleTotalBufferLength = exampleBuffer->GetTotalLength();
+                int64_t exampleTotalBufferLength = exampleBuffer->GetTotalLength();
 
                 //#GetTotalLength end
 
                 //#GetBlockLengthbuffer begin
 
-                long exampleBufferBlockLength = exampleBuffer->GetBlockLength();
+                int64_t exampleBufferBlockLength = exampleBuffer->GetBlockLength();
 
                 //#GetBlockLengthbuffer end
 
@@ -460,6 +664,18 @@ int main(int argc, char *argv[])
 
                 //#SetBlockLengthbuffer end
 
+                //#GetRandomSeed begin
+
+                unsigned int exampleRandomSeed = exampleBuffer->GetRandomSeed();
+
+                //#GetRandomSeed end
+
+                //#SetRandomSeed begin
+
+                exampleBuffer->SetRandomSeed(exampleRandomSeed);
+
+                //#SetRandomSeed end
+
                 /*
                 //#ConfigureUniform begin
 
@@ -488,8 +704,8 @@ int main(int argc, char *argv[])
                         {
                                 std::cout << "IntraComm" << std::endl;
                         }                       
-                        int length;
-                        int address;
+                        int64_t length;
+                        int64_t address;
                         int opcode;
                         int source;
                         exampleBuffer->ReceiveCommandHeader(&opcode, &source, &length, &address, XDMF_DSM_INTRA_COMM, 0);
@@ -507,8 +723,8 @@ int main(int argc, char *argv[])
 
                 if (id == 1)
                 {
-                        int length;
-                        int address;
+                        int64_t length;
+                        int64_t address;
                         char * recvData;
                         exampleBuffer->ReceiveData(0, recvData, length, XDMF_DSM_PUT_DATA_TAG, address, XDMF_DSM_INTER_COMM);
                 }
@@ -568,8 +784,8 @@ int main(int argc, char *argv[])
 
                 //#GetAddressRangeForId begin
 
-                int core0StartAddress = 0;
-                int core0EndAddress = 0;
+                int64_t core0StartAddress = 0;
+                int64_t core0EndAddress = 0;
                 exampleBuffer->GetAddressRangeForId(0, &core0StartAddress, &core0EndAddress);
 
                 //#GetAddressRangeForId end
@@ -580,6 +796,15 @@ int main(int argc, char *argv[])
 
                 //#AddressToId end
 
+                //#AddressToLocation begin
+
+                int locationId = 0;
+                int64_t locationAddress = 0;
+                int64_t locationLength = 0;
+                exampleBuffer->AddressToLocation(500, &locationId, &locationAddress, &locationLength);
+
+                //#AddressToLocation end
+
                 //#PutGet begin
 
                 int dsmData = 5;
@@ -596,6 +821,23 @@ int main(int argc, char *argv[])
 
                 //#PutGet end
 
+                //#PutNonBlocking begin
+
+                int dsmValues[2] = {5, 6};
+                if (2*sizeof(int)/sizeof(char) + core0StartAddress < core0EndAddress)
+                {
+                        exampleBuffer->PutNonBlocking(0, sizeof(int)/sizeof(char), &dsmValues[0]);
+                        exampleBuffer->PutNonBlocking(sizeof(int)/sizeof(char), sizeof(int)/sizeof(char), &dsmValues[1]);
+                        exampleBuffer->WaitNonBlocking();
+                }
+                else
+                {
+                        // Error occured
+                        XdmfError::message(XdmfError::FATAL, "Address out of range");
+                }
+
+                //#PutNonBlocking end
+
                 //#GetComm begin
 
                 XdmfDSMCommMPI * exampleDSMComm = exampleBuffer->GetComm();
@@ -1,6 +1,8 @@
 #include "XdmfGridCollection.hpp"
 #include "XdmfGridCollectionType.hpp"
 #include "XdmfInformation.hpp"
+#include "XdmfTime.hpp"
+#include "XdmfUnstructuredGrid.hpp"
 
 int main(int, char **)
 {
@@ -40,5 +42,64 @@ int main(int, char **)
 
         //#insert end
 
+        //Add some steps to look up
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+                shared_ptr<XdmfUnstructuredGrid> exampleStep = XdmfUnstructuredGrid::New();
+                exampleStep->setTime(XdmfTime::New(i * 0.5));
+                exampleCollection->insert(exampleStep);
+        }
+
+        //#getNumberSteps begin
+
+        unsigned int exampleNumSteps = exampleCollection->getNumberSteps();
+
+        //#getNumberSteps end
+
+        //#getStep begin
+
+        //Steps are sorted by time
+        shared_ptr<XdmfGrid> exampleFirstStep = exampleCollection->getStep(0);
+
+        //#getStep end
+
+        //#getStepTime begin
+
+        double exampleStepTime = exampleCollection->getStepTime(0);
+
+        //#getStepTime end
+
+        //#getNearestStep begin
+
+        shared_ptr<XdmfGrid> exampleNearestStep =
+          exampleCollection->getStep(exampleCollection->getNearestStep(1.2));
+        //exampleNearestStep is the step at time 1.0
+
+        //#getNearestStep end
+
+        //#getLowerStep begin
+
+        //The steps between times 1.0 and 2.0
+        for (unsigned int i = exampleCollection->getLowerStep(1.0);
+             i < exampleCollection->getUpperStep(2.0);
+             ++i)
+        {
+                shared_ptr<XdmfGrid> exampleRangeStep = exampleCollection->getStep(i);
+        }
+
+        //#getLowerStep end
+
+        //#getUpperStep begin
+
+        //The steps right before and after time 1.2
+        unsigned int exampleAfter = exampleCollection->getUpperStep(1.2);
+        if (exampleAfter > 0 && exampleAfter < exampleCollection->getNumberSteps())
+        {
+                shared_ptr<XdmfGrid> exampleBefore = exampleCollection->getStep(exampleAfter - 1);
+                shared_ptr<XdmfGrid> exampleNext = exampleCollection->getStep(exampleAfter);
+        }
+
+        //#getUpperStep end
+
         return 0;
 }
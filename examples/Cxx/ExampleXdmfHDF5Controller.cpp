@@ -1,4 +1,7 @@
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
 #include "XdmfHDF5Controller.hpp"
+#include <vector>
 
 int main(int, char **)
 {
@@ -80,5 +83,38 @@ int main(int, char **)
 
         //#closeFiles end
 
+        //#readconvert begin
+
+        shared_ptr<XdmfArray> convertedArray = XdmfArray::New();
+        exampleController->read(convertedArray.get(), XdmfArrayType::Float32());
+        //hdf5 converts the values to Float32 as they are read
+
+        //#readconvert end
+
+        //#readwindow begin
+
+        shared_ptr<XdmfArray> windowArray = XdmfArray::New();
+        exampleController->read(windowArray.get(), 95, 1, 10);
+        //Only the 10 selected values are read, spanning two rows of the data set
+
+        //#readwindow end
+
+        //#readbuffer begin
+
+        std::vector<double> readBuffer(exampleController->getSize());
+        exampleController->read(&readBuffer[0], XdmfArrayType::Float64(), readBuffer.size());
+        //hdf5 reads and converts the values straight into readBuffer
+
+        //#readbuffer end
+
+        //#readArrays begin
+
+        std::vector<shared_ptr<XdmfArray> > packedArrays;
+        //Arrays written by an XdmfHDF5Writer with a pack size set
+        XdmfHDF5Controller::readArrays(packedArrays);
+        //Arrays that are next to each other in a pool are read with one hdf5 read
+
+        //#readArrays end
+
         return 0;
 }
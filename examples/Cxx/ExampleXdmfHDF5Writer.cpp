@@ -25,5 +25,70 @@ int main(int, char **)
 
         //#getChunkSize end
 
+        //#setDeduplicate begin
+
+        bool verifyDuplicates = false;
+        //arrays with equal hashes share a data set without comparing values
+
+        exampleWriter->setDeduplicate(true, verifyDuplicates);
+
+        //#setDeduplicate end
+
+        //#getDeduplicate begin
+
+        bool exampleDeduplicate = exampleWriter->getDeduplicate();
+
+        //#getDeduplicate end
+
+        //#getDuplicateHits begin
+
+        unsigned int exampleHits = exampleWriter->getDuplicateHits();
+
+        //#getDuplicateHits end
+
+        //#getDuplicateLookups begin
+
+        unsigned int exampleLookups = exampleWriter->getDuplicateLookups();
+
+        //#getDuplicateLookups end
+
+        //#setPackSize begin
+
+        unsigned int newPackSize = 10000;
+        //arrays of up to 10000 values share pool data sets
+
+        exampleWriter->setPackSize(newPackSize);
+
+        //#setPackSize end
+
+        //#getPackSize begin
+
+        unsigned int examplePackSize = exampleWriter->getPackSize();
+
+        //#getPackSize end
+
+        //#setVirtualDataSets begin
+
+        exampleWriter->setVirtualDataSets(true);
+        //arrays split across files are also written as one virtual data set
+
+        //#setVirtualDataSets end
+
+        //#getVirtualDataSets begin
+
+        bool exampleVirtualDataSets = exampleWriter->getVirtualDataSets();
+
+        //#getVirtualDataSets end
+
+        //#flush begin
+
+        exampleWriter->openFile();
+        //Write arrays here, the file stays open between them
+        exampleWriter->flush();
+        //Everything written so far is on disk, the file is still open
+        exampleWriter->closeFile();
+
+        //#flush end
+
         return 0;
 }
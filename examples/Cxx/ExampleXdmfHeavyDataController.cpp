@@ -1,6 +1,7 @@
 #include "XdmfHDF5Controller.hpp"
 #include "XdmfArray.hpp"
 #include "XdmfArrayType.hpp"
+#include <vector>
 
 int main(int, char **)
 {
@@ -86,6 +87,30 @@ int main(int, char **)
 
         //#read end
 
+        //#readconvert begin
+
+        shared_ptr<XdmfArray> convertedArray = XdmfArray::New();
+        exampleController->read(convertedArray.get(), XdmfArrayType::Int16());
+        //convertedArray now holds the data that exampleController holds as Int16 values.
+
+        //#readconvert end
+
+        //#readwindow begin
+
+        shared_ptr<XdmfArray> windowArray = XdmfArray::New();
+        exampleController->read(windowArray.get(), 100, 1, 10);
+        //windowArray now holds values 100 through 109 of the data that exampleController holds.
+
+        //#readwindow end
+
+        //#readbuffer begin
+
+        std::vector<float> readBuffer(exampleController->getSize());
+        exampleController->read(&readBuffer[0], XdmfArrayType::Float32(), readBuffer.size());
+        //readBuffer now holds the data that exampleController holds as Float32 values.
+
+        //#readbuffer end
+
         //#setArrayOffset begin
 
         unsigned int newArrayOffset = 5;//default is 0
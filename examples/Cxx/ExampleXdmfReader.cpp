@@ -8,5 +8,18 @@ int main(int, char **)
 
         //#initialization end
 
+        //#setDeferredSteps begin
+
+        exampleReader->setDeferredSteps(true);
+        //Steps of temporal collections are now read when requested from the collection
+
+        //#setDeferredSteps end
+
+        //#getDeferredSteps begin
+
+        bool exampleDeferred = exampleReader->getDeferredSteps();
+
+        //#getDeferredSteps end
+
         return 0;
 }
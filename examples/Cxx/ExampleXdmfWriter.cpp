@@ -1,4 +1,8 @@
 #include "XdmfDomain.hpp"
+#include "XdmfGridCollection.hpp"
+#include "XdmfGridCollectionType.hpp"
+#include "XdmfTime.hpp"
+#include "XdmfUnstructuredGrid.hpp"
 #include "XdmfAttribute.hpp"
 #include "XdmfAttributeType.hpp"
 #include "XdmfAttributeCenter.hpp"
@@ -38,6 +42,30 @@ int main(int, char **)
 
         //#getFilePath
 
+        //#setAppendTarget begin
+
+        shared_ptr<XdmfDomain> exampleSeriesDomain = XdmfDomain::New();
+        shared_ptr<XdmfGridCollection> exampleSeries = XdmfGridCollection::New();
+        exampleSeries->setType(XdmfGridCollectionType::Temporal());
+        exampleSeriesDomain->insert(exampleSeries);
+        exampleWriter->setAppendTarget(exampleSeries);
+        exampleSeriesDomain->accept(exampleWriter);
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+                shared_ptr<XdmfUnstructuredGrid> exampleStep = XdmfUnstructuredGrid::New();
+                exampleStep->setTime(XdmfTime::New(i));
+                //Only the new grid is written to the file
+                exampleStep->accept(exampleWriter);
+        }
+
+        //#setAppendTarget end
+
+        //#getAppendTarget begin
+
+        shared_ptr<XdmfItem> exampleTarget = exampleWriter->getAppendTarget();
+
+        //#getAppendTarget end
+
         //#getHeavyDataWriter begin
 
         shared_ptr<XdmfHeavyDataWriter> exampleHeavyWriter = exampleWriter->getHeavyDataWriter();
@@ -45,6 +45,43 @@ int main(int argc, char *argv[])
 
                 //#SetDsmFileName end
 
+                //#GetConnectMethod begin
+
+                int connectMethod = exampleWriter->getServerBuffer()->GetComm()->GetConnectMethod();
+
+                //#GetConnectMethod end
+
+                //#SetConnectMethod begin
+
+                // XDMF_DSM_CONNECT_SOCKET avoids writing the port to a shared file system
+                exampleWriter->getServerBuffer()->GetComm()->SetConnectMethod(connectMethod);
+
+                //#SetConnectMethod end
+
+                //#GetDsmServiceName begin
+
+                std::string serviceName = exampleWriter->getServerBuffer()->GetComm()->GetDsmServiceName();
+
+                //#GetDsmServiceName end
+
+                //#SetDsmServiceName begin
+
+                exampleWriter->getServerBuffer()->GetComm()->SetDsmServiceName(serviceName);
+
+                //#SetDsmServiceName end
+
+                //#GetConnectTimeout begin
+
+                double connectTimeout = exampleWriter->getServerBuffer()->GetComm()->GetConnectTimeout();
+
+                //#GetConnectTimeout end
+
+                //#SetConnectTimeout begin
+
+                exampleWriter->getServerBuffer()->GetComm()->SetConnectTimeout(connectTimeout);
+
+                //#SetConnectTimeout end
+
                 //#OpenPort begin
 
                 exampleWriter->getServerBuffer()->GetComm()->OpenPort();
@@ -31,6 +31,43 @@ if __name__ == "__main__":
 
                 #//SetDsmFileName end
 
+                #//GetConnectMethod begin
+
+                connectMethod = exampleWriter.getServerBuffer().GetComm().GetConnectMethod()
+
+                #//GetConnectMethod end
+
+                #//SetConnectMethod begin
+
+                # XDMF_DSM_CONNECT_SOCKET avoids writing the port to a shared file system
+                exampleWriter.getServerBuffer().GetComm().SetConnectMethod(connectMethod)
+
+                #//SetConnectMethod end
+
+                #//GetDsmServiceName begin
+
+                serviceName = exampleWriter.getServerBuffer().GetComm().GetDsmServiceName()
+
+                #//GetDsmServiceName end
+
+                #//SetDsmServiceName begin
+
+                exampleWriter.getServerBuffer().GetComm().SetDsmServiceName(serviceName)
+
+                #//SetDsmServiceName end
+
+                #//GetConnectTimeout begin
+
+                connectTimeout = exampleWriter.getServerBuffer().GetComm().GetConnectTimeout()
+
+                #//GetConnectTimeout end
+
+                #//SetConnectTimeout begin
+
+                exampleWriter.getServerBuffer().GetComm().SetConnectTimeout(connectTimeout)
+
+                #//SetConnectTimeout end
+
                 #//OpenPort begin
 
                 exampleWriter.getServerBuffer().GetComm().OpenPort()
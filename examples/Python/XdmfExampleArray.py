@@ -256,6 +256,28 @@ if __name__ == "__main__":
 
         #//readController end
 
+        #//readconvert begin
+
+        if not(exampleArray.isInitialized()):
+                exampleArray.read(XdmfArrayType.Float32())
+                #values are stored as Float32 regardless of the type on disk
+
+        #//readconvert end
+
+        #//readControllerconvert begin
+
+        newArray.readController(XdmfArrayType.Int32())
+
+        #//readControllerconvert end
+
+        #//readwindow begin
+
+        #Read every other value of the first 10 values from disk
+        exampleArray.read(0, 2, 5)
+        #exampleArray now contains values 0, 2, 4, 6 and 8 of the stored data
+
+        #//readwindow end
+
         #//release begin
 
         exampleArray.release()
@@ -8,6 +8,19 @@ if __name__ == "__main__":
 
         #//initialization end
 
+        #//setLightDataCache begin
+
+        exampleReader.setLightDataCache(True)
+        #Whole files are now read from a cache kept next to them
+
+        #//setLightDataCache end
+
+        #//getLightDataCache begin
+
+        exampleCache = exampleReader.getLightDataCache()
+
+        #//getLightDataCache end
+
         #//parse begin
 
         readLight = "<dataitem>1 1 1 1 1 1 3 5 7 4 2</dataitem>"
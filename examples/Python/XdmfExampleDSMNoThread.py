@@ -59,6 +59,18 @@ if __name__ == "__main__":
         #//initwritergenerate end
 
         '''
+        #//initwritermanagergenerate begin
+
+        configuredManager = XdmfDSMManager()
+        configuredManager.SetLocalBufferSizeMBytes(dsmSize/numServersCores)
+        configuredManager.SetDsmType(XDMF_DSM_TYPE_BLOCK_CYCLIC)
+        configuredManager.SetBlockLength(XDMF_DSM_DEFAULT_BLOCK_LENGTH)
+        # The writer deletes the manager
+        configuredManager.thisown = 0
+        exampleWriter = XdmfHDF5WriterDSM.New(newPath, comm, configuredManager, size-numServersCores, size-1)
+
+        #//initwritermanagergenerate end
+
         #//initcontrollergenerate begin
 
         exampleController = XdmfHDF5ControllerDSM.New(
@@ -163,6 +175,36 @@ if __name__ == "__main__":
                 writeController.setServerMode(True)
                 exampleControllerServerMode = writeController.getServerMode()
 
+                #//setRawModewriter begin
+
+                rawWriter = XdmfHDF5WriterDSM.New("dsmraw", exampleWriter.getServerBuffer())
+                # Arrays are placed in the DSM without building an HDF5 file
+                rawWriter.setRawMode(True)
+
+                #//setRawModewriter end
+
+                #//getRawModewriter begin
+
+                exampleRawMode = rawWriter.getRawMode()
+
+                #//getRawModewriter end
+
+                #//initrawcontrollerwithbuffer begin
+
+                rawArray = XdmfArray.New()
+                rawArray.insert(0, testArray, 0, testArray.getSize())
+                rawArray.accept(rawWriter)
+
+                rawController = rawArray.getHeavyDataController(0)
+
+                # Other cores can find the array by name in the index of the raw file
+                namedController = XdmfBinaryControllerDSM.New(
+                        "dsmraw",
+                        "Data0",
+                        exampleWriter.getServerBuffer())
+
+                #//initrawcontrollerwithbuffer end
+
                 #//getServerManagerwriter begin
 
                 exampleManager = exampleWriter.getServerManager()
@@ -225,6 +267,19 @@ if __name__ == "__main__":
 
                 #//SetLocalBufferSizeMBytes end
 
+                #//GetMaxBufferSizeMBytes begin
+
+                exampleMaxBufferSize = exampleManager.GetMaxBufferSizeMBytes()
+
+                #//GetMaxBufferSizeMBytes end
+
+                #//SetMaxBufferSizeMBytes begin
+
+                # Server buffers may grow up to twice their initial size
+                exampleManager.SetMaxBufferSizeMBytes(2 * exampleBufferSize)
+
+                #//SetMaxBufferSizeMBytes end
+
                 #//GetIsServer begin
 
                 exampleIsServer = exampleManager.GetIsServer()
@@ -261,6 +316,30 @@ if __name__ == "__main__":
 
                 #//SetBlockLength end
 
+                #//GetTransportType begin
+
+                exampleTransport = exampleManager.GetTransportType()
+
+                #//GetTransportType end
+
+                #//SetTransportType begin
+
+                exampleManager.SetTransportType(XDMF_DSM_TRANSPORT_MESSAGE)
+
+                #//SetTransportType end
+
+                #//GetUseSharedMemory begin
+
+                exampleUseShared = exampleManager.GetUseSharedMemory()
+
+                #//GetUseSharedMemory end
+
+                #//SetUseSharedMemory begin
+
+                exampleManager.SetUseSharedMemory(exampleUseShared)
+
+                #//SetUseSharedMemory end
+
                 #//GetInterCommType begin
 
                 exampleCommType = exampleManager.GetInterCommType()
@@ -361,6 +440,131 @@ if __name__ == "__main__":
 
                 #//SetDsmTypebuffer end
 
+                #//GetTransportTypebuffer begin
+
+                exampleBufferTransport = exampleBuffer.GetTransportType()
+
+                #//GetTransportTypebuffer end
+
+                #//SetTransportTypebuffer begin
+
+                exampleBuffer.SetTransportType(exampleBufferTransport)
+
+                #//SetTransportTypebuffer end
+
+                #//GetUseSharedMemorybuffer begin
+
+                exampleBufferUseShared = exampleBuffer.GetUseSharedMemory()
+
+                #//GetUseSharedMemorybuffer end
+
+                #//SetUseSharedMemorybuffer begin
+
+                exampleBuffer.SetUseSharedMemory(exampleBufferUseShared)
+
+                #//SetUseSharedMemorybuffer end
+
+                #//GetLockServerId begin
+
+                exampleLockServer = exampleBuffer.GetLockServerId(0)
+
+                #//GetLockServerId end
+
+                #//AcquireLock begin
+
+                # Any non negative number may be used to identify a lock
+                exampleStep = exampleBuffer.AcquireLock(0, XDMF_DSM_LOCK_WRITE)
+
+                #//AcquireLock end
+
+                #//ReleaseLock begin
+
+                # Let cores waiting on the lock know that a new step was written
+                exampleBuffer.ReleaseLock(0, XDMF_DSM_LOCK_WRITE, True)
+
+                #//ReleaseLock end
+
+                #//WaitForStep begin
+
+                exampleStep = exampleBuffer.WaitForStep(0, exampleStep)
+
+                #//WaitForStep end
+
+                #//GetMaxLength begin
+
+                exampleMaxLength = exampleBuffer.GetMaxLength()
+
+                #//GetMaxLength end
+
+                #//SetMaxLength begin
+
+                exampleBuffer.SetMaxLength(exampleMaxLength)
+
+                #//SetMaxLength end
+
+                #//GetMaxMessageLength begin
+
+                exampleMaxMessageLength = exampleBuffer.GetMaxMessageLength()
+
+                #//GetMaxMessageLength end
+
+                #//SetMaxMessageLength begin
+
+                exampleBuffer.SetMaxMessageLength(exampleMaxMessageLength)
+
+                #//SetMaxMessageLength end
+
+                #//GetFileSlots begin
+
+                exampleFileSlots = exampleBuffer.GetFileSlots()
+
+                #//GetFileSlots end
+
+                #//SetFileSlots begin
+
+                # Set on the servers before clients connect
+                exampleBuffer.SetFileSlots(exampleFileSlots)
+
+                #//SetFileSlots end
+
+                #//GetFileLocking begin
+
+                exampleFileLocking = exampleBuffer.GetFileLocking()
+
+                #//GetFileLocking end
+
+                #//SetFileLocking begin
+
+                exampleBuffer.SetFileLocking(exampleFileLocking)
+
+                #//SetFileLocking end
+
+                #//GetAllocationLength begin
+
+                exampleAllocationLength = exampleBuffer.GetAllocationLength()
+
+                #//GetAllocationLength end
+
+                #//SetAllocationLength begin
+
+                # Files reserve space in multiples of the allocation length
+                exampleBuffer.SetAllocationLength(exampleAllocationLength)
+
+                #//SetAllocationLength end
+
+                #//Grow begin
+
+                # Only block cyclic and block random DSMs can grow past their current length
+                exampleGrownLength = exampleBuffer.Grow(exampleBuffer.GetTotalLength())
+
+                #//Grow end
+
+                #//QueryLength begin
+
+                exampleGrownLength = exampleBuffer.QueryLength()
+
+                #//QueryLength end
+
                 #//GetIsServerbuffer begin
 
                 exampleBufferIsServer = exampleBuffer.GetIsServer()
@@ -421,6 +625,18 @@ if __name__ == "__main__":
 
                 #//SetBlockLengthbuffer end
 
+                #//GetRandomSeed begin
+
+                exampleRandomSeed = exampleBuffer.GetRandomSeed()
+
+                #//GetRandomSeed end
+
+                #//SetRandomSeed begin
+
+                exampleBuffer.SetRandomSeed(exampleRandomSeed)
+
+                #//SetRandomSeed end
+
                 '''
                 #//ConfigureUniform begin
 
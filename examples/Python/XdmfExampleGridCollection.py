@@ -34,3 +34,53 @@ if __name__ == "__main__":
         exampleCollection.insert(exampleInformation)
 
         #//insert end
+
+        #Add some steps to look up
+        for i in range(10):
+                exampleStep = XdmfUnstructuredGrid.New()
+                exampleStep.setTime(XdmfTime.New(i * 0.5))
+                exampleCollection.insert(exampleStep)
+
+        #//getNumberSteps begin
+
+        exampleNumSteps = exampleCollection.getNumberSteps()
+
+        #//getNumberSteps end
+
+        #//getStep begin
+
+        #Steps are sorted by time
+        exampleFirstStep = exampleCollection.getStep(0)
+
+        #//getStep end
+
+        #//getStepTime begin
+
+        exampleStepTime = exampleCollection.getStepTime(0)
+
+        #//getStepTime end
+
+        #//getNearestStep begin
+
+        exampleNearestStep = exampleCollection.getStep(exampleCollection.getNearestStep(1.2))
+        #exampleNearestStep is the step at time 1.0
+
+        #//getNearestStep end
+
+        #//getLowerStep begin
+
+        #The steps between times 1.0 and 2.0
+        for i in range(exampleCollection.getLowerStep(1.0), exampleCollection.getUpperStep(2.0)):
+                exampleRangeStep = exampleCollection.getStep(i)
+
+        #//getLowerStep end
+
+        #//getUpperStep begin
+
+        #The steps right before and after time 1.2
+        exampleAfter = exampleCollection.getUpperStep(1.2)
+        if exampleAfter > 0 and exampleAfter < exampleCollection.getNumberSteps():
+                exampleBefore = exampleCollection.getStep(exampleAfter - 1)
+                exampleNext = exampleCollection.getStep(exampleAfter)
+
+        #//getUpperStep end
@@ -79,3 +79,28 @@ if __name__ == "__main__":
 
         #//closeFiles end
 
+        #//readconvert begin
+
+        convertedArray = XdmfArray.New()
+        exampleController.read(convertedArray, XdmfArrayType.Float32())
+        #hdf5 converts the values to Float32 as they are read
+
+        #//readconvert end
+
+        #//readwindow begin
+
+        windowArray = XdmfArray.New()
+        exampleController.read(windowArray, 95, 1, 10)
+        #Only the 10 selected values are read, spanning two rows of the data set
+
+        #//readwindow end
+
+        #//readArrays begin
+
+        packedArrays = ArrayVector()
+        #Arrays written by an XdmfHDF5Writer with a pack size set
+        XdmfHDF5Controller.readArrays(packedArrays)
+        #Arrays that are next to each other in a pool are read with one hdf5 read
+
+        #//readArrays end
+
@@ -23,3 +23,68 @@ if __name__ == "__main__":
         exampleChunk = exampleWriter.getChunkSize()
 
         #//getChunkSize end
+
+        #//setDeduplicate begin
+
+        verifyDuplicates = False
+        #arrays with equal hashes share a data set without comparing values
+
+        exampleWriter.setDeduplicate(True, verifyDuplicates)
+
+        #//setDeduplicate end
+
+        #//getDeduplicate begin
+
+        exampleDeduplicate = exampleWriter.getDeduplicate()
+
+        #//getDeduplicate end
+
+        #//getDuplicateHits begin
+
+        exampleHits = exampleWriter.getDuplicateHits()
+
+        #//getDuplicateHits end
+
+        #//getDuplicateLookups begin
+
+        exampleLookups = exampleWriter.getDuplicateLookups()
+
+        #//getDuplicateLookups end
+
+        #//setPackSize begin
+
+        newPackSize = 10000
+        #arrays of up to 10000 values share pool data sets
+
+        exampleWriter.setPackSize(newPackSize)
+
+        #//setPackSize end
+
+        #//getPackSize begin
+
+        examplePackSize = exampleWriter.getPackSize()
+
+        #//getPackSize end
+
+        #//setVirtualDataSets begin
+
+        exampleWriter.setVirtualDataSets(True)
+        #arrays split across files are also written as one virtual data set
+
+        #//setVirtualDataSets end
+
+        #//getVirtualDataSets begin
+
+        exampleVirtualDataSets = exampleWriter.getVirtualDataSets()
+
+        #//getVirtualDataSets end
+
+        #//flush begin
+
+        exampleWriter.openFile()
+        #Write arrays here, the file stays open between them
+        exampleWriter.flush()
+        #Everything written so far is on disk, the file is still open
+        exampleWriter.closeFile()
+
+        #//flush end
@@ -83,6 +83,22 @@ if __name__ == "__main__":
 
         #//read end
 
+        #//readconvert begin
+
+        convertedArray = XdmfArray.New()
+        exampleController.read(convertedArray, XdmfArrayType.Int16())
+        #convertedArray now holds the data that exampleController holds as Int16 values.
+
+        #//readconvert end
+
+        #//readwindow begin
+
+        windowArray = XdmfArray.New()
+        exampleController.read(windowArray, 100, 1, 10)
+        #windowArray now holds values 100 through 109 of the data that exampleController holds.
+
+        #//readwindow end
+
         #//setArrayOffset begin
 
         newArrayOffset = 5#default is 0
@@ -7,3 +7,16 @@ if __name__ == "__main__":
         exampleReader = XdmfReader.New()
 
         #//initialization end
+
+        #//setDeferredSteps begin
+
+        exampleReader.setDeferredSteps(True)
+        #Steps of temporal collections are now read when requested from the collection
+
+        #//setDeferredSteps end
+
+        #//getDeferredSteps begin
+
+        exampleDeferred = exampleReader.getDeferredSteps()
+
+        #//getDeferredSteps end
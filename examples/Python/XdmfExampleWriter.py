@@ -24,6 +24,28 @@ if __name__ == "__main__":
 
         #//getFilePath end
 
+        #//setAppendTarget begin
+
+        exampleSeriesDomain = XdmfDomain.New()
+        exampleSeries = XdmfGridCollection.New()
+        exampleSeries.setType(XdmfGridCollectionType.Temporal())
+        exampleSeriesDomain.insert(exampleSeries)
+        exampleWriter.setAppendTarget(exampleSeries)
+        exampleSeriesDomain.accept(exampleWriter)
+        for i in range(10):
+                exampleStep = XdmfUnstructuredGrid.New()
+                exampleStep.setTime(XdmfTime.New(i))
+                #Only the new grid is written to the file
+                exampleStep.accept(exampleWriter)
+
+        #//setAppendTarget end
+
+        #//getAppendTarget begin
+
+        exampleTarget = exampleWriter.getAppendTarget()
+
+        #//getAppendTarget end
+
         #//getHeavyDataWriter begin
 
         exampleHeavyWriter = exampleWriter.getHeavyDataWriter()
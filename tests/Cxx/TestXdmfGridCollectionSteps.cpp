@@ -0,0 +1,205 @@
+#include "XdmfAttribute.hpp"
+#include "XdmfDomain.hpp"
+#include "XdmfGeometry.hpp"
+#include "XdmfGeometryType.hpp"
+#include "XdmfGridCollection.hpp"
+#include "XdmfGridCollectionType.hpp"
+#include "XdmfReader.hpp"
+#include "XdmfTime.hpp"
+#include "XdmfUnstructuredGrid.hpp"
+#include "XdmfWriter.hpp"
+#include <boost/weak_ptr.hpp>
+#include <cassert>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#include "XdmfTestCompareFiles.hpp"
+
+// Looks up the steps of a temporal collection by time, in memory and
+// read from a file with the steps read only when requested. Pass the
+// number of steps to time a larger run, for example 50000.
+
+static double
+stepTime(unsigned int step)
+{
+  // Two steps share each time
+  return (step / 2) * 0.5;
+}
+
+static shared_ptr<XdmfUnstructuredGrid>
+createStep(unsigned int step,
+           const shared_ptr<XdmfGeometry> geometry)
+{
+  shared_ptr<XdmfUnstructuredGrid> grid = XdmfUnstructuredGrid::New();
+  grid->setTime(XdmfTime::New(stepTime(step)));
+  // Written as an xi:include of the first step
+  grid->setGeometry(geometry);
+  shared_ptr<XdmfAttribute> attribute = XdmfAttribute::New();
+  attribute->setName("Step");
+  attribute->resize<unsigned int>(200, step);
+  grid->insert(attribute);
+  return grid;
+}
+
+int main(int argc, char * argv[])
+{
+  unsigned int numSteps = 100;
+  if(argc > 1) {
+    numSteps = std::atoi(argv[1]);
+  }
+
+  shared_ptr<XdmfGeometry> geometry = XdmfGeometry::New();
+  geometry->setType(XdmfGeometryType::XYZ());
+  geometry->resize<double>(300, 1.0);
+
+  // Steps inserted out of order of time are indexed in order
+  shared_ptr<XdmfGridCollection> collection = XdmfGridCollection::New();
+  collection->setType(XdmfGridCollectionType::Temporal());
+  for(unsigned int i = 0; i < numSteps; ++i) {
+    const unsigned int step = (i % 2 == 0) ? i : numSteps - i;
+    collection->insert(createStep(step, geometry));
+  }
+  assert(collection->getNumberSteps() == numSteps);
+  for(unsigned int i = 0; i + 1 < numSteps; ++i) {
+    assert(collection->getStepTime(i) <= collection->getStepTime(i + 1));
+  }
+
+  // Lookups in memory
+  assert(collection->getLowerStep(1.0) == 4);
+  assert(collection->getUpperStep(1.0) == 6);
+  assert(collection->getLowerStep(1.2) == 6);
+  assert(collection->getUpperStep(1.2) == 6);
+  assert(collection->getNearestStep(1.2) == 4);
+  assert(collection->getNearestStep(1.3) == 6);
+  assert(collection->getNearestStep(-1.0) == 0);
+  assert(collection->getNearestStep(1e9) ==
+         collection->getLowerStep(stepTime(numSteps - 1)));
+  assert(collection->getLowerStep(1e9) == numSteps);
+  assert(collection->getStep(4)->getTime()->getValue() == 1.0);
+  assert(!collection->getStep(numSteps));
+
+  // The index follows grids inserted later
+  shared_ptr<XdmfUnstructuredGrid> early = createStep(0, geometry);
+  early->getTime()->setValue(-1.0);
+  collection->insert(early);
+  assert(collection->getNumberSteps() == numSteps + 1);
+  assert(collection->getStep(0) == early);
+  collection->removeUnstructuredGrid(numSteps);
+  assert(collection->getNumberSteps() == numSteps);
+
+  // The index follows times changed in place
+  shared_ptr<XdmfGrid> first = collection->getStep(0);
+  first->getTime()->setValue(1e9);
+  assert(collection->getStep(numSteps - 1) == first);
+  first->setTime(XdmfTime::New(-1.0));
+  assert(collection->getStep(0) == first);
+  first->setTime(XdmfTime::New(stepTime(0)));
+  assert(collection->getStepTime(0) == stepTime(0));
+
+  // Grids added without a time are found once they get one
+  shared_ptr<XdmfUnstructuredGrid> untimed = XdmfUnstructuredGrid::New();
+  collection->insert(untimed);
+  assert(collection->getNumberSteps() == numSteps);
+  untimed->setTime(XdmfTime::New(-2.0));
+  assert(collection->getNumberSteps() == numSteps + 1);
+  assert(collection->getStep(0) == untimed);
+
+  // Removing a grid and inserting another keeps the number of grids
+  collection->removeUnstructuredGrid(numSteps);
+  shared_ptr<XdmfUnstructuredGrid> replacement = createStep(0, geometry);
+  replacement->getTime()->setValue(-3.0);
+  collection->insert(replacement);
+  assert(collection->getNumberSteps() == numSteps + 1);
+  assert(collection->getStep(0) == replacement);
+  collection->removeUnstructuredGrid(numSteps);
+  assert(collection->getNumberSteps() == numSteps);
+  assert(collection->getStepTime(0) == stepTime(0));
+
+  shared_ptr<XdmfDomain> domain = XdmfDomain::New();
+  domain->insert(collection);
+  shared_ptr<XdmfWriter> writer =
+    XdmfWriter::New("TestXdmfGridCollectionSteps1.xmf");
+  domain->accept(writer);
+
+  // Steps are read only when requested
+  shared_ptr<XdmfReader> reader = XdmfReader::New();
+  assert(!reader->getDeferredSteps());
+  reader->setDeferredSteps(true);
+  assert(reader->getDeferredSteps());
+  clock_t start = clock();
+  shared_ptr<XdmfDomain> readDomain = shared_dynamic_cast<XdmfDomain>(
+    reader->read("./TestXdmfGridCollectionSteps1.xmf"));
+  shared_ptr<XdmfGridCollection> readCollection =
+    readDomain->getGridCollection(0);
+  const unsigned int nearest = readCollection->getNearestStep(1.3);
+  shared_ptr<XdmfGrid> step = readCollection->getStep(nearest);
+  const double deferredTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  assert(readCollection->getNumberSteps() == numSteps);
+  assert(readCollection->getNumberUnstructuredGrids() == 1);
+  assert(nearest == 6);
+  assert(step->getTime()->getValue() == 1.5);
+  assert(readCollection->getStep(nearest) == step);
+  shared_ptr<XdmfAttribute> attribute = step->getAttribute("Step");
+  attribute->read();
+  assert(attribute->getValue<unsigned int>(0) == 6 ||
+         attribute->getValue<unsigned int>(0) == 7);
+  attribute->release();
+
+  // Steps read later still share what they include
+  shared_ptr<XdmfGrid> lastStep = readCollection->getStep(numSteps - 1);
+  assert(readCollection->getNumberUnstructuredGrids() == 2);
+  assert(lastStep->getGeometry() == step->getGeometry());
+  assert(lastStep->getTime()->getValue() == stepTime(numSteps - 1));
+  shared_ptr<XdmfGeometry> lastGeometry =
+    shared_dynamic_cast<XdmfUnstructuredGrid>(lastStep)->getGeometry();
+  lastGeometry->read();
+  assert(lastGeometry->getSize() == 300);
+  lastGeometry->release();
+
+  // Reading every step up front gives the same index
+  shared_ptr<XdmfReader> fullReader = XdmfReader::New();
+  start = clock();
+  shared_ptr<XdmfDomain> fullDomain = shared_dynamic_cast<XdmfDomain>(
+    fullReader->read("./TestXdmfGridCollectionSteps1.xmf"));
+  const double fullTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+  shared_ptr<XdmfGridCollection> fullCollection =
+    fullDomain->getGridCollection(0);
+  assert(fullCollection->getNumberUnstructuredGrids() == numSteps);
+  assert(fullCollection->getNumberSteps() == numSteps);
+  for(unsigned int i = 0; i < numSteps; i += numSteps / 10 + 1) {
+    assert(fullCollection->getStepTime(i) == readCollection->getStepTime(i));
+  }
+
+  std::cout << numSteps << " steps, one step read in " << deferredTime
+            << " s with the steps deferred, all steps read in " << fullTime
+            << " s" << std::endl;
+
+  // Writing a collection reads the rest of its steps
+  shared_ptr<XdmfWriter> fullWriter =
+    XdmfWriter::New("TestXdmfGridCollectionSteps2.xmf");
+  fullWriter->setMode(XdmfWriter::DistributedHeavyData);
+  fullDomain->accept(fullWriter);
+  shared_ptr<XdmfWriter> deferredWriter =
+    XdmfWriter::New("TestXdmfGridCollectionSteps3.xmf");
+  deferredWriter->setMode(XdmfWriter::DistributedHeavyData);
+  readDomain->accept(deferredWriter);
+  assert(readCollection->getNumberUnstructuredGrids() == numSteps);
+  assert(XdmfTestCompareFiles::compareFiles("TestXdmfGridCollectionSteps2.xmf",
+                                            "TestXdmfGridCollectionSteps3.xmf"));
+
+  // Steps read later do not keep the tree read alive
+  boost::weak_ptr<XdmfDomain> weakDomain;
+  {
+    shared_ptr<XdmfReader> stepReader = XdmfReader::New();
+    stepReader->setDeferredSteps(true);
+    shared_ptr<XdmfDomain> stepDomain = shared_dynamic_cast<XdmfDomain>(
+      stepReader->read("./TestXdmfGridCollectionSteps1.xmf"));
+    assert(stepDomain->getGridCollection(0)->getStep(1));
+    weakDomain = stepDomain;
+  }
+  assert(weakDomain.expired());
+
+  return 0;
+}
@@ -0,0 +1,136 @@
+#include "XdmfArray.hpp"
+#include "XdmfArrayType.hpp"
+#include "XdmfAttribute.hpp"
+#include "XdmfDomain.hpp"
+#include "XdmfHDF5Controller.hpp"
+#include "XdmfHDF5Writer.hpp"
+#include "XdmfReader.hpp"
+#include "XdmfUnstructuredGrid.hpp"
+#include "XdmfWriter.hpp"
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+int main(int, char **)
+{
+  const unsigned int numberAttributes = 200;
+
+  shared_ptr<XdmfDomain> domain = XdmfDomain::New();
+  shared_ptr<XdmfUnstructuredGrid> grid = XdmfUnstructuredGrid::New();
+  domain->insert(grid);
+
+  std::vector<unsigned int> dimensions;
+  dimensions.push_back(10);
+  dimensions.push_back(10);
+  for(unsigned int i = 0; i < numberAttributes; ++i) {
+    shared_ptr<XdmfAttribute> attribute = XdmfAttribute::New();
+    attribute->initialize<double>(dimensions);
+    for(unsigned int j = 0; j < attribute->getSize(); ++j) {
+      attribute->insert<double>(j, i * 1000 + j);
+    }
+    grid->insert(attribute);
+  }
+
+  // Too large to be packed, it gets a data set of its own
+  shared_ptr<XdmfAttribute> largeAttribute = XdmfAttribute::New();
+  largeAttribute->initialize<int>(5000);
+  for(unsigned int j = 0; j < largeAttribute->getSize(); ++j) {
+    largeAttribute->insert<int>(j, j);
+  }
+  grid->insert(largeAttribute);
+
+  shared_ptr<XdmfHDF5Writer> hdf5Writer =
+    XdmfHDF5Writer::New("TestXdmfHDF5Packing.h5", true);
+  assert(hdf5Writer->getPackSize() == 0);
+  hdf5Writer->setPackSize(1000);
+  assert(hdf5Writer->getPackSize() == 1000);
+  shared_ptr<XdmfWriter> writer =
+    XdmfWriter::New("TestXdmfHDF5Packing.xmf", hdf5Writer);
+  writer->setLightDataLimit(10);
+  domain->accept(writer);
+
+  // The small arrays follow each other in one pool
+  std::set<std::string> dataSets;
+  for(unsigned int i = 0; i < numberAttributes; ++i) {
+    shared_ptr<XdmfHDF5Controller> controller =
+      shared_dynamic_cast<XdmfHDF5Controller>(grid->getAttribute(i)->getHeavyDataController(0));
+    assert(controller);
+    assert(controller->getStart().size() == 1);
+    assert(controller->getStart()[0] == i * 100);
+    assert(controller->getDimensions() == dimensions);
+    dataSets.insert(controller->getDataSetPath());
+  }
+  std::cout << dataSets.size() << " ?= " << 1 << std::endl;
+  assert(dataSets.size() == 1);
+  shared_ptr<XdmfHDF5Controller> largeController =
+    shared_dynamic_cast<XdmfHDF5Controller>(largeAttribute->getHeavyDataController(0));
+  assert(dataSets.count(largeController->getDataSetPath()) == 0);
+  assert(largeController->getStart()[0] == 0);
+
+  // Packed arrays are described as hyperslabs of their pool
+  std::ifstream lightData("TestXdmfHDF5Packing.xmf");
+  std::stringstream lightDataStream;
+  lightDataStream << lightData.rdbuf();
+  const std::string lightDataText = lightDataStream.str();
+  assert(lightDataText.find("ItemType=\"HyperSlab\"") != std::string::npos);
+  assert(lightDataText.find("Seek") == std::string::npos);
+
+  // Read back through the light data
+  shared_ptr<XdmfReader> reader = XdmfReader::New();
+  shared_ptr<XdmfDomain> readDomain =
+    shared_dynamic_cast<XdmfDomain>(reader->read("./TestXdmfHDF5Packing.xmf"));
+  shared_ptr<XdmfUnstructuredGrid> readGrid =
+    readDomain->getUnstructuredGrid(0);
+  assert(readGrid->getNumberAttributes() == numberAttributes + 1);
+
+  for(unsigned int i = 0; i < numberAttributes; i += 37) {
+    shared_ptr<XdmfAttribute> attribute = readGrid->getAttribute(i);
+    attribute->read();
+    assert(attribute->getDimensions() == dimensions);
+    assert(attribute->getValue<double>(0) == i * 1000);
+    assert(attribute->getValue<double>(99) == i * 1000 + 99);
+  }
+
+  shared_ptr<XdmfAttribute> readLarge = readGrid->getAttribute(numberAttributes);
+  readLarge->read();
+  assert(readLarge->getSize() == 5000);
+  assert(readLarge->getValue<int>(4999) == 4999);
+
+  // A window of a packed array comes from its own run of values
+  shared_ptr<XdmfArray> window = XdmfArray::New();
+  readGrid->getAttribute(5)->getHeavyDataController(0)->read(window.get(), 10, 2, 5);
+  assert(window->getSize() == 5);
+  assert(window->getValue<double>(0) == 5010);
+  assert(window->getValue<double>(4) == 5018);
+
+  // Neighbouring arrays are read together
+  std::vector<shared_ptr<XdmfArray> > arrays;
+  for(unsigned int i = 0; i < readGrid->getNumberAttributes(); ++i) {
+    readGrid->getAttribute(i)->release();
+    arrays.push_back(readGrid->getAttribute(i));
+  }
+  XdmfHDF5Controller::readArrays(arrays);
+  for(unsigned int i = 0; i < numberAttributes; ++i) {
+    assert(arrays[i]->getDimensions() == dimensions);
+    for(unsigned int j = 0; j < arrays[i]->getSize(); ++j) {
+      assert(arrays[i]->getValue<double>(j) == i * 1000 + j);
+    }
+  }
+  assert(arrays[numberAttributes]->getValue<int>(1234) == 1234);
+
+  // Without an open file the pool is written when the visit ends
+  shared_ptr<XdmfArray> single = XdmfArray::New();
+  for(unsigned int j = 0; j < 10; ++j) {
+    single->pushBack<float>(j * 0.5f);
+  }
+  hdf5Writer->setReleaseData(true);
+  single->accept(hdf5Writer);
+  assert(!single->isInitialized());
+  single->read();
+  assert(single->getSize() == 10);
+  assert(single->getValue<float>(9) == 4.5f);
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include "XdmfAttribute.hpp"
+#include "XdmfDomain.hpp"
+#include "XdmfHDF5Controller.hpp"
+#include "XdmfHDF5Writer.hpp"
+#include "XdmfReader.hpp"
+#include "XdmfUnstructuredGrid.hpp"
+#include "XdmfWriter.hpp"
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+
+int main(int, char **)
+{
+  const char * files[] = {"TestXdmfHDF5VirtualDataSet.h5",
+                          "TestXdmfHDF5VirtualDataSet1.h5",
+                          "TestXdmfHDF5VirtualDataSet2.h5",
+                          "TestXdmfHDF5VirtualDataSet3.h5"};
+  for(unsigned int i = 0; i < 4; ++i) {
+    std::remove(files[i]);
+  }
+
+  shared_ptr<XdmfDomain> domain = XdmfDomain::New();
+  shared_ptr<XdmfUnstructuredGrid> grid = XdmfUnstructuredGrid::New();
+  domain->insert(grid);
+
+  // 2.4 MB of values split over files of 1 MB
+  std::vector<unsigned int> dimensions;
+  dimensions.push_back(1000);
+  dimensions.push_back(300);
+  shared_ptr<XdmfAttribute> attribute = XdmfAttribute::New();
+  attribute->initialize<double>(dimensions);
+  for(unsigned int i = 0; i < attribute->getSize(); ++i) {
+    attribute->insert<double>(i, i);
+  }
+  grid->insert(attribute);
+
+  shared_ptr<XdmfHDF5Writer> hdf5Writer =
+    XdmfHDF5Writer::New("TestXdmfHDF5VirtualDataSet.h5", true);
+  hdf5Writer->setFileSizeLimit(1);
+  hdf5Writer->setAllowSetSplitting(true);
+  assert(!hdf5Writer->getVirtualDataSets());
+  hdf5Writer->setVirtualDataSets(true);
+  assert(hdf5Writer->getVirtualDataSets());
+  shared_ptr<XdmfWriter> writer =
+    XdmfWriter::New("TestXdmfHDF5VirtualDataSet.xmf", hdf5Writer);
+  domain->accept(writer);
+
+  // One controller for the virtual data set replaces the pieces
+  std::cout << attribute->getNumberHeavyDataControllers() << " ?= " << 1
+            << std::endl;
+  assert(attribute->getNumberHeavyDataControllers() == 1);
+  shared_ptr<XdmfHDF5Controller> controller =
+    shared_dynamic_cast<XdmfHDF5Controller>(attribute->getHeavyDataController(0));
+  assert(controller);
+  assert(controller->getDimensions() == dimensions);
+  assert(controller->getDataspaceDimensions() ==
+         std::vector<unsigned int>(1, 300000));
+  std::cout << controller->getFilePath() << " "
+            << controller->getDataSetPath() << std::endl;
+  assert(controller->getFilePath().compare("TestXdmfHDF5VirtualDataSet.h5") != 0);
+
+  // Read back through the light data with a single read
+  shared_ptr<XdmfReader> reader = XdmfReader::New();
+  shared_ptr<XdmfDomain> readDomain =
+    shared_dynamic_cast<XdmfDomain>(reader->read("./TestXdmfHDF5VirtualDataSet.xmf"));
+  shared_ptr<XdmfAttribute> readAttribute =
+    readDomain->getUnstructuredGrid(0)->getAttribute(0);
+  assert(readAttribute->getNumberHeavyDataControllers() == 1);
+  readAttribute->read();
+  assert(readAttribute->getDimensions() == dimensions);
+  for(unsigned int i = 0; i < readAttribute->getSize(); i += 997) {
+    assert(readAttribute->getValue<double>(i) == i);
+  }
+  assert(readAttribute->getValue<double>(299999) == 299999);
+
+  // Without the option every piece keeps its own controller
+  shared_ptr<XdmfHDF5Writer> pieceWriter =
+    XdmfHDF5Writer::New("TestXdmfHDF5VirtualDataSet.h5", true);
+  pieceWriter->setFileSizeLimit(1);
+  pieceWriter->setAllowSetSplitting(true);
+  attribute->accept(pieceWriter);
+  assert(attribute->getNumberHeavyDataControllers() > 1);
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include "XdmfArray.hpp"
+#include "XdmfAttribute.hpp"
+#include "XdmfGridCollection.hpp"
+#include "XdmfInformation.hpp"
+#include "XdmfItemFactory.hpp"
+#include "XdmfRegularGrid.hpp"
+#include "XdmfTime.hpp"
+#include "XdmfTopology.hpp"
+#include <cassert>
+
+// Factory registering a tag of its own and replacing a built in one
+class TestXdmfItemFactory : public XdmfItemFactory {
+
+public:
+
+  static shared_ptr<TestXdmfItemFactory>
+  New()
+  {
+    shared_ptr<TestXdmfItemFactory> p(new TestXdmfItemFactory());
+    return p;
+  }
+
+protected:
+
+  TestXdmfItemFactory()
+  {
+    this->registerItem("Note", createNote);
+    this->registerItem(XdmfTime::ItemTag, createTime);
+  }
+
+private:
+
+  static shared_ptr<XdmfItem>
+  createNote(const XdmfCoreItemFactory & factory,
+             const std::map<std::string, std::string> & itemProperties,
+             const std::vector<shared_ptr<XdmfItem> > & childItems)
+  {
+    // Built through the factory passed in
+    shared_ptr<XdmfInformation> note = shared_dynamic_cast<XdmfInformation>(
+      factory.createItem(XdmfInformation::ItemTag, itemProperties, childItems));
+    note->setKey("Note");
+    return note;
+  }
+
+  static shared_ptr<XdmfItem>
+  createTime(const XdmfCoreItemFactory &,
+             const std::map<std::string, std::string> &,
+             const std::vector<shared_ptr<XdmfItem> > &)
+  {
+    return XdmfTime::New(-1.0);
+  }
+
+};
+
+int main(int, char **)
+{
+  std::map<std::string, std::string> properties;
+  std::vector<shared_ptr<XdmfItem> > children;
+
+  shared_ptr<XdmfItemFactory> factory = XdmfItemFactory::New();
+  assert(shared_dynamic_cast<XdmfAttribute>(
+    factory->createItem(XdmfAttribute::ItemTag, properties, children)));
+  assert(shared_dynamic_cast<XdmfArray>(
+    factory->createItem("DataStructure", properties, children)));
+  assert(!factory->createItem("Unknown", properties, children));
+  assert(!factory->createItem("Note", properties, children));
+
+  // Values of properties that select the item built
+  properties["TopologyType"] = "3DCoRectMesh";
+  properties["Dimensions"] = "2 3 4";
+  shared_ptr<XdmfRegularGrid> regularGrid = shared_dynamic_cast<XdmfRegularGrid>(
+    factory->createItem(XdmfTopology::ItemTag, properties, children));
+  assert(regularGrid);
+  assert(regularGrid->getDimensions()->getValue<unsigned int>(2) == 4);
+  properties["TopologyType"] = "Triangle";
+  shared_ptr<XdmfItem> topology =
+    factory->createItem(XdmfTopology::ItemTag, properties, children);
+  assert(shared_dynamic_cast<XdmfTopology>(topology));
+  properties["GridType"] = "Collection";
+  assert(shared_dynamic_cast<XdmfGridCollection>(
+    factory->createItem(XdmfGrid::ItemTag, properties, children)));
+  properties.clear();
+
+  // Tags registered by a derived factory
+  shared_ptr<TestXdmfItemFactory> testFactory = TestXdmfItemFactory::New();
+  shared_ptr<XdmfInformation> note = shared_dynamic_cast<XdmfInformation>(
+    testFactory->createItem("Note", properties, children));
+  assert(note);
+  assert(note->getKey().compare("Note") == 0);
+  shared_ptr<XdmfTime> time = shared_dynamic_cast<XdmfTime>(
+    testFactory->createItem(XdmfTime::ItemTag, properties, children));
+  assert(time->getValue() == -1.0);
+  assert(shared_dynamic_cast<XdmfAttribute>(
+    testFactory->createItem(XdmfAttribute::ItemTag, properties, children)));
+
+  return 0;
+}
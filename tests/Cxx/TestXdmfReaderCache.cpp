@@ -0,0 +1,163 @@
+#include "XdmfDomain.hpp"
+#include "XdmfGridCollection.hpp"
+#include "XdmfGridCollectionType.hpp"
+#include "XdmfInformation.hpp"
+#include "XdmfReader.hpp"
+#include "XdmfTime.hpp"
+#include "XdmfWriter.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "XdmfTestCompareFiles.hpp"
+#include "XdmfTestDataGenerator.hpp"
+
+// Reads a temporal collection through the light data cache and checks
+// that the tree matches the one parsed from XML. Pass the number of
+// steps to time a larger run, for example 10000.
+
+static void
+writeSeries(unsigned int numSteps)
+{
+  shared_ptr<XdmfDomain> domain = XdmfDomain::New();
+  shared_ptr<XdmfInformation> information =
+    XdmfInformation::New("Run", "Cache");
+  domain->insert(information);
+  shared_ptr<XdmfGridCollection> collection = XdmfGridCollection::New();
+  collection->setType(XdmfGridCollectionType::Temporal());
+  domain->insert(collection);
+  for(unsigned int i = 0; i < numSteps; ++i) {
+    shared_ptr<XdmfUnstructuredGrid> grid =
+      XdmfTestDataGenerator::createHexahedron();
+    grid->setTime(XdmfTime::New(i));
+    // Written as an xi:include of the first
+    grid->insert(information);
+    collection->insert(grid);
+  }
+  shared_ptr<XdmfWriter> writer = XdmfWriter::New("TestXdmfReaderCache.xmf");
+  writer->setLightDataLimit(10);
+  domain->accept(writer);
+}
+
+static shared_ptr<XdmfDomain>
+readSeries(shared_ptr<XdmfReader> reader,
+           const std::string & outputFile,
+           double & readTime)
+{
+  const clock_t start = clock();
+  shared_ptr<XdmfDomain> domain =
+    shared_dynamic_cast<XdmfDomain>(reader->read("./TestXdmfReaderCache.xmf"));
+  readTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+  shared_ptr<XdmfWriter> writer = XdmfWriter::New(outputFile);
+  writer->setMode(XdmfWriter::DistributedHeavyData);
+  domain->accept(writer);
+  return domain;
+}
+
+static bool
+fileExists(const std::string & filePath)
+{
+  std::ifstream file(filePath.c_str());
+  return file.good();
+}
+
+int main(int argc, char * argv[])
+{
+  unsigned int numSteps = 50;
+  if(argc > 1) {
+    numSteps = std::atoi(argv[1]);
+  }
+
+  std::remove("TestXdmfReaderCache.xmf.cache");
+  writeSeries(numSteps);
+
+  double parseTime, firstTime, cacheTime;
+  shared_ptr<XdmfReader> reader = XdmfReader::New();
+  assert(!reader->getLightDataCache());
+  readSeries(reader, "TestXdmfReaderCache1.xmf", parseTime);
+  assert(!fileExists("./TestXdmfReaderCache.xmf.cache"));
+
+  // The first read builds the cache, the second reads from it
+  reader->setLightDataCache(true);
+  assert(reader->getLightDataCache());
+  readSeries(reader, "TestXdmfReaderCache2.xmf", firstTime);
+  assert(fileExists("./TestXdmfReaderCache.xmf.cache"));
+  shared_ptr<XdmfDomain> domain =
+    readSeries(reader, "TestXdmfReaderCache3.xmf", cacheTime);
+
+  std::cout << numSteps << " steps parsed in " << parseTime
+            << " s, read from the cache in " << cacheTime << " s" << std::endl;
+
+  assert(XdmfTestCompareFiles::compareFiles("TestXdmfReaderCache1.xmf",
+                                            "TestXdmfReaderCache2.xmf"));
+  assert(XdmfTestCompareFiles::compareFiles("TestXdmfReaderCache1.xmf",
+                                            "TestXdmfReaderCache3.xmf"));
+
+  // Items included by an xpointer are still shared
+  shared_ptr<XdmfGridCollection> collection = domain->getGridCollection(0);
+  assert(collection->getNumberUnstructuredGrids() == numSteps);
+  assert(collection->getUnstructuredGrid(numSteps - 1)->getTime()->getValue() ==
+         numSteps - 1);
+  assert(collection->getUnstructuredGrid(numSteps - 1)->getInformation(0) ==
+         domain->getInformation(0));
+
+  // Heavy data read through the cache is found next to the file
+  shared_ptr<XdmfAttribute> attribute =
+    collection->getUnstructuredGrid(0)->getAttribute(0);
+  attribute->read();
+  assert(attribute->getSize() > 0);
+
+  // A changed file is parsed again
+  writeSeries(numSteps + 1);
+  collection = readSeries(reader, "TestXdmfReaderCache2.xmf",
+                          cacheTime)->getGridCollection(0);
+  assert(collection->getNumberUnstructuredGrids() == numSteps + 1);
+  collection = readSeries(reader, "TestXdmfReaderCache3.xmf",
+                          cacheTime)->getGridCollection(0);
+  assert(collection->getNumberUnstructuredGrids() == numSteps + 1);
+
+  // A file edited in place without changing its size is parsed again,
+  // even within the same tick of the file system's clock
+  std::string xml;
+  {
+    std::ifstream xmlFile("TestXdmfReaderCache.xmf",
+                          std::ios::in | std::ios::binary);
+    std::stringstream xmlStream;
+    xmlStream << xmlFile.rdbuf();
+    xml = xmlStream.str();
+  }
+  const size_t valuePosition = xml.find("Value=\"Cache\"");
+  assert(valuePosition != std::string::npos);
+  std::string editedXML(xml);
+  editedXML.replace(valuePosition, 13, "Value=\"Cachf\"");
+  {
+    std::ofstream xmlFile("TestXdmfReaderCache.xmf",
+                          std::ios::out | std::ios::binary | std::ios::trunc);
+    xmlFile << editedXML;
+  }
+  domain = shared_dynamic_cast<XdmfDomain>(
+    reader->read("./TestXdmfReaderCache.xmf"));
+  assert(domain->getInformation(0)->getValue().compare("Cachf") == 0);
+  {
+    std::ofstream xmlFile("TestXdmfReaderCache.xmf",
+                          std::ios::out | std::ios::binary | std::ios::trunc);
+    xmlFile << xml;
+  }
+
+  // A broken cache is replaced
+  std::ofstream cacheFile("TestXdmfReaderCache.xmf.cache",
+                          std::ios::out | std::ios::binary | std::ios::app);
+  cacheFile << "broken";
+  cacheFile.close();
+  collection = readSeries(reader, "TestXdmfReaderCache3.xmf",
+                          cacheTime)->getGridCollection(0);
+  assert(collection->getNumberUnstructuredGrids() == numSteps + 1);
+  assert(XdmfTestCompareFiles::compareFiles("TestXdmfReaderCache2.xmf",
+                                            "TestXdmfReaderCache3.xmf"));
+
+  return 0;
+}
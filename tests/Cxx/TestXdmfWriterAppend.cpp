@@ -0,0 +1,116 @@
+#include "XdmfAttribute.hpp"
+#include "XdmfDomain.hpp"
+#include "XdmfGridCollection.hpp"
+#include "XdmfGridCollectionType.hpp"
+#include "XdmfHDF5Writer.hpp"
+#include "XdmfInformation.hpp"
+#include "XdmfReader.hpp"
+#include "XdmfTime.hpp"
+#include "XdmfUnstructuredGrid.hpp"
+#include "XdmfWriter.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+// Writes a time series one step at a time into a temporal collection,
+// then continues the series with a new writer. Pass the number of
+// steps to time a larger run, for example 10000.
+
+static shared_ptr<XdmfUnstructuredGrid>
+createStep(unsigned int step)
+{
+  shared_ptr<XdmfUnstructuredGrid> grid = XdmfUnstructuredGrid::New();
+  grid->setName("Step");
+  grid->setTime(XdmfTime::New(step));
+  shared_ptr<XdmfAttribute> attribute = XdmfAttribute::New();
+  attribute->setName("Pressure");
+  attribute->resize<double>(1000, step);
+  grid->insert(attribute);
+  // Written as an xi:include of the first
+  grid->insert(attribute);
+  return grid;
+}
+
+static double
+appendSteps(shared_ptr<XdmfWriter> writer,
+            unsigned int first,
+            unsigned int numSteps)
+{
+  const clock_t start = clock();
+  for(unsigned int i = first; i < first + numSteps; ++i) {
+    createStep(i)->accept(writer);
+  }
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void
+checkSteps(unsigned int numSteps)
+{
+  shared_ptr<XdmfReader> reader = XdmfReader::New();
+  shared_ptr<XdmfDomain> domain =
+    shared_dynamic_cast<XdmfDomain>(reader->read("./TestXdmfWriterAppend.xmf"));
+  assert(domain->getNumberInformations() == 1);
+  shared_ptr<XdmfGridCollection> collection = domain->getGridCollection(0);
+  std::cout << collection->getNumberUnstructuredGrids() << " ?= "
+            << numSteps << std::endl;
+  assert(collection->getNumberUnstructuredGrids() == numSteps);
+  for(unsigned int i = 0; i < numSteps; i += numSteps / 10 + 1) {
+    shared_ptr<XdmfUnstructuredGrid> grid = collection->getUnstructuredGrid(i);
+    assert(grid->getTime()->getValue() == i);
+    assert(grid->getNumberAttributes() == 2);
+    for(unsigned int j = 0; j < 2; ++j) {
+      shared_ptr<XdmfAttribute> attribute = grid->getAttribute(j);
+      attribute->read();
+      assert(attribute->getSize() == 1000);
+      assert(attribute->getValue<double>(999) == i);
+    }
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  unsigned int numSteps = 200;
+  if(argc > 1) {
+    numSteps = std::atoi(argv[1]);
+  }
+  const unsigned int half = numSteps / 2;
+
+  std::remove("TestXdmfWriterAppend.xmf");
+
+  shared_ptr<XdmfDomain> domain = XdmfDomain::New();
+  domain->insert(XdmfInformation::New("Run", "Append"));
+  shared_ptr<XdmfGridCollection> collection = XdmfGridCollection::New();
+  collection->setType(XdmfGridCollectionType::Temporal());
+  collection->insert(createStep(0));
+  domain->insert(collection);
+
+  shared_ptr<XdmfHDF5Writer> heavyWriter =
+    XdmfHDF5Writer::New("TestXdmfWriterAppend.h5", true);
+  shared_ptr<XdmfWriter> writer =
+    XdmfWriter::New("TestXdmfWriterAppend.xmf", heavyWriter);
+  assert(!writer->getAppendTarget());
+  writer->setAppendTarget(collection);
+  assert(writer->getAppendTarget() == collection);
+  domain->accept(writer);
+  checkSteps(1);
+
+  const double firstTime = appendSteps(writer, 1, half - 1);
+  checkSteps(half);
+
+  // A new writer finds the target in the file and continues the series
+  shared_ptr<XdmfHDF5Writer> appendHeavyWriter =
+    XdmfHDF5Writer::New("TestXdmfWriterAppend.h5");
+  shared_ptr<XdmfWriter> appendWriter =
+    XdmfWriter::New("TestXdmfWriterAppend.xmf", appendHeavyWriter);
+  appendWriter->setAppendTarget(collection);
+  const double secondTime = appendSteps(appendWriter, half, numSteps - half);
+  checkSteps(numSteps);
+
+  std::cout << numSteps << " steps appended in " << firstTime + secondTime
+            << " s (" << firstTime << " s for the first " << half
+            << ", " << secondTime << " s for the rest)" << std::endl;
+
+  return 0;
+}
@@ -122,6 +122,36 @@ XdmfFortran::insertElements(const T grid,
   }
 }
 
+namespace {
+
+  // Fill the caller's buffer straight from the heavy data controllers,
+  // the conversion to T is done by the controllers while reading. The
+  // array is released afterwards so that it does not keep referring to
+  // memory it does not own.
+  template <typename T>
+  void
+  readIntoBuffer(const shared_ptr<XdmfArray> & array,
+                 void * const values,
+                 const unsigned int numValues)
+  {
+    array->read(static_cast<T *>(values), numValues);
+    array->release();
+  }
+
+  // Wrap the caller's buffer in the array without copying it.
+  template <typename T>
+  void
+  wrapBuffer(const shared_ptr<XdmfArray> & array,
+             const void * const values,
+             const unsigned int numValues)
+  {
+    array->setValuesInternal(static_cast<const T *>(values),
+                             numValues,
+                             false);
+  }
+
+}
+
 // read values from an xdmf array for a number type
 void
 XdmfFortran::readFromArray(shared_ptr<XdmfArray> array,
@@ -132,6 +162,46 @@ XdmfFortran::readFromArray(shared_ptr<XdmfArray> array,
                            const unsigned int arrayStride,
                            const unsigned int valuesStride)
 {
+  if (mPassThrough &&
+      !array->isInitialized() &&
+      array->getNumberHeavyDataControllers() > 0 &&
+      array->getReadMode() == XdmfArray::Controller &&
+      startIndex == 0 &&
+      arrayStride == 1 &&
+      valuesStride == 1 &&
+      numValues == array->getSize()) {
+    switch(arrayType) {
+    case XDMF_ARRAY_TYPE_INT8:
+      readIntoBuffer<char>(array, values, numValues);
+      return;
+    case XDMF_ARRAY_TYPE_INT16:
+      readIntoBuffer<short>(array, values, numValues);
+      return;
+    case XDMF_ARRAY_TYPE_INT32:
+      readIntoBuffer<int>(array, values, numValues);
+      return;
+    case XDMF_ARRAY_TYPE_INT64:
+      readIntoBuffer<long>(array, values, numValues);
+      return;
+    case XDMF_ARRAY_TYPE_UINT8:
+      readIntoBuffer<unsigned char>(array, values, numValues);
+      return;
+    case XDMF_ARRAY_TYPE_UINT16:
+      readIntoBuffer<unsigned short>(array, values, numValues);
+      return;
+    case XDMF_ARRAY_TYPE_UINT32:
+      readIntoBuffer<unsigned int>(array, values, numValues);
+      return;
+    case XDMF_ARRAY_TYPE_FLOAT32:
+      readIntoBuffer<float>(array, values, numValues);
+      return;
+    case XDMF_ARRAY_TYPE_FLOAT64:
+      readIntoBuffer<double>(array, values, numValues);
+      return;
+    default:
+      break;
+    }
+  }
   if (!array->isInitialized()) {
     array->read();
   }
@@ -220,6 +290,50 @@ XdmfFortran::writeToArray(shared_ptr<XdmfArray> array,
                           const unsigned int arrayStride,
                           const unsigned int valueStride)
 {
+  if (mPassThrough &&
+      array->getSize() == 0 &&
+      offset == 0 &&
+      arrayStride == 1 &&
+      valueStride == 1) {
+    bool wrapped = true;
+    switch(arrayType) {
+    case XDMF_ARRAY_TYPE_INT8:
+      wrapBuffer<char>(array, values, numValues);
+      break;
+    case XDMF_ARRAY_TYPE_INT16:
+      wrapBuffer<short>(array, values, numValues);
+      break;
+    case XDMF_ARRAY_TYPE_INT32:
+      wrapBuffer<int>(array, values, numValues);
+      break;
+    case XDMF_ARRAY_TYPE_INT64:
+      wrapBuffer<long>(array, values, numValues);
+      break;
+    case XDMF_ARRAY_TYPE_UINT8:
+      wrapBuffer<unsigned char>(array, values, numValues);
+      break;
+    case XDMF_ARRAY_TYPE_UINT16:
+      wrapBuffer<unsigned short>(array, values, numValues);
+      break;
+    case XDMF_ARRAY_TYPE_UINT32:
+      wrapBuffer<unsigned int>(array, values, numValues);
+      break;
+    case XDMF_ARRAY_TYPE_FLOAT32:
+      wrapBuffer<float>(array, values, numValues);
+      break;
+    case XDMF_ARRAY_TYPE_FLOAT64:
+      wrapBuffer<double>(array, values, numValues);
+      break;
+    default:
+      wrapped = false;
+      break;
+    }
+    if (wrapped) {
+      mPassThroughArrays.push_back(array);
+      return;
+    }
+  }
+
   switch(arrayType) {
   case XDMF_ARRAY_TYPE_INT8:
     array->insert(offset,
@@ -307,7 +421,8 @@ XdmfFortran::XdmfFortran() :
   mHeavyDataWriter(shared_ptr<XdmfHeavyDataWriter>()),
   mDSMWriter(shared_ptr<XdmfHDF5WriterDSM>()),
   mMaxFileSize(0),
-  mAllowSetSplitting(false)
+  mAllowSetSplitting(false),
+  mPassThrough(false)
 {
 }
 
@@ -3799,9 +3914,6 @@ XdmfFortran::retrieveGeometryValues(void * values,
     }
   }
   else {
-    if (!mGeometry->isInitialized()) {
-      mGeometry->read();
-    }
     readFromArray(mGeometry,
                   dataType,
                   values,
@@ -4204,9 +4316,6 @@ XdmfFortran::retrieveTopologyValues(void * values,
     }
   }
   else {
-    if (!mTopology->isInitialized()) {
-      mTopology->read();
-    }
     readFromArray(mTopology,
                   dataType,
                   values,
@@ -4551,9 +4660,6 @@ XdmfFortran::retrieveDimensionsValues(void * values,
     }
   }
   else {
-    if (!mDimensions->isInitialized()) {
-      mDimensions->read();
-    }
     readFromArray(mDimensions,
                   dataType,
                   values,
@@ -4844,9 +4950,6 @@ XdmfFortran::retrieveOriginValues(void * values,
     }
   }
   else {
-    if (!mOrigin->isInitialized()) {
-      mOrigin->read();
-    }
     readFromArray(mOrigin,
                   dataType,
                   values,
@@ -5133,9 +5236,6 @@ XdmfFortran::retrieveBrickValues(void * values,
     }
   }
   else {
-    if (!mBrick->isInitialized()) {
-      mBrick->read();
-    }
     readFromArray(mBrick,
                   dataType,
                   values,
@@ -5638,9 +5738,6 @@ XdmfFortran::retrieveAttributeValues(const int index,
                                      const int valueStride)
 {
   if (index < (int)mAttributes.size()) {
-    if (!mAttributes[index]->isInitialized()) {
-      mAttributes[index]->read();
-    }
     readFromArray(mAttributes[index],
                   dataType,
                   values,
@@ -6203,9 +6300,6 @@ XdmfFortran::retrieveCoordinateValues(const int index,
                                       const int valueStride)
 {
   if (index < (int)mCoordinates.size()) {
-    if (!mCoordinates[index]->isInitialized()) {
-      mCoordinates[index]->read();
-    }
     readFromArray(mCoordinates[index],
                   dataType,
                   values,
@@ -6640,9 +6734,6 @@ XdmfFortran::retrieveSetValues(const int index,
                                const int valueStride)
 {
   if (index < (int)mSets.size()) {
-    if (!mSets[index]->isInitialized()) {
-      mSets[index]->read();
-    }
     readFromArray(mSets[index],
                   dataType,
                   values,
@@ -7446,9 +7537,6 @@ XdmfFortran::retrieveInformationArrayValues(const int index,
 {
   if (index < (int)mInformations.size()) {
     if (arrayIndex < (int)mInformations[index]->getNumberArrays()) {
-      if (!mInformations[index]->getArray(arrayIndex)->isInitialized()) {
-        mInformations[index]->getArray(arrayIndex)->read();
-      }
       readFromArray(mInformations[index]->getArray(arrayIndex),
                     dataType,
                     values,
@@ -7492,6 +7580,36 @@ XdmfFortran::clearPrevious()
   mPreviousCoordinates.clear();
 }
 
+void
+XdmfFortran::releasePassThrough()
+{
+  // The caller's buffers are only borrowed until they have been
+  // written. Arrays that went to heavy data are released so that they
+  // are read back from the file when needed, the rest keep a copy.
+  for(std::vector<boost::weak_ptr<XdmfArray> >::const_iterator iter =
+        mPassThroughArrays.begin();
+      iter != mPassThroughArrays.end();
+      ++iter) {
+    if(shared_ptr<XdmfArray> array = iter->lock()) {
+      if(array->isInitialized()) {
+        if(array->getNumberHeavyDataControllers() > 0) {
+          array->release();
+        }
+        else {
+          array->reserve(array->getSize());
+        }
+      }
+    }
+  }
+  mPassThroughArrays.clear();
+}
+
+void
+XdmfFortran::setPassThrough(bool newPassThrough)
+{
+  mPassThrough = newPassThrough;
+}
+
 void
 XdmfFortran::setAllowSetSplitting(bool newAllow)
 {
@@ -7522,6 +7640,7 @@ XdmfFortran::write(const char * const xmlFilePath,
   shared_dynamic_cast<XdmfHDF5Writer>(writer->getHeavyDataWriter())->setFileSizeLimit(mMaxFileSize);
   shared_dynamic_cast<XdmfHDF5Writer>(writer->getHeavyDataWriter())->setAllowSetSplitting(mAllowSetSplitting);
   mDomain->accept(writer);
+  releasePassThrough();
 }
 
 void 
@@ -7541,6 +7660,7 @@ XdmfFortran::writeHDF5(const char * const xmlFilePath,
   mHeavyDataWriter->openFile();
   mDomain->accept(mHeavyDataWriter);
   mHeavyDataWriter->closeFile();
+  releasePassThrough();
 }
 
 void
@@ -7753,7 +7873,6 @@ XdmfFortran::readFromDSM(const char * const dsmDataSetPath,
     shared_ptr<XdmfArray> readArray = XdmfArray::New();
 
     readArray->insert(writerController);
-    readArray->read();
 
     readFromArray(readArray,
                   arrayType,
@@ -9827,6 +9946,13 @@ extern "C"
     xdmfFortran->setAllowSetSplitting(*newAllow);
   }
 
+  void
+  XdmfSetPassThrough(long * pointer, bool * newPassThrough)
+  {
+    XdmfFortran * xdmfFortran = reinterpret_cast<XdmfFortran *>(*pointer);
+    xdmfFortran->setPassThrough(*newPassThrough);
+  }
+
   void
   XdmfSetMaxFileSize(long * pointer, int * newSize)
   {
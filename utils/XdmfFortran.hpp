@@ -46,6 +46,7 @@ class XdmfHDF5WriterDSM;
 //Includes
 #include <stack>
 #include <vector>
+#include <boost/weak_ptr.hpp>
 #include "XdmfUtils.hpp"
 #include "XdmfSharedPtr.hpp"
 
@@ -182,6 +183,7 @@ class XdmfHDF5WriterDSM;
 #define XdmfSetTopology xdmfsettopology_
 #define XdmfSetAllowSetSplitting xdmfsetallowsetsplitting_
 #define XdmfSetMaxFileSize xdmfsetmaxfilesize_
+#define XdmfSetPassThrough xdmfsetpassthrough_
 #define XdmfWrite xdmfwrite_
 #define XdmfRead xdmfread_
 #define XdmfInitDSMServer xdmfinitdsmserver_
@@ -2890,6 +2892,22 @@ public:
    */
   void setAllowSetSplitting(bool newAllow);
 
+  /**
+   * Sets whether arrays passed in are used in place instead of being
+   * copied. When on, the values given to addAttribute, setGeometry,
+   * setTopology and the other calls that create an array are wrapped
+   * without a copy, so they must stay valid and unchanged until the
+   * next write or writeHDF5. After writing, arrays that went to heavy
+   * data are released and the rest are copied. Retrieving all of the
+   * values of an array that has not been read yet reads them from the
+   * heavy data straight into the buffer given, converting to the
+   * requested type while reading.
+   * Default is off (false).
+   *
+   * @param     newPassThrough  Whether to use buffers in place or not
+   */
+  void setPassThrough(bool newPassThrough);
+
   /**
    * Sets the file size at which the hdf5 writer will move to a new file.
    * Default is no splitting (value=0)
@@ -3098,6 +3116,8 @@ private:
                const unsigned int offset = 0,
                const unsigned int arrayStride = 1,
                const unsigned int valueStride = 1);
+
+  void releasePassThrough();
   
   shared_ptr<XdmfDomain>                        mDomain;
   shared_ptr<XdmfGeometry>                      mGeometry;
@@ -3129,6 +3149,8 @@ private:
 
   unsigned int mMaxFileSize;
   bool mAllowSetSplitting;
+  bool mPassThrough;
+  std::vector<boost::weak_ptr<XdmfArray> >      mPassThroughArrays;
 
 
 };